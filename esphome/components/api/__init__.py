@@ -50,6 +50,8 @@ SERVICE_ARG_NATIVE_TYPES = {
 }
 CONF_ENCRYPTION = "encryption"
 CONF_BATCH_DELAY = "batch_delay"
+CONF_TX_BUFFER_SIZE = "tx_buffer_size"
+CONF_TX_BUFFER_IN_PSRAM = "tx_buffer_in_psram"
 
 
 def validate_encryption_key(value):
@@ -113,6 +115,12 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_BATCH_DELAY, default="100ms"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_TX_BUFFER_SIZE, default=4096): cv.All(
+                cv.validate_bytes, cv.int_range(min=1024, max=32768)
+            ),
+            cv.Optional(CONF_TX_BUFFER_IN_PSRAM): cv.All(
+                cv.only_on_esp32, cv.requires_component("psram"), cv.boolean
+            ),
             cv.Optional(CONF_ON_CLIENT_CONNECTED): automation.validate_automation(
                 single=True
             ),
@@ -134,6 +142,9 @@ async def to_code(config):
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
     cg.add(var.set_batch_delay(config[CONF_BATCH_DELAY]))
+    cg.add(var.set_tx_buffer_size(config[CONF_TX_BUFFER_SIZE]))
+    if config.get(CONF_TX_BUFFER_IN_PSRAM):
+        cg.add(var.set_tx_buffer_in_psram(True))
 
     for conf in config.get(CONF_ACTIONS, []):
         template_args = []
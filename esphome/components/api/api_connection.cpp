@@ -47,6 +47,7 @@ APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *pa
 #else
 #error "No frame helper defined"
 #endif
+  this->helper_->set_tx_buffer_config(parent->get_tx_buffer_size(), parent->get_tx_buffer_in_psram());
 }
 
 uint32_t APIConnection::get_batch_delay_ms_() const { return this->parent_->get_batch_delay(); }
@@ -130,10 +131,12 @@ void APIConnection::loop() {
       this->last_traffic_ = App.get_loop_component_start_time();
       // read a packet
       if (buffer.data_len > 0) {
-        this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
+        this->read_message(buffer.data_len, buffer.type, buffer.data);
       } else {
         this->read_message(0, buffer.type, nullptr);
       }
+      // A command may have changed entity states that other connections already encoded
+      this->parent_->invalidate_encoded_states();
       if (this->remove_)
         return;
     }
@@ -179,8 +182,12 @@ void APIConnection::loop() {
   }
 
 #ifdef USE_ESP32_CAMERA
-  if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
-    uint32_t to_send = std::min((size_t) MAX_PACKET_SIZE, this->image_reader_.available());
+  // Image chunks are at most MAX_PACKET_SIZE bytes plus framing, and smaller when that would not fit into the bulk
+  // lane of a small TX buffer
+  static constexpr uint16_t IMAGE_CHUNK_OVERHEAD = 32;
+  uint32_t to_send = std::min({(size_t) MAX_PACKET_SIZE, this->image_reader_.available(),
+                               (size_t) this->helper_->lane_budget(APILane::BULK) - IMAGE_CHUNK_OVERHEAD});
+  if (to_send != 0 && this->helper_->can_queue(APILane::BULK, to_send + IMAGE_CHUNK_OVERHEAD)) {
     bool done = this->image_reader_.available() == to_send;
     uint32_t msg_size = 0;
     ProtoSize::add_fixed_field<4>(msg_size, 1, true);
@@ -191,13 +198,13 @@ void APIConnection::loop() {
 
     auto buffer = this->create_buffer(msg_size);
     // fixed32 key = 1;
-    buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
+    buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash(), true);
     // bytes data = 2;
     buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
     // bool done = 3;
     buffer.encode_bool(3, done);
 
-    bool success = this->send_buffer(buffer, 44);
+    bool success = buffer.verify(44) && this->send_buffer(buffer, 44);
 
     if (success) {
       this->image_reader_.consume_data(to_send);
@@ -244,7 +251,8 @@ void APIConnection::on_disconnect_response(const DisconnectResponse &value) {
 }
 
 // Encodes a message to the buffer and returns the total number of bytes used,
-// including header and footer overhead. Returns 0 if the message doesn't fit.
+// including header and footer overhead. Returns 0 if the message doesn't fit or was dropped because it did not
+// encode to its calculated size.
 uint16_t APIConnection::encode_message_to_buffer(ProtoMessage &msg, uint16_t message_type, APIConnection *conn,
                                                  uint32_t remaining_size, bool is_single) {
   // Calculate size
@@ -264,25 +272,26 @@ uint16_t APIConnection::encode_message_to_buffer(ProtoMessage &msg, uint16_t mes
   }
 
   // Allocate buffer space - pass payload size, allocation functions add header/footer space
+  std::vector<uint8_t> &shared_buf = conn->parent_->get_shared_buffer_ref();
+  const size_t previous_size = shared_buf.size();
+  const bool was_first_message = conn->batch_first_message_;
   ProtoWriteBuffer buffer = is_single ? conn->allocate_single_message_buffer(calculated_size)
                                       : conn->allocate_batch_message_buffer(calculated_size);
 
-  // Get buffer size after allocation (which includes header padding)
-  std::vector<uint8_t> &shared_buf = conn->parent_->get_shared_buffer_ref();
-  size_t size_before_encode = shared_buf.size();
-
-  // Encode directly into buffer
+  // Encode directly into the space allocated for it
   msg.encode(buffer);
 
-  // Calculate actual encoded size (not including header that was already added)
-  size_t actual_payload_size = shared_buf.size() - size_before_encode;
-
-  // Return actual total size (header + actual payload + footer)
-  size_t actual_total_size = header_padding + actual_payload_size + footer_size;
-
-  // Verify that calculate_size() returned the correct value
-  assert(calculated_size == actual_payload_size);
-  return static_cast<uint16_t>(actual_total_size);
+  // Encoding must end exactly at the end of the buffer, otherwise calculate_size() was wrong and the frame is dropped
+  if (!buffer.verify(message_type)) {
+    if (is_single || was_first_message) {
+      shared_buf.clear();
+    } else {
+      shared_buf.resize(previous_size);
+    }
+    conn->batch_first_message_ = was_first_message;
+    return 0;
+  }
+  return static_cast<uint16_t>(total_calculated_size);
 }
 
 #ifdef USE_BINARY_SENSOR
@@ -1359,7 +1368,8 @@ void APIConnection::voice_assistant_set_configuration(const VoiceAssistantSetCon
       return;
     }
 
-    voice_assistant::global_voice_assistant->on_set_configuration(msg.active_wake_words);
+    std::vector<std::string> active_wake_words(msg.active_wake_words.begin(), msg.active_wake_words.end());
+    voice_assistant::global_voice_assistant->on_set_configuration(active_wake_words);
   }
 }
 
@@ -1530,14 +1540,16 @@ bool APIConnection::try_send_log_message(int level, const char *tag, const char
   // 1 byte for field tag + size of length varint + string length
   msg_size += 1 + api::ProtoSize::varint(static_cast<uint32_t>(line_length)) + line_length;
 
-  // Create a pre-sized buffer
+  // Create a buffer sized for exactly this message
   auto buffer = this->create_buffer(msg_size);
 
-  // Encode the message (SubscribeLogsResponse)
-  buffer.encode_uint32(1, static_cast<uint32_t>(level));  // LogLevel level = 1
-  buffer.encode_string(3, line, line_length);             // string message = 3
+  // Encode the message (SubscribeLogsResponse), level is always written since its size is counted above
+  buffer.encode_uint32(1, static_cast<uint32_t>(level), true);  // LogLevel level = 1
+  buffer.encode_string(3, line, line_length);                   // string message = 3
 
   // SubscribeLogsResponse - 29
+  if (!buffer.verify(SubscribeLogsResponse::MESSAGE_TYPE))
+    return false;
   return this->send_buffer(buffer, SubscribeLogsResponse::MESSAGE_TYPE);
 }
 
@@ -1684,8 +1696,45 @@ bool APIConnection::try_to_clear_buffer(bool log_out_of_space) {
   }
   return false;
 }
+bool APIConnection::try_to_queue_in_lane_(APILane lane, uint16_t frame_size) {
+  if (this->helper_->can_queue(lane, frame_size))
+    return true;
+  this->try_to_clear_buffer(false);
+  if (this->helper_->can_queue(lane, frame_size))
+    return true;
+  this->helper_->get_tx_stats().lanes[static_cast<uint8_t>(lane)].frames_refused++;
+  return false;
+}
+void APIConnection::log_tx_stats_() {
+  const APITxStats &stats = this->helper_->get_tx_stats();
+  bool any_refused = false;
+  for (const auto &lane : stats.lanes)
+    any_refused |= lane.frames_refused != 0;
+  if (stats.frames_queued == 0 && stats.states_superseded == 0 && !any_refused)
+    return;
+  ESP_LOGD(TAG,
+           "%s: TX buffer peak %u bytes, %" PRIu32 " frames queued, %" PRIu32 " stale states dropped, grown %u times",
+           this->client_combined_info_.c_str(), stats.peak_bytes, stats.frames_queued, stats.states_superseded,
+           stats.grows);
+  for (uint8_t i = 0; i < API_LANE_COUNT; i++) {
+    const APILaneStats &lane = stats.lanes[i];
+    if (lane.frames_queued == 0 && lane.frames_refused == 0)
+      continue;
+    ESP_LOGD(TAG,
+             "  %s lane: %" PRIu32 " frames queued, %" PRIu32 " refused, queueing delay avg %" PRIu32
+             " ms, max %u ms",
+             api_lane_to_str(static_cast<APILane>(i)), lane.frames_queued, lane.frames_refused,
+             lane.runs_sent == 0 ? 0 : lane.delay_total_ms / lane.runs_sent, lane.delay_max_ms);
+  }
+}
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint16_t message_type) {
-  if (!this->try_to_clear_buffer(message_type != SubscribeLogsResponse::MESSAGE_TYPE)) {  // SubscribeLogsResponse
+  // Control frames only need the TX buffer below its high water mark, the other lanes are limited to their share
+  APILane lane = api_message_lane(message_type);
+  if (lane != APILane::CONTROL) {
+    uint16_t frame_size = buffer.get_buffer()->size() + this->helper_->frame_footer_size();
+    if (!this->try_to_queue_in_lane_(lane, frame_size))
+      return false;
+  } else if (!this->try_to_clear_buffer(true)) {
     return false;
   }
 
@@ -1718,20 +1767,62 @@ void APIConnection::on_fatal_error() {
   this->remove_ = true;
 }
 
-void APIConnection::DeferredBatch::add_item(EntityBase *entity, MessageCreator creator, uint16_t message_type) {
+bool APIConnection::DeferredBatch::add_item(EntityBase *entity, MessageCreator creator, uint16_t message_type) {
   // Check if we already have a message of this type for this entity
   // This provides deduplication per entity/message_type combination
-  // O(n) but optimized for RAM and not performance.
-  for (auto &item : items) {
-    if (item.entity == entity && item.message_type == message_type) {
-      // Update the existing item with the new creator
-      item.creator = std::move(creator);
-      return;
+  const uint32_t mask = this->index.size() - 1;
+  uint32_t slot = 0;
+  if (this->index.empty()) {
+    for (auto &item : this->items) {
+      if (item.entity == entity && item.message_type == message_type) {
+        // Update the existing item with the new creator
+        item.creator = std::move(creator);
+        return true;
+      }
+    }
+  } else {
+    for (slot = entity_message_hash(entity, message_type) & mask; this->index[slot] != 0; slot = (slot + 1) & mask) {
+      auto &item = this->items[this->index[slot] - 1];
+      if (item.entity == entity && item.message_type == message_type) {
+        item.creator = std::move(creator);
+        return true;
+      }
     }
   }
 
   // No existing item found, add new one
-  items.emplace_back(entity, std::move(creator), message_type);
+  this->items.emplace_back(entity, std::move(creator), message_type);
+  if (this->index.empty() ? this->items.size() >= INDEX_MIN_ITEMS : this->items.size() * 4 > this->index.size() * 3) {
+    this->rebuild_index_();
+  } else if (!this->index.empty()) {
+    this->index[slot] = this->items.size();
+  }
+  return false;
+}
+
+void APIConnection::DeferredBatch::remove_front(size_t count) {
+  this->items.erase(this->items.begin(), this->items.begin() + count);
+  // The remaining items moved, so their index entries are stale
+  if (this->items.size() < INDEX_MIN_ITEMS) {
+    this->index.clear();
+  } else {
+    this->rebuild_index_();
+  }
+}
+
+void APIConnection::DeferredBatch::rebuild_index_() {
+  // Start at most 3/8 full, add_item() rebuilds again once it gets more than 3/4 full
+  size_t capacity = 32;
+  while (this->items.size() * 4 > capacity * 3 / 2)
+    capacity *= 2;
+  this->index.assign(capacity, 0);
+  const uint32_t mask = capacity - 1;
+  for (size_t i = 0; i < this->items.size(); i++) {
+    uint32_t slot = entity_message_hash(this->items[i].entity, this->items[i].message_type) & mask;
+    while (this->index[slot] != 0)
+      slot = (slot + 1) & mask;
+    this->index[slot] = i + 1;
+  }
 }
 
 bool APIConnection::schedule_batch_() {
@@ -1769,7 +1860,7 @@ void APIConnection::process_batch_() {
     const auto &item = this->deferred_batch_.items[0];
 
     // Let the creator calculate size and encode if it fits
-    uint16_t payload_size = item.creator(item.entity, this, std::numeric_limits<uint16_t>::max(), true);
+    uint16_t payload_size = this->encode_batch_item_(item, std::numeric_limits<uint16_t>::max(), true);
 
     if (payload_size > 0 &&
         this->send_buffer(ProtoWriteBuffer{&this->parent_->get_shared_buffer_ref()}, item.message_type)) {
@@ -1819,7 +1910,7 @@ void APIConnection::process_batch_() {
   for (const auto &item : this->deferred_batch_.items) {
     // Try to encode message
     // The creator will calculate overhead to determine if the message fits
-    uint16_t payload_size = item.creator(item.entity, this, remaining_size, false);
+    uint16_t payload_size = this->encode_batch_item_(item, remaining_size, false);
 
     if (payload_size == 0) {
       // Message won't fit, stop processing
@@ -1870,8 +1961,7 @@ void APIConnection::process_batch_() {
   // Handle remaining items more efficiently
   if (items_processed < this->deferred_batch_.items.size()) {
     // Remove processed items from the beginning
-    this->deferred_batch_.items.erase(this->deferred_batch_.items.begin(),
-                                      this->deferred_batch_.items.begin() + items_processed);
+    this->deferred_batch_.remove_front(items_processed);
 
     // Reschedule for remaining items
     this->schedule_batch_();
@@ -1881,6 +1971,37 @@ void APIConnection::process_batch_() {
   }
 }
 
+uint16_t APIConnection::encode_batch_item_(const DeferredBatch::BatchItem &item, uint32_t remaining_size,
+                                           bool is_single) {
+  EncodedStateCache *cache = this->parent_->get_encoded_state_cache();
+  // Small messages like sensor states encode about as fast as they can be looked up and copied
+  if (cache == nullptr || item.entity == nullptr || !item.creator.is_function_ptr() ||
+      get_estimated_message_size(item.message_type) < MIN_SHARED_PAYLOAD_SIZE)
+    return item.creator(item.entity, this, remaining_size, is_single);
+
+  const uint8_t header_padding = this->helper_->frame_header_padding();
+  const uint8_t footer_size = this->helper_->frame_footer_size();
+  EncodedStateCache::Payload cached = cache->find(item.entity, item.message_type);
+  if (cached.data != nullptr) {
+    size_t total_size = cached.size + header_padding + footer_size;
+    if (total_size > remaining_size)
+      return 0;
+    ProtoWriteBuffer buffer = is_single ? this->allocate_single_message_buffer(cached.size)
+                                        : this->allocate_batch_message_buffer(cached.size);
+    std::memcpy(buffer.get_pos(), cached.data, cached.size);
+    return static_cast<uint16_t>(total_size);
+  }
+
+  uint16_t total_size = item.creator(item.entity, this, remaining_size, is_single);
+  if (total_size != 0) {
+    // The creator encoded the payload at the end of the shared buffer
+    const std::vector<uint8_t> &shared_buf = this->parent_->get_shared_buffer_ref();
+    uint16_t payload_size = total_size - header_padding - footer_size;
+    cache->store(item.entity, item.message_type, shared_buf.data() + shared_buf.size() - payload_size, payload_size);
+  }
+  return total_size;
+}
+
 uint16_t APIConnection::MessageCreator::operator()(EntityBase *entity, APIConnection *conn, uint32_t remaining_size,
                                                    bool is_single) const {
   switch (message_type_) {
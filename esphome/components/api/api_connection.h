@@ -227,10 +227,10 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
+  ProtoWriteBuffer create_buffer(uint32_t payload_size) override {
     // FIXME: ensure no recursive writes can happen
 
-    // Get header padding size - used for both reserve and insert
+    // Get header padding size - used for both reserve and resize
     uint8_t header_padding = this->helper_->frame_header_padding();
 
     // Get shared buffer from parent server
@@ -239,10 +239,10 @@ class APIConnection : public APIServerConnection {
     // Reserve space for header padding + message + footer
     // - Header padding: space for protocol headers (7 bytes for Noise, 6 for Plaintext)
     // - Footer: space for MAC (16 bytes for Noise, 0 for Plaintext)
-    shared_buf.reserve(reserve_size + header_padding + this->helper_->frame_footer_size());
-    // Resize to add header padding so message encoding starts at the correct position
-    shared_buf.resize(header_padding);
-    return {&shared_buf};
+    shared_buf.reserve(payload_size + header_padding + this->helper_->frame_footer_size());
+    // Size the buffer for header padding + message, the message is then encoded in place after the padding
+    shared_buf.resize(header_padding + payload_size);
+    return {&shared_buf, header_padding};
   }
 
   // Prepare buffer for next message in batch
@@ -263,13 +263,10 @@ class APIConnection : public APIServerConnection {
                                 ? this->helper_->frame_header_padding()
                                 : this->helper_->frame_header_padding() + this->helper_->frame_footer_size();
 
-    // Reserve space for padding + message
-    shared_buf.reserve(current_size + padding_to_add + message_size);
+    // Size the buffer for the padding bytes + message, the message is then encoded in place after the padding
+    shared_buf.resize(current_size + padding_to_add + message_size);
 
-    // Resize to add the padding bytes
-    shared_buf.resize(current_size + padding_to_add);
-
-    return {&shared_buf};
+    return {&shared_buf, current_size + padding_to_add};
   }
 
   bool try_to_clear_buffer(bool log_out_of_space);
@@ -542,6 +539,9 @@ class APIConnection : public APIServerConnection {
     // Call operator
     uint16_t operator()(EntityBase *entity, APIConnection *conn, uint32_t remaining_size, bool is_single) const;
 
+    // Function pointer creators read the current entity state, so their payload is the same for every connection
+    bool is_function_ptr() const { return message_type_ == 0; }
+
    private:
     // Helper to check if this message type uses heap-allocated strings
     bool uses_string_data_() const { return message_type_ == EventResponse::MESSAGE_TYPE; }
@@ -564,7 +564,13 @@ class APIConnection : public APIServerConnection {
           : entity(entity), creator(std::move(creator)), message_type(message_type) {}
     };
 
+    // Batches with fewer items are searched linearly, larger ones get an index
+    static constexpr size_t INDEX_MIN_ITEMS = 16;
+
     std::vector<BatchItem> items;
+    // Open addressing table of item index + 1 keyed by entity and message type, 0 marks a free slot.
+    // Its size is a power of two; it stays empty while the batch has fewer than INDEX_MIN_ITEMS items.
+    std::vector<uint16_t> index;
     uint32_t batch_start_time{0};
     bool batch_scheduled{false};
 
@@ -573,14 +579,20 @@ class APIConnection : public APIServerConnection {
       items.reserve(8);
     }
 
-    // Add item to the batch
-    void add_item(EntityBase *entity, MessageCreator creator, uint16_t message_type);
+    // Add item to the batch, returns true if it replaced a pending item for the same entity and message type
+    bool add_item(EntityBase *entity, MessageCreator creator, uint16_t message_type);
+    // Remove the first count items after they were sent
+    void remove_front(size_t count);
     void clear() {
       items.clear();
+      index.clear();
       batch_scheduled = false;
       batch_start_time = 0;
     }
     bool empty() const { return items.empty(); }
+
+   protected:
+    void rebuild_index_();
   };
 
   DeferredBatch deferred_batch_;
@@ -600,13 +612,23 @@ class APIConnection : public APIServerConnection {
 
   bool schedule_batch_();
   void process_batch_();
+  // Messages estimated smaller than this are always encoded by each connection
+  static constexpr uint16_t MIN_SHARED_PAYLOAD_SIZE = 16;
+  // Encode a batch item, reusing the payload when another connection already encoded it in this loop
+  uint16_t encode_batch_item_(const DeferredBatch::BatchItem &item, uint32_t remaining_size, bool is_single);
+
+  // Check if a frame fits into the share of the TX buffer its lane may use, counting it as refused if not
+  bool try_to_queue_in_lane_(APILane lane, uint16_t frame_size);
+  // Log the TX buffer counters of this connection, if it ever had to queue anything
+  void log_tx_stats_();
 
   // State for batch buffer allocation
   bool batch_first_message_{false};
 
   // Helper function to schedule a deferred message with known message type
   bool schedule_message_(EntityBase *entity, MessageCreator creator, uint16_t message_type) {
-    this->deferred_batch_.add_item(entity, std::move(creator), message_type);
+    if (this->deferred_batch_.add_item(entity, std::move(creator), message_type))
+      this->helper_->get_tx_stats().states_superseded++;
     return this->schedule_batch_();
   }
 
@@ -5,7 +5,9 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "proto.h"
+#include "api_pb2.h"
 #include "api_pb2_size.h"
+#include <algorithm>
 #include <cstring>
 #include <cinttypes>
 
@@ -66,21 +68,158 @@ const char *api_error_to_str(APIError err) {
   return "UNKNOWN";
 }
 
-// Helper method to buffer data from IOVs
-void APIFrameHelper::buffer_data_from_iov_(const struct iovec *iov, int iovcnt, uint16_t total_write_len) {
-  SendBuffer buffer;
-  buffer.data.reserve(total_write_len);
+APILane api_message_lane(uint16_t message_type) {
+  switch (message_type) {
+    case HomeassistantServiceResponse::MESSAGE_TYPE:
+      return APILane::EVENT;
+    case BluetoothLEAdvertisementResponse::MESSAGE_TYPE:
+    case BluetoothLERawAdvertisementsResponse::MESSAGE_TYPE:
+      return APILane::BLE;
+    case SubscribeLogsResponse::MESSAGE_TYPE:
+      return APILane::LOG;
+    case CameraImageResponse::MESSAGE_TYPE:
+    case VoiceAssistantAudio::MESSAGE_TYPE:
+      return APILane::BULK;
+    default:
+      return APILane::CONTROL;
+  }
+}
+
+const char *api_lane_to_str(APILane lane) {
+  switch (lane) {
+    case APILane::CONTROL:
+      return "control";
+    case APILane::EVENT:
+      return "event";
+    case APILane::BLE:
+      return "ble";
+    case APILane::LOG:
+      return "log";
+    case APILane::BULK:
+      return "bulk";
+  }
+  return "unknown";
+}
+
+APIFrameHelper::~APIFrameHelper() {
+  if (this->tx_buf_ != nullptr) {
+    RAMAllocator<uint8_t> allocator;
+    allocator.deallocate(this->tx_buf_, this->tx_buf_allocated_);
+  }
+}
+
+// Helper method to queue data from IOVs in the tx ring buffer
+APIError APIFrameHelper::buffer_data_from_iov_(const struct iovec *iov, int iovcnt, uint16_t total_write_len,
+                                               uint16_t skip, APILane lane) {
+  const uint16_t needed = total_write_len - skip;
+  if (this->tx_buf_allocated_ - this->tx_buf_len_ < needed) {
+    // Allocate the buffer on first use, or grow it when a frame doesn't fit into the free space. The latter only
+    // happens for frames larger than the space left below the high water mark, or during the handshake. A partly
+    // sent frame can't be refused, so the buffer grows to the queued bytes plus that frame, at most 64 KiB, and is
+    // freed again by try_send_tx_buf_() once it has drained.
+    uint32_t new_size = std::max<uint32_t>(this->tx_buf_capacity_, this->tx_buf_len_ + needed);
+    if (new_size > std::numeric_limits<uint16_t>::max()) {
+      this->state_ = State::FAILED;
+      return APIError::OUT_OF_MEMORY;
+    }
+    RAMAllocator<uint8_t> allocator(this->tx_buf_use_psram_ ? 0 : RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+    uint8_t *new_buf = allocator.allocate(new_size);
+    if (new_buf == nullptr) {
+      ESP_LOGW(TAG, "%s: Could not allocate %" PRIu32 " bytes for the TX buffer", this->info_.c_str(), new_size);
+      this->state_ = State::FAILED;
+      return APIError::OUT_OF_MEMORY;
+    }
+    if (this->tx_buf_ != nullptr) {
+      // Move the queued data to the start of the new buffer
+      uint16_t first = std::min<uint16_t>(this->tx_buf_len_, this->tx_buf_allocated_ - this->tx_buf_head_);
+      std::memcpy(new_buf, this->tx_buf_ + this->tx_buf_head_, first);
+      std::memcpy(new_buf + first, this->tx_buf_, this->tx_buf_len_ - first);
+      allocator.deallocate(this->tx_buf_, this->tx_buf_allocated_);
+      this->tx_stats_.grows++;
+    }
+    this->tx_buf_ = new_buf;
+    this->tx_buf_allocated_ = new_size;
+    this->tx_buf_head_ = 0;
+  }
+
+  // Copy into the ring, wrapping around at the end of the buffer
+  uint16_t tail = (this->tx_buf_head_ + this->tx_buf_len_) % this->tx_buf_allocated_;
   for (int i = 0; i < iovcnt; i++) {
     const uint8_t *data = reinterpret_cast<uint8_t *>(iov[i].iov_base);
-    buffer.data.insert(buffer.data.end(), data, data + iov[i].iov_len);
+    uint16_t len = static_cast<uint16_t>(iov[i].iov_len);
+    if (skip >= len) {
+      // This segment was already sent
+      skip -= len;
+      continue;
+    }
+    data += skip;
+    len -= skip;
+    skip = 0;
+    while (len > 0) {
+      uint16_t chunk = std::min<uint16_t>(len, this->tx_buf_allocated_ - tail);
+      std::memcpy(this->tx_buf_ + tail, data, chunk);
+      tail = (tail + chunk) % this->tx_buf_allocated_;
+      data += chunk;
+      len -= chunk;
+    }
+  }
+  this->tx_buf_len_ += needed;
+  this->tx_stats_.frames_queued++;
+  this->tx_stats_.peak_bytes = std::max(this->tx_stats_.peak_bytes, this->tx_buf_len_);
+  this->tx_stats_.lanes[static_cast<uint8_t>(lane)].frames_queued++;
+
+  // Extend the newest run if it is of the same lane, or if there is no slot left for a new one
+  if (this->tx_runs_len_ != 0) {
+    TxRun &last = this->newest_tx_run_();
+    if (last.lane == lane) {
+      last.bytes += needed;
+      this->lane_bytes_[static_cast<uint8_t>(lane)] += needed;
+      return APIError::OK;
+    }
+    if (this->tx_runs_len_ == TX_RUN_SLOTS) {
+      // can_queue() keeps other lanes out while no slot is free, so this is a control frame
+      last.bytes += needed;
+      last.control_bytes += needed;
+      this->lane_bytes_[static_cast<uint8_t>(APILane::CONTROL)] += needed;
+      return APIError::OK;
+    }
+  }
+  this->tx_runs_[(this->tx_runs_head_ + this->tx_runs_len_) % TX_RUN_SLOTS] = {App.get_loop_component_start_time(),
+                                                                                needed, 0, lane};
+  this->tx_runs_len_++;
+  this->lane_bytes_[static_cast<uint8_t>(lane)] += needed;
+  return APIError::OK;
+}
+
+void APIFrameHelper::consume_tx_runs_(uint16_t sent) {
+  while (sent != 0 && this->tx_runs_len_ != 0) {
+    TxRun &run = this->tx_runs_[this->tx_runs_head_];
+    uint16_t consumed = std::min(sent, run.bytes);
+    // The control frames mixed into a run are interleaved with its own frames. Count them as sent first, so the
+    // run's lane is never counted fewer bytes than it has queued; control may use the whole buffer anyway.
+    uint16_t control = std::min(consumed, run.control_bytes);
+    run.bytes -= consumed;
+    run.control_bytes -= control;
+    this->lane_bytes_[static_cast<uint8_t>(APILane::CONTROL)] -= control;
+    this->lane_bytes_[static_cast<uint8_t>(run.lane)] -= consumed - control;
+    sent -= consumed;
+    if (run.bytes != 0)
+      break;
+    APILaneStats &stats = this->tx_stats_.lanes[static_cast<uint8_t>(run.lane)];
+    uint32_t delay = App.get_loop_component_start_time() - run.queued_at;
+    stats.runs_sent++;
+    stats.delay_total_ms += delay;
+    stats.delay_max_ms = std::min<uint32_t>(std::max<uint32_t>(stats.delay_max_ms, delay), UINT16_MAX);
+    this->tx_runs_head_ = (this->tx_runs_head_ + 1) % TX_RUN_SLOTS;
+    this->tx_runs_len_--;
   }
-  this->tx_buf_.push_back(std::move(buffer));
 }
 
 // This method writes data to socket or buffers it
-APIError APIFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
+APIError APIFrameHelper::write_raw_(const struct iovec *iov, int iovcnt, APILane lane) {
   // Returns APIError::OK if successful (or would block, but data has been buffered)
   // Returns APIError::SOCKET_WRITE_FAILED if socket write failed, and sets state to FAILED
+  // Returns APIError::OUT_OF_MEMORY if the data could not be buffered, and sets state to FAILED
 
   if (iovcnt == 0)
     return APIError::OK;  // Nothing to do, success
@@ -95,7 +234,7 @@ APIError APIFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   }
 
   // Try to send any existing buffered data first if there is any
-  if (!this->tx_buf_.empty()) {
+  if (this->tx_buf_len_ != 0) {
     APIError send_result = try_send_tx_buf_();
     // If real error occurred (not just WOULD_BLOCK), return it
     if (send_result != APIError::OK && send_result != APIError::WOULD_BLOCK) {
@@ -104,9 +243,8 @@ APIError APIFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
 
     // If there is still data in the buffer, we can't send, buffer
     // the new data and return
-    if (!this->tx_buf_.empty()) {
-      this->buffer_data_from_iov_(iov, iovcnt, total_write_len);
-      return APIError::OK;  // Success, data buffered
+    if (this->tx_buf_len_ != 0) {
+      return this->buffer_data_from_iov_(iov, iovcnt, total_write_len, 0, lane);
     }
   }
 
@@ -116,8 +254,7 @@ APIError APIFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (sent == -1) {
     if (errno == EWOULDBLOCK || errno == EAGAIN) {
       // Socket would block, buffer the data
-      this->buffer_data_from_iov_(iov, iovcnt, total_write_len);
-      return APIError::OK;  // Success, data buffered
+      return this->buffer_data_from_iov_(iov, iovcnt, total_write_len, 0, lane);
     }
     // Socket error
     ESP_LOGVV(TAG, "%s: Socket write failed with errno %d", this->info_.c_str(), errno);
@@ -125,26 +262,7 @@ APIError APIFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
     return APIError::SOCKET_WRITE_FAILED;  // Socket write failed
   } else if (static_cast<uint16_t>(sent) < total_write_len) {
     // Partially sent, buffer the remaining data
-    SendBuffer buffer;
-    uint16_t to_consume = static_cast<uint16_t>(sent);
-    uint16_t remaining = total_write_len - static_cast<uint16_t>(sent);
-
-    buffer.data.reserve(remaining);
-
-    for (int i = 0; i < iovcnt; i++) {
-      if (to_consume >= iov[i].iov_len) {
-        // This segment was fully sent
-        to_consume -= static_cast<uint16_t>(iov[i].iov_len);
-      } else {
-        // This segment was partially sent or not sent at all
-        const uint8_t *data = reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume;
-        uint16_t len = static_cast<uint16_t>(iov[i].iov_len) - to_consume;
-        buffer.data.insert(buffer.data.end(), data, data + len);
-        to_consume = 0;
-      }
-    }
-
-    this->tx_buf_.push_back(std::move(buffer));
+    return this->buffer_data_from_iov_(iov, iovcnt, total_write_len, static_cast<uint16_t>(sent), lane);
   }
 
   return APIError::OK;  // Success, all data sent or buffered
@@ -153,42 +271,42 @@ APIError APIFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
 // Common implementation for trying to send buffered data
 // IMPORTANT: Caller MUST ensure tx_buf_ is not empty before calling this method
 APIError APIFrameHelper::try_send_tx_buf_() {
-  // Try to send from tx_buf - we assume it's not empty as it's the caller's responsibility to check
-  bool tx_buf_empty = false;
-  while (!tx_buf_empty) {
-    // Get the first buffer in the queue
-    SendBuffer &front_buffer = this->tx_buf_.front();
-
-    // Try to send the remaining data in this buffer
-    ssize_t sent = this->socket_->write(front_buffer.current_data(), front_buffer.remaining());
-
-    if (sent == -1) {
-      if (errno != EWOULDBLOCK && errno != EAGAIN) {
-        // Real socket error (not just would block)
-        ESP_LOGVV(TAG, "%s: Socket write failed with errno %d", this->info_.c_str(), errno);
-        this->state_ = State::FAILED;
-        return APIError::SOCKET_WRITE_FAILED;  // Socket write failed
-      }
-      // Socket would block, we'll try again later
-      return APIError::WOULD_BLOCK;
-    } else if (sent == 0) {
-      // Nothing sent but not an error
-      return APIError::WOULD_BLOCK;
-    } else if (static_cast<uint16_t>(sent) < front_buffer.remaining()) {
-      // Partially sent, update offset
-      // Cast to ensure no overflow issues with uint16_t
-      front_buffer.offset += static_cast<uint16_t>(sent);
-      return APIError::WOULD_BLOCK;  // Stop processing more buffers if we couldn't send a complete buffer
-    } else {
-      // Buffer completely sent, remove it from the queue
-      this->tx_buf_.pop_front();
-      // Update empty status for the loop condition
-      tx_buf_empty = this->tx_buf_.empty();
-      // Continue loop to try sending the next buffer
+  // The queued data is at most two contiguous regions when it wraps around the end of the ring
+  struct iovec iov[2];
+  uint16_t first = std::min<uint16_t>(this->tx_buf_len_, this->tx_buf_allocated_ - this->tx_buf_head_);
+  iov[0].iov_base = this->tx_buf_ + this->tx_buf_head_;
+  iov[0].iov_len = first;
+  iov[1].iov_base = this->tx_buf_;
+  iov[1].iov_len = this->tx_buf_len_ - first;
+  ssize_t sent = this->socket_->writev(iov, iov[1].iov_len == 0 ? 1 : 2);
+
+  if (sent == -1) {
+    if (errno != EWOULDBLOCK && errno != EAGAIN) {
+      // Real socket error (not just would block)
+      ESP_LOGVV(TAG, "%s: Socket write failed with errno %d", this->info_.c_str(), errno);
+      this->state_ = State::FAILED;
+      return APIError::SOCKET_WRITE_FAILED;  // Socket write failed
     }
+    // Socket would block, we'll try again later
+    return APIError::WOULD_BLOCK;
   }
 
-  return APIError::OK;  // All buffers sent successfully
+  // Consume what was sent, start over at the beginning of the ring once it is empty
+  this->consume_tx_runs_(static_cast<uint16_t>(sent));
+  this->tx_buf_len_ -= static_cast<uint16_t>(sent);
+  if (this->tx_buf_len_ == 0) {
+    this->tx_buf_head_ = 0;
+    if (this->tx_buf_allocated_ > this->tx_buf_capacity_) {
+      // Give back a buffer that grew for an oversized frame, the next one is allocated at the configured capacity
+      RAMAllocator<uint8_t> allocator;
+      allocator.deallocate(this->tx_buf_, this->tx_buf_allocated_);
+      this->tx_buf_ = nullptr;
+      this->tx_buf_allocated_ = 0;
+    }
+    return APIError::OK;  // All buffered data sent successfully
+  }
+  this->tx_buf_head_ = (this->tx_buf_head_ + static_cast<uint16_t>(sent)) % this->tx_buf_allocated_;
+  return APIError::WOULD_BLOCK;  // Partially sent, the socket is full
 }
 
 APIError APIFrameHelper::init_common_() {
@@ -278,7 +396,7 @@ APIError APINoiseFrameHelper::loop() {
   if (err != APIError::OK && err != APIError::WOULD_BLOCK) {
     return err;
   }
-  if (!this->tx_buf_.empty()) {
+  if (this->tx_buf_len_ != 0) {
     err = try_send_tx_buf_();
     if (err != APIError::OK && err != APIError::WOULD_BLOCK) {
       return err;
@@ -382,9 +500,9 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
 #ifdef HELPER_LOG_PACKETS
   ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
 #endif
-  frame->msg = std::move(rx_buf_);
-  // consume msg
-  rx_buf_ = {};
+  frame->msg = rx_buf_.data();
+  frame->msg_len = msg_size;
+  // consume msg, rx_buf_ keeps its capacity for the next frame
   rx_buf_len_ = 0;
   rx_header_buf_len_ = 0;
   return APIError::OK;
@@ -422,10 +540,10 @@ APIError APINoiseFrameHelper::state_action_() {
       return aerr;
     // ignore contents, may be used in future for flags
     // Reserve space for: existing prologue + 2 size bytes + frame data
-    prologue_.reserve(prologue_.size() + 2 + frame.msg.size());
-    prologue_.push_back((uint8_t) (frame.msg.size() >> 8));
-    prologue_.push_back((uint8_t) frame.msg.size());
-    prologue_.insert(prologue_.end(), frame.msg.begin(), frame.msg.end());
+    prologue_.reserve(prologue_.size() + 2 + frame.msg_len);
+    prologue_.push_back((uint8_t) (frame.msg_len >> 8));
+    prologue_.push_back((uint8_t) frame.msg_len);
+    prologue_.insert(prologue_.end(), frame.msg, frame.msg + frame.msg_len);
 
     state_ = State::SERVER_HELLO;
   }
@@ -476,7 +594,7 @@ APIError APINoiseFrameHelper::state_action_() {
       if (aerr != APIError::OK)
         return aerr;
 
-      if (frame.msg.empty()) {
+      if (frame.msg_len == 0) {
         send_explicit_handshake_reject_("Empty handshake message");
         return APIError::BAD_HANDSHAKE_ERROR_BYTE;
       } else if (frame.msg[0] != 0x00) {
@@ -487,7 +605,7 @@ APIError APINoiseFrameHelper::state_action_() {
 
       NoiseBuffer mbuf;
       noise_buffer_init(mbuf);
-      noise_buffer_set_input(mbuf, frame.msg.data() + 1, frame.msg.size() - 1);
+      noise_buffer_set_input(mbuf, frame.msg + 1, frame.msg_len - 1);
       err = noise_handshakestate_read_message(handshake_, &mbuf, nullptr);
       if (err != 0) {
         state_ = State::FAILED;
@@ -570,7 +688,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, frame.msg.data(), frame.msg.size(), frame.msg.size());
+  noise_buffer_set_inout(mbuf, frame.msg, frame.msg_len, frame.msg_len);
   err = noise_cipherstate_decrypt(recv_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -579,7 +697,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   }
 
   uint16_t msg_size = mbuf.size;
-  uint8_t *msg_data = frame.msg.data();
+  uint8_t *msg_data = frame.msg;
   if (msg_size < 4) {
     state_ = State::FAILED;
     HELPER_LOG("Bad data packet: size %d too short", msg_size);
@@ -598,8 +716,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
     return APIError::BAD_DATA_PACKET;
   }
 
-  buffer->container = std::move(frame.msg);
-  buffer->data_offset = 4;
+  buffer->data = msg_data + 4;
   buffer->data_len = data_len;
   buffer->type = type;
   return APIError::OK;
@@ -685,7 +802,8 @@ APIError APINoiseFrameHelper::write_protobuf_packets(ProtoWriteBuffer buffer, co
   }
 
   // Send all encrypted packets in one writev call
-  return this->write_raw_(this->reusable_iovs_.data(), this->reusable_iovs_.size());
+  return this->write_raw_(this->reusable_iovs_.data(), this->reusable_iovs_.size(),
+                          api_message_lane(packets[0].message_type));
 }
 
 APIError APINoiseFrameHelper::write_frame_(const uint8_t *data, uint16_t len) {
@@ -827,7 +945,7 @@ APIError APIPlaintextFrameHelper::loop() {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
-  if (!this->tx_buf_.empty()) {
+  if (this->tx_buf_len_ != 0) {
     APIError err = try_send_tx_buf_();
     if (err != APIError::OK && err != APIError::WOULD_BLOCK) {
       return err;
@@ -979,9 +1097,9 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
 #ifdef HELPER_LOG_PACKETS
   ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
 #endif
-  frame->msg = std::move(rx_buf_);
-  // consume msg
-  rx_buf_ = {};
+  frame->msg = rx_buf_.data();
+  frame->msg_len = rx_header_parsed_len_;
+  // consume msg, rx_buf_ keeps its capacity for the next frame
   rx_buf_len_ = 0;
   rx_header_buf_pos_ = 0;
   rx_header_parsed_ = false;
@@ -1019,9 +1137,8 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
     return aerr;
   }
 
-  buffer->container = std::move(frame.msg);
-  buffer->data_offset = 0;
-  buffer->data_len = rx_header_parsed_len_;
+  buffer->data = frame.msg;
+  buffer->data_len = frame.msg_len;
   buffer->type = rx_header_parsed_type_;
   return APIError::OK;
 }
@@ -1105,7 +1222,8 @@ APIError APIPlaintextFrameHelper::write_protobuf_packets(ProtoWriteBuffer buffer
   }
 
   // Send all packets in one writev call
-  return write_raw_(this->reusable_iovs_.data(), this->reusable_iovs_.size());
+  return write_raw_(this->reusable_iovs_.data(), this->reusable_iovs_.size(),
+                    api_message_lane(packets[0].message_type));
 }
 
 #endif  // USE_API_PLAINTEXT
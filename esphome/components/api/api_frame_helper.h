@@ -1,6 +1,5 @@
 #pragma once
 #include <cstdint>
-#include <deque>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -21,9 +20,9 @@ namespace api {
 class ProtoWriteBuffer;
 
 struct ReadPacketBuffer {
-  std::vector<uint8_t> container;
+  // Points into the frame helper's receive buffer, only valid until the next read_packet() call
+  uint8_t *data;
   uint16_t type;
-  uint16_t data_offset;
   uint16_t data_len;
 };
 
@@ -66,17 +65,75 @@ enum class APIError : int {
 
 const char *api_error_to_str(APIError err);
 
+// Classes of outbound traffic, from highest to lowest priority. Queued frames can't be reordered once they are
+// framed (Noise encrypts them in sequence), so priority is enforced when frames enter the TX buffer: each lane may
+// only fill its share of it, which keeps room for state updates and bounds the backlog they can end up behind.
+enum class APILane : uint8_t {
+  CONTROL = 0,  // State updates, entity info and responses to requests; may use the whole buffer
+  EVENT,        // Home Assistant service calls and events; half of the buffer, deferred when full
+  BLE,          // Bluetooth LE advertisements; a quarter of the buffer, dropped when full
+  LOG,          // Log lines; a quarter of the buffer, dropped when full
+  BULK,         // Camera images and voice assistant audio; half of the buffer, deferred when full
+};
+static constexpr uint8_t API_LANE_COUNT = 5;
+
+// Lane a message of the given type is sent in
+APILane api_message_lane(uint16_t message_type);
+const char *api_lane_to_str(APILane lane);
+
+// Counters of one traffic lane. Queueing delay is measured per run of consecutive queued frames of the lane, from
+// when its first frame was queued until the last one was sent.
+struct APILaneStats {
+  uint32_t frames_queued{0};   // Frames (or their unsent rest) that had to wait in the TX buffer
+  uint32_t frames_refused{0};  // Frames refused because the lane had used up its share of the TX buffer
+  uint32_t runs_sent{0};       // Runs of queued frames that were fully sent
+  uint32_t delay_total_ms{0};  // Queueing delay of all sent runs
+  uint16_t delay_max_ms{0};    // Longest queueing delay of a run
+};
+
+// Counters describing how the TX buffer of a connection was used, to monitor slow clients
+struct APITxStats {
+  uint32_t frames_queued{0};      // Frames (or their unsent rest) that were queued because the socket was full
+  uint32_t states_superseded{0};  // Pending state updates replaced by a newer state of the same entity
+  uint16_t peak_bytes{0};         // Highest number of bytes queued at once
+  uint16_t grows{0};              // Times the TX buffer had to grow to fit a frame larger than its free space
+  APILaneStats lanes[API_LANE_COUNT];
+};
+
 class APIFrameHelper {
  public:
   APIFrameHelper() = default;
   explicit APIFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_owned_(std::move(socket)) {
     socket_ = socket_owned_.get();
   }
-  virtual ~APIFrameHelper() = default;
+  virtual ~APIFrameHelper();
   virtual APIError init() = 0;
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
-  bool can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
+  // Set the capacity of the TX ring buffer, which is allocated the first time a frame can't be written directly.
+  // Must be called before any data is written.
+  void set_tx_buffer_config(uint16_t capacity, bool use_psram) {
+    this->tx_buf_capacity_ = capacity;
+    this->tx_buf_use_psram_ = use_psram;
+  }
+  // True while the TX buffer is below its high water mark (half its capacity). State updates and responses are only
+  // sent then, so under backpressure pending states keep being coalesced instead of filling the buffer.
+  bool can_write_without_blocking() {
+    return state_ == State::DATA && this->tx_buf_len_ <= this->tx_buf_capacity_ / 2;
+  }
+  // True if a frame of frame_size bytes fits into the share of the TX buffer that lane may use. While all run slots
+  // are taken, only frames of the newest run's lane are accepted, so the bytes of other lanes aren't mixed into it.
+  bool can_queue(APILane lane, uint16_t frame_size) {
+    uint8_t index = static_cast<uint8_t>(lane);
+    return state_ == State::DATA && this->tx_buf_len_ + frame_size <= this->tx_buf_capacity_ &&
+           this->lane_bytes_[index] + frame_size <= this->lane_budget(lane) &&
+           (this->tx_runs_len_ != TX_RUN_SLOTS || this->newest_tx_run_().lane == lane);
+  }
+  // Bytes of the TX buffer lane may fill
+  uint16_t lane_budget(APILane lane) const {
+    return this->tx_buf_capacity_ >> LANE_BUDGET_SHIFT[static_cast<uint8_t>(lane)];
+  }
+  APITxStats &get_tx_stats() { return this->tx_stats_; }
   std::string getpeername() { return socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) { return socket_->getpeername(addr, addrlen); }
   APIError close() {
@@ -110,23 +167,43 @@ class APIFrameHelper {
   bool is_socket_ready() const { return socket_ != nullptr && socket_->ready(); }
 
  protected:
-  // Struct for holding parsed frame data
+  // Struct for holding parsed frame data. msg points into rx_buf_, which is reused for the next frame,
+  // so it is only valid until the next try_read_frame_() call.
   struct ParsedFrame {
-    std::vector<uint8_t> msg;
+    uint8_t *msg;
+    uint16_t msg_len;
   };
 
-  // Buffer containing data to be sent
-  struct SendBuffer {
-    std::vector<uint8_t> data;
-    uint16_t offset{0};  // Current offset within the buffer (uint16_t to reduce memory usage)
-
-    // Using uint16_t reduces memory usage since ESPHome API messages are limited to UINT16_MAX (65535) bytes
-    uint16_t remaining() const { return static_cast<uint16_t>(data.size()) - offset; }
-    const uint8_t *current_data() const { return data.data() + offset; }
+  // TX ring buffer holding frames that could not be written to the socket yet. Frames are copied in once and
+  // drained with writev(), so backpressure doesn't allocate per frame.
+  uint8_t *tx_buf_{nullptr};
+  uint16_t tx_buf_capacity_{4096};
+  uint16_t tx_buf_allocated_{0};  // Size of tx_buf_, 0 until first use; exceeds tx_buf_capacity_ after a grow until
+                                  // the buffer drains and is freed
+  uint16_t tx_buf_head_{0};       // Offset of the first queued byte
+  uint16_t tx_buf_len_{0};        // Number of queued bytes
+  bool tx_buf_use_psram_{false};
+  APITxStats tx_stats_;
+
+  // Share of tx_buf_capacity_ each lane may fill, as a right shift of the capacity
+  static constexpr uint8_t LANE_BUDGET_SHIFT[API_LANE_COUNT] = {0, 1, 2, 2, 1};
+  // Bytes each lane has in the TX buffer
+  uint16_t lane_bytes_[API_LANE_COUNT]{};
+
+  // Queued bytes of consecutive frames of one lane, in the order they are in the TX buffer
+  struct TxRun {
+    uint32_t queued_at;      // When the oldest frame of the run was queued
+    uint16_t bytes;          // All queued bytes of the run, including control_bytes
+    uint16_t control_bytes;  // Bytes of control frames queued into a run of another lane while the slots were full
+    APILane lane;
   };
-
-  // Queue of data buffers to be sent
-  std::deque<SendBuffer> tx_buf_;
+  // Runs only split when the lane changes, so a few are enough. When they run out, can_queue() refuses frames of
+  // other lanes, and control frames, which are never refused, are counted towards the newest run as control_bytes.
+  static constexpr uint8_t TX_RUN_SLOTS = 8;
+  TxRun tx_runs_[TX_RUN_SLOTS];
+  uint8_t tx_runs_head_{0};
+  uint8_t tx_runs_len_{0};
+  TxRun &newest_tx_run_() { return this->tx_runs_[(this->tx_runs_head_ + this->tx_runs_len_ - 1) % TX_RUN_SLOTS]; }
 
   // Common state enum for all frame helpers
   // Note: Not all states are used by all implementations
@@ -157,17 +234,17 @@ class APIFrameHelper {
   socket::Socket *socket_{nullptr};
   std::unique_ptr<socket::Socket> socket_owned_;
 
-  // Common implementation for writing raw data to socket
-  APIError write_raw_(const struct iovec *iov, int iovcnt);
+  // Common implementation for writing raw data to socket, frames that can't be sent right away are queued in lane
+  APIError write_raw_(const struct iovec *iov, int iovcnt, APILane lane = APILane::CONTROL);
 
   // Try to send data from the tx buffer
   APIError try_send_tx_buf_();
 
-  // Helper method to buffer data from IOVs
-  void buffer_data_from_iov_(const struct iovec *iov, int iovcnt, uint16_t total_write_len);
-  template<typename StateEnum>
-  APIError write_raw_(const struct iovec *iov, int iovcnt, socket::Socket *socket, std::vector<uint8_t> &tx_buf,
-                      const std::string &info, StateEnum &state, StateEnum failed_state);
+  // Queue the iovs in the tx buffer, skipping the first skip bytes which were already sent
+  APIError buffer_data_from_iov_(const struct iovec *iov, int iovcnt, uint16_t total_write_len, uint16_t skip,
+                                 APILane lane);
+  // Account sent bytes to the lanes they were queued in, oldest first
+  void consume_tx_runs_(uint16_t sent);
 
   uint8_t frame_header_padding_{0};
   uint8_t frame_footer_size_{0};
@@ -175,7 +252,7 @@ class APIFrameHelper {
   // Reusable IOV array for write_protobuf_packets to avoid repeated allocations
   std::vector<struct iovec> reusable_iovs_;
 
-  // Receive buffer for reading frame data
+  // Receive buffer for reading frame data, kept across frames so reading a frame doesn't allocate
   std::vector<uint8_t> rx_buf_;
   uint16_t rx_buf_len_ = 0;
 
@@ -648,14 +648,14 @@ bool HelloRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool HelloRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->client_info = value.as_string();
+      this->client_info = value.as_string_ref();
       return true;
     }
     default:
       return false;
   }
 }
-void HelloRequest::encode(ProtoWriteBuffer buffer) const {
+void HelloRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->client_info);
   buffer.encode_uint32(2, this->api_version_major);
   buffer.encode_uint32(3, this->api_version_minor);
@@ -670,7 +670,7 @@ void HelloRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("HelloRequest {\n");
   out.append("  client_info: ");
-  out.append("'").append(this->client_info).append("'");
+  out.append("'").append(this->client_info.c_str(), this->client_info.size()).append("'");
   out.append("\n");
 
   out.append("  api_version_major: ");
@@ -713,7 +713,7 @@ bool HelloResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value)
       return false;
   }
 }
-void HelloResponse::encode(ProtoWriteBuffer buffer) const {
+void HelloResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint32(1, this->api_version_major);
   buffer.encode_uint32(2, this->api_version_minor);
   buffer.encode_string(3, this->server_info);
@@ -752,14 +752,14 @@ void HelloResponse::dump_to(std::string &out) const {
 bool ConnectRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->password = value.as_string();
+      this->password = value.as_string_ref();
       return true;
     }
     default:
       return false;
   }
 }
-void ConnectRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_string(1, this->password); }
+void ConnectRequest::encode(ProtoWriteBuffer &buffer) const { buffer.encode_string(1, this->password); }
 void ConnectRequest::calculate_size(uint32_t &total_size) const {
   ProtoSize::add_string_field(total_size, 1, this->password, false);
 }
@@ -768,7 +768,7 @@ void ConnectRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("ConnectRequest {\n");
   out.append("  password: ");
-  out.append("'").append(this->password).append("'");
+  out.append("'").append(this->password.c_str(), this->password.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -783,7 +783,7 @@ bool ConnectResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
       return false;
   }
 }
-void ConnectResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->invalid_password); }
+void ConnectResponse::encode(ProtoWriteBuffer &buffer) const { buffer.encode_bool(1, this->invalid_password); }
 void ConnectResponse::calculate_size(uint32_t &total_size) const {
   ProtoSize::add_bool_field(total_size, 1, this->invalid_password, false);
 }
@@ -797,27 +797,27 @@ void ConnectResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
-void DisconnectRequest::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectRequest::encode(ProtoWriteBuffer &buffer) const {}
 void DisconnectRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectRequest::dump_to(std::string &out) const { out.append("DisconnectRequest {}"); }
 #endif
-void DisconnectResponse::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectResponse::encode(ProtoWriteBuffer &buffer) const {}
 void DisconnectResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectResponse::dump_to(std::string &out) const { out.append("DisconnectResponse {}"); }
 #endif
-void PingRequest::encode(ProtoWriteBuffer buffer) const {}
+void PingRequest::encode(ProtoWriteBuffer &buffer) const {}
 void PingRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingRequest::dump_to(std::string &out) const { out.append("PingRequest {}"); }
 #endif
-void PingResponse::encode(ProtoWriteBuffer buffer) const {}
+void PingResponse::encode(ProtoWriteBuffer &buffer) const {}
 void PingResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingResponse::dump_to(std::string &out) const { out.append("PingResponse {}"); }
 #endif
-void DeviceInfoRequest::encode(ProtoWriteBuffer buffer) const {}
+void DeviceInfoRequest::encode(ProtoWriteBuffer &buffer) const {}
 void DeviceInfoRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoRequest::dump_to(std::string &out) const { out.append("DeviceInfoRequest {}"); }
@@ -910,7 +910,7 @@ bool DeviceInfoResponse::decode_length(uint32_t field_id, ProtoLengthDelimited v
       return false;
   }
 }
-void DeviceInfoResponse::encode(ProtoWriteBuffer buffer) const {
+void DeviceInfoResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_bool(1, this->uses_password);
   buffer.encode_string(2, this->name);
   buffer.encode_string(3, this->mac_address);
@@ -1039,17 +1039,17 @@ void DeviceInfoResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
-void ListEntitiesRequest::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesRequest::encode(ProtoWriteBuffer &buffer) const {}
 void ListEntitiesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesRequest::dump_to(std::string &out) const { out.append("ListEntitiesRequest {}"); }
 #endif
-void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesDoneResponse::encode(ProtoWriteBuffer &buffer) const {}
 void ListEntitiesDoneResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDoneResponse::dump_to(std::string &out) const { out.append("ListEntitiesDoneResponse {}"); }
 #endif
-void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeStatesRequest::encode(ProtoWriteBuffer &buffer) const {}
 void SubscribeStatesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
@@ -1108,7 +1108,7 @@ bool ListEntitiesBinarySensorResponse::decode_32bit(uint32_t field_id, Proto32Bi
       return false;
   }
 }
-void ListEntitiesBinarySensorResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesBinarySensorResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -1197,7 +1197,7 @@ bool BinarySensorStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value
       return false;
   }
 }
-void BinarySensorStateResponse::encode(ProtoWriteBuffer buffer) const {
+void BinarySensorStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
   buffer.encode_bool(3, this->missing_state);
@@ -1292,7 +1292,7 @@ bool ListEntitiesCoverResponse::decode_32bit(uint32_t field_id, Proto32Bit value
       return false;
   }
 }
-void ListEntitiesCoverResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesCoverResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -1407,7 +1407,7 @@ bool CoverStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void CoverStateResponse::encode(ProtoWriteBuffer buffer) const {
+void CoverStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::LegacyCoverState>(2, this->legacy_state);
   buffer.encode_float(3, this->position);
@@ -1494,7 +1494,7 @@ bool CoverCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void CoverCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void CoverCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->has_legacy_command);
   buffer.encode_enum<enums::LegacyCoverCommand>(3, this->legacy_command);
@@ -1621,7 +1621,7 @@ bool ListEntitiesFanResponse::decode_32bit(uint32_t field_id, Proto32Bit value)
       return false;
   }
 }
-void ListEntitiesFanResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesFanResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -1759,7 +1759,7 @@ bool FanStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void FanStateResponse::encode(ProtoWriteBuffer buffer) const {
+void FanStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
   buffer.encode_bool(3, this->oscillating);
@@ -1866,7 +1866,7 @@ bool FanCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool FanCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 13: {
-      this->preset_mode = value.as_string();
+      this->preset_mode = value.as_string_ref();
       return true;
     }
     default:
@@ -1883,7 +1883,7 @@ bool FanCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void FanCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void FanCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->has_state);
   buffer.encode_bool(3, this->state);
@@ -1968,7 +1968,7 @@ void FanCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  preset_mode: ");
-  out.append("'").append(this->preset_mode).append("'");
+  out.append("'").append(this->preset_mode.c_str(), this->preset_mode.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -2051,7 +2051,7 @@ bool ListEntitiesLightResponse::decode_32bit(uint32_t field_id, Proto32Bit value
       return false;
   }
 }
-void ListEntitiesLightResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesLightResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -2240,7 +2240,7 @@ bool LightStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void LightStateResponse::encode(ProtoWriteBuffer buffer) const {
+void LightStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
   buffer.encode_float(3, this->brightness);
@@ -2411,7 +2411,7 @@ bool LightCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool LightCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 19: {
-      this->effect = value.as_string();
+      this->effect = value.as_string_ref();
       return true;
     }
     default:
@@ -2464,7 +2464,7 @@ bool LightCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void LightCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void LightCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->has_state);
   buffer.encode_bool(3, this->state);
@@ -2643,7 +2643,7 @@ void LightCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  effect: ");
-  out.append("'").append(this->effect).append("'");
+  out.append("'").append(this->effect.c_str(), this->effect.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -2718,7 +2718,7 @@ bool ListEntitiesSensorResponse::decode_32bit(uint32_t field_id, Proto32Bit valu
       return false;
   }
 }
-void ListEntitiesSensorResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesSensorResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -2832,7 +2832,7 @@ bool SensorStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void SensorStateResponse::encode(ProtoWriteBuffer buffer) const {
+void SensorStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
@@ -2916,7 +2916,7 @@ bool ListEntitiesSwitchResponse::decode_32bit(uint32_t field_id, Proto32Bit valu
       return false;
   }
 }
-void ListEntitiesSwitchResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesSwitchResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -3001,7 +3001,7 @@ bool SwitchStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void SwitchStateResponse::encode(ProtoWriteBuffer buffer) const {
+void SwitchStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
@@ -3044,7 +3044,7 @@ bool SwitchCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void SwitchCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void SwitchCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
@@ -3117,7 +3117,7 @@ bool ListEntitiesTextSensorResponse::decode_32bit(uint32_t field_id, Proto32Bit
       return false;
   }
 }
-void ListEntitiesTextSensorResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesTextSensorResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -3206,7 +3206,7 @@ bool TextSensorStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value)
       return false;
   }
 }
-void TextSensorStateResponse::encode(ProtoWriteBuffer buffer) const {
+void TextSensorStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
@@ -3249,7 +3249,7 @@ bool SubscribeLogsRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
       return false;
   }
 }
-void SubscribeLogsRequest::encode(ProtoWriteBuffer buffer) const {
+void SubscribeLogsRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_bool(2, this->dump_config);
 }
@@ -3295,7 +3295,7 @@ bool SubscribeLogsResponse::decode_length(uint32_t field_id, ProtoLengthDelimite
       return false;
   }
 }
-void SubscribeLogsResponse::encode(ProtoWriteBuffer buffer) const {
+void SubscribeLogsResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_string(3, this->message);
   buffer.encode_bool(4, this->send_failed);
@@ -3326,14 +3326,14 @@ void SubscribeLogsResponse::dump_to(std::string &out) const {
 bool NoiseEncryptionSetKeyRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->key = value.as_string();
+      this->key = value.as_string_ref();
       return true;
     }
     default:
       return false;
   }
 }
-void NoiseEncryptionSetKeyRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_string(1, this->key); }
+void NoiseEncryptionSetKeyRequest::encode(ProtoWriteBuffer &buffer) const { buffer.encode_string(1, this->key); }
 void NoiseEncryptionSetKeyRequest::calculate_size(uint32_t &total_size) const {
   ProtoSize::add_string_field(total_size, 1, this->key, false);
 }
@@ -3342,7 +3342,7 @@ void NoiseEncryptionSetKeyRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("NoiseEncryptionSetKeyRequest {\n");
   out.append("  key: ");
-  out.append("'").append(this->key).append("'");
+  out.append("'").append(this->key.c_str(), this->key.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -3357,7 +3357,7 @@ bool NoiseEncryptionSetKeyResponse::decode_varint(uint32_t field_id, ProtoVarInt
       return false;
   }
 }
-void NoiseEncryptionSetKeyResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->success); }
+void NoiseEncryptionSetKeyResponse::encode(ProtoWriteBuffer &buffer) const { buffer.encode_bool(1, this->success); }
 void NoiseEncryptionSetKeyResponse::calculate_size(uint32_t &total_size) const {
   ProtoSize::add_bool_field(total_size, 1, this->success, false);
 }
@@ -3371,7 +3371,7 @@ void NoiseEncryptionSetKeyResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
-void SubscribeHomeassistantServicesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeassistantServicesRequest::encode(ProtoWriteBuffer &buffer) const {}
 void SubscribeHomeassistantServicesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeassistantServicesRequest::dump_to(std::string &out) const {
@@ -3392,7 +3392,7 @@ bool HomeassistantServiceMap::decode_length(uint32_t field_id, ProtoLengthDelimi
       return false;
   }
 }
-void HomeassistantServiceMap::encode(ProtoWriteBuffer buffer) const {
+void HomeassistantServiceMap::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->key);
   buffer.encode_string(2, this->value);
 }
@@ -3446,7 +3446,7 @@ bool HomeassistantServiceResponse::decode_length(uint32_t field_id, ProtoLengthD
       return false;
   }
 }
-void HomeassistantServiceResponse::encode(ProtoWriteBuffer buffer) const {
+void HomeassistantServiceResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->service);
   for (auto &it : this->data) {
     buffer.encode_message<HomeassistantServiceMap>(2, it, true);
@@ -3498,7 +3498,7 @@ void HomeassistantServiceResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
-void SubscribeHomeAssistantStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeAssistantStatesRequest::encode(ProtoWriteBuffer &buffer) const {}
 void SubscribeHomeAssistantStatesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStatesRequest::dump_to(std::string &out) const {
@@ -3529,7 +3529,7 @@ bool SubscribeHomeAssistantStateResponse::decode_length(uint32_t field_id, Proto
       return false;
   }
 }
-void SubscribeHomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const {
+void SubscribeHomeAssistantStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->entity_id);
   buffer.encode_string(2, this->attribute);
   buffer.encode_bool(3, this->once);
@@ -3560,22 +3560,22 @@ void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
 bool HomeAssistantStateResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->entity_id = value.as_string();
+      this->entity_id = value.as_string_ref();
       return true;
     }
     case 2: {
-      this->state = value.as_string();
+      this->state = value.as_string_ref();
       return true;
     }
     case 3: {
-      this->attribute = value.as_string();
+      this->attribute = value.as_string_ref();
       return true;
     }
     default:
       return false;
   }
 }
-void HomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const {
+void HomeAssistantStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->entity_id);
   buffer.encode_string(2, this->state);
   buffer.encode_string(3, this->attribute);
@@ -3590,20 +3590,20 @@ void HomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("HomeAssistantStateResponse {\n");
   out.append("  entity_id: ");
-  out.append("'").append(this->entity_id).append("'");
+  out.append("'").append(this->entity_id.c_str(), this->entity_id.size()).append("'");
   out.append("\n");
 
   out.append("  state: ");
-  out.append("'").append(this->state).append("'");
+  out.append("'").append(this->state.c_str(), this->state.size()).append("'");
   out.append("\n");
 
   out.append("  attribute: ");
-  out.append("'").append(this->attribute).append("'");
+  out.append("'").append(this->attribute.c_str(), this->attribute.size()).append("'");
   out.append("\n");
   out.append("}");
 }
 #endif
-void GetTimeRequest::encode(ProtoWriteBuffer buffer) const {}
+void GetTimeRequest::encode(ProtoWriteBuffer &buffer) const {}
 void GetTimeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeRequest::dump_to(std::string &out) const { out.append("GetTimeRequest {}"); }
@@ -3618,7 +3618,7 @@ bool GetTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void GetTimeResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->epoch_seconds); }
+void GetTimeResponse::encode(ProtoWriteBuffer &buffer) const { buffer.encode_fixed32(1, this->epoch_seconds); }
 void GetTimeResponse::calculate_size(uint32_t &total_size) const {
   ProtoSize::add_fixed_field<4>(total_size, 1, this->epoch_seconds != 0, false);
 }
@@ -3653,7 +3653,7 @@ bool ListEntitiesServicesArgument::decode_length(uint32_t field_id, ProtoLengthD
       return false;
   }
 }
-void ListEntitiesServicesArgument::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesServicesArgument::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_enum<enums::ServiceArgType>(2, this->type);
 }
@@ -3699,7 +3699,7 @@ bool ListEntitiesServicesResponse::decode_32bit(uint32_t field_id, Proto32Bit va
       return false;
   }
 }
-void ListEntitiesServicesResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesServicesResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_fixed32(2, this->key);
   for (auto &it : this->args) {
@@ -3761,11 +3761,11 @@ bool ExecuteServiceArgument::decode_varint(uint32_t field_id, ProtoVarInt value)
 bool ExecuteServiceArgument::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->string_ = value.as_string();
+      this->string_ = value.as_string_ref();
       return true;
     }
     case 9: {
-      this->string_array.push_back(value.as_string());
+      this->string_array.push_back(value.as_string_ref());
       return true;
     }
     default:
@@ -3786,7 +3786,7 @@ bool ExecuteServiceArgument::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void ExecuteServiceArgument::encode(ProtoWriteBuffer buffer) const {
+void ExecuteServiceArgument::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_bool(1, this->bool_);
   buffer.encode_int32(2, this->legacy_int);
   buffer.encode_float(3, this->float_);
@@ -3851,7 +3851,7 @@ void ExecuteServiceArgument::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  string_: ");
-  out.append("'").append(this->string_).append("'");
+  out.append("'").append(this->string_.c_str(), this->string_.size()).append("'");
   out.append("\n");
 
   out.append("  int_: ");
@@ -3881,7 +3881,7 @@ void ExecuteServiceArgument::dump_to(std::string &out) const {
 
   for (const auto &it : this->string_array) {
     out.append("  string_array: ");
-    out.append("'").append(it).append("'");
+    out.append("'").append(it.c_str(), it.size()).append("'");
     out.append("\n");
   }
   out.append("}");
@@ -3907,7 +3907,7 @@ bool ExecuteServiceRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void ExecuteServiceRequest::encode(ProtoWriteBuffer buffer) const {
+void ExecuteServiceRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   for (auto &it : this->args) {
     buffer.encode_message<ExecuteServiceArgument>(2, it, true);
@@ -3980,7 +3980,7 @@ bool ListEntitiesCameraResponse::decode_32bit(uint32_t field_id, Proto32Bit valu
       return false;
   }
 }
-void ListEntitiesCameraResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesCameraResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -4063,7 +4063,7 @@ bool CameraImageResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void CameraImageResponse::encode(ProtoWriteBuffer buffer) const {
+void CameraImageResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->data);
   buffer.encode_bool(3, this->done);
@@ -4106,7 +4106,7 @@ bool CameraImageRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
       return false;
   }
 }
-void CameraImageRequest::encode(ProtoWriteBuffer buffer) const {
+void CameraImageRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_bool(1, this->single);
   buffer.encode_bool(2, this->stream);
 }
@@ -4246,7 +4246,7 @@ bool ListEntitiesClimateResponse::decode_32bit(uint32_t field_id, Proto32Bit val
       return false;
   }
 }
-void ListEntitiesClimateResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesClimateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -4539,7 +4539,7 @@ bool ClimateStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void ClimateStateResponse::encode(ProtoWriteBuffer buffer) const {
+void ClimateStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::ClimateMode>(2, this->mode);
   buffer.encode_float(3, this->current_temperature);
@@ -4719,11 +4719,11 @@ bool ClimateCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt value)
 bool ClimateCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 17: {
-      this->custom_fan_mode = value.as_string();
+      this->custom_fan_mode = value.as_string_ref();
       return true;
     }
     case 21: {
-      this->custom_preset = value.as_string();
+      this->custom_preset = value.as_string_ref();
       return true;
     }
     default:
@@ -4756,7 +4756,7 @@ bool ClimateCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void ClimateCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void ClimateCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->has_mode);
   buffer.encode_enum<enums::ClimateMode>(3, this->mode);
@@ -4879,7 +4879,7 @@ void ClimateCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  custom_fan_mode: ");
-  out.append("'").append(this->custom_fan_mode).append("'");
+  out.append("'").append(this->custom_fan_mode.c_str(), this->custom_fan_mode.size()).append("'");
   out.append("\n");
 
   out.append("  has_preset: ");
@@ -4895,7 +4895,7 @@ void ClimateCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  custom_preset: ");
-  out.append("'").append(this->custom_preset).append("'");
+  out.append("'").append(this->custom_preset.c_str(), this->custom_preset.size()).append("'");
   out.append("\n");
 
   out.append("  has_target_humidity: ");
@@ -4979,7 +4979,7 @@ bool ListEntitiesNumberResponse::decode_32bit(uint32_t field_id, Proto32Bit valu
       return false;
   }
 }
-void ListEntitiesNumberResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesNumberResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -5095,7 +5095,7 @@ bool NumberStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void NumberStateResponse::encode(ProtoWriteBuffer buffer) const {
+void NumberStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
@@ -5139,7 +5139,7 @@ bool NumberCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void NumberCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void NumberCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
 }
@@ -5213,7 +5213,7 @@ bool ListEntitiesSelectResponse::decode_32bit(uint32_t field_id, Proto32Bit valu
       return false;
   }
 }
-void ListEntitiesSelectResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesSelectResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -5310,7 +5310,7 @@ bool SelectStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void SelectStateResponse::encode(ProtoWriteBuffer buffer) const {
+void SelectStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
@@ -5342,7 +5342,7 @@ void SelectStateResponse::dump_to(std::string &out) const {
 bool SelectCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 2: {
-      this->state = value.as_string();
+      this->state = value.as_string_ref();
       return true;
     }
     default:
@@ -5359,7 +5359,7 @@ bool SelectCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void SelectCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void SelectCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
@@ -5377,7 +5377,7 @@ void SelectCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  state: ");
-  out.append("'").append(this->state).append("'");
+  out.append("'").append(this->state.c_str(), this->state.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -5440,7 +5440,7 @@ bool ListEntitiesSirenResponse::decode_32bit(uint32_t field_id, Proto32Bit value
       return false;
   }
 }
-void ListEntitiesSirenResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesSirenResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -5539,7 +5539,7 @@ bool SirenStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void SirenStateResponse::encode(ProtoWriteBuffer buffer) const {
+void SirenStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
@@ -5595,7 +5595,7 @@ bool SirenCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool SirenCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 5: {
-      this->tone = value.as_string();
+      this->tone = value.as_string_ref();
       return true;
     }
     default:
@@ -5616,7 +5616,7 @@ bool SirenCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void SirenCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void SirenCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->has_state);
   buffer.encode_bool(3, this->state);
@@ -5660,7 +5660,7 @@ void SirenCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  tone: ");
-  out.append("'").append(this->tone).append("'");
+  out.append("'").append(this->tone.c_str(), this->tone.size()).append("'");
   out.append("\n");
 
   out.append("  has_duration: ");
@@ -5745,7 +5745,7 @@ bool ListEntitiesLockResponse::decode_32bit(uint32_t field_id, Proto32Bit value)
       return false;
   }
 }
-void ListEntitiesLockResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesLockResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -5842,7 +5842,7 @@ bool LockStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void LockStateResponse::encode(ProtoWriteBuffer buffer) const {
+void LockStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::LockState>(2, this->state);
 }
@@ -5882,7 +5882,7 @@ bool LockCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool LockCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->code = value.as_string();
+      this->code = value.as_string_ref();
       return true;
     }
     default:
@@ -5899,7 +5899,7 @@ bool LockCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void LockCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void LockCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::LockCommand>(2, this->command);
   buffer.encode_bool(3, this->has_code);
@@ -5929,7 +5929,7 @@ void LockCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  code: ");
-  out.append("'").append(this->code).append("'");
+  out.append("'").append(this->code.c_str(), this->code.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -5984,7 +5984,7 @@ bool ListEntitiesButtonResponse::decode_32bit(uint32_t field_id, Proto32Bit valu
       return false;
   }
 }
-void ListEntitiesButtonResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesButtonResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -6053,7 +6053,7 @@ bool ButtonCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void ButtonCommandRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->key); }
+void ButtonCommandRequest::encode(ProtoWriteBuffer &buffer) const { buffer.encode_fixed32(1, this->key); }
 void ButtonCommandRequest::calculate_size(uint32_t &total_size) const {
   ProtoSize::add_fixed_field<4>(total_size, 1, this->key != 0, false);
 }
@@ -6100,7 +6100,7 @@ bool MediaPlayerSupportedFormat::decode_length(uint32_t field_id, ProtoLengthDel
       return false;
   }
 }
-void MediaPlayerSupportedFormat::encode(ProtoWriteBuffer buffer) const {
+void MediaPlayerSupportedFormat::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->format);
   buffer.encode_uint32(2, this->sample_rate);
   buffer.encode_uint32(3, this->num_channels);
@@ -6197,7 +6197,7 @@ bool ListEntitiesMediaPlayerResponse::decode_32bit(uint32_t field_id, Proto32Bit
       return false;
   }
 }
-void ListEntitiesMediaPlayerResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesMediaPlayerResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -6294,7 +6294,7 @@ bool MediaPlayerStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value)
       return false;
   }
 }
-void MediaPlayerStateResponse::encode(ProtoWriteBuffer buffer) const {
+void MediaPlayerStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::MediaPlayerState>(2, this->state);
   buffer.encode_float(3, this->volume);
@@ -6363,7 +6363,7 @@ bool MediaPlayerCommandRequest::decode_varint(uint32_t field_id, ProtoVarInt val
 bool MediaPlayerCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 7: {
-      this->media_url = value.as_string();
+      this->media_url = value.as_string_ref();
       return true;
     }
     default:
@@ -6384,7 +6384,7 @@ bool MediaPlayerCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value
       return false;
   }
 }
-void MediaPlayerCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void MediaPlayerCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->has_command);
   buffer.encode_enum<enums::MediaPlayerCommand>(3, this->command);
@@ -6437,7 +6437,7 @@ void MediaPlayerCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  media_url: ");
-  out.append("'").append(this->media_url).append("'");
+  out.append("'").append(this->media_url.c_str(), this->media_url.size()).append("'");
   out.append("\n");
 
   out.append("  has_announcement: ");
@@ -6460,7 +6460,7 @@ bool SubscribeBluetoothLEAdvertisementsRequest::decode_varint(uint32_t field_id,
       return false;
   }
 }
-void SubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {
+void SubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint32(1, this->flags);
 }
 void SubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {
@@ -6501,7 +6501,7 @@ bool BluetoothServiceData::decode_length(uint32_t field_id, ProtoLengthDelimited
       return false;
   }
 }
-void BluetoothServiceData::encode(ProtoWriteBuffer buffer) const {
+void BluetoothServiceData::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->uuid);
   for (auto &it : this->legacy_data) {
     buffer.encode_uint32(2, it, true);
@@ -6578,7 +6578,7 @@ bool BluetoothLEAdvertisementResponse::decode_length(uint32_t field_id, ProtoLen
       return false;
   }
 }
-void BluetoothLEAdvertisementResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothLEAdvertisementResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_string(2, this->name);
   buffer.encode_sint32(3, this->rssi);
@@ -6677,7 +6677,7 @@ bool BluetoothLERawAdvertisement::decode_length(uint32_t field_id, ProtoLengthDe
       return false;
   }
 }
-void BluetoothLERawAdvertisement::encode(ProtoWriteBuffer buffer) const {
+void BluetoothLERawAdvertisement::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_sint32(2, this->rssi);
   buffer.encode_uint32(3, this->address_type);
@@ -6724,7 +6724,7 @@ bool BluetoothLERawAdvertisementsResponse::decode_length(uint32_t field_id, Prot
       return false;
   }
 }
-void BluetoothLERawAdvertisementsResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothLERawAdvertisementsResponse::encode(ProtoWriteBuffer &buffer) const {
   for (auto &it : this->advertisements) {
     buffer.encode_message<BluetoothLERawAdvertisement>(1, it, true);
   }
@@ -6766,7 +6766,7 @@ bool BluetoothDeviceRequest::decode_varint(uint32_t field_id, ProtoVarInt value)
       return false;
   }
 }
-void BluetoothDeviceRequest::encode(ProtoWriteBuffer buffer) const {
+void BluetoothDeviceRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_enum<enums::BluetoothDeviceRequestType>(2, this->request_type);
   buffer.encode_bool(3, this->has_address_type);
@@ -6824,7 +6824,7 @@ bool BluetoothDeviceConnectionResponse::decode_varint(uint32_t field_id, ProtoVa
       return false;
   }
 }
-void BluetoothDeviceConnectionResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothDeviceConnectionResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_bool(2, this->connected);
   buffer.encode_uint32(3, this->mtu);
@@ -6871,7 +6871,7 @@ bool BluetoothGATTGetServicesRequest::decode_varint(uint32_t field_id, ProtoVarI
       return false;
   }
 }
-void BluetoothGATTGetServicesRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_uint64(1, this->address); }
+void BluetoothGATTGetServicesRequest::encode(ProtoWriteBuffer &buffer) const { buffer.encode_uint64(1, this->address); }
 void BluetoothGATTGetServicesRequest::calculate_size(uint32_t &total_size) const {
   ProtoSize::add_uint64_field(total_size, 1, this->address, false);
 }
@@ -6900,7 +6900,7 @@ bool BluetoothGATTDescriptor::decode_varint(uint32_t field_id, ProtoVarInt value
       return false;
   }
 }
-void BluetoothGATTDescriptor::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTDescriptor::encode(ProtoWriteBuffer &buffer) const {
   for (auto &it : this->uuid) {
     buffer.encode_uint64(1, it, true);
   }
@@ -6960,7 +6960,7 @@ bool BluetoothGATTCharacteristic::decode_length(uint32_t field_id, ProtoLengthDe
       return false;
   }
 }
-void BluetoothGATTCharacteristic::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTCharacteristic::encode(ProtoWriteBuffer &buffer) const {
   for (auto &it : this->uuid) {
     buffer.encode_uint64(1, it, true);
   }
@@ -7033,7 +7033,7 @@ bool BluetoothGATTService::decode_length(uint32_t field_id, ProtoLengthDelimited
       return false;
   }
 }
-void BluetoothGATTService::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTService::encode(ProtoWriteBuffer &buffer) const {
   for (auto &it : this->uuid) {
     buffer.encode_uint64(1, it, true);
   }
@@ -7095,7 +7095,7 @@ bool BluetoothGATTGetServicesResponse::decode_length(uint32_t field_id, ProtoLen
       return false;
   }
 }
-void BluetoothGATTGetServicesResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTGetServicesResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   for (auto &it : this->services) {
     buffer.encode_message<BluetoothGATTService>(2, it, true);
@@ -7132,7 +7132,7 @@ bool BluetoothGATTGetServicesDoneResponse::decode_varint(uint32_t field_id, Prot
       return false;
   }
 }
-void BluetoothGATTGetServicesDoneResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTGetServicesDoneResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
 }
 void BluetoothGATTGetServicesDoneResponse::calculate_size(uint32_t &total_size) const {
@@ -7163,7 +7163,7 @@ bool BluetoothGATTReadRequest::decode_varint(uint32_t field_id, ProtoVarInt valu
       return false;
   }
 }
-void BluetoothGATTReadRequest::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTReadRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
@@ -7211,7 +7211,7 @@ bool BluetoothGATTReadResponse::decode_length(uint32_t field_id, ProtoLengthDeli
       return false;
   }
 }
-void BluetoothGATTReadResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTReadResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
@@ -7262,14 +7262,14 @@ bool BluetoothGATTWriteRequest::decode_varint(uint32_t field_id, ProtoVarInt val
 bool BluetoothGATTWriteRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
       return false;
   }
 }
-void BluetoothGATTWriteRequest::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTWriteRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
   buffer.encode_bool(3, this->response);
@@ -7300,7 +7300,7 @@ void BluetoothGATTWriteRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -7319,7 +7319,7 @@ bool BluetoothGATTReadDescriptorRequest::decode_varint(uint32_t field_id, ProtoV
       return false;
   }
 }
-void BluetoothGATTReadDescriptorRequest::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTReadDescriptorRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
@@ -7360,14 +7360,14 @@ bool BluetoothGATTWriteDescriptorRequest::decode_varint(uint32_t field_id, Proto
 bool BluetoothGATTWriteDescriptorRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 3: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
       return false;
   }
 }
-void BluetoothGATTWriteDescriptorRequest::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTWriteDescriptorRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
@@ -7392,7 +7392,7 @@ void BluetoothGATTWriteDescriptorRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -7415,7 +7415,7 @@ bool BluetoothGATTNotifyRequest::decode_varint(uint32_t field_id, ProtoVarInt va
       return false;
   }
 }
-void BluetoothGATTNotifyRequest::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTNotifyRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
   buffer.encode_bool(3, this->enable);
@@ -7469,7 +7469,7 @@ bool BluetoothGATTNotifyDataResponse::decode_length(uint32_t field_id, ProtoLeng
       return false;
   }
 }
-void BluetoothGATTNotifyDataResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTNotifyDataResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
@@ -7499,7 +7499,7 @@ void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
-void SubscribeBluetoothConnectionsFreeRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeBluetoothConnectionsFreeRequest::encode(ProtoWriteBuffer &buffer) const {}
 void SubscribeBluetoothConnectionsFreeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothConnectionsFreeRequest::dump_to(std::string &out) const {
@@ -7524,7 +7524,7 @@ bool BluetoothConnectionsFreeResponse::decode_varint(uint32_t field_id, ProtoVar
       return false;
   }
 }
-void BluetoothConnectionsFreeResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothConnectionsFreeResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint32(1, this->free);
   buffer.encode_uint32(2, this->limit);
   for (auto &it : this->allocated) {
@@ -7581,7 +7581,7 @@ bool BluetoothGATTErrorResponse::decode_varint(uint32_t field_id, ProtoVarInt va
       return false;
   }
 }
-void BluetoothGATTErrorResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTErrorResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
   buffer.encode_int32(3, this->error);
@@ -7626,7 +7626,7 @@ bool BluetoothGATTWriteResponse::decode_varint(uint32_t field_id, ProtoVarInt va
       return false;
   }
 }
-void BluetoothGATTWriteResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTWriteResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
@@ -7664,7 +7664,7 @@ bool BluetoothGATTNotifyResponse::decode_varint(uint32_t field_id, ProtoVarInt v
       return false;
   }
 }
-void BluetoothGATTNotifyResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothGATTNotifyResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
@@ -7706,7 +7706,7 @@ bool BluetoothDevicePairingResponse::decode_varint(uint32_t field_id, ProtoVarIn
       return false;
   }
 }
-void BluetoothDevicePairingResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothDevicePairingResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_bool(2, this->paired);
   buffer.encode_int32(3, this->error);
@@ -7754,7 +7754,7 @@ bool BluetoothDeviceUnpairingResponse::decode_varint(uint32_t field_id, ProtoVar
       return false;
   }
 }
-void BluetoothDeviceUnpairingResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothDeviceUnpairingResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
@@ -7784,7 +7784,7 @@ void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
-void UnsubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {}
+void UnsubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer &buffer) const {}
 void UnsubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void UnsubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
@@ -7809,7 +7809,7 @@ bool BluetoothDeviceClearCacheResponse::decode_varint(uint32_t field_id, ProtoVa
       return false;
   }
 }
-void BluetoothDeviceClearCacheResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothDeviceClearCacheResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
@@ -7853,7 +7853,7 @@ bool BluetoothScannerStateResponse::decode_varint(uint32_t field_id, ProtoVarInt
       return false;
   }
 }
-void BluetoothScannerStateResponse::encode(ProtoWriteBuffer buffer) const {
+void BluetoothScannerStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_enum<enums::BluetoothScannerState>(1, this->state);
   buffer.encode_enum<enums::BluetoothScannerMode>(2, this->mode);
 }
@@ -7885,7 +7885,7 @@ bool BluetoothScannerSetModeRequest::decode_varint(uint32_t field_id, ProtoVarIn
       return false;
   }
 }
-void BluetoothScannerSetModeRequest::encode(ProtoWriteBuffer buffer) const {
+void BluetoothScannerSetModeRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_enum<enums::BluetoothScannerMode>(1, this->mode);
 }
 void BluetoothScannerSetModeRequest::calculate_size(uint32_t &total_size) const {
@@ -7915,7 +7915,7 @@ bool SubscribeVoiceAssistantRequest::decode_varint(uint32_t field_id, ProtoVarIn
       return false;
   }
 }
-void SubscribeVoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const {
+void SubscribeVoiceAssistantRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_bool(1, this->subscribe);
   buffer.encode_uint32(2, this->flags);
 }
@@ -7962,7 +7962,7 @@ bool VoiceAssistantAudioSettings::decode_32bit(uint32_t field_id, Proto32Bit val
       return false;
   }
 }
-void VoiceAssistantAudioSettings::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantAudioSettings::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint32(1, this->noise_suppression_level);
   buffer.encode_uint32(2, this->auto_gain);
   buffer.encode_float(3, this->volume_multiplier);
@@ -8025,7 +8025,7 @@ bool VoiceAssistantRequest::decode_length(uint32_t field_id, ProtoLengthDelimite
       return false;
   }
 }
-void VoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_bool(1, this->start);
   buffer.encode_string(2, this->conversation_id);
   buffer.encode_uint32(3, this->flags);
@@ -8080,7 +8080,7 @@ bool VoiceAssistantResponse::decode_varint(uint32_t field_id, ProtoVarInt value)
       return false;
   }
 }
-void VoiceAssistantResponse::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_uint32(1, this->port);
   buffer.encode_bool(2, this->error);
 }
@@ -8117,7 +8117,7 @@ bool VoiceAssistantEventData::decode_length(uint32_t field_id, ProtoLengthDelimi
       return false;
   }
 }
-void VoiceAssistantEventData::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantEventData::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_string(2, this->value);
 }
@@ -8159,7 +8159,7 @@ bool VoiceAssistantEventResponse::decode_length(uint32_t field_id, ProtoLengthDe
       return false;
   }
 }
-void VoiceAssistantEventResponse::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantEventResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_enum<enums::VoiceAssistantEvent>(1, this->event_type);
   for (auto &it : this->data) {
     buffer.encode_message<VoiceAssistantEventData>(2, it, true);
@@ -8205,7 +8205,7 @@ bool VoiceAssistantAudio::decode_length(uint32_t field_id, ProtoLengthDelimited
       return false;
   }
 }
-void VoiceAssistantAudio::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantAudio::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->data);
   buffer.encode_bool(2, this->end);
 }
@@ -8252,18 +8252,18 @@ bool VoiceAssistantTimerEventResponse::decode_varint(uint32_t field_id, ProtoVar
 bool VoiceAssistantTimerEventResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 2: {
-      this->timer_id = value.as_string();
+      this->timer_id = value.as_string_ref();
       return true;
     }
     case 3: {
-      this->name = value.as_string();
+      this->name = value.as_string_ref();
       return true;
     }
     default:
       return false;
   }
 }
-void VoiceAssistantTimerEventResponse::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantTimerEventResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_enum<enums::VoiceAssistantTimerEvent>(1, this->event_type);
   buffer.encode_string(2, this->timer_id);
   buffer.encode_string(3, this->name);
@@ -8288,11 +8288,11 @@ void VoiceAssistantTimerEventResponse::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  timer_id: ");
-  out.append("'").append(this->timer_id).append("'");
+  out.append("'").append(this->timer_id.c_str(), this->timer_id.size()).append("'");
   out.append("\n");
 
   out.append("  name: ");
-  out.append("'").append(this->name).append("'");
+  out.append("'").append(this->name.c_str(), this->name.size()).append("'");
   out.append("\n");
 
   out.append("  total_seconds: ");
@@ -8324,22 +8324,22 @@ bool VoiceAssistantAnnounceRequest::decode_varint(uint32_t field_id, ProtoVarInt
 bool VoiceAssistantAnnounceRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->media_id = value.as_string();
+      this->media_id = value.as_string_ref();
       return true;
     }
     case 2: {
-      this->text = value.as_string();
+      this->text = value.as_string_ref();
       return true;
     }
     case 3: {
-      this->preannounce_media_id = value.as_string();
+      this->preannounce_media_id = value.as_string_ref();
       return true;
     }
     default:
       return false;
   }
 }
-void VoiceAssistantAnnounceRequest::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantAnnounceRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->media_id);
   buffer.encode_string(2, this->text);
   buffer.encode_string(3, this->preannounce_media_id);
@@ -8356,15 +8356,15 @@ void VoiceAssistantAnnounceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("VoiceAssistantAnnounceRequest {\n");
   out.append("  media_id: ");
-  out.append("'").append(this->media_id).append("'");
+  out.append("'").append(this->media_id.c_str(), this->media_id.size()).append("'");
   out.append("\n");
 
   out.append("  text: ");
-  out.append("'").append(this->text).append("'");
+  out.append("'").append(this->text.c_str(), this->text.size()).append("'");
   out.append("\n");
 
   out.append("  preannounce_media_id: ");
-  out.append("'").append(this->preannounce_media_id).append("'");
+  out.append("'").append(this->preannounce_media_id.c_str(), this->preannounce_media_id.size()).append("'");
   out.append("\n");
 
   out.append("  start_conversation: ");
@@ -8383,7 +8383,7 @@ bool VoiceAssistantAnnounceFinished::decode_varint(uint32_t field_id, ProtoVarIn
       return false;
   }
 }
-void VoiceAssistantAnnounceFinished::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->success); }
+void VoiceAssistantAnnounceFinished::encode(ProtoWriteBuffer &buffer) const { buffer.encode_bool(1, this->success); }
 void VoiceAssistantAnnounceFinished::calculate_size(uint32_t &total_size) const {
   ProtoSize::add_bool_field(total_size, 1, this->success, false);
 }
@@ -8415,7 +8415,7 @@ bool VoiceAssistantWakeWord::decode_length(uint32_t field_id, ProtoLengthDelimit
       return false;
   }
 }
-void VoiceAssistantWakeWord::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantWakeWord::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->id);
   buffer.encode_string(2, this->wake_word);
   for (auto &it : this->trained_languages) {
@@ -8451,7 +8451,7 @@ void VoiceAssistantWakeWord::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
-void VoiceAssistantConfigurationRequest::encode(ProtoWriteBuffer buffer) const {}
+void VoiceAssistantConfigurationRequest::encode(ProtoWriteBuffer &buffer) const {}
 void VoiceAssistantConfigurationRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantConfigurationRequest::dump_to(std::string &out) const {
@@ -8482,7 +8482,7 @@ bool VoiceAssistantConfigurationResponse::decode_length(uint32_t field_id, Proto
       return false;
   }
 }
-void VoiceAssistantConfigurationResponse::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantConfigurationResponse::encode(ProtoWriteBuffer &buffer) const {
   for (auto &it : this->available_wake_words) {
     buffer.encode_message<VoiceAssistantWakeWord>(1, it, true);
   }
@@ -8526,14 +8526,14 @@ void VoiceAssistantConfigurationResponse::dump_to(std::string &out) const {
 bool VoiceAssistantSetConfiguration::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->active_wake_words.push_back(value.as_string());
+      this->active_wake_words.push_back(value.as_string_ref());
       return true;
     }
     default:
       return false;
   }
 }
-void VoiceAssistantSetConfiguration::encode(ProtoWriteBuffer buffer) const {
+void VoiceAssistantSetConfiguration::encode(ProtoWriteBuffer &buffer) const {
   for (auto &it : this->active_wake_words) {
     buffer.encode_string(1, it, true);
   }
@@ -8551,7 +8551,7 @@ void VoiceAssistantSetConfiguration::dump_to(std::string &out) const {
   out.append("VoiceAssistantSetConfiguration {\n");
   for (const auto &it : this->active_wake_words) {
     out.append("  active_wake_words: ");
-    out.append("'").append(it).append("'");
+    out.append("'").append(it.c_str(), it.size()).append("'");
     out.append("\n");
   }
   out.append("}");
@@ -8615,7 +8615,7 @@ bool ListEntitiesAlarmControlPanelResponse::decode_32bit(uint32_t field_id, Prot
       return false;
   }
 }
-void ListEntitiesAlarmControlPanelResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesAlarmControlPanelResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -8707,7 +8707,7 @@ bool AlarmControlPanelStateResponse::decode_32bit(uint32_t field_id, Proto32Bit
       return false;
   }
 }
-void AlarmControlPanelStateResponse::encode(ProtoWriteBuffer buffer) const {
+void AlarmControlPanelStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::AlarmControlPanelState>(2, this->state);
 }
@@ -8743,7 +8743,7 @@ bool AlarmControlPanelCommandRequest::decode_varint(uint32_t field_id, ProtoVarI
 bool AlarmControlPanelCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 3: {
-      this->code = value.as_string();
+      this->code = value.as_string_ref();
       return true;
     }
     default:
@@ -8760,7 +8760,7 @@ bool AlarmControlPanelCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit
       return false;
   }
 }
-void AlarmControlPanelCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void AlarmControlPanelCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::AlarmControlPanelStateCommand>(2, this->command);
   buffer.encode_string(3, this->code);
@@ -8784,7 +8784,7 @@ void AlarmControlPanelCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  code: ");
-  out.append("'").append(this->code).append("'");
+  out.append("'").append(this->code.c_str(), this->code.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -8851,7 +8851,7 @@ bool ListEntitiesTextResponse::decode_32bit(uint32_t field_id, Proto32Bit value)
       return false;
   }
 }
-void ListEntitiesTextResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesTextResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -8960,7 +8960,7 @@ bool TextStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void TextStateResponse::encode(ProtoWriteBuffer buffer) const {
+void TextStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
@@ -8992,7 +8992,7 @@ void TextStateResponse::dump_to(std::string &out) const {
 bool TextCommandRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 2: {
-      this->state = value.as_string();
+      this->state = value.as_string_ref();
       return true;
     }
     default:
@@ -9009,7 +9009,7 @@ bool TextCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void TextCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void TextCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
@@ -9027,7 +9027,7 @@ void TextCommandRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  state: ");
-  out.append("'").append(this->state).append("'");
+  out.append("'").append(this->state.c_str(), this->state.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -9078,7 +9078,7 @@ bool ListEntitiesDateResponse::decode_32bit(uint32_t field_id, Proto32Bit value)
       return false;
   }
 }
-void ListEntitiesDateResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesDateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -9163,7 +9163,7 @@ bool DateStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void DateStateResponse::encode(ProtoWriteBuffer buffer) const {
+void DateStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->missing_state);
   buffer.encode_uint32(3, this->year);
@@ -9235,7 +9235,7 @@ bool DateCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void DateCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void DateCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_uint32(2, this->year);
   buffer.encode_uint32(3, this->month);
@@ -9319,7 +9319,7 @@ bool ListEntitiesTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit value)
       return false;
   }
 }
-void ListEntitiesTimeResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesTimeResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -9404,7 +9404,7 @@ bool TimeStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void TimeStateResponse::encode(ProtoWriteBuffer buffer) const {
+void TimeStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->missing_state);
   buffer.encode_uint32(3, this->hour);
@@ -9476,7 +9476,7 @@ bool TimeCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void TimeCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void TimeCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_uint32(2, this->hour);
   buffer.encode_uint32(3, this->minute);
@@ -9568,7 +9568,7 @@ bool ListEntitiesEventResponse::decode_32bit(uint32_t field_id, Proto32Bit value
       return false;
   }
 }
-void ListEntitiesEventResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesEventResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -9661,7 +9661,7 @@ bool EventResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void EventResponse::encode(ProtoWriteBuffer buffer) const {
+void EventResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->event_type);
 }
@@ -9746,7 +9746,7 @@ bool ListEntitiesValveResponse::decode_32bit(uint32_t field_id, Proto32Bit value
       return false;
   }
 }
-void ListEntitiesValveResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesValveResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -9847,7 +9847,7 @@ bool ValveStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void ValveStateResponse::encode(ProtoWriteBuffer buffer) const {
+void ValveStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->position);
   buffer.encode_enum<enums::ValveOperation>(3, this->current_operation);
@@ -9905,7 +9905,7 @@ bool ValveCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void ValveCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void ValveCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->has_position);
   buffer.encode_float(3, this->position);
@@ -9987,7 +9987,7 @@ bool ListEntitiesDateTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit va
       return false;
   }
 }
-void ListEntitiesDateTimeResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesDateTimeResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -10064,7 +10064,7 @@ bool DateTimeStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void DateTimeStateResponse::encode(ProtoWriteBuffer buffer) const {
+void DateTimeStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->missing_state);
   buffer.encode_fixed32(3, this->epoch_seconds);
@@ -10108,7 +10108,7 @@ bool DateTimeCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void DateTimeCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void DateTimeCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_fixed32(2, this->epoch_seconds);
 }
@@ -10182,7 +10182,7 @@ bool ListEntitiesUpdateResponse::decode_32bit(uint32_t field_id, Proto32Bit valu
       return false;
   }
 }
-void ListEntitiesUpdateResponse::encode(ProtoWriteBuffer buffer) const {
+void ListEntitiesUpdateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_string(1, this->object_id);
   buffer.encode_fixed32(2, this->key);
   buffer.encode_string(3, this->name);
@@ -10299,7 +10299,7 @@ bool UpdateStateResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void UpdateStateResponse::encode(ProtoWriteBuffer buffer) const {
+void UpdateStateResponse::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->missing_state);
   buffer.encode_bool(3, this->in_progress);
@@ -10391,7 +10391,7 @@ bool UpdateCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
       return false;
   }
 }
-void UpdateCommandRequest::encode(ProtoWriteBuffer buffer) const {
+void UpdateCommandRequest::encode(ProtoWriteBuffer &buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::UpdateCommand>(2, this->command);
 }
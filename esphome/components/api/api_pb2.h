@@ -282,10 +282,10 @@ class HelloRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "hello_request"; }
 #endif
-  std::string client_info{};
+  StringRef client_info{};
   uint32_t api_version_major{0};
   uint32_t api_version_minor{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -306,7 +306,7 @@ class HelloResponse : public ProtoMessage {
   uint32_t api_version_minor{0};
   std::string server_info{};
   std::string name{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -323,8 +323,8 @@ class ConnectRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "connect_request"; }
 #endif
-  std::string password{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef password{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -341,7 +341,7 @@ class ConnectResponse : public ProtoMessage {
   static constexpr const char *message_name() { return "connect_response"; }
 #endif
   bool invalid_password{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -357,7 +357,7 @@ class DisconnectRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "disconnect_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -372,7 +372,7 @@ class DisconnectResponse : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "disconnect_response"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -387,7 +387,7 @@ class PingRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "ping_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -402,7 +402,7 @@ class PingResponse : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "ping_response"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -417,7 +417,7 @@ class DeviceInfoRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "device_info_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -451,7 +451,7 @@ class DeviceInfoResponse : public ProtoMessage {
   std::string suggested_area{};
   std::string bluetooth_mac_address{};
   bool api_encryption_supported{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -468,7 +468,7 @@ class ListEntitiesRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "list_entities_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -483,7 +483,7 @@ class ListEntitiesDoneResponse : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "list_entities_done_response"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -498,7 +498,7 @@ class SubscribeStatesRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "subscribe_states_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -515,7 +515,7 @@ class ListEntitiesBinarySensorResponse : public InfoResponseProtoMessage {
 #endif
   std::string device_class{};
   bool is_status_binary_sensor{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -535,7 +535,7 @@ class BinarySensorStateResponse : public StateResponseProtoMessage {
 #endif
   bool state{false};
   bool missing_state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -557,7 +557,7 @@ class ListEntitiesCoverResponse : public InfoResponseProtoMessage {
   bool supports_tilt{false};
   std::string device_class{};
   bool supports_stop{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -579,7 +579,7 @@ class CoverStateResponse : public StateResponseProtoMessage {
   float position{0.0f};
   float tilt{0.0f};
   enums::CoverOperation current_operation{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -604,7 +604,7 @@ class CoverCommandRequest : public ProtoMessage {
   bool has_tilt{false};
   float tilt{0.0f};
   bool stop{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -626,7 +626,7 @@ class ListEntitiesFanResponse : public InfoResponseProtoMessage {
   bool supports_direction{false};
   int32_t supported_speed_count{0};
   std::vector<std::string> supported_preset_modes{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -650,7 +650,7 @@ class FanStateResponse : public StateResponseProtoMessage {
   enums::FanDirection direction{};
   int32_t speed_level{0};
   std::string preset_mode{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -680,8 +680,8 @@ class FanCommandRequest : public ProtoMessage {
   bool has_speed_level{false};
   int32_t speed_level{0};
   bool has_preset_mode{false};
-  std::string preset_mode{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef preset_mode{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -707,7 +707,7 @@ class ListEntitiesLightResponse : public InfoResponseProtoMessage {
   float min_mireds{0.0f};
   float max_mireds{0.0f};
   std::vector<std::string> effects{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -737,7 +737,7 @@ class LightStateResponse : public StateResponseProtoMessage {
   float cold_white{0.0f};
   float warm_white{0.0f};
   std::string effect{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -781,8 +781,8 @@ class LightCommandRequest : public ProtoMessage {
   bool has_flash_length{false};
   uint32_t flash_length{0};
   bool has_effect{false};
-  std::string effect{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef effect{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -806,7 +806,7 @@ class ListEntitiesSensorResponse : public InfoResponseProtoMessage {
   std::string device_class{};
   enums::SensorStateClass state_class{};
   enums::SensorLastResetType legacy_last_reset_type{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -826,7 +826,7 @@ class SensorStateResponse : public StateResponseProtoMessage {
 #endif
   float state{0.0f};
   bool missing_state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -845,7 +845,7 @@ class ListEntitiesSwitchResponse : public InfoResponseProtoMessage {
 #endif
   bool assumed_state{false};
   std::string device_class{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -864,7 +864,7 @@ class SwitchStateResponse : public StateResponseProtoMessage {
   static constexpr const char *message_name() { return "switch_state_response"; }
 #endif
   bool state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -883,7 +883,7 @@ class SwitchCommandRequest : public ProtoMessage {
 #endif
   uint32_t key{0};
   bool state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -901,7 +901,7 @@ class ListEntitiesTextSensorResponse : public InfoResponseProtoMessage {
   static constexpr const char *message_name() { return "list_entities_text_sensor_response"; }
 #endif
   std::string device_class{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -921,7 +921,7 @@ class TextSensorStateResponse : public StateResponseProtoMessage {
 #endif
   std::string state{};
   bool missing_state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -941,7 +941,7 @@ class SubscribeLogsRequest : public ProtoMessage {
 #endif
   enums::LogLevel level{};
   bool dump_config{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -960,7 +960,7 @@ class SubscribeLogsResponse : public ProtoMessage {
   enums::LogLevel level{};
   std::string message{};
   bool send_failed{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -977,8 +977,8 @@ class NoiseEncryptionSetKeyRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "noise_encryption_set_key_request"; }
 #endif
-  std::string key{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef key{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -995,7 +995,7 @@ class NoiseEncryptionSetKeyResponse : public ProtoMessage {
   static constexpr const char *message_name() { return "noise_encryption_set_key_response"; }
 #endif
   bool success{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1011,7 +1011,7 @@ class SubscribeHomeassistantServicesRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "subscribe_homeassistant_services_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1023,7 +1023,7 @@ class HomeassistantServiceMap : public ProtoMessage {
  public:
   std::string key{};
   std::string value{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1044,7 +1044,7 @@ class HomeassistantServiceResponse : public ProtoMessage {
   std::vector<HomeassistantServiceMap> data_template{};
   std::vector<HomeassistantServiceMap> variables{};
   bool is_event{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1061,7 +1061,7 @@ class SubscribeHomeAssistantStatesRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "subscribe_home_assistant_states_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1079,7 +1079,7 @@ class SubscribeHomeAssistantStateResponse : public ProtoMessage {
   std::string entity_id{};
   std::string attribute{};
   bool once{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1096,10 +1096,10 @@ class HomeAssistantStateResponse : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "home_assistant_state_response"; }
 #endif
-  std::string entity_id{};
-  std::string state{};
-  std::string attribute{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef entity_id{};
+  StringRef state{};
+  StringRef attribute{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1115,7 +1115,7 @@ class GetTimeRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "get_time_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1131,7 +1131,7 @@ class GetTimeResponse : public ProtoMessage {
   static constexpr const char *message_name() { return "get_time_response"; }
 #endif
   uint32_t epoch_seconds{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1144,7 +1144,7 @@ class ListEntitiesServicesArgument : public ProtoMessage {
  public:
   std::string name{};
   enums::ServiceArgType type{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1164,7 +1164,7 @@ class ListEntitiesServicesResponse : public ProtoMessage {
   std::string name{};
   uint32_t key{0};
   std::vector<ListEntitiesServicesArgument> args{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1179,13 +1179,13 @@ class ExecuteServiceArgument : public ProtoMessage {
   bool bool_{false};
   int32_t legacy_int{0};
   float float_{0.0f};
-  std::string string_{};
+  StringRef string_{};
   int32_t int_{0};
   std::vector<bool> bool_array{};
   std::vector<int32_t> int_array{};
   std::vector<float> float_array{};
-  std::vector<std::string> string_array{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  std::vector<StringRef> string_array{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1205,7 +1205,7 @@ class ExecuteServiceRequest : public ProtoMessage {
 #endif
   uint32_t key{0};
   std::vector<ExecuteServiceArgument> args{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1222,7 +1222,7 @@ class ListEntitiesCameraResponse : public InfoResponseProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "list_entities_camera_response"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1243,7 +1243,7 @@ class CameraImageResponse : public ProtoMessage {
   uint32_t key{0};
   std::string data{};
   bool done{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1263,7 +1263,7 @@ class CameraImageRequest : public ProtoMessage {
 #endif
   bool single{false};
   bool stream{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1297,7 +1297,7 @@ class ListEntitiesClimateResponse : public InfoResponseProtoMessage {
   bool supports_target_humidity{false};
   float visual_min_humidity{0.0f};
   float visual_max_humidity{0.0f};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1329,7 +1329,7 @@ class ClimateStateResponse : public StateResponseProtoMessage {
   std::string custom_preset{};
   float current_humidity{0.0f};
   float target_humidity{0.0f};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1363,14 +1363,14 @@ class ClimateCommandRequest : public ProtoMessage {
   bool has_swing_mode{false};
   enums::ClimateSwingMode swing_mode{};
   bool has_custom_fan_mode{false};
-  std::string custom_fan_mode{};
+  StringRef custom_fan_mode{};
   bool has_preset{false};
   enums::ClimatePreset preset{};
   bool has_custom_preset{false};
-  std::string custom_preset{};
+  StringRef custom_preset{};
   bool has_target_humidity{false};
   float target_humidity{0.0f};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1394,7 +1394,7 @@ class ListEntitiesNumberResponse : public InfoResponseProtoMessage {
   std::string unit_of_measurement{};
   enums::NumberMode mode{};
   std::string device_class{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1414,7 +1414,7 @@ class NumberStateResponse : public StateResponseProtoMessage {
 #endif
   float state{0.0f};
   bool missing_state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1433,7 +1433,7 @@ class NumberCommandRequest : public ProtoMessage {
 #endif
   uint32_t key{0};
   float state{0.0f};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1450,7 +1450,7 @@ class ListEntitiesSelectResponse : public InfoResponseProtoMessage {
   static constexpr const char *message_name() { return "list_entities_select_response"; }
 #endif
   std::vector<std::string> options{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1470,7 +1470,7 @@ class SelectStateResponse : public StateResponseProtoMessage {
 #endif
   std::string state{};
   bool missing_state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1489,8 +1489,8 @@ class SelectCommandRequest : public ProtoMessage {
   static constexpr const char *message_name() { return "select_command_request"; }
 #endif
   uint32_t key{0};
-  std::string state{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef state{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1510,7 +1510,7 @@ class ListEntitiesSirenResponse : public InfoResponseProtoMessage {
   std::vector<std::string> tones{};
   bool supports_duration{false};
   bool supports_volume{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1529,7 +1529,7 @@ class SirenStateResponse : public StateResponseProtoMessage {
   static constexpr const char *message_name() { return "siren_state_response"; }
 #endif
   bool state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1550,12 +1550,12 @@ class SirenCommandRequest : public ProtoMessage {
   bool has_state{false};
   bool state{false};
   bool has_tone{false};
-  std::string tone{};
+  StringRef tone{};
   bool has_duration{false};
   uint32_t duration{0};
   bool has_volume{false};
   float volume{0.0f};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1577,7 +1577,7 @@ class ListEntitiesLockResponse : public InfoResponseProtoMessage {
   bool supports_open{false};
   bool requires_code{false};
   std::string code_format{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1596,7 +1596,7 @@ class LockStateResponse : public StateResponseProtoMessage {
   static constexpr const char *message_name() { return "lock_state_response"; }
 #endif
   enums::LockState state{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1616,8 +1616,8 @@ class LockCommandRequest : public ProtoMessage {
   uint32_t key{0};
   enums::LockCommand command{};
   bool has_code{false};
-  std::string code{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef code{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1636,7 +1636,7 @@ class ListEntitiesButtonResponse : public InfoResponseProtoMessage {
   static constexpr const char *message_name() { return "list_entities_button_response"; }
 #endif
   std::string device_class{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1655,7 +1655,7 @@ class ButtonCommandRequest : public ProtoMessage {
   static constexpr const char *message_name() { return "button_command_request"; }
 #endif
   uint32_t key{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1671,7 +1671,7 @@ class MediaPlayerSupportedFormat : public ProtoMessage {
   uint32_t num_channels{0};
   enums::MediaPlayerFormatPurpose purpose{};
   uint32_t sample_bytes{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1690,7 +1690,7 @@ class ListEntitiesMediaPlayerResponse : public InfoResponseProtoMessage {
 #endif
   bool supports_pause{false};
   std::vector<MediaPlayerSupportedFormat> supported_formats{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1711,7 +1711,7 @@ class MediaPlayerStateResponse : public StateResponseProtoMessage {
   enums::MediaPlayerState state{};
   float volume{0.0f};
   bool muted{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1734,10 +1734,10 @@ class MediaPlayerCommandRequest : public ProtoMessage {
   bool has_volume{false};
   float volume{0.0f};
   bool has_media_url{false};
-  std::string media_url{};
+  StringRef media_url{};
   bool has_announcement{false};
   bool announcement{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1756,7 +1756,7 @@ class SubscribeBluetoothLEAdvertisementsRequest : public ProtoMessage {
   static constexpr const char *message_name() { return "subscribe_bluetooth_le_advertisements_request"; }
 #endif
   uint32_t flags{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1770,7 +1770,7 @@ class BluetoothServiceData : public ProtoMessage {
   std::string uuid{};
   std::vector<uint32_t> legacy_data{};
   std::string data{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1794,7 +1794,7 @@ class BluetoothLEAdvertisementResponse : public ProtoMessage {
   std::vector<BluetoothServiceData> service_data{};
   std::vector<BluetoothServiceData> manufacturer_data{};
   uint32_t address_type{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1810,7 +1810,7 @@ class BluetoothLERawAdvertisement : public ProtoMessage {
   int32_t rssi{0};
   uint32_t address_type{0};
   std::string data{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1828,7 +1828,7 @@ class BluetoothLERawAdvertisementsResponse : public ProtoMessage {
   static constexpr const char *message_name() { return "bluetooth_le_raw_advertisements_response"; }
 #endif
   std::vector<BluetoothLERawAdvertisement> advertisements{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1848,7 +1848,7 @@ class BluetoothDeviceRequest : public ProtoMessage {
   enums::BluetoothDeviceRequestType request_type{};
   bool has_address_type{false};
   uint32_t address_type{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1868,7 +1868,7 @@ class BluetoothDeviceConnectionResponse : public ProtoMessage {
   bool connected{false};
   uint32_t mtu{0};
   int32_t error{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1885,7 +1885,7 @@ class BluetoothGATTGetServicesRequest : public ProtoMessage {
   static constexpr const char *message_name() { return "bluetooth_gatt_get_services_request"; }
 #endif
   uint64_t address{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1898,7 +1898,7 @@ class BluetoothGATTDescriptor : public ProtoMessage {
  public:
   std::vector<uint64_t> uuid{};
   uint32_t handle{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1913,7 +1913,7 @@ class BluetoothGATTCharacteristic : public ProtoMessage {
   uint32_t handle{0};
   uint32_t properties{0};
   std::vector<BluetoothGATTDescriptor> descriptors{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1928,7 +1928,7 @@ class BluetoothGATTService : public ProtoMessage {
   std::vector<uint64_t> uuid{};
   uint32_t handle{0};
   std::vector<BluetoothGATTCharacteristic> characteristics{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1947,7 +1947,7 @@ class BluetoothGATTGetServicesResponse : public ProtoMessage {
 #endif
   uint64_t address{0};
   std::vector<BluetoothGATTService> services{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1965,7 +1965,7 @@ class BluetoothGATTGetServicesDoneResponse : public ProtoMessage {
   static constexpr const char *message_name() { return "bluetooth_gatt_get_services_done_response"; }
 #endif
   uint64_t address{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -1983,7 +1983,7 @@ class BluetoothGATTReadRequest : public ProtoMessage {
 #endif
   uint64_t address{0};
   uint32_t handle{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2002,7 +2002,7 @@ class BluetoothGATTReadResponse : public ProtoMessage {
   uint64_t address{0};
   uint32_t handle{0};
   std::string data{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2022,8 +2022,8 @@ class BluetoothGATTWriteRequest : public ProtoMessage {
   uint64_t address{0};
   uint32_t handle{0};
   bool response{false};
-  std::string data{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef data{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2042,7 +2042,7 @@ class BluetoothGATTReadDescriptorRequest : public ProtoMessage {
 #endif
   uint64_t address{0};
   uint32_t handle{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2060,8 +2060,8 @@ class BluetoothGATTWriteDescriptorRequest : public ProtoMessage {
 #endif
   uint64_t address{0};
   uint32_t handle{0};
-  std::string data{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef data{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2081,7 +2081,7 @@ class BluetoothGATTNotifyRequest : public ProtoMessage {
   uint64_t address{0};
   uint32_t handle{0};
   bool enable{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2100,7 +2100,7 @@ class BluetoothGATTNotifyDataResponse : public ProtoMessage {
   uint64_t address{0};
   uint32_t handle{0};
   std::string data{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2117,7 +2117,7 @@ class SubscribeBluetoothConnectionsFreeRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "subscribe_bluetooth_connections_free_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2135,7 +2135,7 @@ class BluetoothConnectionsFreeResponse : public ProtoMessage {
   uint32_t free{0};
   uint32_t limit{0};
   std::vector<uint64_t> allocated{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2154,7 +2154,7 @@ class BluetoothGATTErrorResponse : public ProtoMessage {
   uint64_t address{0};
   uint32_t handle{0};
   int32_t error{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2172,7 +2172,7 @@ class BluetoothGATTWriteResponse : public ProtoMessage {
 #endif
   uint64_t address{0};
   uint32_t handle{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2190,7 +2190,7 @@ class BluetoothGATTNotifyResponse : public ProtoMessage {
 #endif
   uint64_t address{0};
   uint32_t handle{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2209,7 +2209,7 @@ class BluetoothDevicePairingResponse : public ProtoMessage {
   uint64_t address{0};
   bool paired{false};
   int32_t error{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2228,7 +2228,7 @@ class BluetoothDeviceUnpairingResponse : public ProtoMessage {
   uint64_t address{0};
   bool success{false};
   int32_t error{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2244,7 +2244,7 @@ class UnsubscribeBluetoothLEAdvertisementsRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "unsubscribe_bluetooth_le_advertisements_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2262,7 +2262,7 @@ class BluetoothDeviceClearCacheResponse : public ProtoMessage {
   uint64_t address{0};
   bool success{false};
   int32_t error{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2280,7 +2280,7 @@ class BluetoothScannerStateResponse : public ProtoMessage {
 #endif
   enums::BluetoothScannerState state{};
   enums::BluetoothScannerMode mode{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2297,7 +2297,7 @@ class BluetoothScannerSetModeRequest : public ProtoMessage {
   static constexpr const char *message_name() { return "bluetooth_scanner_set_mode_request"; }
 #endif
   enums::BluetoothScannerMode mode{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2315,7 +2315,7 @@ class SubscribeVoiceAssistantRequest : public ProtoMessage {
 #endif
   bool subscribe{false};
   uint32_t flags{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2329,7 +2329,7 @@ class VoiceAssistantAudioSettings : public ProtoMessage {
   uint32_t noise_suppression_level{0};
   uint32_t auto_gain{0};
   float volume_multiplier{0.0f};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2351,7 +2351,7 @@ class VoiceAssistantRequest : public ProtoMessage {
   uint32_t flags{0};
   VoiceAssistantAudioSettings audio_settings{};
   std::string wake_word_phrase{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2370,7 +2370,7 @@ class VoiceAssistantResponse : public ProtoMessage {
 #endif
   uint32_t port{0};
   bool error{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2383,7 +2383,7 @@ class VoiceAssistantEventData : public ProtoMessage {
  public:
   std::string name{};
   std::string value{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2401,7 +2401,7 @@ class VoiceAssistantEventResponse : public ProtoMessage {
 #endif
   enums::VoiceAssistantEvent event_type{};
   std::vector<VoiceAssistantEventData> data{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2420,7 +2420,7 @@ class VoiceAssistantAudio : public ProtoMessage {
 #endif
   std::string data{};
   bool end{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2438,12 +2438,12 @@ class VoiceAssistantTimerEventResponse : public ProtoMessage {
   static constexpr const char *message_name() { return "voice_assistant_timer_event_response"; }
 #endif
   enums::VoiceAssistantTimerEvent event_type{};
-  std::string timer_id{};
-  std::string name{};
+  StringRef timer_id{};
+  StringRef name{};
   uint32_t total_seconds{0};
   uint32_t seconds_left{0};
   bool is_active{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2460,11 +2460,11 @@ class VoiceAssistantAnnounceRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "voice_assistant_announce_request"; }
 #endif
-  std::string media_id{};
-  std::string text{};
-  std::string preannounce_media_id{};
+  StringRef media_id{};
+  StringRef text{};
+  StringRef preannounce_media_id{};
   bool start_conversation{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2482,7 +2482,7 @@ class VoiceAssistantAnnounceFinished : public ProtoMessage {
   static constexpr const char *message_name() { return "voice_assistant_announce_finished"; }
 #endif
   bool success{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2496,7 +2496,7 @@ class VoiceAssistantWakeWord : public ProtoMessage {
   std::string id{};
   std::string wake_word{};
   std::vector<std::string> trained_languages{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2512,7 +2512,7 @@ class VoiceAssistantConfigurationRequest : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "voice_assistant_configuration_request"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2530,7 +2530,7 @@ class VoiceAssistantConfigurationResponse : public ProtoMessage {
   std::vector<VoiceAssistantWakeWord> available_wake_words{};
   std::vector<std::string> active_wake_words{};
   uint32_t max_active_wake_words{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2547,8 +2547,8 @@ class VoiceAssistantSetConfiguration : public ProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "voice_assistant_set_configuration"; }
 #endif
-  std::vector<std::string> active_wake_words{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  std::vector<StringRef> active_wake_words{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2567,7 +2567,7 @@ class ListEntitiesAlarmControlPanelResponse : public InfoResponseProtoMessage {
   uint32_t supported_features{0};
   bool requires_code{false};
   bool requires_code_to_arm{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2586,7 +2586,7 @@ class AlarmControlPanelStateResponse : public StateResponseProtoMessage {
   static constexpr const char *message_name() { return "alarm_control_panel_state_response"; }
 #endif
   enums::AlarmControlPanelState state{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2605,8 +2605,8 @@ class AlarmControlPanelCommandRequest : public ProtoMessage {
 #endif
   uint32_t key{0};
   enums::AlarmControlPanelStateCommand command{};
-  std::string code{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef code{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2628,7 +2628,7 @@ class ListEntitiesTextResponse : public InfoResponseProtoMessage {
   uint32_t max_length{0};
   std::string pattern{};
   enums::TextMode mode{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2648,7 +2648,7 @@ class TextStateResponse : public StateResponseProtoMessage {
 #endif
   std::string state{};
   bool missing_state{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2667,8 +2667,8 @@ class TextCommandRequest : public ProtoMessage {
   static constexpr const char *message_name() { return "text_command_request"; }
 #endif
   uint32_t key{0};
-  std::string state{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  StringRef state{};
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2685,7 +2685,7 @@ class ListEntitiesDateResponse : public InfoResponseProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "list_entities_date_response"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2707,7 +2707,7 @@ class DateStateResponse : public StateResponseProtoMessage {
   uint32_t year{0};
   uint32_t month{0};
   uint32_t day{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2728,7 +2728,7 @@ class DateCommandRequest : public ProtoMessage {
   uint32_t year{0};
   uint32_t month{0};
   uint32_t day{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2745,7 +2745,7 @@ class ListEntitiesTimeResponse : public InfoResponseProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "list_entities_time_response"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2767,7 +2767,7 @@ class TimeStateResponse : public StateResponseProtoMessage {
   uint32_t hour{0};
   uint32_t minute{0};
   uint32_t second{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2788,7 +2788,7 @@ class TimeCommandRequest : public ProtoMessage {
   uint32_t hour{0};
   uint32_t minute{0};
   uint32_t second{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2807,7 +2807,7 @@ class ListEntitiesEventResponse : public InfoResponseProtoMessage {
 #endif
   std::string device_class{};
   std::vector<std::string> event_types{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2826,7 +2826,7 @@ class EventResponse : public StateResponseProtoMessage {
   static constexpr const char *message_name() { return "event_response"; }
 #endif
   std::string event_type{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2847,7 +2847,7 @@ class ListEntitiesValveResponse : public InfoResponseProtoMessage {
   bool assumed_state{false};
   bool supports_position{false};
   bool supports_stop{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2867,7 +2867,7 @@ class ValveStateResponse : public StateResponseProtoMessage {
 #endif
   float position{0.0f};
   enums::ValveOperation current_operation{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2888,7 +2888,7 @@ class ValveCommandRequest : public ProtoMessage {
   bool has_position{false};
   float position{0.0f};
   bool stop{false};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2905,7 +2905,7 @@ class ListEntitiesDateTimeResponse : public InfoResponseProtoMessage {
 #ifdef HAS_PROTO_MESSAGE_DUMP
   static constexpr const char *message_name() { return "list_entities_date_time_response"; }
 #endif
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2925,7 +2925,7 @@ class DateTimeStateResponse : public StateResponseProtoMessage {
 #endif
   bool missing_state{false};
   uint32_t epoch_seconds{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2944,7 +2944,7 @@ class DateTimeCommandRequest : public ProtoMessage {
 #endif
   uint32_t key{0};
   uint32_t epoch_seconds{0};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2961,7 +2961,7 @@ class ListEntitiesUpdateResponse : public InfoResponseProtoMessage {
   static constexpr const char *message_name() { return "list_entities_update_response"; }
 #endif
   std::string device_class{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -2988,7 +2988,7 @@ class UpdateStateResponse : public StateResponseProtoMessage {
   std::string title{};
   std::string release_summary{};
   std::string release_url{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -3008,7 +3008,7 @@ class UpdateCommandRequest : public ProtoMessage {
 #endif
   uint32_t key{0};
   enums::UpdateCommand command{};
-  void encode(ProtoWriteBuffer buffer) const override;
+  void encode(ProtoWriteBuffer &buffer) const override;
   void calculate_size(uint32_t &total_size) const override;
 #ifdef HAS_PROTO_MESSAGE_DUMP
   void dump_to(std::string &out) const override;
@@ -293,6 +293,19 @@ class ProtoSize {
     total_size += field_id_size + varint(str_size) + str_size;
   }
 
+  /**
+   * @brief Calculates and adds the size of a string/bytes field held as a StringRef
+   */
+  static inline void add_string_field(uint32_t &total_size, uint32_t field_id_size, const StringRef &str,
+                                      bool force = false) {
+    if (str.empty() && !force) {
+      return;
+    }
+
+    const uint32_t str_size = static_cast<uint32_t>(str.size());
+    total_size += field_id_size + varint(str_size) + str_size;
+  }
+
   /**
    * @brief Calculates and adds the size of a nested message field to the total message size
    *
@@ -328,6 +341,8 @@ class ProtoSize {
                                         bool force = false) {
     uint32_t nested_size = 0;
     message.calculate_size(nested_size);
+    // Remembered for ProtoWriteBuffer::encode_message(), which writes the length prefix from it
+    message.set_cached_size(nested_size);
 
     // Use the base implementation with the calculated nested_size
     add_message_field(total_size, field_id_size, nested_size, force);
@@ -32,7 +32,7 @@ APIServer::APIServer() {
 
 void APIServer::setup() {
   ESP_LOGCONFIG(TAG, "Running setup");
-  this->setup_controller();
+  this->setup_controller(false, /* coalesce_updates= */ true);
 
 #ifdef USE_API_NOISE
   uint32_t hash = 88491486UL;
@@ -138,6 +138,12 @@ void APIServer::loop() {
     }
   }
 
+  // Queue the entities that changed since the last loop, so clients send them in this one
+  this->process_entity_updates_();
+
+  // With more than one client, state messages are encoded once and copied into the frames of the others
+  this->encoded_state_cache_active_ = this->clients_.size() > 1;
+
   // Process clients and remove disconnected ones in a single pass
   if (!this->clients_.empty()) {
     size_t client_index = 0;
@@ -148,6 +154,7 @@ void APIServer::loop() {
         // Handle disconnection
         this->client_disconnected_trigger_->trigger(client->client_info_, client->client_peername_);
         ESP_LOGV(TAG, "Removing connection to %s", client->client_info_.c_str());
+        client->log_tx_stats_();
 
         // Swap with the last element and pop (avoids expensive vector shifts)
         if (client_index < this->clients_.size() - 1) {
@@ -162,6 +169,11 @@ void APIServer::loop() {
       }
     }
   }
+  if (this->encoded_state_cache_active_) {
+    // States will have changed by the next loop
+    this->encoded_state_cache_.clear();
+    this->encoded_state_cache_active_ = false;
+  }
 
   if (this->reboot_timeout_ != 0) {
     const uint32_t now = millis();
@@ -181,8 +193,9 @@ void APIServer::loop() {
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG,
                 "API Server:\n"
-                "  Address: %s:%u",
-                network::get_use_address().c_str(), this->port_);
+                "  Address: %s:%u\n"
+                "  TX buffer size: %u bytes",
+                network::get_use_address().c_str(), this->port_, this->tx_buffer_size_);
 #ifdef USE_API_NOISE
   ESP_LOGCONFIG(TAG, "  Using noise encryption: %s", YESNO(this->noise_ctx_->has_psk()));
   if (!this->noise_ctx_->has_psk()) {
@@ -195,12 +208,12 @@ void APIServer::dump_config() {
 
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 
-bool APIServer::check_password(const std::string &password) const {
+bool APIServer::check_password(const StringRef &password) const {
   // depend only on input password length
   const char *a = this->password_.c_str();
   uint32_t len_a = this->password_.length();
   const char *b = password.c_str();
-  uint32_t len_b = password.length();
+  uint32_t len_b = password.size();
 
   // disable optimization with volatile
   volatile uint32_t length = len_b;
@@ -3,6 +3,7 @@
 #include "esphome/core/defines.h"
 #ifdef USE_API
 #include "api_noise_context.h"
+#include "encoded_state_cache.h"
 #include "api_pb2.h"
 #include "api_pb2_service.h"
 #include "esphome/components/socket/socket.h"
@@ -35,16 +36,26 @@ class APIServer : public Component, public Controller {
   void dump_config() override;
   void on_shutdown() override;
   bool teardown() override;
-  bool check_password(const std::string &password) const;
+  bool check_password(const StringRef &password) const;
   bool uses_password() const;
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
   void set_batch_delay(uint32_t batch_delay);
   uint32_t get_batch_delay() const { return batch_delay_; }
+  void set_tx_buffer_size(uint16_t tx_buffer_size) { this->tx_buffer_size_ = tx_buffer_size; }
+  uint16_t get_tx_buffer_size() const { return tx_buffer_size_; }
+  void set_tx_buffer_in_psram(bool tx_buffer_in_psram) { this->tx_buffer_in_psram_ = tx_buffer_in_psram; }
+  bool get_tx_buffer_in_psram() const { return tx_buffer_in_psram_; }
 
   // Get reference to shared buffer for API connections
   std::vector<uint8_t> &get_shared_buffer_ref() { return shared_write_buffer_; }
+  /// Payloads already encoded by another connection in this loop, or nullptr when there is nothing to share.
+  EncodedStateCache *get_encoded_state_cache() {
+    return this->encoded_state_cache_active_ ? &this->encoded_state_cache_ : nullptr;
+  }
+  /// Forget the cached payloads, called when entity states may have changed.
+  void invalidate_encoded_states() { this->encoded_state_cache_.clear(); }
 
 #ifdef USE_API_NOISE
   bool save_noise_psk(psk_t psk, bool make_active = true);
@@ -147,10 +158,14 @@ class APIServer : public Component, public Controller {
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
   uint32_t batch_delay_{100};
+  uint16_t tx_buffer_size_{4096};
+  bool tx_buffer_in_psram_{false};
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
   std::vector<uint8_t> shared_write_buffer_;  // Shared proto write buffer for all connections
+  EncodedStateCache encoded_state_cache_;
+  bool encoded_state_cache_active_{false};
   std::vector<HomeAssistantStateSubscription> state_subs_;
   std::vector<UserServiceDescriptor *> user_services_;
   Trigger<std::string, std::string> *client_connected_trigger_ = new Trigger<std::string, std::string>();
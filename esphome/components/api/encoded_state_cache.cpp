@@ -0,0 +1,67 @@
+#include "encoded_state_cache.h"
+#ifdef USE_API
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace api {
+
+uint32_t EncodedStateCache::slot_(const EntityBase *entity, uint16_t message_type) const {
+  return entity_message_hash(entity, message_type) & (this->index_.size() - 1);
+}
+
+EncodedStateCache::Payload EncodedStateCache::find(const EntityBase *entity, uint16_t message_type) const {
+  if (this->entries_.empty())
+    return {nullptr, 0};
+  const uint32_t mask = this->index_.size() - 1;
+  for (uint32_t slot = this->slot_(entity, message_type);; slot = (slot + 1) & mask) {
+    uint16_t i = this->index_[slot];
+    if (i == 0)
+      return {nullptr, 0};
+    const Entry &entry = this->entries_[i - 1];
+    if (entry.entity == entity && entry.message_type == message_type)
+      return {this->payloads_.data() + entry.offset, entry.size};
+  }
+}
+
+void EncodedStateCache::store(const EntityBase *entity, uint16_t message_type, const uint8_t *data, uint16_t size) {
+  // The index holds entry numbers as uint16_t; a pass never encodes anywhere near that many messages
+  if (this->entries_.size() >= UINT16_MAX - 1)
+    return;
+  // Keep the index at most 3/4 full
+  if ((this->entries_.size() + 1) * 4 > this->index_.size() * 3)
+    this->grow_index_();
+  const uint32_t mask = this->index_.size() - 1;
+  uint32_t slot = this->slot_(entity, message_type);
+  while (this->index_[slot] != 0)
+    slot = (slot + 1) & mask;
+  this->entries_.push_back({entity, static_cast<uint32_t>(this->payloads_.size()), message_type, size});
+  this->index_[slot] = this->entries_.size();
+  this->payloads_.insert(this->payloads_.end(), data, data + size);
+}
+
+void EncodedStateCache::grow_index_() {
+  size_t capacity = this->index_.empty() ? 32 : this->index_.size() * 2;
+  this->index_.assign(capacity, 0);
+  const uint32_t mask = capacity - 1;
+  for (uint16_t i = 0; i < this->entries_.size(); i++) {
+    const Entry &entry = this->entries_[i];
+    uint32_t slot = this->slot_(entry.entity, entry.message_type);
+    while (this->index_[slot] != 0)
+      slot = (slot + 1) & mask;
+    this->index_[slot] = i + 1;
+  }
+}
+
+void EncodedStateCache::clear() {
+  if (this->entries_.empty())
+    return;
+  // Keep the allocations, the next pass usually caches about as many payloads
+  this->entries_.clear();
+  this->payloads_.clear();
+  std::fill(this->index_.begin(), this->index_.end(), 0);
+}
+
+}  // namespace api
+}  // namespace esphome
+#endif
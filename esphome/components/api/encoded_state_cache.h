@@ -0,0 +1,62 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#ifdef USE_API
+#include "esphome/core/entity_base.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace api {
+
+/// Hash an entity and message type, the key of the open addressing tables of EncodedStateCache and the batches.
+inline uint32_t entity_message_hash(const EntityBase *entity, uint16_t message_type) {
+  // Entities are heap objects, so the lowest pointer bits carry no information
+  uint32_t hash = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(entity) >> 3) ^ (message_type * 0x9E3779B1u);
+  hash ^= hash >> 15;
+  hash *= 0x2C1B3C6Du;
+  hash ^= hash >> 12;
+  return hash;
+}
+
+/** Protobuf payloads encoded during one pass over the API connections, keyed by entity and message type.
+ *
+ * When several clients are subscribed, each of them sends the same state message for an entity. The first
+ * connection encodes the payload and stores it here, the others copy it and only add their own framing. The
+ * cache is only used inside APIServer::loop(). It is cleared at the end of the loop and after a connection handled
+ * a received message, as entity states may have changed by then.
+ */
+class EncodedStateCache {
+ public:
+  struct Payload {
+    const uint8_t *data;
+    uint16_t size;
+  };
+
+  /// Return the cached payload for \p entity and \p message_type, or a payload with data == nullptr.
+  Payload find(const EntityBase *entity, uint16_t message_type) const;
+  /// Store a copy of an encoded payload. Must not be called for a key that is already cached.
+  void store(const EntityBase *entity, uint16_t message_type, const uint8_t *data, uint16_t size);
+  void clear();
+
+ protected:
+  struct Entry {
+    const EntityBase *entity;
+    uint32_t offset;  ///< Offset of the payload in payloads_
+    uint16_t message_type;
+    uint16_t size;
+  };
+
+  uint32_t slot_(const EntityBase *entity, uint16_t message_type) const;
+  void grow_index_();
+
+  std::vector<Entry> entries_;
+  /// Open addressing table of entry index + 1, 0 marks a free slot. Its size is a power of two.
+  std::vector<uint16_t> index_;
+  std::vector<uint8_t> payloads_;
+};
+
+}  // namespace api
+}  // namespace esphome
+#endif
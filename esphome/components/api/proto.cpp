@@ -81,6 +81,14 @@ void ProtoMessage::decode(const uint8_t *buffer, size_t length) {
   }
 }
 
+bool ProtoWriteBuffer::verify(uint16_t message_type) const {
+  if (!this->overflow_ && this->pos_ == this->end_)
+    return true;
+  ESP_LOGE(TAG, "Message type %u does not match its calculated size (%s), dropping it", message_type,
+           this->overflow_ ? "overflow" : "short");
+  return false;
+}
+
 #ifdef HAS_PROTO_MESSAGE_DUMP
 std::string ProtoMessage::dump() const {
   std::string out;
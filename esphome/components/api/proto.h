@@ -3,7 +3,9 @@
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include "esphome/core/string_ref.h"
 
+#include <cstring>
 #include <vector>
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
@@ -137,6 +139,8 @@ class ProtoLengthDelimited {
  public:
   explicit ProtoLengthDelimited(const uint8_t *value, size_t length) : value_(value), length_(length) {}
   std::string as_string() const { return std::string(reinterpret_cast<const char *>(this->value_), this->length_); }
+  /// View of the field in the receive buffer, only valid as long as the buffer passed to decode() is
+  StringRef as_string_ref() const { return StringRef(this->value_, this->length_); }
   template<class C> C as_message() const {
     auto msg = C();
     msg.decode(this->value_, this->length_);
@@ -184,12 +188,43 @@ class Proto64Bit {
   const uint64_t value_;
 };
 
+/** Writes protobuf fields into a buffer that has already been sized for them.
+ *
+ * Encoding is done in two passes: calculate_size() computes the exact encoded size of a message, the caller grows
+ * the buffer by that amount, and encode() then writes through a raw pointer without any vector growth. Writes past
+ * the end of the buffer are dropped and flagged, verify() reports them (or a short write) before the frame is sent.
+ * Nested messages take their length prefix from the size recorded during the calculate_size() pass, so they are
+ * written in place and their fields are not walked again at every nesting level.
+ */
 class ProtoWriteBuffer {
  public:
-  ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
-  void write(uint8_t value) { this->buffer_->push_back(value); }
-  void encode_varint_raw(ProtoVarInt value) { value.encode(*this->buffer_); }
-  void encode_varint_raw(uint32_t value) { this->encode_varint_raw(ProtoVarInt(value)); }
+  /// Write into \p buffer starting at \p offset, up to the current end of the buffer.
+  ProtoWriteBuffer(std::vector<uint8_t> *buffer, size_t offset)
+      : buffer_(buffer), pos_(buffer->data() + offset), end_(buffer->data() + buffer->size()) {}
+  /// Wrap a fully encoded buffer, e.g. to hand it to the frame helper.
+  ProtoWriteBuffer(std::vector<uint8_t> *buffer) : ProtoWriteBuffer(buffer, buffer->size()) {}
+  void write(uint8_t value) {
+    if (this->pos_ == this->end_) {
+      this->overflow_ = true;
+      return;
+    }
+    *this->pos_++ = value;
+  }
+  void encode_varint_raw(uint32_t value) {
+    while (value > 0x7F) {
+      this->write(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    this->write(static_cast<uint8_t>(value));
+  }
+  void encode_varint_raw(ProtoVarInt value) { this->encode_varint_raw_64(value.as_uint64()); }
+  void encode_varint_raw_64(uint64_t value) {
+    while (value > 0x7F) {
+      this->write(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    this->write(static_cast<uint8_t>(value));
+  }
   /**
    * Encode a field key (tag/wire type combination).
    *
@@ -212,12 +247,19 @@ class ProtoWriteBuffer {
 
     this->encode_field_raw(field_id, 2);  // type 2: Length-delimited string
     this->encode_varint_raw(len);
-    auto *data = reinterpret_cast<const uint8_t *>(string);
-    this->buffer_->insert(this->buffer_->end(), data, data + len);
+    if (len > static_cast<size_t>(this->end_ - this->pos_)) {
+      this->overflow_ = true;
+      return;
+    }
+    std::memcpy(this->pos_, string, len);
+    this->pos_ += len;
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
     this->encode_string(field_id, value.data(), value.size(), force);
   }
+  void encode_string(uint32_t field_id, const StringRef &value, bool force = false) {
+    this->encode_string(field_id, value.c_str(), value.size(), force);
+  }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
   }
@@ -231,7 +273,7 @@ class ProtoWriteBuffer {
     if (value == 0 && !force)
       return;
     this->encode_field_raw(field_id, 0);  // type 0: Varint - uint64
-    this->encode_varint_raw(ProtoVarInt(value));
+    this->encode_varint_raw_64(value);
   }
   void encode_bool(uint32_t field_id, bool value, bool force = false) {
     if (!value && !force)
@@ -307,29 +349,37 @@ class ProtoWriteBuffer {
     this->encode_uint64(field_id, uvalue, force);
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
+    // Recorded by ProtoSize::add_message_object() during the size pass of the enclosing message
+    uint32_t nested_length = value.get_cached_size();
+    // Skip empty messages like ProtoSize::add_message_field() does, so the size pass stays exact
+    if (nested_length == 0 && !force)
+      return;
     this->encode_field_raw(field_id, 2);  // type 2: Length-delimited message
-    size_t begin = this->buffer_->size();
-
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
+  /// Position the next byte will be written to.
+  uint8_t *get_pos() const { return pos_; }
+  /// Whether encoding filled the buffer exactly. Logs an error naming \p message_type if it did not.
+  bool verify(uint16_t message_type) const;
 
  protected:
   std::vector<uint8_t> *buffer_;
+  uint8_t *pos_;
+  uint8_t *end_;
+  bool overflow_{false};
 };
 
 class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
-  virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  virtual void encode(ProtoWriteBuffer &buffer) const = 0;
   void decode(const uint8_t *buffer, size_t length);
   virtual void calculate_size(uint32_t &total_size) const = 0;
+  /// Size of this message as a nested field, recorded by the last size pass over the enclosing message.
+  uint32_t get_cached_size() const { return this->cached_size_; }
+  void set_cached_size(uint32_t size) const { this->cached_size_ = size; }
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
   virtual void dump_to(std::string &out) const = 0;
@@ -340,6 +390,8 @@ class ProtoMessage {
   virtual bool decode_length(uint32_t field_id, ProtoLengthDelimited value) { return false; }
   virtual bool decode_32bit(uint32_t field_id, Proto32Bit value) { return false; }
   virtual bool decode_64bit(uint32_t field_id, Proto64Bit value) { return false; }
+
+  mutable uint32_t cached_size_{0};
 };
 
 template<typename T> const char *proto_enum_to_string(T value);
@@ -353,26 +405,27 @@ class ProtoService {
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
   /**
-   * Create a buffer with a reserved size.
-   * @param reserve_size The number of bytes to pre-allocate in the buffer. This is a hint
-   *                     to optimize memory usage and avoid reallocations during encoding.
-   *                     Implementations should aim to allocate at least this size.
-   * @return A ProtoWriteBuffer object with the reserved size.
+   * Create a buffer for a single message.
+   * @param payload_size The exact encoded size of the message, as returned by calculate_size().
+   *                     Encoding stops at the end of the buffer, so an underestimate drops the message.
+   * @return A ProtoWriteBuffer positioned at the start of the payload.
    */
-  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
+  virtual ProtoWriteBuffer create_buffer(uint32_t payload_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint16_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
-  // Optimized method that pre-allocates buffer based on message size
+  // Size the buffer exactly from calculate_size(), then encode into it
   bool send_message_(const ProtoMessage &msg, uint16_t message_type) {
     uint32_t msg_size = 0;
     msg.calculate_size(msg_size);
 
-    // Create a pre-sized buffer
+    // Create a buffer sized for exactly this message
     auto buffer = this->create_buffer(msg_size);
 
     // Encode message into the buffer
     msg.encode(buffer);
+    if (!buffer.verify(message_type))
+      return false;
 
     // Send the buffer
     return this->send_buffer(buffer, message_type);
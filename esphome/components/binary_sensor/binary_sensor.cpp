@@ -1,4 +1,5 @@
 #include "binary_sensor.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -39,6 +40,7 @@ void BinarySensor::send_state_internal(bool state, bool is_initial) {
   this->state = state;
   if (!is_initial || this->publish_initial_state_) {
     this->state_callback_.call(state);
+    ControllerRegistry::notify_update(CONTROLLER_DOMAIN_BINARY_SENSOR, this);
   }
 }
 
@@ -9,6 +9,13 @@ namespace binary_sensor {
 
 static const char *const TAG = "sensor.filter";
 
+// Scheduler ids of the filter timeouts
+static constexpr uint32_t ON_OFF_ID = fnv1_hash("ON_OFF");
+static constexpr uint32_t ON_ID = fnv1_hash("ON");
+static constexpr uint32_t OFF_ID = fnv1_hash("OFF");
+static constexpr uint32_t TIMING_ID = fnv1_hash("TIMING");
+static constexpr uint32_t SETTLE_ID = fnv1_hash("SETTLE");
+
 void Filter::output(bool value, bool is_initial) {
   if (!this->dedup_.next(value))
     return;
@@ -28,9 +35,9 @@ void Filter::input(bool value, bool is_initial) {
 
 optional<bool> DelayedOnOffFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON_OFF", this->on_delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
+    this->set_timeout(ON_OFF_ID, this->on_delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
   } else {
-    this->set_timeout("ON_OFF", this->off_delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
+    this->set_timeout(ON_OFF_ID, this->off_delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
   }
   return {};
 }
@@ -39,10 +46,10 @@ float DelayedOnOffFilter::get_setup_priority() const { return setup_priority::HA
 
 optional<bool> DelayedOnFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON", this->delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
+    this->set_timeout(ON_ID, this->delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
     return {};
   } else {
-    this->cancel_timeout("ON");
+    this->cancel_timeout(ON_ID);
     return false;
   }
 }
@@ -51,10 +58,10 @@ float DelayedOnFilter::get_setup_priority() const { return setup_priority::HARDW
 
 optional<bool> DelayedOffFilter::new_value(bool value, bool is_initial) {
   if (!value) {
-    this->set_timeout("OFF", this->delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
+    this->set_timeout(OFF_ID, this->delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
     return {};
   } else {
-    this->cancel_timeout("OFF");
+    this->cancel_timeout(OFF_ID);
     return true;
   }
 }
@@ -74,8 +81,8 @@ optional<bool> AutorepeatFilter::new_value(bool value, bool is_initial) {
     this->next_timing_();
     return true;
   } else {
-    this->cancel_timeout("TIMING");
-    this->cancel_timeout("ON_OFF");
+    this->cancel_timeout(TIMING_ID);
+    this->cancel_timeout(ON_OFF_ID);
     this->active_timing_ = 0;
     return false;
   }
@@ -87,7 +94,7 @@ void AutorepeatFilter::next_timing_() {
   // 2nd time: starts waiting the second delay and starts toggling with the first time_off / _on
   // last time: no delay to start but have to bump the index to reflect the last
   if (this->active_timing_ < this->timings_.size())
-    this->set_timeout("TIMING", this->timings_[this->active_timing_].delay, [this]() { this->next_timing_(); });
+    this->set_timeout(TIMING_ID, this->timings_[this->active_timing_].delay, [this]() { this->next_timing_(); });
 
   if (this->active_timing_ <= this->timings_.size()) {
     this->active_timing_++;
@@ -102,7 +109,7 @@ void AutorepeatFilter::next_timing_() {
 void AutorepeatFilter::next_value_(bool val) {
   const AutorepeatFilterTiming &timing = this->timings_[this->active_timing_ - 2];
   this->output(val, false);  // This is at least the second one so not initial
-  this->set_timeout("ON_OFF", val ? timing.time_on : timing.time_off, [this, val]() { this->next_value_(!val); });
+  this->set_timeout(ON_OFF_ID, val ? timing.time_on : timing.time_off, [this, val]() { this->next_value_(!val); });
 }
 
 float AutorepeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
@@ -113,7 +120,7 @@ optional<bool> LambdaFilter::new_value(bool value, bool is_initial) { return thi
 
 optional<bool> SettleFilter::new_value(bool value, bool is_initial) {
   if (!this->steady_) {
-    this->set_timeout("SETTLE", this->delay_.value(), [this, value, is_initial]() {
+    this->set_timeout(SETTLE_ID, this->delay_.value(), [this, value, is_initial]() {
       this->steady_ = true;
       this->output(value, is_initial);
     });
@@ -121,7 +128,7 @@ optional<bool> SettleFilter::new_value(bool value, bool is_initial) {
   } else {
     this->steady_ = false;
     this->output(value, is_initial);
-    this->set_timeout("SETTLE", this->delay_.value(), [this]() { this->steady_ = true; });
+    this->set_timeout(SETTLE_ID, this->delay_.value(), [this]() { this->steady_ = true; });
     return value;
   }
 }
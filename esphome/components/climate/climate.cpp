@@ -1,4 +1,5 @@
 #include "climate.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/macros.h"
 
 namespace esphome {
@@ -433,6 +434,7 @@ void Climate::publish_state() {
 
   // Send state to frontend
   this->state_callback_.call(*this);
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_CLIMATE, this);
   // Save state
   this->save_state_();
 }
@@ -1,4 +1,5 @@
 #include "cover.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -186,6 +187,7 @@ void Cover::publish_state(bool save) {
   ESP_LOGD(TAG, "  Current Operation: %s", cover_operation_to_str(this->current_operation));
 
   this->state_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_COVER, this);
 
   if (save) {
     CoverRestoreState restore{};
@@ -2,6 +2,7 @@
 
 #ifdef USE_DATETIME_DATE
 
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -32,6 +33,7 @@ void DateEntity::publish_state() {
   this->set_has_state(true);
   ESP_LOGD(TAG, "'%s': Sending date %d-%d-%d", this->get_name().c_str(), this->year_, this->month_, this->day_);
   this->state_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_DATE, this);
 }
 
 DateCall DateEntity::make_call() { return DateCall(this); }
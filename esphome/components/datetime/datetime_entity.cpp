@@ -2,6 +2,7 @@
 
 #ifdef USE_DATETIME_DATETIME
 
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -48,6 +49,7 @@ void DateTimeEntity::publish_state() {
   ESP_LOGD(TAG, "'%s': Sending datetime %04u-%02u-%02u %02d:%02d:%02d", this->get_name().c_str(), this->year_,
            this->month_, this->day_, this->hour_, this->minute_, this->second_);
   this->state_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_DATETIME, this);
 }
 
 DateTimeCall DateTimeEntity::make_call() { return DateTimeCall(this); }
@@ -2,6 +2,7 @@
 
 #ifdef USE_DATETIME_TIME
 
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -29,6 +30,7 @@ void TimeEntity::publish_state() {
   ESP_LOGD(TAG, "'%s': Sending time %02d:%02d:%02d", this->get_name().c_str(), this->hour_, this->minute_,
            this->second_);
   this->state_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_TIME, this);
 }
 
 TimeCall TimeEntity::make_call() { return TimeCall(this); }
@@ -1,3 +1,4 @@
+from esphome import automation
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.const import (
@@ -13,8 +14,22 @@ CODEOWNERS = ["@OttoWinter"]
 DEPENDENCIES = ["logger"]
 
 CONF_DEBUG_ID = "debug_id"
+CONF_LOG_INTERVAL = "log_interval"
+CONF_MAX_ENTRIES = "max_entries"
+CONF_PROFILE = "profile"
+CONF_RESET = "reset"
 debug_ns = cg.esphome_ns.namespace("debug")
 DebugComponent = debug_ns.class_("DebugComponent", cg.PollingComponent)
+ComponentProfiler = debug_ns.class_("ComponentProfiler")
+DumpProfileAction = debug_ns.class_("DumpProfileAction", automation.Action)
+
+PROFILE_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ComponentProfiler),
+        cv.Optional(CONF_MAX_ENTRIES, default=32): cv.int_range(min=1, max=1024),
+        cv.Optional(CONF_LOG_INTERVAL): cv.positive_time_period_milliseconds,
+    }
+)
 
 
 CONFIG_SCHEMA = cv.All(
@@ -36,6 +51,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_LOOP_TIME): cv.invalid(
                 "The 'loop_time' option has been moved to the 'debug' sensor component"
             ),
+            cv.Optional(CONF_PROFILE): PROFILE_SCHEMA,
         }
     ).extend(cv.polling_component_schema("60s")),
 )
@@ -44,3 +60,30 @@ CONFIG_SCHEMA = cv.All(
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
+
+    if profile_conf := config.get(CONF_PROFILE):
+        cg.add_define("USE_DEBUG_PROFILE")
+        profiler = cg.new_Pvariable(
+            profile_conf[CONF_ID], profile_conf[CONF_MAX_ENTRIES]
+        )
+        cg.add(var.set_profiler(profiler))
+        if log_interval := profile_conf.get(CONF_LOG_INTERVAL):
+            cg.add(var.set_profile_log_interval(log_interval))
+
+
+@automation.register_action(
+    "debug.dump_profile",
+    DumpProfileAction,
+    automation.maybe_simple_id(
+        {
+            cv.GenerateID(): cv.use_id(ComponentProfiler),
+            cv.Optional(CONF_RESET, default=False): cv.boolean,
+        }
+    ),
+)
+async def debug_dump_profile_to_code(config, action_id, template_arg, args):
+    profiler = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, profiler)
+    if config[CONF_RESET]:
+        cg.add(var.set_reset(True))
+    return var
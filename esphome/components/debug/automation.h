@@ -0,0 +1,32 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/defines.h"
+#include "profiler.h"
+
+#ifdef USE_DEBUG_PROFILE
+
+namespace esphome {
+namespace debug {
+
+template<typename... Ts> class DumpProfileAction : public Action<Ts...> {
+ public:
+  explicit DumpProfileAction(ComponentProfiler *profiler) : profiler_(profiler) {}
+
+  void set_reset(bool reset) { this->reset_ = reset; }
+
+  void play(Ts... x) override {
+    this->profiler_->dump();
+    if (this->reset_)
+      this->profiler_->reset();
+  }
+
+ protected:
+  ComponentProfiler *profiler_;
+  bool reset_{false};
+};
+
+}  // namespace debug
+}  // namespace esphome
+
+#endif  // USE_DEBUG_PROFILE
@@ -14,6 +14,14 @@ namespace debug {
 
 static const char *const TAG = "debug";
 
+void DebugComponent::setup() {
+#ifdef USE_DEBUG_PROFILE
+  if (this->profiler_ != nullptr && this->profile_log_interval_ != 0) {
+    this->set_interval("profile", this->profile_log_interval_, [this]() { this->profiler_->dump(); });
+  }
+#endif  // USE_DEBUG_PROFILE
+}
+
 void DebugComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Debug component:");
 #ifdef USE_TEXT_SENSOR
@@ -26,7 +34,19 @@ void DebugComponent::dump_config() {
 #if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   LOG_SENSOR("  ", "Heap fragmentation", this->fragmentation_sensor_);
 #endif  // defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
+#ifdef USE_DEBUG_PROFILE
+  LOG_SENSOR("  ", "Loop busy", this->loop_busy_sensor_);
+#endif  // USE_DEBUG_PROFILE
 #endif  // USE_SENSOR
+#ifdef USE_DEBUG_PROFILE
+  ESP_LOGCONFIG(TAG, "  Profiling: enabled");
+  if (this->profile_log_interval_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Profile log interval: %" PRIu32 " ms", this->profile_log_interval_);
+  }
+#ifdef USE_TEXT_SENSOR
+  LOG_TEXT_SENSOR("  ", "Slowest component", this->slowest_component_sensor_);
+#endif  // USE_TEXT_SENSOR
+#endif  // USE_DEBUG_PROFILE
 
   std::string device_info;
   device_info.reserve(256);
@@ -89,6 +109,20 @@ void DebugComponent::update() {
   }
 
 #endif  // USE_SENSOR
+#ifdef USE_DEBUG_PROFILE
+  if (this->profiler_ != nullptr) {
+    const ComponentProfiler::Entry *slowest = nullptr;
+    float busy = this->profiler_->end_period(&slowest);
+#ifdef USE_SENSOR
+    if (this->loop_busy_sensor_ != nullptr)
+      this->loop_busy_sensor_->publish_state(busy);
+#endif  // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+    if (this->slowest_component_sensor_ != nullptr && slowest != nullptr)
+      this->slowest_component_sensor_->publish_state(ComponentProfiler::entry_name(*slowest));
+#endif  // USE_TEXT_SENSOR
+  }
+#endif  // USE_DEBUG_PROFILE
   update_platform_();
 }
 
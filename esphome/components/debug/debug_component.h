@@ -11,6 +11,9 @@
 #ifdef USE_TEXT_SENSOR
 #include "esphome/components/text_sensor/text_sensor.h"
 #endif
+#ifdef USE_DEBUG_PROFILE
+#include "profiler.h"
+#endif
 
 namespace esphome {
 namespace debug {
@@ -25,6 +28,11 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   void set_device_info_sensor(text_sensor::TextSensor *device_info) { device_info_ = device_info; }
   void set_reset_reason_sensor(text_sensor::TextSensor *reset_reason) { reset_reason_ = reset_reason; }
+#ifdef USE_DEBUG_PROFILE
+  void set_slowest_component_sensor(text_sensor::TextSensor *slowest_component) {
+    this->slowest_component_sensor_ = slowest_component;
+  }
+#endif  // USE_DEBUG_PROFILE
 #endif  // USE_TEXT_SENSOR
 #ifdef USE_SENSOR
   void set_free_sensor(sensor::Sensor *free_sensor) { free_sensor_ = free_sensor; }
@@ -39,7 +47,15 @@ class DebugComponent : public PollingComponent {
   void set_cpu_frequency_sensor(sensor::Sensor *cpu_frequency_sensor) {
     this->cpu_frequency_sensor_ = cpu_frequency_sensor;
   }
+#ifdef USE_DEBUG_PROFILE
+  void set_loop_busy_sensor(sensor::Sensor *loop_busy_sensor) { this->loop_busy_sensor_ = loop_busy_sensor; }
+#endif  // USE_DEBUG_PROFILE
 #endif  // USE_SENSOR
+#ifdef USE_DEBUG_PROFILE
+  void set_profiler(ComponentProfiler *profiler) { this->profiler_ = profiler; }
+  void set_profile_log_interval(uint32_t log_interval) { this->profile_log_interval_ = log_interval; }
+#endif  // USE_DEBUG_PROFILE
+  void setup() override;
 #ifdef USE_ESP32
   void on_shutdown() override;
 #endif  // USE_ESP32
@@ -60,8 +76,16 @@ class DebugComponent : public PollingComponent {
   sensor::Sensor *psram_sensor_{nullptr};
 #endif  // USE_ESP32
   sensor::Sensor *cpu_frequency_sensor_{nullptr};
+#ifdef USE_DEBUG_PROFILE
+  sensor::Sensor *loop_busy_sensor_{nullptr};
+#endif  // USE_DEBUG_PROFILE
 #endif  // USE_SENSOR
 
+#ifdef USE_DEBUG_PROFILE
+  ComponentProfiler *profiler_{nullptr};
+  uint32_t profile_log_interval_{0};
+#endif  // USE_DEBUG_PROFILE
+
 #ifdef USE_ESP32
   /**
    * @brief Logs information about the device's partition table.
@@ -79,6 +103,9 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   text_sensor::TextSensor *device_info_{nullptr};
   text_sensor::TextSensor *reset_reason_{nullptr};
+#ifdef USE_DEBUG_PROFILE
+  text_sensor::TextSensor *slowest_component_sensor_{nullptr};
+#endif  // USE_DEBUG_PROFILE
 #endif  // USE_TEXT_SENSOR
 
   std::string get_reset_reason_();
@@ -0,0 +1,152 @@
+#include "profiler.h"
+
+#ifdef USE_DEBUG_PROFILE
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace debug {
+
+static const char *const TAG = "debug.profile";
+
+ComponentProfiler::ComponentProfiler(uint16_t max_entries) : max_entries_(max_entries) {
+  // Keep the index at most half full so probe sequences stay short
+  size_t slots = 1;
+  while (slots < static_cast<size_t>(max_entries) * 2)
+    slots <<= 1;
+  this->entries_.reserve(max_entries);
+  this->slots_.assign(slots, EMPTY_SLOT);
+  this->period_start_us_ = micros();
+  global_runtime_profiler = this;
+}
+
+uint32_t ComponentProfiler::Entry::p99_us() const {
+  uint32_t total = 0;
+  for (uint16_t bucket : this->histogram)
+    total += bucket;
+  // Number of samples allowed above the percentile
+  uint32_t tail = total / 100;
+  uint32_t seen = 0;
+  for (int8_t i = HISTOGRAM_BUCKETS - 1; i >= 0; i--) {
+    seen += this->histogram[i];
+    if (seen > tail) {
+      // Bucket i holds samples in [2^i, 2^(i+1)) us
+      uint32_t upper = i == HISTOGRAM_BUCKETS - 1 ? this->max_us : (1UL << (i + 1)) - 1;
+      return std::min(upper, this->max_us);
+    }
+  }
+  return 0;
+}
+
+ComponentProfiler::Entry *ComponentProfiler::find_or_insert_(Component *component, const char *kind, uint32_t id) {
+  const size_t mask = this->slots_.size() - 1;
+  size_t slot = (reinterpret_cast<uintptr_t>(component) >> 2) ^ id ^ (reinterpret_cast<uintptr_t>(kind) >> 1);
+  slot = (slot * 2654435761UL) & mask;
+  while (true) {
+    uint16_t index = this->slots_[slot];
+    if (index == EMPTY_SLOT) {
+      if (this->entries_.size() >= this->max_entries_)
+        return nullptr;
+      this->slots_[slot] = this->entries_.size();
+      Entry entry{};
+      entry.component = component;
+      entry.kind = kind;
+      entry.id = id;
+      this->entries_.push_back(entry);
+      return &this->entries_.back();
+    }
+    Entry &entry = this->entries_[index];
+    if (entry.component == component && entry.id == id && entry.kind == kind)
+      return &entry;
+    slot = (slot + 1) & mask;
+  }
+}
+
+void ComponentProfiler::record(Component *component, const char *kind, uint32_t id, uint32_t duration_us) {
+  this->period_total_us_ += duration_us;
+  Entry *entry = this->find_or_insert_(component, kind, id);
+  if (entry == nullptr) {
+    this->dropped_++;
+    return;
+  }
+  entry->count++;
+  entry->total_us += duration_us;
+  entry->period_us += duration_us;
+  entry->max_us = std::max(entry->max_us, duration_us);
+
+  uint8_t bucket = duration_us == 0 ? 0 : 31 - __builtin_clz(duration_us);
+  bucket = std::min<uint8_t>(bucket, HISTOGRAM_BUCKETS - 1);
+  if (entry->histogram[bucket] == UINT16_MAX) {
+    // Halve all buckets to make room; this keeps the shape of the distribution
+    for (uint16_t &b : entry->histogram)
+      b >>= 1;
+  }
+  entry->histogram[bucket]++;
+}
+
+std::string ComponentProfiler::entry_name(const Entry &entry) {
+  const char *source = entry.component != nullptr ? entry.component->get_component_source() : "<null>";
+  if (strcmp(entry.kind, "loop") == 0)
+    return source;
+  char buf[32];
+  snprintf(buf, sizeof(buf), "/%s 0x%08" PRIX32, entry.kind, entry.id);
+  return std::string(source) + buf;
+}
+
+void ComponentProfiler::dump() const {
+  // Sort indices rather than entries so the hash index stays valid
+  std::vector<uint16_t> order(this->entries_.size());
+  for (uint16_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [this](uint16_t a, uint16_t b) {
+    return this->entries_[a].total_us > this->entries_[b].total_us;
+  });
+
+  ESP_LOGI(TAG, "Profile (%zu sources, %" PRIu32 " samples dropped):", this->entries_.size(), this->dropped_);
+  ESP_LOGI(TAG, "  %-40s %10s %10s %8s %8s %8s", "Source", "Calls", "Total ms", "Avg us", "Max us", "P99 us");
+  for (uint16_t i : order) {
+    const Entry &entry = this->entries_[i];
+    uint32_t avg_us = entry.count == 0 ? 0 : entry.total_us / entry.count;
+    ESP_LOGI(TAG, "  %-40s %10" PRIu32 " %10" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32,
+             entry_name(entry).c_str(), entry.count, static_cast<uint32_t>(entry.total_us / 1000), avg_us,
+             entry.max_us, entry.p99_us());
+  }
+}
+
+void ComponentProfiler::reset() {
+  this->entries_.clear();
+  std::fill(this->slots_.begin(), this->slots_.end(), EMPTY_SLOT);
+  this->dropped_ = 0;
+  this->period_total_us_ = 0;
+  this->period_start_us_ = micros();
+}
+
+float ComponentProfiler::end_period(const Entry **slowest) {
+  const uint32_t now = micros();
+  const uint32_t elapsed = now - this->period_start_us_;
+  float busy = elapsed == 0 ? 0.0f : 100.0f * this->period_total_us_ / elapsed;
+
+  const Entry *max_entry = nullptr;
+  for (Entry &entry : this->entries_) {
+    if (entry.period_us != 0 && (max_entry == nullptr || entry.period_us > max_entry->period_us))
+      max_entry = &entry;
+  }
+  if (slowest != nullptr)
+    *slowest = max_entry;
+  for (Entry &entry : this->entries_)
+    entry.period_us = 0;
+
+  this->period_total_us_ = 0;
+  this->period_start_us_ = now;
+  return std::min(busy, 100.0f);
+}
+
+}  // namespace debug
+}  // namespace esphome
+
+#endif  // USE_DEBUG_PROFILE
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#include "esphome/core/profiler.h"
+
+#ifdef USE_DEBUG_PROFILE
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace debug {
+
+/** Accumulates how long each component's loop() and each scheduler callback runs.
+ *
+ * Registers itself as the global RuntimeProfiler. Samples are reported by WarnIfComponentBlockingGuard, which
+ * already wraps every loop() and scheduler call, so enabling the profiler costs two micros() calls, a virtual call
+ * and a table lookup per call. The table has a fixed number of entries allocated once at startup; sources that
+ * don't fit are counted as dropped.
+ */
+class ComponentProfiler : public RuntimeProfiler {
+ public:
+  /// Number of log2 histogram buckets used to estimate the 99th percentile, the last one covers >= 2^17 us.
+  static constexpr uint8_t HISTOGRAM_BUCKETS = 18;
+
+  struct Entry {
+    Component *component;
+    const char *kind;  ///< "loop", "timeout" or "interval"
+    uint32_t id;       ///< Scheduler id for timeouts/intervals, 0 for loop()
+    uint32_t count;
+    uint64_t total_us;
+    uint32_t max_us;
+    uint32_t period_us;  ///< Time spent since the last end_period()
+    uint16_t histogram[HISTOGRAM_BUCKETS];
+
+    /// Upper bound of the histogram bucket containing the 99th percentile, capped at max_us.
+    uint32_t p99_us() const;
+  };
+
+  explicit ComponentProfiler(uint16_t max_entries);
+
+  /// Record one call of \p duration_us. Must only be called from the main loop.
+  void record(Component *component, const char *kind, uint32_t id, uint32_t duration_us) override;
+
+  /// Log all entries, sorted by total time spent.
+  void dump() const;
+  /// Clear all entries and counters.
+  void reset();
+
+  /// Finish the current measurement period and return the share of wall time spent in profiled calls, in percent.
+  /// If \p slowest is not null, it receives the entry with the most time spent during the period (or nullptr).
+  float end_period(const Entry **slowest);
+
+  /// Human readable name of an entry, e.g. "api" or "sensor/interval 0x1A2B3C4D".
+  static std::string entry_name(const Entry &entry);
+
+ protected:
+  Entry *find_or_insert_(Component *component, const char *kind, uint32_t id);
+
+  std::vector<Entry> entries_;
+  /// Open addressing index into entries_, keyed by component and id. Power of two size, EMPTY_SLOT if unused.
+  std::vector<uint16_t> slots_;
+  static constexpr uint16_t EMPTY_SLOT = 0xFFFF;
+  uint16_t max_entries_;
+  uint32_t dropped_{0};
+  uint32_t period_start_us_{0};
+  uint64_t period_total_us_{0};
+};
+
+}  // namespace debug
+}  // namespace esphome
+
+#endif  // USE_DEBUG_PROFILE
@@ -15,11 +15,13 @@ from esphome.const import (
     UNIT_MILLISECOND,
     UNIT_PERCENT,
 )
+import esphome.final_validate as fv
 
-from . import CONF_DEBUG_ID, DebugComponent
+from . import CONF_DEBUG_ID, CONF_PROFILE, DebugComponent
 
 DEPENDENCIES = ["debug"]
 
+CONF_LOOP_BUSY = "loop_busy"
 CONF_PSRAM = "psram"
 
 CONFIG_SCHEMA = {
@@ -62,6 +64,12 @@ CONFIG_SCHEMA = {
             entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
         ),
     ),
+    cv.Optional(CONF_LOOP_BUSY): sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        icon=ICON_TIMER,
+        accuracy_decimals=1,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
     cv.Optional(CONF_CPU_FREQUENCY): cv.All(
         sensor.sensor_schema(
             unit_of_measurement=UNIT_HERTZ,
@@ -73,6 +81,17 @@ CONFIG_SCHEMA = {
 }
 
 
+def _final_validate(config):
+    if CONF_LOOP_BUSY in config and CONF_PROFILE not in fv.full_config.get()["debug"]:
+        raise cv.Invalid(
+            f"'{CONF_LOOP_BUSY}' requires 'profile:' in the debug component"
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     debug_component = await cg.get_variable(config[CONF_DEBUG_ID])
 
@@ -96,6 +115,10 @@ async def to_code(config):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
 
+    if loop_busy_conf := config.get(CONF_LOOP_BUSY):
+        sens = await sensor.new_sensor(loop_busy_conf)
+        cg.add(debug_component.set_loop_busy_sensor(sens))
+
     if cpu_freq_conf := config.get(CONF_CPU_FREQUENCY):
         sens = await sensor.new_sensor(cpu_freq_conf)
         cg.add(debug_component.set_cpu_frequency_sensor(sens))
@@ -6,14 +6,17 @@ from esphome.const import (
     ENTITY_CATEGORY_DIAGNOSTIC,
     ICON_CHIP,
     ICON_RESTART,
+    ICON_TIMER,
 )
+import esphome.final_validate as fv
 
-from . import CONF_DEBUG_ID, DebugComponent
+from . import CONF_DEBUG_ID, CONF_PROFILE, DebugComponent
 
 DEPENDENCIES = ["debug"]
 
 
 CONF_RESET_REASON = "reset_reason"
+CONF_SLOWEST_COMPONENT = "slowest_component"
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -25,10 +28,28 @@ CONFIG_SCHEMA = cv.Schema(
             icon=ICON_RESTART,
             entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
         ),
+        cv.Optional(CONF_SLOWEST_COMPONENT): text_sensor.text_sensor_schema(
+            icon=ICON_TIMER,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
     }
 )
 
 
+def _final_validate(config):
+    if (
+        CONF_SLOWEST_COMPONENT in config
+        and CONF_PROFILE not in fv.full_config.get()["debug"]
+    ):
+        raise cv.Invalid(
+            f"'{CONF_SLOWEST_COMPONENT}' requires 'profile:' in the debug component"
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     debug_component = await cg.get_variable(config[CONF_DEBUG_ID])
 
@@ -38,3 +59,6 @@ async def to_code(config):
     if CONF_RESET_REASON in config:
         sens = await text_sensor.new_text_sensor(config[CONF_RESET_REASON])
         cg.add(debug_component.set_reset_reason_sensor(sens))
+    if CONF_SLOWEST_COMPONENT in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_SLOWEST_COMPONENT])
+        cg.add(debug_component.set_slowest_component_sensor(sens))
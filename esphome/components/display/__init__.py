@@ -13,7 +13,7 @@ from esphome.const import (
     CONF_TO,
     CONF_TRIGGER_ID,
 )
-from esphome.core import coroutine_with_priority
+from esphome.core import CORE, coroutine_with_priority
 
 IS_PLATFORM_COMPONENT = True
 
@@ -39,6 +39,8 @@ DisplayOnPageChangeTrigger = display_ns.class_(
 
 CONF_ON_PAGE_CHANGE = "on_page_change"
 CONF_SHOW_TEST_CARD = "show_test_card"
+CONF_SKIP_UNCHANGED = "skip_unchanged"
+CONF_DOUBLE_BUFFER = "double_buffer"
 CONF_UNSPECIFIED = "unspecified"
 
 DISPLAY_ROTATIONS = {
@@ -130,6 +132,14 @@ async def setup_display_core_(var, config):
         )
     if config.get(CONF_SHOW_TEST_CARD):
         cg.add(var.show_test_card())
+    # Only offered by DisplayBuffer drivers that flush the dirty region
+    if config.get(CONF_SKIP_UNCHANGED):
+        cg.add(var.set_skip_unchanged(True))
+    if config.get(CONF_DOUBLE_BUFFER):
+        cg.add(var.set_double_buffer(True))
+        if CORE.is_esp32:
+            # DisplayBuffer drivers send frames from a FreeRTOS task
+            cg.add_define("USE_DISPLAY_DOUBLE_BUFFER")
 
 
 async def register_display(var, config):
@@ -0,0 +1,74 @@
+#include "dirty_region.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace esphome {
+namespace display {
+
+/// Sending a separate rectangle costs about as much bus time as this many pixels, so merging is preferred when it
+/// adds fewer unchanged pixels than that.
+static const int32_t MERGE_SLACK = 64;
+
+static inline int32_t area(const Rect &rect) { return int32_t(rect.w) * rect.h; }
+
+static inline Rect bounding_box(const Rect &a, const Rect &b) {
+  int16_t x1 = std::min(a.x, b.x);
+  int16_t y1 = std::min(a.y, b.y);
+  return Rect(x1, y1, std::max(a.x2(), b.x2()) - x1, std::max(a.y2(), b.y2()) - y1);
+}
+
+/// Number of pixels that merging \p a and \p b adds on top of both, negative if they overlap.
+static inline int32_t merge_cost(const Rect &a, const Rect &b) {
+  return area(bounding_box(a, b)) - area(a) - area(b);
+}
+
+void DirtyRegion::add(int x, int y, int width, int height) {
+  Rect rect(x, y, width, height);
+  if (this->count_ != 0) {
+    const Rect &last = this->rects_[this->last_];
+    if (rect.x >= last.x && rect.y >= last.y && rect.x2() <= last.x2() && rect.y2() <= last.y2())
+      return;
+  }
+  uint8_t best = 0;
+  int32_t best_cost = INT32_MAX;
+  for (uint8_t i = 0; i != this->count_; i++) {
+    int32_t cost = merge_cost(this->rects_[i], rect);
+    if (cost < best_cost) {
+      best = i;
+      best_cost = cost;
+    }
+  }
+  if (best_cost > MERGE_SLACK && this->count_ != MAX_RECTS) {
+    this->last_ = this->count_;
+    this->rects_[this->count_++] = rect;
+    return;
+  }
+  this->rects_[best] = bounding_box(this->rects_[best], rect);
+  this->coalesce_(best);
+}
+
+void DirtyRegion::coalesce_(uint8_t index) {
+  for (uint8_t i = 0; i != this->count_;) {
+    if (i == index || merge_cost(this->rects_[index], this->rects_[i]) > MERGE_SLACK) {
+      i++;
+      continue;
+    }
+    this->rects_[index] = bounding_box(this->rects_[index], this->rects_[i]);
+    this->remove_(i);
+    // the last entry was moved into slot i
+    if (index == this->count_)
+      index = i;
+    // the grown rectangle may now reach entries that were already checked
+    i = 0;
+  }
+  this->last_ = index;
+}
+
+void DirtyRegion::remove_(uint8_t index) {
+  this->count_--;
+  this->rects_[index] = this->rects_[this->count_];
+}
+
+}  // namespace display
+}  // namespace esphome
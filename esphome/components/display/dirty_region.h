@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include "rect.h"
+
+namespace esphome {
+namespace display {
+
+/** The parts of a framebuffer that changed since it was last sent to the display, as a short list of rectangles.
+ *
+ * A rectangle is merged with an entry as it is added if their bounding box holds few pixels that neither covers,
+ * e.g. when they line up along an edge or one contains the other. Rectangles that merely cross stay separate,
+ * as merging a long row with a long column would send their whole bounding box. Once the list is full, a new
+ * rectangle is merged with the entry whose bounding box grows least, so the region always covers every change but
+ * may include some unchanged pixels. Coordinates are absolute (unrotated) display coordinates.
+ */
+class DirtyRegion {
+ public:
+  static constexpr uint8_t MAX_RECTS = 8;
+
+  /// Add the rectangle at x, y with the given (positive) width and height.
+  void add(int x, int y, int width, int height);
+  void clear() { this->count_ = 0; }
+
+  bool empty() const { return this->count_ == 0; }
+  uint8_t size() const { return this->count_; }
+  const Rect *begin() const { return this->rects_; }
+  const Rect *end() const { return this->rects_ + this->count_; }
+
+ protected:
+  /// Merge entry \p index with any other entry it now overlaps.
+  void coalesce_(uint8_t index);
+  void remove_(uint8_t index);
+
+  Rect rects_[MAX_RECTS];
+  uint8_t count_{0};
+  /// The entry that grew last, which is where the next pixel of a line or glyph most likely lands.
+  uint8_t last_{0};
+};
+
+}  // namespace display
+}  // namespace esphome
@@ -258,6 +258,17 @@ class Display : public PollingComponent {
     this->draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, 0, 0, 0);
   }
 
+  /** Fill \p width pixels starting at [x,y] to the right with the given color.
+   * The naive implementation here draws pixel by pixel, sub-classes can override it to handle the whole span at once.
+   */
+  virtual void fill_span(int x, int y, int width, Color color);
+
+  /** Fill a rectangle with the top left point at [x,y] with the given color.
+   * The naive implementation here draws one span per row, sub-classes can override it to handle the whole rectangle
+   * at once.
+   */
+  virtual void fill_rect(int x, int y, int width, int height, Color color);
+
   /// Draw a straight line from the point [x1,y1] to [x2,y2] with the given color.
   void line(int x1, int y1, int x2, int y2, Color color = COLOR_ON);
 
@@ -603,6 +614,18 @@ class Display : public PollingComponent {
 
   DisplayRotation get_rotation() const { return this->rotation_; }
 
+  /** Frame fences. Drivers that support them number each frame sent by update() and report when all of it is on the
+   * panel, which with double buffering happens in the background after update() returned. Frame 0 always counts as
+   * presented.
+   */
+  uint32_t get_submitted_frame() const { return this->submitted_frame_; }
+  uint32_t get_presented_frame() const { return this->presented_frame_; }
+  bool is_frame_presented(uint32_t frame) const { return int32_t(this->presented_frame_ - frame) >= 0; }
+  /// Called from the main loop with the number of each frame once it has been presented.
+  void add_on_frame_presented_callback(std::function<void(uint32_t)> &&callback) {
+    this->frame_presented_callback_.add(std::move(callback));
+  }
+
   /** Get the type of display that the buffer corresponds to. In case of dynamically configurable displays,
    * returns the type the display is currently configured to.
    */
@@ -661,12 +684,31 @@ class Display : public PollingComponent {
  protected:
   bool clamp_x_(int x, int w, int &min_x, int &max_x);
   bool clamp_y_(int y, int h, int &min_y, int &max_y);
+
+  /// Read the raw value of pixel \p index from a buffer in the format used by draw_pixels_at().
+  static inline uint32_t read_pixel_(const uint8_t *ptr, size_t index, ColorBitness bitness, bool big_endian) {
+    switch (bitness) {
+      default:
+        return ptr[index];
+      case COLOR_BITNESS_565:
+        ptr += index * 2;
+        return big_endian ? (ptr[0] << 8) + ptr[1] : ptr[0] + (ptr[1] << 8);
+      case COLOR_BITNESS_888:
+        ptr += index * 3;
+        return big_endian ? (ptr[0] << 16) + (ptr[1] << 8) + ptr[2] : ptr[0] + (ptr[1] << 8) + (ptr[2] << 16);
+    }
+  }
   void vprintf_(int x, int y, BaseFont *font, Color color, Color background, TextAlign align, const char *format,
                 va_list arg);
 
   void do_update_();
   void clear_clipping_();
 
+  /// Number a new frame, which is passed to frame_presented_() once it is on the panel.
+  uint32_t submit_frame_() { return ++this->submitted_frame_; }
+  /// Must be called from the main loop.
+  void frame_presented_(uint32_t frame);
+
   virtual int get_height_internal() = 0;
   virtual int get_width_internal() = 0;
 
@@ -685,8 +727,13 @@ class Display : public PollingComponent {
   DisplayPage *previous_page_{nullptr};
   std::vector<DisplayOnPageChangeTrigger *> on_page_change_triggers_;
   bool auto_clear_enabled_{true};
+  /// Set while do_update_() runs the writer, so drivers can tell frame drawing from direct writes such as LVGL's.
+  bool in_update_{false};
   std::vector<Rect> clipping_rectangle_;
   bool show_test_card_{false};
+  uint32_t submitted_frame_{0};
+  uint32_t presented_frame_{0};
+  CallbackManager<void(uint32_t)> frame_presented_callback_;
 };
 
 class DisplayPage {
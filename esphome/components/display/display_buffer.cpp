@@ -1,5 +1,8 @@
 #include "display_buffer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 #include <utility>
 
 #include "esphome/core/application.h"
@@ -17,9 +20,202 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
     ESP_LOGE(TAG, "Could not allocate buffer for display!");
     return;
   }
+  this->buffer_length_ = buffer_length;
   this->clear();
 }
 
+bool DisplayBuffer::flush_dirty_() {
+#ifdef USE_DISPLAY_DOUBLE_BUFFER
+  if (this->double_buffer_)
+    return this->flush_in_background_();
+#endif
+  if (this->skip_unchanged_)
+    this->drop_unchanged_rows_();
+  uint32_t frame = this->submit_frame_();
+  bool sent = !this->dirty_region_.empty();
+  if (sent) {
+    this->flush_region_internal(this->buffer_, this->dirty_region_);
+    this->dirty_region_.clear();
+  }
+  this->frame_presented_(frame);
+  return sent;
+}
+
+void DisplayBuffer::flush_region_internal(const uint8_t *buffer, const DirtyRegion &region) {
+  for (const Rect &rect : region)
+    this->flush_rect_internal(buffer, rect.x, rect.y, rect.w, rect.h);
+}
+
+#ifdef USE_DISPLAY_DOUBLE_BUFFER
+void DisplayBuffer::wait_for_flush_() {
+  if (this->flush_idle_ == nullptr || this->in_flush_task_())
+    return;
+  xSemaphoreTake(this->flush_idle_, portMAX_DELAY);
+  xSemaphoreGive(this->flush_idle_);
+}
+
+bool DisplayBuffer::in_flush_task_() const {
+  return this->flush_task_handle_ != nullptr && xTaskGetCurrentTaskHandle() == this->flush_task_handle_;
+}
+
+bool DisplayBuffer::is_double_buffered_() const { return this->double_buffer_; }
+
+void DisplayBuffer::loop() {
+  this->report_flushed_frame_();
+  this->disable_loop();
+}
+
+void DisplayBuffer::report_flushed_frame_() {
+  uint32_t frame = this->flushed_frame_.load();
+  if (int32_t(frame - this->presented_frame_) > 0)
+    this->frame_presented_(frame);
+}
+
+bool DisplayBuffer::start_flush_task_() {
+  if (this->buffer_ == nullptr || this->get_height_internal() <= 0)
+    return false;
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  this->front_buffer_ = allocator.allocate(this->buffer_length_);
+  if (this->front_buffer_ != nullptr) {
+    memcpy(this->front_buffer_, this->buffer_, this->buffer_length_);
+    this->flush_idle_ = xSemaphoreCreateBinary();
+  }
+  if (this->flush_idle_ != nullptr) {
+    xSemaphoreGive(this->flush_idle_);
+    xTaskCreate(DisplayBuffer::flush_task, "display_flush", FLUSH_TASK_STACK_SIZE, (void *) this,
+                FLUSH_TASK_PRIORITY, &this->flush_task_handle_);
+  }
+  if (this->flush_task_handle_ != nullptr)
+    return true;
+
+  ESP_LOGE(TAG, "Could not start double buffering, sending frames from the main loop");
+  if (this->flush_idle_ != nullptr) {
+    vSemaphoreDelete(this->flush_idle_);
+    this->flush_idle_ = nullptr;
+  }
+  if (this->front_buffer_ != nullptr) {
+    allocator.deallocate(this->front_buffer_, this->buffer_length_);
+    this->front_buffer_ = nullptr;
+  }
+  return false;
+}
+
+bool DisplayBuffer::flush_in_background_() {
+  if (this->flush_task_handle_ == nullptr && !this->start_flush_task_()) {
+    this->double_buffer_ = false;
+    return this->flush_dirty_();
+  }
+  // The previous frame has to be on the panel before its buffer can be drawn into again
+  this->wait_for_flush_();
+  this->report_flushed_frame_();
+  if (this->skip_unchanged_)
+    this->drop_unchanged_rows_();
+  uint32_t frame = this->submit_frame_();
+  if (this->dirty_region_.empty()) {
+    this->frame_presented_(frame);
+    return false;
+  }
+
+  std::swap(this->buffer_, this->front_buffer_);
+  // The new back buffer still holds the previous frame, which differs from this one only in the dirty rows
+  const size_t row_bytes = this->buffer_length_ / this->get_height_internal();
+  for (const Rect &rect : this->dirty_region_)
+    memcpy(this->buffer_ + rect.y * row_bytes, this->front_buffer_ + rect.y * row_bytes, rect.h * row_bytes);
+
+  xSemaphoreTake(this->flush_idle_, portMAX_DELAY);
+  this->flush_region_ = this->dirty_region_;
+  this->flush_frame_ = frame;
+  this->dirty_region_.clear();
+  xTaskNotifyGive(this->flush_task_handle_);
+  return true;
+}
+
+void DisplayBuffer::flush_task(void *params) {
+  auto *display = static_cast<DisplayBuffer *>(params);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    display->flush_region_internal(display->front_buffer_, display->flush_region_);
+    display->flushed_frame_.store(display->flush_frame_);
+    xSemaphoreGive(display->flush_idle_);
+    display->enable_loop_soon_any_context();
+  }
+}
+#else
+void DisplayBuffer::wait_for_flush_() {}
+bool DisplayBuffer::in_flush_task_() const { return false; }
+bool DisplayBuffer::is_double_buffered_() const { return false; }
+#endif
+
+enum BandState : uint8_t { BAND_UNKNOWN, BAND_CHANGED, BAND_UNCHANGED };
+
+// Multiply and shift, so that a change in any bit of a word reaches all bits of the hash. A collision only costs
+// a missed refresh of one band until it changes again.
+static uint32_t hash_band(const uint8_t *data, size_t length) {
+  uint32_t hash = 0x811C9DC5UL;
+  size_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    uint32_t word;
+    memcpy(&word, data + i, 4);
+    hash = (hash ^ word) * 0x9E3779B1UL;
+    hash ^= hash >> 15;
+  }
+  for (; i != length; i++) {
+    hash = (hash ^ data[i]) * 0x9E3779B1UL;
+    hash ^= hash >> 15;
+  }
+  return hash;
+}
+
+void DisplayBuffer::drop_unchanged_rows_() {
+  const int height = this->get_height_internal();
+  if (this->buffer_ == nullptr || height <= 0 || this->dirty_region_.empty())
+    return;
+  const size_t bands = (height + BAND_ROWS - 1) / BAND_ROWS;
+  const size_t band_bytes = this->buffer_length_ * BAND_ROWS / height;
+  if (this->band_hashes_.size() != bands)
+    this->band_hashes_.assign(bands, 0);
+  this->band_states_.assign(bands, BAND_UNKNOWN);
+
+  // Only bands touched by the dirty region can have changed, so the others are never hashed
+  auto changed = [&](size_t band) {
+    if (this->band_states_[band] == BAND_UNKNOWN) {
+      size_t offset = band * band_bytes;
+      uint32_t hash = hash_band(this->buffer_ + offset, std::min(band_bytes, this->buffer_length_ - offset));
+      this->band_states_[band] = hash == this->band_hashes_[band] ? BAND_UNCHANGED : BAND_CHANGED;
+      this->band_hashes_[band] = hash;
+    }
+    return this->band_states_[band] == BAND_CHANGED;
+  };
+
+  DirtyRegion trimmed;
+  for (const Rect &rect : this->dirty_region_) {
+    int first = rect.y / BAND_ROWS;
+    int last = (rect.y2() - 1) / BAND_ROWS;
+    // hash every band of the rectangle so that the stored hashes stay current
+    bool any = false;
+    for (int band = first; band <= last; band++)
+      any |= changed(band);
+    if (!any)
+      continue;
+    while (!changed(first))
+      first++;
+    while (!changed(last))
+      last--;
+    int y1 = std::max<int>(rect.y, first * BAND_ROWS);
+    int y2 = std::min<int>(rect.y2(), (last + 1) * BAND_ROWS);
+    trimmed.add(rect.x, y1, rect.w, y2 - y1);
+  }
+  this->dirty_region_ = trimmed;
+}
+
+void DisplayBuffer::feed_wdt_(uint32_t pixels) {
+  this->pixels_since_wdt_feed_ += pixels;
+  if (this->pixels_since_wdt_feed_ >= WDT_FEED_PIXELS) {
+    App.feed_wdt();
+    this->pixels_since_wdt_feed_ = 0;
+  }
+}
+
 int DisplayBuffer::get_width() {
   switch (this->rotation_) {
     case DISPLAY_ROTATION_90_DEGREES:
@@ -65,7 +261,103 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
       break;
   }
   this->draw_absolute_pixel_internal(x, y, color);
-  App.feed_wdt();
+  this->feed_wdt_(1);
+}
+
+void HOT DisplayBuffer::fill_span(int x, int y, int width, Color color) { this->fill_rect(x, y, width, 1, color); }
+
+void HOT DisplayBuffer::fill_rect(int x, int y, int width, int height, Color color) {
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x, width, x1, x2) || !this->clamp_y_(y, height, y1, y2))
+    return;
+
+  // Same mapping as in draw_pixel_at(), applied to the corners of the rectangle [x1, x2) x [y1, y2)
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      this->fill_rect_internal(x1, y1, x2 - x1, y2 - y1, color);
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      this->fill_rect_internal(this->get_width_internal() - y2, x1, y2 - y1, x2 - x1, color);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      this->fill_rect_internal(this->get_width_internal() - x2, this->get_height_internal() - y2, x2 - x1, y2 - y1,
+                               color);
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      this->fill_rect_internal(y1, this->get_height_internal() - x2, y2 - y1, x2 - x1, color);
+      break;
+  }
+  this->feed_wdt_((x2 - x1) * (y2 - y1));
+}
+
+void DisplayBuffer::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  for (int j = y; j != y + height; j++) {
+    for (int i = x; i != x + width; i++)
+      this->draw_absolute_pixel_internal(i, j, color);
+  }
+}
+
+void HOT DisplayBuffer::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                                       ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) {
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x_start, w, x1, x2) || !this->clamp_y_(y_start, h, y1, y2))
+    return;
+
+  // Position of pixel (x, y) on the display is origin + x * x_step + y * y_step, see draw_pixel_at()
+  const int max_x = this->get_width_internal() - 1;
+  const int max_y = this->get_height_internal() - 1;
+  int origin_x = 0, origin_y = 0, x_step_x = 1, x_step_y = 0, y_step_x = 0, y_step_y = 1;
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      origin_x = max_x;
+      x_step_x = 0;
+      x_step_y = 1;
+      y_step_x = -1;
+      y_step_y = 0;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      origin_x = max_x;
+      origin_y = max_y;
+      x_step_x = -1;
+      y_step_y = -1;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      origin_y = max_y;
+      x_step_x = 0;
+      x_step_y = -1;
+      y_step_x = 1;
+      y_step_y = 0;
+      break;
+  }
+
+  size_t line_stride = x_offset + w + x_pad;  // length of each source line in pixels
+  // Instantiated per bitness, so that the color conversion scales by constants instead of dividing per pixel
+  auto draw_rows = [&](auto bitness_constant) {
+    constexpr ColorBitness BITNESS = decltype(bitness_constant)::value;
+    for (int y = y1; y != y2; y++) {
+      size_t source_idx = (y_offset + y - y_start) * line_stride + x_offset + x1 - x_start;
+      int abs_x = origin_x + x1 * x_step_x + y * y_step_x;
+      int abs_y = origin_y + x1 * x_step_y + y * y_step_y;
+      for (int x = x1; x != x2; x++, source_idx++, abs_x += x_step_x, abs_y += x_step_y) {
+        uint32_t color_value = read_pixel_(ptr, source_idx, BITNESS, big_endian);
+        this->draw_absolute_pixel_internal(abs_x, abs_y, ColorUtil::to_color(color_value, order, BITNESS));
+      }
+    }
+  };
+  switch (bitness) {
+    case COLOR_BITNESS_888:
+      draw_rows(std::integral_constant<ColorBitness, COLOR_BITNESS_888>());
+      break;
+    case COLOR_BITNESS_565:
+      draw_rows(std::integral_constant<ColorBitness, COLOR_BITNESS_565>());
+      break;
+    case COLOR_BITNESS_332:
+      draw_rows(std::integral_constant<ColorBitness, COLOR_BITNESS_332>());
+      break;
+  }
+  this->feed_wdt_((x2 - x1) * (y2 - y1));
 }
 
 }  // namespace display
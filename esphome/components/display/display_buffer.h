@@ -3,12 +3,20 @@
 #include <cstdarg>
 #include <vector>
 
+#include "dirty_region.h"
 #include "display.h"
 #include "display_color_utils.h"
 
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 
+#ifdef USE_DISPLAY_DOUBLE_BUFFER
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 namespace display {
 
@@ -22,12 +30,108 @@ class DisplayBuffer : public Display {
   /// Set a single pixel at the specified coordinates to the given color.
   void draw_pixel_at(int x, int y, Color color) override;
 
+  /// Clipping and rotation are resolved once for the whole span or rectangle, see fill_rect_internal().
+  void fill_span(int x, int y, int width, Color color) override;
+  void fill_rect(int x, int y, int width, int height, Color color) override;
+
+  /// Clipping and rotation are resolved once for the whole block, then each pixel is drawn with
+  /// draw_absolute_pixel_internal().
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                      ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
+
+  /** Before flushing, compare each band of rows with its content at the last flush and leave out the bands that
+   * are unchanged. This lets pages that are redrawn from scratch on each update (e.g. with auto clear) send only
+   * what actually differs, and nothing at all if the page looks the same as before.
+   */
+  void set_skip_unchanged(bool skip_unchanged) { this->skip_unchanged_ = skip_unchanged; }
+
+#ifdef USE_DISPLAY_DOUBLE_BUFFER
+  /** Allocate a second framebuffer. update() then draws into one while a background task sends the other to the
+   * panel, and flush_dirty_() returns as soon as the frame is handed over. Needs a row major framebuffer, as the
+   * changed rows are copied from one buffer to the other.
+   */
+  void set_double_buffer(bool double_buffer) { this->double_buffer_ = double_buffer; }
+
+  /// Reports frames presented by the flush task, drivers that override loop() must call this.
+  void loop() override;
+#endif
+
  protected:
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /** Fill a rectangle given in absolute (unrotated) display coordinates.
+   * The rectangle has already been clipped, so it is never empty and lies entirely within the display.
+   * The default implementation calls draw_absolute_pixel_internal() for each pixel, drivers with a framebuffer
+   * should override this to write whole rows at once.
+   */
+  virtual void fill_rect_internal(int x, int y, int width, int height, Color color);
+
   void init_internal_(uint32_t buffer_length);
 
+  /// Record that a rectangle of the framebuffer changed, in absolute display coordinates. Drivers call this when a
+  /// write actually modifies the buffer.
+  void mark_dirty_(int x, int y, int width, int height) { this->dirty_region_.add(x, y, width, height); }
+  /** Send the changed parts of the framebuffer with flush_region_internal() and clear the dirty region. Each call
+   * submits a frame, see Display::get_submitted_frame().
+   * @return false if nothing needed to be sent.
+   */
+  bool flush_dirty_();
+  /** Send the rectangles of \p region from \p buffer to the display. This runs on the flush task when double
+   * buffering, so it must not use state that the main loop changes. The default calls flush_rect_internal() for
+   * each rectangle.
+   */
+  virtual void flush_region_internal(const uint8_t *buffer, const DirtyRegion &region);
+  /// Send a rectangle of \p buffer (absolute coordinates, within the display) to the display.
+  virtual void flush_rect_internal(const uint8_t *buffer, int x, int y, int width, int height) {}
+  /// Trim the dirty region to the bands of rows that changed since the last flush, see set_skip_unchanged().
+  void drop_unchanged_rows_();
+
+  /// Block until the flush task is idle. Drivers call this before using the bus from the main loop.
+  void wait_for_flush_();
+  /// Whether the caller runs on the flush task, which e.g. must not feed the watchdog of the main loop.
+  bool in_flush_task_() const;
+  /// Whether frames are drawn into a second buffer, in which case all drawing has to go through the buffer.
+  bool is_double_buffered_() const;
+
+  /// Feed the watchdog once every WDT_FEED_PIXELS pixels drawn rather than for every call, as reading the time isn't
+  /// free.
+  void feed_wdt_(uint32_t pixels);
+  static constexpr uint32_t WDT_FEED_PIXELS = 4096;
+
   uint8_t *buffer_{nullptr};
+  uint32_t buffer_length_{0};
+  uint32_t pixels_since_wdt_feed_{0};
+  DirtyRegion dirty_region_;
+  bool skip_unchanged_{false};
+  /// Rows per band compared by drop_unchanged_rows_(). Page oriented monochrome buffers keep 8 rows per byte, so
+  /// a band is always a contiguous range of the buffer.
+  static constexpr uint8_t BAND_ROWS = 8;
+  /// Hash of each band as of the last flush, allocated on first use.
+  std::vector<uint32_t> band_hashes_;
+  /// Scratch state of each band during drop_unchanged_rows_(), see BandState in display_buffer.cpp.
+  std::vector<uint8_t> band_states_;
+
+#ifdef USE_DISPLAY_DOUBLE_BUFFER
+  bool start_flush_task_();
+  bool flush_in_background_();
+  void report_flushed_frame_();
+  static void flush_task(void *params);
+
+  static constexpr uint32_t FLUSH_TASK_STACK_SIZE = 4096;
+  static constexpr UBaseType_t FLUSH_TASK_PRIORITY = 1;
+
+  bool double_buffer_{false};
+  /// The buffer being sent by the flush task, buffer_ is always the one drawn into.
+  uint8_t *front_buffer_{nullptr};
+  /// Rectangles of front_buffer_ to send, and the frame they belong to. Only changed while the task is idle.
+  DirtyRegion flush_region_;
+  uint32_t flush_frame_{0};
+  /// Last frame sent by the flush task.
+  std::atomic<uint32_t> flushed_frame_{0};
+  TaskHandle_t flush_task_handle_{nullptr};
+  /// Given while the flush task is idle.
+  SemaphoreHandle_t flush_idle_{nullptr};
+#endif
 };
 
 }  // namespace display
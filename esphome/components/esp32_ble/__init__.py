@@ -4,6 +4,7 @@ import re
 from esphome import automation
 import esphome.codegen as cg
 from esphome.components.esp32 import add_idf_sdkconfig_option, const, get_esp32_variant
+from esphome.components.socket import require_wake_loop_threadsafe
 import esphome.config_validation as cv
 from esphome.const import CONF_ENABLE_ON_BOOT, CONF_ESPHOME, CONF_ID, CONF_NAME
 from esphome.core import CORE
@@ -256,6 +257,7 @@ async def to_code(config):
                     add_idf_sdkconfig_option(f"{logger.value}_NONE", True)
 
     cg.add_define("USE_ESP32_BLE")
+    require_wake_loop_threadsafe()
 
 
 @automation.register_condition("ble.enabled", BLEEnabledCondition, cv.Schema({}))
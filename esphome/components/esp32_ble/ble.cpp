@@ -436,6 +436,10 @@ template<typename... Args> void enqueue_ble_event(Args... args) {
   // Push the event to the queue
   global_ble->ble_events_.push(event);
   // Push always succeeds because we're the only producer and the pool ensures we never exceed queue size
+#ifdef USE_WAKE_LOOP_THREADSAFE
+  // Called from the Bluetooth task; let the main loop process the event now instead of on its next tick
+  App.wake_loop_threadsafe();
+#endif
 }
 
 // Explicit template instantiations for the friend function
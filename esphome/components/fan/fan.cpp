@@ -1,4 +1,5 @@
 #include "fan.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -141,6 +142,7 @@ void Fan::publish_state() {
     ESP_LOGD(TAG, "  Preset Mode: %s", this->preset_mode.c_str());
   }
   this->state_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_FAN, this);
   this->save_state_();
 }
 
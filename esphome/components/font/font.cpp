@@ -52,6 +52,41 @@ Font::Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t
     glyphs_.emplace_back(&data[i]);
 }
 int Font::match_next_glyph(const uint8_t *str, int *match_length) {
+  // Decode the UTF-8 sequence at the start of str, only well formed characters of the basic multilingual plane are
+  // cached. Overlong encodings and surrogates would otherwise share a cache entry with a valid character.
+  uint32_t code_point = str[0];
+  int length = 1;
+  if (code_point >= 0xE0 && code_point < 0xF0) {
+    code_point &= 0x0F;
+    length = 3;
+  } else if (code_point >= 0xC0 && code_point < 0xE0) {
+    code_point &= 0x1F;
+    length = 2;
+  } else if (code_point == 0 || code_point >= 0x80) {
+    return this->search_glyph_(str, match_length);
+  }
+  for (int i = 1; i != length; i++) {
+    if ((str[i] & 0xC0) != 0x80)
+      return this->search_glyph_(str, match_length);
+    code_point = (code_point << 6) | (str[i] & 0x3F);
+  }
+  if ((length == 2 && code_point < 0x80) || (length == 3 && code_point < 0x800) ||
+      (code_point >= 0xD800 && code_point <= 0xDFFF))
+    return this->search_glyph_(str, match_length);
+
+  if (this->glyph_cache_.empty())
+    this->glyph_cache_.resize(GLYPH_CACHE_SIZE, GlyphCacheEntry{0, -1});
+  GlyphCacheEntry &entry = this->glyph_cache_[code_point % GLYPH_CACHE_SIZE];
+  if (entry.code_point != code_point) {
+    // Glyphs are single characters, so a match always covers the whole sequence
+    int found_length;
+    entry.code_point = code_point;
+    entry.glyph = this->search_glyph_(str, &found_length);
+  }
+  *match_length = entry.glyph < 0 ? 0 : length;
+  return entry.glyph;
+}
+int Font::search_glyph_(const uint8_t *str, int *match_length) {
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -103,7 +138,6 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
 void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text, Color background) {
   int i = 0;
   int x_at = x_start;
-  int scan_x1, scan_y1, scan_width, scan_height;
   while (text[i] != '\0') {
     int match_length;
     int glyph_n = this->match_next_glyph((const uint8_t *) text + i, &match_length);
@@ -121,49 +155,68 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
     }
 
     const Glyph &glyph = this->get_glyphs()[glyph_n];
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
+    this->draw_glyph_(x_at, y_start, display, glyph.glyph_data_, color, background);
+    x_at += glyph.glyph_data_->advance;
 
-    const uint8_t *data = glyph.glyph_data_->data;
-    const int max_x = x_at + scan_x1 + scan_width;
-    const int max_y = y_start + scan_y1 + scan_height;
+    i += match_length;
+  }
+}
+void Font::draw_glyph_(int x, int y, display::Display *display, const GlyphData *glyph, Color color,
+                       Color background) {
+  const uint8_t *data = glyph->data;
+  const int min_x = x + glyph->offset_x;
+  const int max_x = min_x + glyph->width;
+  const int min_y = y + glyph->offset_y;
+  const int max_y = min_y + glyph->height;
 
-    uint8_t bitmask = 0;
-    uint8_t pixel_data = 0;
-    uint8_t bpp_max = (1 << this->bpp_) - 1;
-    auto diff_r = (float) color.r - (float) background.r;
-    auto diff_g = (float) color.g - (float) background.g;
-    auto diff_b = (float) color.b - (float) background.b;
-    auto diff_w = (float) color.w - (float) background.w;
-    auto b_r = (float) background.r;
-    auto b_g = (float) background.g;
-    auto b_b = (float) background.b;
-    auto b_w = (float) background.w;
-    for (int glyph_y = y_start + scan_y1; glyph_y != max_y; glyph_y++) {
-      for (int glyph_x = x_at + scan_x1; glyph_x != max_x; glyph_x++) {
-        uint8_t pixel = 0;
-        for (int bit_num = 0; bit_num != this->bpp_; bit_num++) {
-          if (bitmask == 0) {
-            pixel_data = progmem_read_byte(data++);
-            bitmask = 0x80;
-          }
-          pixel <<= 1;
-          if ((pixel_data & bitmask) != 0)
-            pixel |= 1;
-          bitmask >>= 1;
-        }
-        if (pixel == bpp_max) {
-          display->draw_pixel_at(glyph_x, glyph_y, color);
-        } else if (pixel != 0) {
-          auto on = (float) pixel / (float) bpp_max;
-          auto blended = Color((uint8_t) (diff_r * on + b_r), (uint8_t) (diff_g * on + b_g),
-                               (uint8_t) (diff_b * on + b_b), (uint8_t) (diff_w * on + b_w));
-          display->draw_pixel_at(glyph_x, glyph_y, blended);
-        }
-      }
+  const uint8_t bpp = this->bpp_;
+  const uint8_t bpp_max = (1 << bpp) - 1;
+  auto diff_r = (float) color.r - (float) background.r;
+  auto diff_g = (float) color.g - (float) background.g;
+  auto diff_b = (float) color.b - (float) background.b;
+  auto diff_w = (float) color.w - (float) background.w;
+  auto b_r = (float) background.r;
+  auto b_g = (float) background.g;
+  auto b_b = (float) background.b;
+  auto b_w = (float) background.w;
+  // Draw a run of pixels with the same value, blending the color for partially covered pixels
+  auto draw_run = [&](int start, int end, int glyph_y, uint8_t pixel) {
+    if (pixel == 0)
+      return;
+    Color run_color = color;
+    if (pixel != bpp_max) {
+      auto on = (float) pixel / (float) bpp_max;
+      run_color = Color((uint8_t) (diff_r * on + b_r), (uint8_t) (diff_g * on + b_g), (uint8_t) (diff_b * on + b_b),
+                        (uint8_t) (diff_w * on + b_w));
     }
-    x_at += glyph.glyph_data_->advance;
+    if (end - start == 1) {
+      display->draw_pixel_at(start, glyph_y, run_color);
+    } else {
+      display->fill_span(start, glyph_y, end - start, run_color);
+    }
+  };
 
-    i += match_length;
+  // Rows are not padded, the pixels of the whole glyph form one bit stream. bpp is a power of two, so pixels never
+  // cross a byte boundary.
+  uint8_t pixel_data = 0;
+  int8_t shift = -1;
+  for (int glyph_y = min_y; glyph_y != max_y; glyph_y++) {
+    int run_start = min_x;
+    uint8_t run_pixel = 0;
+    for (int glyph_x = min_x; glyph_x != max_x; glyph_x++) {
+      if (shift < 0) {
+        pixel_data = progmem_read_byte(data++);
+        shift = 8 - bpp;
+      }
+      uint8_t pixel = (pixel_data >> shift) & bpp_max;
+      shift -= bpp;
+      if (pixel != run_pixel) {
+        draw_run(run_start, glyph_x, glyph_y, run_pixel);
+        run_start = glyph_x;
+        run_pixel = pixel;
+      }
+    }
+    draw_run(run_start, max_x, glyph_y, run_pixel);
   }
 }
 #endif
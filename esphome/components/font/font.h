@@ -56,6 +56,7 @@ class Font
    */
   Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp = 1);
 
+  /// Find the glyph for the character at the start of \p str, returns -1 if the font doesn't have it.
   int match_next_glyph(const uint8_t *str, int *match_length);
 
 #ifdef USE_DISPLAY
@@ -70,6 +71,22 @@ class Font
   const std::vector<Glyph, ExternalRAMAllocator<Glyph>> &get_glyphs() const { return glyphs_; }
 
  protected:
+  /// Look up \p str in the sorted glyph table.
+  int search_glyph_(const uint8_t *str, int *match_length);
+#ifdef USE_DISPLAY
+  /// Draw the glyph with its top left corner at [x,y], as one span for each run of pixels with the same value.
+  void draw_glyph_(int x, int y, display::Display *display, const GlyphData *glyph, Color color, Color background);
+#endif
+
+  /// Direct mapped cache of recent glyph lookups, indexed by the low bits of the code point. Covers ASCII without
+  /// collisions and is allocated on first use.
+  struct GlyphCacheEntry {
+    uint16_t code_point;  ///< 0 if the entry is unused
+    int16_t glyph;        ///< Index into glyphs_, -1 if the font has no glyph for the code point
+  };
+  static constexpr size_t GLYPH_CACHE_SIZE = 128;
+  std::vector<GlyphCacheEntry, ExternalRAMAllocator<GlyphCacheEntry>> glyph_cache_;
+
   std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
   int baseline_;
   int height_;
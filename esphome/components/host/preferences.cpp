@@ -1,9 +1,12 @@
 #ifdef USE_HOST
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
 #include <filesystem>
-#include <fstream>
 #include "preferences.h"
 #include "esphome/core/application.h"
+#include "esphome/core/log.h"
 
 namespace esphome {
 namespace host {
@@ -11,53 +14,261 @@ namespace fs = std::filesystem;
 
 static const char *const TAG = "host.preferences";
 
+/// Spread the key bits over the index (murmur3 finalizer).
+static inline uint32_t hash_key(uint32_t key) {
+  key ^= key >> 16;
+  key *= 0x85ebca6b;
+  key ^= key >> 13;
+  key *= 0xc2b2ae35;
+  key ^= key >> 16;
+  return key;
+}
+
 void HostPreferences::setup_() {
   if (this->setup_complete_)
     return;
-  this->filename_.append(getenv("HOME"));
-  this->filename_.append("/.esphome");
-  this->filename_.append("/prefs");
-  fs::create_directories(this->filename_);
-  this->filename_.append("/");
-  this->filename_.append(App.get_name());
-  this->filename_.append(".prefs");
+  if (this->filename_.empty()) {
+    this->filename_.append(getenv("HOME"));
+    this->filename_.append("/.esphome/prefs/");
+    this->filename_.append(App.get_name());
+    this->filename_.append(".prefs");
+  }
+  fs::create_directories(fs::path(this->filename_).parent_path());
   FILE *fp = fopen(this->filename_.c_str(), "rb");
   if (fp != nullptr) {
-    while (!feof((fp))) {
-      uint32_t key;
-      uint8_t len;
-      if (fread(&key, sizeof(key), 1, fp) != 1)
-        break;
-      if (fread(&len, sizeof(len), 1, fp) != 1)
-        break;
-      uint8_t data[len];
-      if (fread(data, sizeof(uint8_t), len, fp) != len)
-        break;
-      std::vector vec(data, data + len);
-      this->data[key] = vec;
-    }
+    std::vector<uint8_t> buf;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), fp)) != 0)
+      buf.insert(buf.end(), chunk, chunk + read);
     fclose(fp);
+    this->log_size_ = this->parse_log_(buf.data(), buf.size());
+    if (this->log_size_ != buf.size()) {
+      // An interrupted append left a partial record behind; cut it off so new records follow a complete one.
+      ESP_LOGW(TAG, "Dropping %zu bytes of incomplete record at the end of %s", buf.size() - this->log_size_,
+               this->filename_.c_str());
+      std::error_code ec;
+      fs::resize_file(this->filename_, this->log_size_, ec);
+      if (ec)
+        this->needs_compaction_ = true;
+    }
   }
   this->setup_complete_ = true;
 }
 
+size_t HostPreferences::parse_log_(const uint8_t *buf, size_t size) {
+  size_t pos = 0;
+  while (pos + RECORD_HEADER_SIZE <= size) {
+    uint32_t key;
+    memcpy(&key, buf + pos, sizeof(key));
+    uint8_t len = buf[pos + sizeof(key)];
+    if (pos + RECORD_HEADER_SIZE + len > size)
+      break;
+    this->store_(key, buf + pos + RECORD_HEADER_SIZE, len);
+    pos += RECORD_HEADER_SIZE + len;
+  }
+  return pos;
+}
+
+HostPreferences::Entry *HostPreferences::find_(uint32_t key) {
+  if (this->index_.empty())
+    return nullptr;
+  const uint32_t mask = this->index_.size() - 1;
+  for (uint32_t slot = hash_key(key) & mask;; slot = (slot + 1) & mask) {
+    uint32_t i = this->index_[slot];
+    if (i == 0)
+      return nullptr;
+    if (this->entries_[i - 1].key == key)
+      return &this->entries_[i - 1];
+  }
+}
+
+void HostPreferences::grow_index_() {
+  size_t capacity = this->index_.empty() ? 64 : this->index_.size() * 2;
+  this->index_.assign(capacity, 0);
+  const uint32_t mask = capacity - 1;
+  for (uint32_t i = 0; i < this->entries_.size(); i++) {
+    uint32_t slot = hash_key(this->entries_[i].key) & mask;
+    while (this->index_[slot] != 0)
+      slot = (slot + 1) & mask;
+    this->index_[slot] = i + 1;
+  }
+}
+
+HostPreferences::Entry *HostPreferences::store_(uint32_t key, const uint8_t *data, uint8_t len) {
+  Entry *entry = this->find_(key);
+  if (entry == nullptr) {
+    // Keep the index at most 3/4 full
+    if ((this->entries_.size() + 1) * 4 > this->index_.size() * 3)
+      this->grow_index_();
+    const uint32_t mask = this->index_.size() - 1;
+    uint32_t slot = hash_key(key) & mask;
+    while (this->index_[slot] != 0)
+      slot = (slot + 1) & mask;
+    this->entries_.push_back({key, static_cast<uint32_t>(this->values_.size()), len, false});
+    this->index_[slot] = this->entries_.size();
+    this->values_.resize(this->values_.size() + len);
+    this->live_size_ += RECORD_HEADER_SIZE + len;
+    entry = &this->entries_.back();
+  } else if (entry->len != len) {
+    // The old bytes stay unused in the arena until the next compaction.
+    this->live_size_ += len;
+    this->live_size_ -= entry->len;
+    entry->offset = this->values_.size();
+    entry->len = len;
+    this->values_.resize(this->values_.size() + len);
+  }
+  memcpy(this->values_.data() + entry->offset, data, len);
+  return entry;
+}
+
+bool HostPreferences::save(uint32_t key, const uint8_t *data, size_t len) {
+  if (len > 255)
+    return false;
+  this->setup_();
+  Entry *entry = this->find_(key);
+  if (entry != nullptr && entry->len == len && memcmp(this->values_.data() + entry->offset, data, len) == 0)
+    return true;
+  entry = this->store_(key, data, len);
+  if (!entry->dirty) {
+    entry->dirty = true;
+    this->dirty_.push_back(entry - this->entries_.data());
+  }
+  return true;
+}
+
+bool HostPreferences::load(uint32_t key, uint8_t *data, size_t len) {
+  if (len > 255)
+    return false;
+  this->setup_();
+  const Entry *entry = this->find_(key);
+  if (entry == nullptr || entry->len != len)
+    return false;
+  memcpy(data, this->values_.data() + entry->offset, len);
+  return true;
+}
+
 bool HostPreferences::sync() {
   this->setup_();
-  FILE *fp = fopen(this->filename_.c_str(), "wb");
-  std::map<uint32_t, std::vector<uint8_t>>::iterator it;
-
-  for (it = this->data.begin(); it != this->data.end(); ++it) {
-    fwrite(&it->first, sizeof(uint32_t), 1, fp);
-    uint8_t len = it->second.size();
-    fwrite(&len, sizeof(len), 1, fp);
-    fwrite(it->second.data(), sizeof(uint8_t), it->second.size(), fp);
+  size_t pending = 0;
+  for (uint32_t i : this->dirty_)
+    pending += RECORD_HEADER_SIZE + this->entries_[i].len;
+  if (!this->needs_compaction_ && this->log_size_ + pending >= COMPACT_MIN_SIZE &&
+      this->log_size_ + pending > this->live_size_ * 2)
+    this->needs_compaction_ = true;
+  if (this->needs_compaction_)
+    return this->compact_();
+  if (this->dirty_.empty())
+    return true;
+  return this->append_dirty_();
+}
+
+bool HostPreferences::append_dirty_() {
+  bool created = false;
+  if (this->log_ == nullptr) {
+    std::error_code ec;
+    created = !fs::exists(this->filename_, ec);
+    this->log_ = fopen(this->filename_.c_str(), "ab");
+    if (this->log_ == nullptr) {
+      ESP_LOGE(TAG, "Could not open %s: %s", this->filename_.c_str(), strerror(errno));
+      return false;
+    }
   }
-  fclose(fp);
+  std::vector<uint8_t> buf;
+  for (uint32_t i : this->dirty_) {
+    const Entry &entry = this->entries_[i];
+    const uint8_t *key = reinterpret_cast<const uint8_t *>(&entry.key);
+    buf.insert(buf.end(), key, key + sizeof(entry.key));
+    buf.push_back(entry.len);
+    buf.insert(buf.end(), this->values_.begin() + entry.offset, this->values_.begin() + entry.offset + entry.len);
+  }
+  if (fwrite(buf.data(), 1, buf.size(), this->log_) != buf.size() || fflush(this->log_) != 0 ||
+      fsync(fileno(this->log_)) != 0) {
+    ESP_LOGE(TAG, "Writing %s failed: %s", this->filename_.c_str(), strerror(errno));
+    // The log may now end in a partial record, rewrite it on the next sync.
+    this->close_log_();
+    this->needs_compaction_ = true;
+    return false;
+  }
+  // A new file is only found after a crash once its directory entry is on disk too.
+  if (created)
+    this->sync_directory_();
+  this->log_size_ += buf.size();
+  this->clear_dirty_();
   return true;
 }
 
+bool HostPreferences::compact_() {
+  std::string tmp_name = this->filename_ + ".tmp";
+  FILE *fp = fopen(tmp_name.c_str(), "wb");
+  if (fp == nullptr) {
+    ESP_LOGE(TAG, "Could not open %s: %s", tmp_name.c_str(), strerror(errno));
+    return false;
+  }
+  // Write the records in entry order and pack the arena the same way, dropping replaced values.
+  std::vector<uint8_t> values;
+  values.reserve(this->live_size_);
+  std::vector<uint8_t> buf;
+  buf.reserve(this->live_size_);
+  for (Entry &entry : this->entries_) {
+    const uint8_t *key = reinterpret_cast<const uint8_t *>(&entry.key);
+    const uint8_t *value = this->values_.data() + entry.offset;
+    buf.insert(buf.end(), key, key + sizeof(entry.key));
+    buf.push_back(entry.len);
+    buf.insert(buf.end(), value, value + entry.len);
+    entry.offset = values.size();
+    values.insert(values.end(), value, value + entry.len);
+  }
+  this->values_.swap(values);
+  // After a reset there is nothing to write, and buf.data() may be null.
+  bool ok = (buf.empty() || fwrite(buf.data(), 1, buf.size(), fp) == buf.size()) && fflush(fp) == 0 &&
+            fsync(fileno(fp)) == 0;
+  ok = fclose(fp) == 0 && ok;
+  // The append handle would keep writing to the replaced file.
+  this->close_log_();
+  if (!ok || rename(tmp_name.c_str(), this->filename_.c_str()) != 0) {
+    ESP_LOGE(TAG, "Writing %s failed: %s", tmp_name.c_str(), strerror(errno));
+    remove(tmp_name.c_str());
+    return false;
+  }
+  // Make the rename itself durable.
+  this->sync_directory_();
+  this->log_size_ = buf.size();
+  this->needs_compaction_ = false;
+  this->clear_dirty_();
+  return true;
+}
+
+void HostPreferences::sync_directory_() {
+  int dir = open(fs::path(this->filename_).parent_path().c_str(), O_RDONLY);
+  if (dir >= 0) {
+    fsync(dir);
+    close(dir);
+  }
+}
+
+void HostPreferences::clear_dirty_() {
+  for (uint32_t i : this->dirty_)
+    this->entries_[i].dirty = false;
+  this->dirty_.clear();
+}
+
+void HostPreferences::close_log_() {
+  if (this->log_ != nullptr) {
+    fclose(this->log_);
+    this->log_ = nullptr;
+  }
+}
+
 bool HostPreferences::reset() {
-  host_preferences->data.clear();
+  // Load first, or the next setup_() would bring the stored values back.
+  this->setup_();
+  this->entries_.clear();
+  this->index_.clear();
+  this->values_.clear();
+  this->dirty_.clear();
+  this->live_size_ = 0;
+  this->needs_compaction_ = true;
   return true;
 }
 
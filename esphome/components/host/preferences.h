@@ -3,7 +3,9 @@
 #ifdef USE_HOST
 
 #include "esphome/core/preferences.h"
-#include <map>
+#include <cstdio>
+#include <string>
+#include <vector>
 
 namespace esphome {
 namespace host {
@@ -19,8 +21,19 @@ class HostPreferenceBackend : public ESPPreferenceBackend {
   uint32_t key_{};
 };
 
+/** Preferences stored in ~/.esphome/prefs/<name>.prefs.
+ *
+ * The file is a log of `key (uint32) | length (uint8) | data` records; when a key appears more than once the
+ * last record wins. sync() only appends the records changed since the previous sync and fsyncs them. Once the
+ * log holds mostly superseded records it is compacted into a temporary file, which atomically replaces the log.
+ * A record cut short by a crash is dropped on the next start.
+ *
+ * In memory, values live back to back in one arena and are found through an open addressing index.
+ */
 class HostPreferences : public ESPPreferences {
  public:
+  ~HostPreferences() { this->close_log_(); }
+
   bool sync() override;
   bool reset() override;
 
@@ -29,33 +42,54 @@ class HostPreferences : public ESPPreferences {
     return make_preference(length, type, false);
   }
 
-  bool save(uint32_t key, const uint8_t *data, size_t len) {
-    if (len > 255)
-      return false;
-    this->setup_();
-    std::vector vec(data, data + len);
-    this->data[key] = vec;
-    return true;
-  }
-
-  bool load(uint32_t key, uint8_t *data, size_t len) {
-    if (len > 255)
-      return false;
-    this->setup_();
-    if (this->data.count(key) == 0)
-      return false;
-    auto vec = this->data[key];
-    if (vec.size() != len)
-      return false;
-    memcpy(data, vec.data(), len);
-    return true;
-  }
+  bool save(uint32_t key, const uint8_t *data, size_t len);
+  bool load(uint32_t key, uint8_t *data, size_t len);
 
  protected:
+  struct Entry {
+    uint32_t key;
+    uint32_t offset;  ///< Offset of the value in values_.
+    uint8_t len;
+    bool dirty;  ///< Changed since the last sync, listed in dirty_.
+  };
+
+  /// Size of a record header in the file: key and length.
+  static constexpr size_t RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint8_t);
+  /// Logs smaller than this are never compacted.
+  static constexpr size_t COMPACT_MIN_SIZE = 4096;
+
   void setup_();
+  /// Parse the records in buf and return the number of bytes that form complete records.
+  size_t parse_log_(const uint8_t *buf, size_t size);
+  /// Return the entry for key, or nullptr if it was never saved.
+  Entry *find_(uint32_t key);
+  /// Point key at a new value of len bytes, creating the entry if needed.
+  Entry *store_(uint32_t key, const uint8_t *data, uint8_t len);
+  void grow_index_();
+  bool append_dirty_();
+  bool compact_();
+  /// fsync() the directory of the log, so a new or renamed file survives a crash.
+  void sync_directory_();
+  void clear_dirty_();
+  void close_log_();
+
   bool setup_complete_{};
+  /// Set on the first load or save, unless a subclass set it before.
   std::string filename_{};
-  std::map<uint32_t, std::vector<uint8_t>> data{};
+  FILE *log_{nullptr};
+  /// Bytes in the log file, including superseded records.
+  size_t log_size_{0};
+  /// Bytes the log would need to hold only the current value of every key.
+  size_t live_size_{0};
+  /// Set by reset(); the next sync() rewrites the file.
+  bool needs_compaction_{false};
+
+  std::vector<Entry> entries_{};
+  /// Open addressing table of entry index + 1, 0 marks a free slot. Its size is a power of two.
+  std::vector<uint32_t> index_{};
+  std::vector<uint8_t> values_{};
+  /// Indices of the entries changed since the last sync.
+  std::vector<uint32_t> dirty_{};
 };
 void setup_preferences();
 extern HostPreferences *host_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -186,6 +186,10 @@ CONFIG_SCHEMA = cv.All(
                 }
             ),
             cv.Optional(CONF_INIT_SEQUENCE): cv.ensure_list(map_sequence),
+            cv.Optional(display.CONF_SKIP_UNCHANGED): cv.boolean,
+            cv.Optional(display.CONF_DOUBLE_BUFFER): cv.All(
+                cv.boolean, cv.only_on_esp32
+            ),
         }
     )
     .extend(cv.polling_component_schema("1s"))
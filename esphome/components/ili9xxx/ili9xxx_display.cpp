@@ -1,4 +1,5 @@
 #include "ili9xxx_display.h"
+#include <algorithm>
 #include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -57,10 +58,7 @@ void ILI9XXXDisplay::setup() {
 
   this->set_madctl();
   this->command(this->pre_invertcolors_ ? ILI9XXX_INVON : ILI9XXX_INVOFF);
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  this->dirty_region_.clear();
 }
 
 void ILI9XXXDisplay::alloc_buffer_() {
@@ -134,10 +132,7 @@ void ILI9XXXDisplay::fill(Color color) {
   if (!this->check_buffer_())
     return;
   uint16_t new_color = 0;
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  this->mark_dirty_(0, 0, this->get_width_internal(), this->get_height_internal());
   switch (this->buffer_color_mode_) {
     case BITS_8_INDEXED:
       new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
@@ -196,17 +191,75 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
     this->buffer_[pos] = new_color;
     updated = true;
   }
-  if (updated) {
-    // low and high watermark may speed up drawing from buffer
-    if (x < this->x_low_)
-      this->x_low_ = x;
-    if (y < this->y_low_)
-      this->y_low_ = y;
-    if (x > this->x_high_)
-      this->x_high_ = x;
-    if (y > this->y_high_)
-      this->y_high_ = y;
+  if (updated)
+    this->mark_dirty_(x, y, 1, 1);
+}
+
+void HOT ILI9XXXDisplay::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->check_buffer_())
+    return;
+  uint16_t new_color;
+  size_t bytes_per_pixel = 1;
+  switch (this->buffer_color_mode_) {
+    case BITS_8_INDEXED:
+      new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
+      break;
+    case BITS_16:
+      new_color = display::ColorUtil::color_to_565(color, display::ColorOrder::COLOR_ORDER_RGB);
+      bytes_per_pixel = 2;
+      break;
+    default:
+      new_color = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
+      break;
   }
+  const uint8_t hi_byte = new_color >> 8;
+  const uint8_t lo_byte = new_color;
+
+  // bounds of the pixels that actually changed
+  int x1 = x + width, x2 = x, y1 = y + height, y2 = y;
+  for (int row = y; row != y + height; row++) {
+    uint8_t *ptr = this->buffer_ + ((row * this->width_) + x) * bytes_per_pixel;
+    int first = width, last = -1;
+    if (bytes_per_pixel == 2) {
+      for (int i = 0; i != width; i++, ptr += 2) {
+        if (ptr[0] != hi_byte || ptr[1] != lo_byte) {
+          ptr[0] = hi_byte;
+          ptr[1] = lo_byte;
+          first = std::min(first, i);
+          last = i;
+        }
+      }
+    } else {
+      for (int i = 0; i != width; i++, ptr++) {
+        if (*ptr != lo_byte) {
+          *ptr = lo_byte;
+          first = std::min(first, i);
+          last = i;
+        }
+      }
+    }
+    if (last >= 0) {
+      x1 = std::min(x1, x + first);
+      x2 = std::max(x2, x + last + 1);
+      y1 = std::min(y1, row);
+      y2 = row + 1;
+    }
+  }
+  if (x2 > x1)
+    this->mark_dirty_(x1, y1, x2 - x1, y2 - y1);
+}
+
+void ILI9XXXDisplay::copy_to_buffer_(int x_start, int y_start, int w, int h, const uint8_t *ptr, int x_offset,
+                                     int y_offset, int x_pad) {
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x_start, w, x1, x2) || !this->clamp_y_(y_start, h, y1, y2))
+    return;
+  size_t stride = x_offset + w + x_pad;
+  for (int y = y1; y != y2; y++) {
+    memcpy(this->buffer_ + (y * this->width_ + x1) * 2,
+           ptr + ((y - y_start + y_offset) * stride + x_offset + x1 - x_start) * 2, (x2 - x1) * 2);
+  }
+  this->mark_dirty_(x1, y1, x2 - x1, y2 - y1);
 }
 
 void ILI9XXXDisplay::update() {
@@ -224,51 +277,46 @@ void ILI9XXXDisplay::update() {
 }
 
 void ILI9XXXDisplay::display_() {
-  // check if something was displayed
-  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
-    return;
-  }
-
-  // we will only update the changed rows to the display
-  size_t const w = this->x_high_ - this->x_low_ + 1;
-  size_t const h = this->y_high_ - this->y_low_ + 1;
+  auto now = millis();
+  if (this->flush_dirty_())
+    ESP_LOGV(TAG, "Data write took %dms", (unsigned) (millis() - now));
+}
 
+void ILI9XXXDisplay::flush_rect_internal(const uint8_t *buffer, int x, int y, int w, int h) {
   size_t mhz = this->data_rate_ / 1000000;
   // estimate time for a single write
   size_t sw_time = this->width_ * h * 16 / mhz + this->width_ * h * 2 / SPI_MAX_BLOCK_SIZE * SPI_SETUP_US * 2;
   // estimate time for multiple writes
   size_t mw_time = (w * h * 16) / mhz + w * h * 2 / ILI9XXX_TRANSFER_BUFFER_SIZE * SPI_SETUP_US;
   ESP_LOGV(TAG,
-           "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%d, "
-           "height:%zu, mode=%d, 18bit=%d, sw_time=%zuus, mw_time=%zuus)",
-           this->x_low_, this->y_low_, this->x_high_, this->y_high_, w, h, this->buffer_color_mode_,
-           this->is_18bitdisplay_, sw_time, mw_time);
-  auto now = millis();
+           "Start display(x:%d, y:%d, width:%d, height:%d, mode=%d, 18bit=%d, sw_time=%zuus, "
+           "mw_time=%zuus)",
+           x, y, w, h, this->buffer_color_mode_, this->is_18bitdisplay_, sw_time, mw_time);
   if (this->buffer_color_mode_ == BITS_16 && !this->is_18bitdisplay_ && sw_time < mw_time) {
     // 16 bit mode maps directly to display format
-    ESP_LOGV(TAG, "Doing single write of %zu bytes", this->width_ * h * 2);
-    set_addr_window_(0, this->y_low_, this->width_ - 1, this->y_high_);
-    this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
+    ESP_LOGV(TAG, "Doing single write of %zu bytes", (size_t) this->width_ * h * 2);
+    set_addr_window_(0, y, this->width_ - 1, y + h - 1);
+    this->write_array(buffer + y * this->width_ * 2, h * this->width_ * 2);
   } else {
     ESP_LOGV(TAG, "Doing multiple write");
     uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
     size_t rem = h * w;  // remaining number of pixels to write
-    set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
+    set_addr_window_(x, y, x + w - 1, y + h - 1);
     size_t idx = 0;    // index into transfer_buffer
     size_t pixel = 0;  // pixel number offset
-    size_t pos = this->y_low_ * this->width_ + this->x_low_;
+    size_t pos = y * this->width_ + x;
     while (rem-- != 0) {
       uint16_t color_val;
       switch (this->buffer_color_mode_) {
         case BITS_8:
-          color_val = display::ColorUtil::color_to_565(display::ColorUtil::rgb332_to_color(this->buffer_[pos++]));
+          color_val = display::ColorUtil::color_to_565(display::ColorUtil::rgb332_to_color(buffer[pos++]));
           break;
         case BITS_8_INDEXED:
           color_val = display::ColorUtil::color_to_565(
-              display::ColorUtil::index8_to_color_palette888(this->buffer_[pos++], this->palette_));
+              display::ColorUtil::index8_to_color_palette888(buffer[pos++], this->palette_));
           break;
         default:  // case BITS_16:
-          color_val = (this->buffer_[pos * 2] << 8) + this->buffer_[pos * 2 + 1];
+          color_val = (buffer[pos * 2] << 8) + buffer[pos * 2 + 1];
           pos++;
           break;
       }
@@ -283,10 +331,11 @@ void ILI9XXXDisplay::display_() {
       if (idx == sizeof(transfer_buffer)) {
         this->write_array(transfer_buffer, idx);
         idx = 0;
-        App.feed_wdt();
+        if (!this->in_flush_task_())
+          App.feed_wdt();
       }
       // end of line? Skip to the next.
-      if (++pixel == w) {
+      if (++pixel == (size_t) w) {
         pixel = 0;
         pos += this->width_ - w;
       }
@@ -297,28 +346,37 @@ void ILI9XXXDisplay::display_() {
     }
   }
   this->end_data_();
-  ESP_LOGV(TAG, "Data write took %dms", (unsigned) (millis() - now));
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
 }
 
-// note that this bypasses the buffer and writes directly to the display.
+// note that unless a buffer is in use, this bypasses it and writes directly to the display.
 void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr,
                                     display::ColorOrder order, display::ColorBitness bitness, bool big_endian,
                                     int x_offset, int y_offset, int x_pad) {
   if (w <= 0 || h <= 0)
     return;
+  // While update() draws a frame the buffer holds what will be shown, so pixels written directly to the display would
+  // be overwritten when the buffer is sent. Outside update(), e.g. from LVGL, pixels still go straight to the display,
+  // unless the buffers are double buffered and the flush task may be sending one of them.
+  if (this->buffer_ != nullptr && (this->in_update_ || this->is_double_buffered_())) {
+    if (this->rotation_ == display::DISPLAY_ROTATION_0_DEGREES && bitness == display::COLOR_BITNESS_565 &&
+        big_endian && order == display::COLOR_ORDER_RGB && this->buffer_color_mode_ == BITS_16) {
+      this->copy_to_buffer_(x_start, y_start, w, h, ptr, x_offset, y_offset, x_pad);
+    } else {
+      display::DisplayBuffer::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset,
+                                             y_offset, x_pad);
+    }
+    return;
+  }
   // if color mapping or software rotation is required, hand this off to the parent implementation. This will
   // do color conversion pixel-by-pixel into the buffer and draw it later. If this is happening the user has not
   // configured the renderer well.
   if (this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES || bitness != display::COLOR_BITNESS_565 || !big_endian) {
-    display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
-                                     x_pad);
+    display::DisplayBuffer::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset,
+                                           y_offset, x_pad);
     return;
   }
+  // The flush task may still be sending the last frame, on the same bus
+  this->wait_for_flush_();
   this->set_addr_window_(x_start, y_start, x_start + w - 1, y_start + h - 1);
   // x_ and y_offset are offsets into the source buffer, unrelated to our own offsets into the display.
   auto stride = x_offset + w + x_pad;
@@ -328,7 +386,7 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
       this->write_array(ptr, w * h * 2);
     } else {
       for (size_t y = 0; y != h; y++) {
-        this->write_array(ptr + (y + y_offset) * stride + x_offset, w * 2);
+        this->write_array(ptr + ((y + y_offset) * stride + x_offset) * 2, w * 2);
       }
     }
   } else {
@@ -454,6 +512,7 @@ void ILI9XXXDisplay::set_addr_window_(uint16_t x1, uint16_t y1, uint16_t x2, uin
 void ILI9XXXDisplay::invert_colors(bool invert) {
   this->pre_invertcolors_ = invert;
   if (is_ready()) {
+    this->wait_for_flush_();
     this->command(invert ? ILI9XXX_INVON : ILI9XXX_INVOFF);
   }
 }
@@ -89,7 +89,10 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
 
   void dump_config() override;
   void setup() override;
-  void on_powerdown() override { this->command(ILI9XXX_SLPIN); }
+  void on_powerdown() override {
+    this->wait_for_flush_();
+    this->command(ILI9XXX_SLPIN);
+  }
 
   display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_COLOR; }
   void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
@@ -106,6 +109,11 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   }
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_rect_internal(int x, int y, int width, int height, Color color) override;
+  void flush_rect_internal(const uint8_t *buffer, int x, int y, int w, int h) override;
+  /// Copy big endian RGB565 pixels into the buffer, the layout of BITS_16 mode without rotation.
+  void copy_to_buffer_(int x_start, int y_start, int w, int h, const uint8_t *ptr, int x_offset, int y_offset,
+                       int x_pad);
   void setup_pins_();
 
   virtual void set_madctl();
@@ -120,10 +128,6 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   int16_t height_{0};  ///< Display height as modified by current rotation
   int16_t offset_x_{0};
   int16_t offset_y_{0};
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
   const uint8_t *palette_{};
 
   ILI9XXXColorMode buffer_color_mode_{BITS_16};
@@ -6,6 +6,59 @@
 namespace esphome {
 namespace image {
 
+namespace {
+
+/// Number of pixels converted at a time when image rows can't be handed to the display as they are stored.
+static const int LINE_BUFFER_PIXELS = 64;
+/// Shorter runs of binary image pixels are drawn one by one, which is cheaper than clipping and rotating a span.
+static const int MIN_SPAN_PIXELS = 4;
+
+/// Collects consecutive visible pixels of an image row in big endian 565 or 888 format and draws them with a single
+/// Display::draw_pixels_at() call.
+class LineBuffer {
+ public:
+  LineBuffer(display::Display *display, display::ColorBitness bitness)
+      : display_(display), bitness_(bitness), bytes_per_pixel_(bitness == display::COLOR_BITNESS_565 ? 2 : 3) {}
+
+  /// Start a new run of pixels at display position [x,y].
+  void start(int x, int y) {
+    this->flush();
+    this->x_ = x;
+    this->y_ = y;
+  }
+  /// Add a pixel to the current run and return where to store its color.
+  uint8_t *append() {
+    if (this->length_ == LINE_BUFFER_PIXELS)
+      this->flush();
+    return this->data_ + this->bytes_per_pixel_ * this->length_++;
+  }
+  /// Skip a transparent pixel, this ends the current run.
+  void skip() {
+    this->flush();
+    this->x_++;
+  }
+  /// Draw the pixels collected so far.
+  void flush() {
+    if (this->length_ == 0)
+      return;
+    this->display_->draw_pixels_at(this->x_, this->y_, this->length_, 1, this->data_, display::COLOR_ORDER_RGB,
+                                   this->bitness_, true);
+    this->x_ += this->length_;
+    this->length_ = 0;
+  }
+
+ protected:
+  display::Display *display_;
+  display::ColorBitness bitness_;
+  uint8_t bytes_per_pixel_;
+  int x_{0};
+  int y_{0};
+  int length_{0};
+  uint8_t data_[LINE_BUFFER_PIXELS * 3];
+};
+
+}  // namespace
+
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
   int img_x0 = 0;
   int img_y0 = 0;
@@ -23,29 +76,57 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
     if (h > clipping.y2() - y)
       h = clipping.y2() - y;
   }
+  if (img_x0 >= w || img_y0 >= h)
+    return;
+
+#ifndef USE_ESP8266
+  // Opaque color images are stored in a format the display understands, hand them over in one piece
+  if (this->transparency_ == TRANSPARENCY_OPAQUE && (type_ == IMAGE_TYPE_RGB565 || type_ == IMAGE_TYPE_RGB)) {
+    display->draw_pixels_at(x + img_x0, y + img_y0, w - img_x0, h - img_y0, this->data_start_,
+                            display::COLOR_ORDER_RGB,
+                            type_ == IMAGE_TYPE_RGB565 ? display::COLOR_BITNESS_565 : display::COLOR_BITNESS_888, true,
+                            img_x0, img_y0, this->width_ - w);
+    return;
+  }
+#endif
 
   switch (type_) {
     case IMAGE_TYPE_BINARY: {
-      for (int img_x = img_x0; img_x < w; img_x++) {
-        for (int img_y = img_y0; img_y < h; img_y++) {
-          if (this->get_binary_pixel_(img_x, img_y)) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_on);
-          } else if (!this->transparency_) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_off);
+      // Draw longer runs of pixels with the same value as spans
+      for (int img_y = img_y0; img_y < h; img_y++) {
+        int run_start = img_x0;
+        bool run_on = this->get_binary_pixel_(img_x0, img_y);
+        for (int img_x = img_x0 + 1; img_x <= w; img_x++) {
+          bool on = img_x < w && this->get_binary_pixel_(img_x, img_y);
+          if (img_x < w && on == run_on)
+            continue;
+          if (run_on || !this->transparency_) {
+            Color color = run_on ? color_on : color_off;
+            if (img_x - run_start >= MIN_SPAN_PIXELS) {
+              display->fill_span(x + run_start, y + img_y, img_x - run_start, color);
+            } else {
+              for (int i = run_start; i != img_x; i++)
+                display->draw_pixel_at(x + i, y + img_y, color);
+            }
           }
+          run_start = img_x;
+          run_on = on;
         }
       }
       break;
     }
-    case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = img_x0; img_x < w; img_x++) {
-        for (int img_y = img_y0; img_y < h; img_y++) {
-          const uint32_t pos = (img_x + img_y * this->width_);
-          const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
+    case IMAGE_TYPE_GRAYSCALE: {
+      LineBuffer line(display, display::COLOR_BITNESS_888);
+      for (int img_y = img_y0; img_y < h; img_y++) {
+        line.start(x + img_x0, y + img_y);
+        const uint8_t *src = this->data_start_ + img_x0 + img_y * this->width_;
+        for (int img_x = img_x0; img_x < w; img_x++) {
+          const uint8_t gray = progmem_read_byte(src++);
           Color color = Color(gray, gray, gray, 0xFF);
           switch (this->transparency_) {
             case TRANSPARENCY_CHROMA_KEY:
               if (gray == 1) {
+                line.skip();
                 continue;  // skip drawing
               }
               break;
@@ -60,30 +141,62 @@ void Image::draw(int x, int y, display::Display *display, Color color_on, Color
             default:
               break;
           }
-          display->draw_pixel_at(x + img_x, y + img_y, color);
+          uint8_t *dst = line.append();
+          dst[0] = color.r;
+          dst[1] = color.g;
+          dst[2] = color.b;
         }
       }
+      line.flush();
       break;
-    case IMAGE_TYPE_RGB565:
-      for (int img_x = img_x0; img_x < w; img_x++) {
-        for (int img_y = img_y0; img_y < h; img_y++) {
-          auto color = this->get_rgb565_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
+    }
+    case IMAGE_TYPE_RGB565: {
+      LineBuffer line(display, display::COLOR_BITNESS_565);
+      const size_t bytes_per_pixel = this->bpp_ / 8;
+      for (int img_y = img_y0; img_y < h; img_y++) {
+        line.start(x + img_x0, y + img_y);
+        const uint8_t *src = this->data_start_ + (img_x0 + img_y * this->width_) * bytes_per_pixel;
+        for (int img_x = img_x0; img_x < w; img_x++, src += bytes_per_pixel) {
+          const uint8_t hi_byte = progmem_read_byte(src);
+          const uint8_t lo_byte = progmem_read_byte(src + 1);
+          if ((this->transparency_ == TRANSPARENCY_ALPHA_CHANNEL && progmem_read_byte(src + 2) < 0x80) ||
+              (this->transparency_ == TRANSPARENCY_CHROMA_KEY && hi_byte == 0x00 && lo_byte == 0x20)) {
+            line.skip();
+            continue;
           }
+          uint8_t *dst = line.append();
+          dst[0] = hi_byte;
+          dst[1] = lo_byte;
         }
       }
+      line.flush();
       break;
-    case IMAGE_TYPE_RGB:
-      for (int img_x = img_x0; img_x < w; img_x++) {
-        for (int img_y = img_y0; img_y < h; img_y++) {
-          auto color = this->get_rgb_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
+    }
+    case IMAGE_TYPE_RGB: {
+      LineBuffer line(display, display::COLOR_BITNESS_888);
+      const size_t bytes_per_pixel = this->bpp_ / 8;
+      for (int img_y = img_y0; img_y < h; img_y++) {
+        line.start(x + img_x0, y + img_y);
+        const uint8_t *src = this->data_start_ + (img_x0 + img_y * this->width_) * bytes_per_pixel;
+        for (int img_x = img_x0; img_x < w; img_x++, src += bytes_per_pixel) {
+          const uint8_t r = progmem_read_byte(src);
+          const uint8_t g = progmem_read_byte(src + 1);
+          const uint8_t b = progmem_read_byte(src + 2);
+          // (0, 1, 0) has been defined as transparent color for non-alpha images.
+          if ((this->transparency_ == TRANSPARENCY_ALPHA_CHANNEL && progmem_read_byte(src + 3) < 0x80) ||
+              (this->transparency_ == TRANSPARENCY_CHROMA_KEY && r == 0 && g == 1 && b == 0)) {
+            line.skip();
+            continue;
           }
+          uint8_t *dst = line.append();
+          dst[0] = r;
+          dst[1] = g;
+          dst[2] = b;
         }
       }
+      line.flush();
       break;
+    }
   }
 }
 Color Image::get_pixel(int x, int y, const Color color_on, const Color color_off) const {
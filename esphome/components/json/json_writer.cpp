@@ -0,0 +1,246 @@
+#include "json_writer.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace json {
+
+JsonObjectWriter JsonWriter::root() {
+  this->out_.clear();
+  this->depth_ = 0;
+  this->has_values_ = 0;
+  memset(this->ids_, 0, sizeof(this->ids_));
+  return JsonObjectWriter(this, this->open_('{', '}'));
+}
+
+std::string JsonWriter::str() {
+  this->close_to_(0);
+  return std::move(this->out_);
+}
+
+bool JsonWriter::begin_value_(uint8_t depth, uint16_t id) {
+  if (id == 0 || depth > this->depth_ || this->ids_[depth] != id)
+    return false;
+  this->close_to_(depth);
+  if (this->has_values_ & (1 << depth)) {
+    this->out_.push_back(',');
+  } else {
+    this->has_values_ |= 1 << depth;
+  }
+  return true;
+}
+
+uint16_t JsonWriter::open_(char open, char close) {
+  if (this->depth_ == MAX_DEPTH) {
+    // The separator and key are written already, so the container is replaced by null to keep the JSON valid
+    this->out_.append("null");
+    return 0;
+  }
+  this->out_.push_back(open);
+  this->depth_++;
+  this->closers_[this->depth_] = close;
+  this->has_values_ &= ~(1 << this->depth_);
+  // 0 marks a container that could not be opened
+  if (++this->next_id_ == 0)
+    this->next_id_ = 1;
+  this->ids_[this->depth_] = this->next_id_;
+  return this->next_id_;
+}
+
+void JsonWriter::close_to_(uint8_t depth) {
+  while (this->depth_ > depth) {
+    this->out_.push_back(this->closers_[this->depth_]);
+    this->ids_[this->depth_] = 0;
+    this->depth_--;
+  }
+}
+
+void JsonWriter::write_value(const char *value) {
+  if (value == nullptr) {
+    this->out_.append("null");
+    return;
+  }
+  this->write_string_(value, strlen(value));
+}
+
+void JsonWriter::write_value(float value) {
+  // ArduinoJson stores floats as double
+  this->write_double_(value);
+}
+
+void JsonWriter::write_value(double value) { this->write_double_(value); }
+
+void JsonWriter::write_double_(double value) {
+  // Same digits as FloatParts<double> in ArduinoJson 6
+  if (!std::isfinite(value)) {
+    this->out_.append("null");
+    return;
+  }
+  if (value < 0.0) {
+    this->out_.push_back('-');
+    value = -value;
+  }
+
+  // Scale into 1..10 by binary powers of ten if the number is out of 1e-5..1e7
+  static const double POSITIVE_POWERS[] = {1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
+  static const double NEGATIVE_POWERS[] = {1e-1, 1e-2, 1e-4, 1e-8, 1e-16, 1e-32, 1e-64, 1e-128, 1e-256};
+  static const double NEGATIVE_POWERS_PLUS_ONE[] = {1e0, 1e-1, 1e-3, 1e-7, 1e-15, 1e-31, 1e-63, 1e-127, 1e-255};
+  int exponent = 0;
+  int index = 8;
+  int bit = 1 << index;
+  if (value >= 1e7) {
+    for (; index >= 0; index--) {
+      if (value >= POSITIVE_POWERS[index]) {
+        value *= NEGATIVE_POWERS[index];
+        exponent += bit;
+      }
+      bit >>= 1;
+    }
+  }
+  if (value > 0 && value <= 1e-5) {
+    for (; index >= 0; index--) {
+      if (value < NEGATIVE_POWERS_PLUS_ONE[index]) {
+        value *= POSITIVE_POWERS[index];
+        exponent -= bit;
+      }
+      bit >>= 1;
+    }
+  }
+
+  // Nine digits after the point, minus one for every integral digit past the first
+  auto integral = static_cast<uint32_t>(value);
+  uint32_t max_decimal = 1000000000;
+  int decimal_places = 9;
+  for (uint32_t tmp = integral; tmp >= 10; tmp /= 10) {
+    max_decimal /= 10;
+    decimal_places--;
+  }
+  double remainder = (value - integral) * max_decimal;
+  auto decimal = static_cast<uint32_t>(remainder);
+  remainder -= decimal;
+  // Round half up
+  decimal += static_cast<uint32_t>(remainder * 2);
+  if (decimal >= max_decimal) {
+    decimal = 0;
+    integral++;
+    if (exponent != 0 && integral >= 10) {
+      exponent++;
+      integral = 1;
+    }
+  }
+  while (decimal % 10 == 0 && decimal_places > 0) {
+    decimal /= 10;
+    decimal_places--;
+  }
+
+  this->write_uint_(integral);
+  if (decimal_places > 0) {
+    char buf[10];
+    char *pos = buf + sizeof(buf);
+    for (int i = 0; i < decimal_places; i++, decimal /= 10)
+      *--pos = static_cast<char>('0' + decimal % 10);
+    this->out_.push_back('.');
+    this->out_.append(pos, buf + sizeof(buf) - pos);
+  }
+  if (exponent != 0) {
+    this->out_.push_back('e');
+    this->write_int_(exponent);
+  }
+}
+
+void JsonWriter::write_string_(const char *value, size_t length) {
+  static const char *const HEX = "0123456789abcdef";
+  this->out_.push_back('"');
+  size_t start = 0;
+  for (size_t i = 0; i < length; i++) {
+    auto c = static_cast<uint8_t>(value[i]);
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    // Copy the run of characters that need no escaping at once
+    this->out_.append(value + start, i - start);
+    start = i + 1;
+    this->out_.push_back('\\');
+    switch (c) {
+      case '"':
+      case '\\':
+        this->out_.push_back(c);
+        break;
+      case '\b':
+        this->out_.push_back('b');
+        break;
+      case '\f':
+        this->out_.push_back('f');
+        break;
+      case '\n':
+        this->out_.push_back('n');
+        break;
+      case '\r':
+        this->out_.push_back('r');
+        break;
+      case '\t':
+        this->out_.push_back('t');
+        break;
+      default:
+        this->out_.append("u00");
+        this->out_.push_back(HEX[c >> 4]);
+        this->out_.push_back(HEX[c & 0xF]);
+        break;
+    }
+  }
+  this->out_.append(value + start, length - start);
+  this->out_.push_back('"');
+}
+
+void JsonWriter::write_int_(int64_t value) {
+  if (value < 0) {
+    this->out_.push_back('-');
+    this->write_uint_(0 - static_cast<uint64_t>(value));
+  } else {
+    this->write_uint_(value);
+  }
+}
+
+void JsonWriter::write_uint_(uint64_t value) {
+  char buf[20];
+  char *pos = buf + sizeof(buf);
+  do {
+    *--pos = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  this->out_.append(pos, buf + sizeof(buf) - pos);
+}
+
+JsonArrayWriter JsonArrayWriter::create_nested_array() {
+  if (!this->writer_->begin_value_(this->depth_, this->id_))
+    return JsonArrayWriter(this->writer_, 0);
+  return JsonArrayWriter(this->writer_, this->writer_->open_('[', ']'));
+}
+
+JsonObjectWriter JsonArrayWriter::create_nested_object() {
+  if (!this->writer_->begin_value_(this->depth_, this->id_))
+    return JsonObjectWriter(this->writer_, 0);
+  return JsonObjectWriter(this->writer_, this->writer_->open_('{', '}'));
+}
+
+bool JsonObjectWriter::begin_member_(const char *key, size_t key_length) {
+  if (!this->writer_->begin_value_(this->depth_, this->id_))
+    return false;
+  this->writer_->write_string_(key, key_length);
+  this->writer_->out_.push_back(':');
+  return true;
+}
+
+JsonArrayWriter JsonObjectWriter::create_nested_array(const char *key) {
+  if (!this->begin_member_(key, strlen(key)))
+    return JsonArrayWriter(this->writer_, 0);
+  return JsonArrayWriter(this->writer_, this->writer_->open_('[', ']'));
+}
+
+JsonObjectWriter JsonObjectWriter::create_nested_object(const char *key) {
+  if (!this->begin_member_(key, strlen(key)))
+    return JsonObjectWriter(this->writer_, 0);
+  return JsonObjectWriter(this->writer_, this->writer_->open_('{', '}'));
+}
+
+}  // namespace json
+}  // namespace esphome
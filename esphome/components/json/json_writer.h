@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "esphome/core/string_ref.h"
+
+namespace esphome {
+namespace json {
+
+class JsonWriter;
+class JsonArrayWriter;
+class JsonObjectWriter;
+
+/** Writes JSON text straight into a string, without building a document in memory first.
+ *
+ * Members are written in the order they are set. Setting a member of an object, or adding to an array, completes any
+ * nested object or array that was opened in it before, so nested values have to be written before the next member of
+ * their parent. Writes to an object or array that was already completed are dropped.
+ *
+ * Strings are escaped, NaN and infinite numbers are written as null. Floating point numbers are written like
+ * ArduinoJson 6 serializes them, so documents read the same as they did when they were built with it.
+ *
+ * @code
+ * json::JsonWriter writer;
+ * auto root = writer.root();
+ * root["id"] = "sensor-temperature";
+ * root["value"] = 21.5f;
+ * auto options = root.create_nested_array("options");
+ * options.add("a");
+ * options.add("b");
+ * root["state"] = "a";
+ * std::string json = writer.str();  // {"id":"sensor-temperature","value":21.5,"options":["a","b"],"state":"a"}
+ * @endcode
+ */
+class JsonWriter {
+ public:
+  /// Reserve \p capacity bytes for the output up front, enough for most entity states.
+  explicit JsonWriter(size_t capacity = 128) { this->out_.reserve(capacity); }
+
+  /// Start the root object, call this once before writing anything else.
+  JsonObjectWriter root();
+  /// Complete all open objects and arrays and return the JSON text, leaving the writer empty.
+  std::string str();
+
+  void write_value(const char *value);
+  void write_value(const std::string &value) { this->write_string_(value.data(), value.size()); }
+  void write_value(const StringRef &value) { this->write_string_(value.c_str(), value.size()); }
+  void write_value(bool value) { this->out_.append(value ? "true" : "false"); }
+  void write_value(float value);
+  void write_value(double value);
+  template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0> void write_value(T value) {
+    if (std::is_signed<T>::value) {
+      this->write_int_(static_cast<int64_t>(value));
+    } else {
+      this->write_uint_(static_cast<uint64_t>(value));
+    }
+  }
+  /// Enums are written as their numeric value.
+  template<typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0> void write_value(T value) {
+    this->write_value(static_cast<typename std::underlying_type<T>::type>(value));
+  }
+
+ protected:
+  friend class JsonArrayWriter;
+  friend class JsonObjectWriter;
+
+  static constexpr uint8_t MAX_DEPTH = 8;
+
+  /// Complete any containers nested in the one at \p depth and write the separator for its next value. Returns
+  /// false if that container was completed already, in which case nothing should be written.
+  bool begin_value_(uint8_t depth, uint16_t id);
+  /// Open an object or array as a value of the current container, returns its id. If nesting is too deep, null is
+  /// written in its place and 0 returned.
+  uint16_t open_(char open, char close);
+  void close_to_(uint8_t depth);
+  void write_string_(const char *value, size_t length);
+  void write_int_(int64_t value);
+  void write_uint_(uint64_t value);
+  /// Write \p value with up to 9 significant decimal places, in exponent notation outside 1e-5..1e7.
+  void write_double_(double value);
+
+  std::string out_;
+  /// Closing character of each open container, indexed by depth starting at 1.
+  char closers_[MAX_DEPTH + 1];
+  /// Id of each open container, so writes through a handle to a completed container are recognized.
+  uint16_t ids_[MAX_DEPTH + 1]{};
+  /// Bit per depth, set once the container at that depth has a value.
+  uint16_t has_values_{0};
+  uint8_t depth_{0};
+  uint16_t next_id_{0};
+};
+
+/// Handle to an array that is being written by a JsonWriter.
+class JsonArrayWriter {
+ public:
+  template<typename T> void add(const T &value) {
+    if (this->writer_->begin_value_(this->depth_, this->id_))
+      this->writer_->write_value(value);
+  }
+  JsonArrayWriter create_nested_array();
+  JsonObjectWriter create_nested_object();
+
+ protected:
+  friend class JsonObjectWriter;
+  JsonArrayWriter(JsonWriter *writer, uint16_t id) : writer_(writer), depth_(writer->depth_), id_(id) {}
+
+  JsonWriter *writer_;
+  uint8_t depth_;
+  uint16_t id_;
+};
+
+/// Handle to an object that is being written by a JsonWriter.
+class JsonObjectWriter {
+ public:
+  /// A member of the object, assigning a value to it writes the member.
+  class Member {
+   public:
+    template<typename T> Member &operator=(const T &value) {
+      if (this->parent_->begin_member_(this->key_, this->key_length_))
+        this->parent_->writer_->write_value(value);
+      return *this;
+    }
+
+   protected:
+    friend class JsonObjectWriter;
+    Member(JsonObjectWriter *parent, const char *key, size_t key_length)
+        : parent_(parent), key_(key), key_length_(key_length) {}
+
+    JsonObjectWriter *parent_;
+    const char *key_;
+    size_t key_length_;
+  };
+
+  Member operator[](const char *key) { return Member(this, key, strlen(key)); }
+  Member operator[](const std::string &key) { return Member(this, key.data(), key.size()); }
+  JsonArrayWriter create_nested_array(const char *key);
+  JsonObjectWriter create_nested_object(const char *key);
+
+ protected:
+  friend class JsonWriter;
+  friend class JsonArrayWriter;
+  JsonObjectWriter(JsonWriter *writer, uint16_t id) : writer_(writer), depth_(writer->depth_), id_(id) {}
+
+  /// Write the separator and key of the next member, returns false if the object was completed already.
+  bool begin_member_(const char *key, size_t key_length);
+
+  JsonWriter *writer_;
+  uint8_t depth_;
+  uint16_t id_;
+};
+
+}  // namespace json
+}  // namespace esphome
@@ -8,7 +8,13 @@ namespace light {
 
 // See https://www.home-assistant.io/integrations/light.mqtt/#json-schema for documentation on the schema
 
-void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
+static json::JsonObjectWriter create_nested_object(json::JsonObjectWriter &root, const char *key) {
+  return root.create_nested_object(key);
+}
+static JsonObject create_nested_object(JsonObject &root, const char *key) { return root.createNestedObject(key); }
+
+/// Both overloads of dump_json(), \p T is json::JsonObjectWriter or an ArduinoJson JsonObject.
+template<typename T> static void dump_light_json(LightState &state, T &root) {
   if (state.supports_effects())
     root["effect"] = state.get_effect_name();
 
@@ -52,26 +58,31 @@ void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
   if (values.get_color_mode() & ColorCapability::BRIGHTNESS)
     root["brightness"] = uint8_t(values.get_brightness() * 255);
 
-  JsonObject color = root.createNestedObject("color");
+  if (values.get_color_mode() & ColorCapability::WHITE)
+    root["white_value"] = uint8_t(values.get_white() * 255);  // legacy API
+  if (values.get_color_mode() & ColorCapability::COLOR_TEMPERATURE) {
+    // this one isn't under the color subkey for some reason
+    root["color_temp"] = uint32_t(values.get_color_temperature());
+  }
+
+  // written last, the members above can't be set any more once it's open
+  auto color = create_nested_object(root, "color");
   if (values.get_color_mode() & ColorCapability::RGB) {
     color["r"] = uint8_t(values.get_color_brightness() * values.get_red() * 255);
     color["g"] = uint8_t(values.get_color_brightness() * values.get_green() * 255);
     color["b"] = uint8_t(values.get_color_brightness() * values.get_blue() * 255);
   }
-  if (values.get_color_mode() & ColorCapability::WHITE) {
+  if (values.get_color_mode() & ColorCapability::WHITE)
     color["w"] = uint8_t(values.get_white() * 255);
-    root["white_value"] = uint8_t(values.get_white() * 255);  // legacy API
-  }
-  if (values.get_color_mode() & ColorCapability::COLOR_TEMPERATURE) {
-    // this one isn't under the color subkey for some reason
-    root["color_temp"] = uint32_t(values.get_color_temperature());
-  }
   if (values.get_color_mode() & ColorCapability::COLD_WARM_WHITE) {
     color["c"] = uint8_t(values.get_cold_white() * 255);
     color["w"] = uint8_t(values.get_warm_white() * 255);
   }
 }
 
+void LightJSONSchema::dump_json(LightState &state, json::JsonObjectWriter &root) { dump_light_json(state, root); }
+void LightJSONSchema::dump_json(LightState &state, JsonObject root) { dump_light_json(state, root); }
+
 void LightJSONSchema::parse_color_json(LightState &state, LightCall &call, JsonObject root) {
   if (root.containsKey("state")) {
     auto val = parse_on_off(root["state"]);
@@ -1,3 +1,4 @@
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 #include "light_output.h"
@@ -140,7 +141,10 @@ void LightState::loop() {
 
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
 
-void LightState::publish_state() { this->remote_values_callback_.call(); }
+void LightState::publish_state() {
+  this->remote_values_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_LIGHT, this);
+}
 
 LightOutput *LightState::get_output() const { return this->output_; }
 std::string LightState::get_effect_name() {
@@ -17,6 +17,7 @@ from esphome.components.esp32.const import (
 )
 from esphome.components.libretiny import get_libretiny_component, get_libretiny_family
 from esphome.components.libretiny.const import COMPONENT_BK72XX, COMPONENT_RTL87XX
+from esphome.components.socket import require_wake_loop_threadsafe
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_ARGS,
@@ -267,6 +268,7 @@ async def to_code(config):
         if task_log_buffer_size > 0:
             cg.add_define("USE_ESPHOME_TASK_LOG_BUFFER")
             cg.add(log.init_log_buffer(task_log_buffer_size))
+            require_wake_loop_threadsafe()
 
     cg.add(log.set_log_level(initial_level))
     if CONF_HARDWARE_UART in config:
@@ -1,4 +1,5 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
 #ifdef USE_ESPHOME_TASK_LOG_BUFFER
 #include <memory>  // For unique_ptr
@@ -25,12 +26,16 @@ static const char *const TAG = "logger";
 //    - Fallback to emergency console logging only if ring buffer is full
 //  - WITHOUT task log buffer: Only emergency console output, no callbacks
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag))
+  if (level > this->current_level_ && this->log_levels_.empty())
     return;
 
   TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
   bool is_main_task = (current_task == main_task_);
 
+  // The tag level cache is owned by the main task
+  if (level > (is_main_task ? this->level_for(tag) : this->level_for_uncached_(tag)))
+    return;
+
   // Check and set recursion guard - uses pthread TLS for per-task state
   if (this->check_and_set_task_log_recursion_(is_main_task)) {
     return;  // Recursion detected
@@ -48,6 +53,11 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
   // For non-main tasks, queue the message for callbacks - but only if we have any callbacks registered
   message_sent = this->log_buffer_->send_message_thread_safe(static_cast<uint8_t>(level), tag,
                                                              static_cast<uint16_t>(line), current_task, format, args);
+#ifdef USE_WAKE_LOOP_THREADSAFE
+  // Deliver the message to log listeners (e.g. API clients) without waiting for the next loop iteration
+  if (message_sent)
+    App.wake_loop_threadsafe();
+#endif
 #endif  // USE_ESPHOME_TASK_LOG_BUFFER
 
   // Emergency console logging for non-main tasks when ring buffer is full or disabled
@@ -70,7 +80,9 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
 #else
 // Implementation for all other platforms
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || global_recursion_guard_)
+  // The tag level cache is owned by the main task
+  if (level > (this->is_main_task_() ? this->level_for(tag) : this->level_for_uncached_(tag)) ||
+      global_recursion_guard_)
     return;
 
   global_recursion_guard_ = true;
@@ -87,7 +99,9 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
 // Note: USE_STORE_LOG_STR_IN_FLASH is only defined for ESP8266.
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || global_recursion_guard_)
+  // The tag level cache is owned by the main task
+  if (level > (this->is_main_task_() ? this->level_for(tag) : this->level_for_uncached_(tag)) ||
+      global_recursion_guard_)
     return;
 
   global_recursion_guard_ = true;
@@ -122,18 +136,52 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif  // USE_STORE_LOG_STR_IN_FLASH
 
-inline int Logger::level_for(const char *tag) {
+int Logger::level_for_uncached_(const char *tag) {
   auto it = this->log_levels_.find(tag);
   if (it != this->log_levels_.end())
     return it->second;
   return this->current_level_;
 }
 
+int Logger::cache_tag_level_(const char *tag) {
+  auto it = this->log_levels_.find(tag);
+  int8_t level = it != this->log_levels_.end() ? it->second : TAG_LEVEL_DEFAULT;
+
+  // Keep the table at most half full so probe sequences stay short
+  if ((this->tag_cache_used_ + 1) * 2 > this->tag_cache_.size()) {
+    std::vector<TagLevel> old;
+    old.swap(this->tag_cache_);
+    this->clear_tag_cache_(old.size() * 2);
+    for (const TagLevel &entry : old) {
+      if (entry.tag != nullptr)
+        this->insert_tag_level_(entry.tag, entry.level);
+    }
+  }
+  this->insert_tag_level_(tag, level);
+  return level == TAG_LEVEL_DEFAULT ? this->current_level_ : level;
+}
+
+void Logger::insert_tag_level_(const char *tag, int8_t level) {
+  const size_t mask = this->tag_cache_.size() - 1;
+  size_t slot = tag_cache_slot_(tag, mask);
+  while (this->tag_cache_[slot].tag != nullptr)
+    slot = (slot + 1) & mask;
+  this->tag_cache_[slot] = TagLevel{tag, level};
+  this->tag_cache_used_++;
+}
+
+void Logger::clear_tag_cache_(size_t size) {
+  this->tag_cache_.assign(size, TagLevel{nullptr, TAG_LEVEL_DEFAULT});
+  this->tag_cache_used_ = 0;
+}
+
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
   // add 1 to buffer size for null terminator
   this->tx_buffer_ = new char[this->tx_buffer_size_ + 1];  // NOLINT
 #if defined(USE_ESP32) || defined(USE_LIBRETINY)
   this->main_task_ = xTaskGetCurrentTaskHandle();
+#elif defined(USE_HOST)
+  this->main_thread_ = pthread_self();
 #endif
 }
 #ifdef USE_ESPHOME_TASK_LOG_BUFFER
@@ -195,7 +243,11 @@ void Logger::loop() {
 #endif
 
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
-void Logger::set_log_level(const std::string &tag, int log_level) { this->log_levels_[tag] = log_level; }
+void Logger::set_log_level(const std::string &tag, int log_level) {
+  this->log_levels_[tag] = log_level;
+  // Levels of tags already seen may have changed, resolve them again on their next use
+  this->clear_tag_cache_(std::max<size_t>(this->tag_cache_.size(), TAG_CACHE_INITIAL_SIZE));
+}
 
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
 UARTSelection Logger::get_uart() const { return this->uart_; }
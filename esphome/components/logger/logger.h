@@ -2,7 +2,8 @@
 
 #include <cstdarg>
 #include <map>
-#ifdef USE_ESP32
+#include <vector>
+#if defined(USE_ESP32) || defined(USE_HOST)
 #include <pthread.h>
 #endif
 #include "esphome/core/automation.h"
@@ -140,7 +141,22 @@ class Logger : public Component {
   void pre_setup();
   void dump_config() override;
 
-  inline int level_for(const char *tag);
+  /// Effective log level for \p tag, resolved through the tag level cache. Main task only, the cache is not locked.
+  inline int level_for(const char *tag) {
+    // No per-tag levels configured, the common case
+    if (this->tag_cache_.empty())
+      return this->current_level_;
+    const size_t mask = this->tag_cache_.size() - 1;
+    size_t slot = tag_cache_slot_(tag, mask);
+    while (true) {
+      const TagLevel &entry = this->tag_cache_[slot];
+      if (entry.tag == tag)
+        return entry.level == TAG_LEVEL_DEFAULT ? this->current_level_ : entry.level;
+      if (entry.tag == nullptr)
+        return this->cache_tag_level_(tag);
+      slot = (slot + 1) & mask;
+    }
+  }
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
@@ -158,6 +174,17 @@ class Logger : public Component {
  protected:
   void write_msg_(const char *msg);
 
+  static size_t tag_cache_slot_(const char *tag, size_t mask) {
+    uint32_t hash = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(tag)) * 2654435761U;
+    return (hash >> 8) & mask;
+  }
+  /// Look up the level of a tag that isn't cached yet and insert it into the cache.
+  int cache_tag_level_(const char *tag);
+  void insert_tag_level_(const char *tag, int8_t level);
+  /// Level for \p tag straight from log_levels_, for tasks that must not touch the cache.
+  int level_for_uncached_(const char *tag);
+  void clear_tag_cache_(size_t size);
+
   // Format a log message with printf-style arguments and write it to a buffer with header, footer, and null terminator
   // It's the caller's responsibility to initialize buffer_at (typically to 0)
   inline void HOT format_log_to_buffer_with_terminator_(int level, const char *tag, int line, const char *format,
@@ -239,6 +266,17 @@ class Logger : public Component {
   uart_port_t uart_num_;
 #endif
   std::map<std::string, int> log_levels_{};
+  /// Tags are pointers to string constants, so each one is looked up in log_levels_ only once and its level is
+  /// remembered here by pointer. Open addressing with a power of two size, empty until a per-tag level is set.
+  /// Only accessed from the main task.
+  struct TagLevel {
+    const char *tag;
+    int8_t level;
+  };
+  static constexpr int8_t TAG_LEVEL_DEFAULT = -1;  ///< Tag has no level of its own, use current_level_
+  static constexpr size_t TAG_CACHE_INITIAL_SIZE = 32;
+  std::vector<TagLevel> tag_cache_{};
+  size_t tag_cache_used_{0};
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   int current_level_{ESPHOME_LOG_LEVEL_VERY_VERBOSE};
 #ifdef USE_ESPHOME_TASK_LOG_BUFFER
@@ -256,7 +294,16 @@ class Logger : public Component {
   CallbackManager<void(int)> level_callback_{};
 
 #if defined(USE_ESP32) || defined(USE_LIBRETINY)
-  void *main_task_ = nullptr;  // Only used for thread name identification
+  void *main_task_ = nullptr;  // Used for thread name identification and to guard the tag level cache
+  bool is_main_task_() const { return xTaskGetCurrentTaskHandle() == this->main_task_; }
+#elif defined(USE_HOST)
+  pthread_t main_thread_;
+  bool is_main_task_() const { return pthread_equal(pthread_self(), this->main_thread_); }
+#else
+  // Everything runs on the main task
+  static constexpr bool is_main_task_() { return true; }
+#endif
+#if defined(USE_ESP32) || defined(USE_LIBRETINY)
   const char *HOT get_thread_name_() {
     TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
     if (current_task == main_task_) {
@@ -1,5 +1,6 @@
 #include "media_player.h"
 
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -135,7 +136,10 @@ void MediaPlayer::add_on_state_callback(std::function<void()> &&callback) {
   this->state_callback_.add(std::move(callback));
 }
 
-void MediaPlayer::publish_state() { this->state_callback_.call(); }
+void MediaPlayer::publish_state() {
+  this->state_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_MEDIA_PLAYER, this);
+}
 
 }  // namespace media_player
 }  // namespace esphome
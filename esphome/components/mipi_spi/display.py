@@ -232,6 +232,10 @@ def model_schema(bus_mode, model: DriverChip, swapsies: bool):
                 ),
                 cv.Required(CONF_MODEL): cv.one_of(model.name, upper=True),
                 iseqconf: cv.ensure_list(map_sequence),
+                cv.Optional(display.CONF_SKIP_UNCHANGED): cv.boolean,
+                cv.Optional(display.CONF_DOUBLE_BUFFER): cv.All(
+                    cv.boolean, cv.only_on_esp32
+                ),
             }
         )
         .extend(
@@ -1,4 +1,5 @@
 #include "mipi_spi.h"
+#include <algorithm>
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -94,38 +95,43 @@ void MipiSpi::update() {
     return;
   }
   this->do_update_();
-  if (this->buffer_ == nullptr || this->x_low_ > this->x_high_ || this->y_low_ > this->y_high_)
+  if (this->buffer_ == nullptr)
+    return;
+  this->flush_dirty_();
+}
+
+void MipiSpi::flush_region_internal(const uint8_t *buffer, const display::DirtyRegion &region) {
+  if (!this->draw_from_origin_) {
+    DisplayBuffer::flush_region_internal(buffer, region);
     return;
-  ESP_LOGV(TAG, "x_low %d, y_low %d, x_high %d, y_high %d", this->x_low_, this->y_low_, this->x_high_, this->y_high_);
-  // Some chips require that the drawing window be aligned on certain boundaries
-  auto dr = this->draw_rounding_;
-  this->x_low_ = this->x_low_ / dr * dr;
-  this->y_low_ = this->y_low_ / dr * dr;
-  this->x_high_ = (this->x_high_ + dr) / dr * dr - 1;
-  this->y_high_ = (this->y_high_ + dr) / dr * dr - 1;
-  if (this->draw_from_origin_) {
-    this->x_low_ = 0;
-    this->y_low_ = 0;
-    this->x_high_ = this->width_ - 1;
   }
-  int w = this->x_high_ - this->x_low_ + 1;
-  int h = this->y_high_ - this->y_low_ + 1;
-  this->write_to_display_(this->x_low_, this->y_low_, w, h, this->buffer_, this->x_low_, this->y_low_,
-                          this->width_ - w - this->x_low_);
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  // Every write has to start at the origin, so send all rows down to the lowest rectangle at once
+  int rows = 0;
+  for (const auto &rect : region)
+    rows = std::max<int>(rows, rect.y2());
+  rows = std::min<int>((rows + this->draw_rounding_ - 1) / this->draw_rounding_ * this->draw_rounding_, this->height_);
+  this->write_to_display_(0, 0, this->width_, rows, buffer, 0, 0, 0);
+}
+
+void MipiSpi::flush_rect_internal(const uint8_t *buffer, int x, int y, int w, int h) {
+  ESP_LOGV(TAG, "x %d, y %d, w %d, h %d", x, y, w, h);
+  int x2 = x + w;
+  int y2 = y + h;
+  // Some chips require that the drawing window be aligned on certain boundaries
+  int dr = this->draw_rounding_;
+  x = x / dr * dr;
+  y = y / dr * dr;
+  x2 = std::min<int>((x2 + dr - 1) / dr * dr, this->width_);
+  y2 = std::min<int>((y2 + dr - 1) / dr * dr, this->height_);
+  w = x2 - x;
+  h = y2 - y;
+  this->write_to_display_(x, y, w, h, buffer, x, y, this->width_ - w - x);
 }
 
 void MipiSpi::fill(Color color) {
   if (!this->check_buffer_())
     return;
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  this->mark_dirty_(0, 0, this->get_width_internal(), this->get_height_internal());
   switch (this->color_depth_) {
     case display::COLOR_BITNESS_332: {
       auto new_color = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
@@ -177,20 +183,68 @@ void MipiSpi::draw_absolute_pixel_internal(int x, int y, Color color) {
     default:
       return;
   }
-  // low and high watermark may speed up drawing from buffer
-  if (x < this->x_low_)
-    this->x_low_ = x;
-  if (y < this->y_low_)
-    this->y_low_ = y;
-  if (x > this->x_high_)
-    this->x_high_ = x;
-  if (y > this->y_high_)
-    this->y_high_ = y;
+  this->mark_dirty_(x, y, 1, 1);
+}
+
+void MipiSpi::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->check_buffer_())
+    return;
+  bool updated = false;
+  switch (this->color_depth_) {
+    case display::COLOR_BITNESS_332: {
+      uint8_t new_color = display::ColorUtil::color_to_332(color);
+      for (int row = y; row != y + height; row++) {
+        uint8_t *ptr = this->buffer_ + row * this->width_ + x;
+        for (int i = 0; i != width; i++) {
+          if (ptr[i] != new_color) {
+            ptr[i] = new_color;
+            updated = true;
+          }
+        }
+      }
+      break;
+    }
+
+    case display::COLOR_BITNESS_565: {
+      uint8_t hi_byte = static_cast<uint8_t>(color.r & 0xF8) | (color.g >> 5);
+      uint8_t lo_byte = static_cast<uint8_t>((color.g & 0x1C) << 3) | (color.b >> 3);
+      uint16_t new_color = hi_byte | (lo_byte << 8);  // big endian
+      for (int row = y; row != y + height; row++) {
+        auto *ptr_16 = reinterpret_cast<uint16_t *>(this->buffer_) + row * this->width_ + x;
+        for (int i = 0; i != width; i++) {
+          if (ptr_16[i] != new_color) {
+            ptr_16[i] = new_color;
+            updated = true;
+          }
+        }
+      }
+      break;
+    }
+    default:
+      return;
+  }
+  if (!updated)
+    return;
+  this->mark_dirty_(x, y, width, height);
+}
+
+void MipiSpi::copy_to_buffer_(int x_start, int y_start, int w, int h, const uint8_t *ptr, int x_offset, int y_offset,
+                              int x_pad) {
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x_start, w, x1, x2) || !this->clamp_y_(y_start, h, y1, y2))
+    return;
+  size_t stride = x_offset + w + x_pad;
+  for (int y = y1; y != y2; y++) {
+    memcpy(this->buffer_ + (y * this->width_ + x1) * 2,
+           ptr + ((y - y_start + y_offset) * stride + x_offset + x1 - x_start) * 2, (x2 - x1) * 2);
+  }
+  this->mark_dirty_(x1, y1, x2 - x1, y2 - y1);
 }
 
 void MipiSpi::reset_params_() {
   if (!this->is_ready())
     return;
+  this->wait_for_flush_();
   this->write_command_(this->invert_colors_ ? INVERT_ON : INVERT_OFF);
   if (this->brightness_.has_value())
     this->write_command_(BRIGHTNESS, this->brightness_.value());
@@ -247,11 +301,25 @@ void MipiSpi::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8
     return;
   if (w <= 0 || h <= 0)
     return;
+  // While update() draws a frame the buffer holds what will be shown, so pixels written directly to the display would
+  // be overwritten when the buffer is sent. Outside update(), e.g. from LVGL, pixels still go straight to the display,
+  // unless the buffers are double buffered and the flush task may be sending one of them.
+  if (this->buffer_ != nullptr && ((this->in_update_ && !this->draw_from_origin_) || this->is_double_buffered_())) {
+    if (this->rotation_ == display::DISPLAY_ROTATION_0_DEGREES && bitness == display::COLOR_BITNESS_565 &&
+        this->color_depth_ == display::COLOR_BITNESS_565 && big_endian && order == display::COLOR_ORDER_RGB) {
+      this->copy_to_buffer_(x_start, y_start, w, h, ptr, x_offset, y_offset, x_pad);
+    } else {
+      DisplayBuffer::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
+                                    x_pad);
+    }
+    return;
+  }
   if (bitness != this->color_depth_ || big_endian != (this->bit_order_ == spi::BIT_ORDER_MSB_FIRST)) {
-    Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset, x_pad);
+    DisplayBuffer::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset, x_pad);
     return;
   }
   if (this->draw_from_origin_) {
+    this->wait_for_flush_();
     auto stride = x_offset + w + x_pad;
     for (int y = 0; y != h; y++) {
       memcpy(this->buffer_ + ((y + y_start) * this->width_ + x_start) * 2,
@@ -108,6 +108,12 @@ class MipiSpi : public display::DisplayBuffer,
   }
   void fill(Color color) override;
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_rect_internal(int x, int y, int width, int height, Color color) override;
+  void flush_region_internal(const uint8_t *buffer, const display::DirtyRegion &region) override;
+  void flush_rect_internal(const uint8_t *buffer, int x, int y, int w, int h) override;
+  /// Copy big endian RGB565 pixels into the buffer, which has the same layout when the color depth is 565.
+  void copy_to_buffer_(int x_start, int y_start, int w, int h, const uint8_t *ptr, int x_offset, int y_offset,
+                       int x_pad);
   void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
                       display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
   void write_18_from_16_bit_(const uint16_t *ptr, size_t w, size_t h, size_t stride);
@@ -144,10 +150,6 @@ class MipiSpi : public display::DisplayBuffer,
   GPIOPin *reset_pin_{nullptr};
   std::vector<GPIOPin *> enable_pins_{};
   GPIOPin *dc_pin_{nullptr};
-  uint16_t x_low_{1};
-  uint16_t y_low_{1};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
   bool setup_complete_{};
 
   bool invert_colors_{};
@@ -32,8 +32,10 @@ void MQTTJSONLightComponent::setup() {
 MQTTJSONLightComponent::MQTTJSONLightComponent(LightState *state) : state_(state) {}
 
 bool MQTTJSONLightComponent::publish_state_() {
-  return this->publish_json(this->get_state_topic_(),
-                            [this](JsonObject root) { LightJSONSchema::dump_json(*this->state_, root); });
+  json::JsonWriter writer;
+  auto root = writer.root();
+  LightJSONSchema::dump_json(*this->state_, root);
+  return this->publish(this->get_state_topic_(), writer.str());
 }
 LightState *MQTTJSONLightComponent::get_state() const { return this->state_; }
 
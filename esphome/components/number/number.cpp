@@ -1,4 +1,5 @@
 #include "number.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -11,6 +12,7 @@ void Number::publish_state(float state) {
   this->state = state;
   ESP_LOGD(TAG, "'%s': Sending state %f", this->get_name().c_str(), state);
   this->state_callback_.call(state);
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_NUMBER, this);
 }
 
 void Number::add_on_state_callback(std::function<void(float)> &&callback) {
@@ -0,0 +1,804 @@
+#include "prometheus_exposition.h"
+#ifdef USE_NETWORK
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#ifndef F
+// Only Arduino and web_server_idf define it
+#define F(string_literal) (string_literal)
+#endif
+
+namespace esphome {
+namespace prometheus {
+
+static void append(std::string &out, const char *str) { out.append(str); }
+#ifdef USE_ARDUINO
+/// Strings passed through F() stay in flash on the ESP8266, so they are copied with the _P functions.
+static void append(std::string &out, const __FlashStringHelper *str) {
+  PGM_P data = reinterpret_cast<PGM_P>(str);
+  size_t length = strlen_P(data);
+  size_t offset = out.size();
+  out.resize(offset + length);
+  memcpy_P(&out[offset], data, length);
+}
+#endif
+static void append(std::string &out, const LogString *str) {
+#ifdef USE_STORE_LOG_STR_IN_FLASH
+  append(out, reinterpret_cast<const __FlashStringHelper *>(str));
+#else
+  out.append(LOG_STR_ARG(str));
+#endif
+}
+
+static void append_value(std::string &out, float value) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%.7g", value);
+  out.append(buf);
+}
+static void append_value(std::string &out, int value) { out.append(to_string(value)); }
+static void append_value(std::string &out, bool value) { out.push_back(value ? '1' : '0'); }
+
+/// Start a row of \p metric with the labels of its entity, the row is completed by the caller.
+template<typename S> static void add_metric(std::string &out, S metric, const std::string &labels) {
+  append(out, metric);
+  out.append(labels);
+}
+
+template<typename T> void PrometheusExposition::add_entries_(ControllerDomain domain, const std::vector<T *> &objs) {
+  this->first_entry_[domain] = this->entries_.size();
+  for (T *obj : objs) {
+    this->entries_.emplace_back();
+    if (!obj->is_internal() || this->include_internal_)
+      this->entries_.back().labels = this->render_labels_(obj);
+  }
+}
+
+template<typename T>
+void PrometheusExposition::add_rows_(std::string &out, ControllerDomain domain, const std::vector<T *> &objs,
+                                     void (PrometheusExposition::*row)(std::string &, T *, const std::string &),
+                                     bool &changed) {
+  const std::string &previous = *this->text_;
+  MetricsEntry *entry = &this->entries_[this->first_entry_[domain]];
+  for (T *obj : objs) {
+    uint32_t offset = out.size();
+    if (entry->labels.empty()) {
+      // Not exported
+    } else if (!entry->render) {
+      out.append(previous, entry->offset, entry->length);
+    } else {
+      (this->*row)(out, obj, entry->labels);
+      uint32_t length = out.size() - offset;
+      changed |= length != entry->length || out.compare(offset, length, previous, entry->offset, length) != 0;
+    }
+    entry->offset = offset;
+    entry->length = out.size() - offset;
+    entry++;
+  }
+}
+
+void PrometheusExposition::setup() {
+#ifdef USE_SENSOR
+  this->add_entries_(CONTROLLER_DOMAIN_SENSOR, App.get_sensors());
+#endif
+#ifdef USE_BINARY_SENSOR
+  this->add_entries_(CONTROLLER_DOMAIN_BINARY_SENSOR, App.get_binary_sensors());
+#endif
+#ifdef USE_FAN
+  this->add_entries_(CONTROLLER_DOMAIN_FAN, App.get_fans());
+#endif
+#ifdef USE_LIGHT
+  this->add_entries_(CONTROLLER_DOMAIN_LIGHT, App.get_lights());
+  for (auto *obj : App.get_lights())
+    this->render_lights_ |= !obj->is_internal() || this->include_internal_;
+#endif
+#ifdef USE_COVER
+  this->add_entries_(CONTROLLER_DOMAIN_COVER, App.get_covers());
+#endif
+#ifdef USE_SWITCH
+  this->add_entries_(CONTROLLER_DOMAIN_SWITCH, App.get_switches());
+#endif
+#ifdef USE_LOCK
+  this->add_entries_(CONTROLLER_DOMAIN_LOCK, App.get_locks());
+#endif
+#ifdef USE_TEXT_SENSOR
+  this->add_entries_(CONTROLLER_DOMAIN_TEXT_SENSOR, App.get_text_sensors());
+#endif
+#ifdef USE_NUMBER
+  this->add_entries_(CONTROLLER_DOMAIN_NUMBER, App.get_numbers());
+#endif
+#ifdef USE_SELECT
+  this->add_entries_(CONTROLLER_DOMAIN_SELECT, App.get_selects());
+#endif
+#ifdef USE_MEDIA_PLAYER
+  this->add_entries_(CONTROLLER_DOMAIN_MEDIA_PLAYER, App.get_media_players());
+#endif
+#ifdef USE_UPDATE
+  this->add_entries_(CONTROLLER_DOMAIN_UPDATE, App.get_updates());
+#endif
+#ifdef USE_VALVE
+  this->add_entries_(CONTROLLER_DOMAIN_VALVE, App.get_valves());
+#endif
+#ifdef USE_CLIMATE
+  this->add_entries_(CONTROLLER_DOMAIN_CLIMATE, App.get_climates());
+#endif
+  // Only needed for the labels, which are rendered now
+  this->relabel_map_id_.clear();
+  this->relabel_map_name_.clear();
+
+  this->text_ = std::make_shared<std::string>();
+  this->etag_prefix_ = random_uint32();
+  this->setup_controller(this->include_internal_, /* coalesce_updates= */ true);
+}
+
+bool PrometheusExposition::update() {
+  {
+    // Only the flags are taken under the lock, the main loop does not wait for the rows to be rendered
+    LockGuard guard(this->lock_);
+    if (!this->any_stale_ && !this->render_lights_)
+      return false;
+    // Cleared first, an entity that publishes while its rows are rendered is rendered again on the next scrape
+    this->any_stale_ = false;
+    for (auto &entry : this->entries_) {
+      entry.render = entry.stale;
+      entry.stale = false;
+    }
+  }
+  auto text = std::make_shared<std::string>();
+  text->reserve(this->text_->size());
+  bool changed = this->generation_ == 0;
+
+#ifdef USE_SENSOR
+  this->sensor_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_SENSOR, App.get_sensors(), &PrometheusExposition::sensor_row_, changed);
+#endif
+
+#ifdef USE_BINARY_SENSOR
+  this->binary_sensor_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_BINARY_SENSOR, App.get_binary_sensors(),
+                  &PrometheusExposition::binary_sensor_row_, changed);
+#endif
+
+#ifdef USE_FAN
+  this->fan_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_FAN, App.get_fans(), &PrometheusExposition::fan_row_, changed);
+#endif
+
+#ifdef USE_LIGHT
+  // Light rows show the current values, which change during transitions without a new state being published
+  for (auto *obj : App.get_lights())
+    this->entries_[this->first_entry_[CONTROLLER_DOMAIN_LIGHT] + obj->get_domain_index()].render = true;
+  this->light_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_LIGHT, App.get_lights(), &PrometheusExposition::light_row_, changed);
+#endif
+
+#ifdef USE_COVER
+  this->cover_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_COVER, App.get_covers(), &PrometheusExposition::cover_row_, changed);
+#endif
+
+#ifdef USE_SWITCH
+  this->switch_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_SWITCH, App.get_switches(), &PrometheusExposition::switch_row_, changed);
+#endif
+
+#ifdef USE_LOCK
+  this->lock_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_LOCK, App.get_locks(), &PrometheusExposition::lock_row_, changed);
+#endif
+
+#ifdef USE_TEXT_SENSOR
+  this->text_sensor_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_TEXT_SENSOR, App.get_text_sensors(),
+                  &PrometheusExposition::text_sensor_row_, changed);
+#endif
+
+#ifdef USE_NUMBER
+  this->number_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_NUMBER, App.get_numbers(), &PrometheusExposition::number_row_, changed);
+#endif
+
+#ifdef USE_SELECT
+  this->select_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_SELECT, App.get_selects(), &PrometheusExposition::select_row_, changed);
+#endif
+
+#ifdef USE_MEDIA_PLAYER
+  this->media_player_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_MEDIA_PLAYER, App.get_media_players(),
+                  &PrometheusExposition::media_player_row_, changed);
+#endif
+
+#ifdef USE_UPDATE
+  this->update_entity_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_UPDATE, App.get_updates(), &PrometheusExposition::update_entity_row_,
+                  changed);
+#endif
+
+#ifdef USE_VALVE
+  this->valve_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_VALVE, App.get_valves(), &PrometheusExposition::valve_row_, changed);
+#endif
+
+#ifdef USE_CLIMATE
+  this->climate_type_(*text);
+  this->add_rows_(*text, CONTROLLER_DOMAIN_CLIMATE, App.get_climates(), &PrometheusExposition::climate_row_, changed);
+#endif
+
+  if (!changed)
+    return false;
+  this->text_ = std::move(text);
+  this->generation_++;
+  snprintf(this->etag_, sizeof(this->etag_), "\"%08" PRIx32 "-%" PRIu32 "\"", this->etag_prefix_, this->generation_);
+  return true;
+}
+
+std::string PrometheusExposition::relabel_id_(EntityBase *obj) {
+  auto item = relabel_map_id_.find(obj);
+  return item == relabel_map_id_.end() ? obj->get_object_id() : item->second;
+}
+
+std::string PrometheusExposition::relabel_name_(EntityBase *obj) {
+  auto item = relabel_map_name_.find(obj);
+  return item == relabel_map_name_.end() ? obj->get_name() : item->second;
+}
+
+std::string PrometheusExposition::render_labels_(EntityBase *obj) {
+  std::string labels = "{id=\"";
+  labels += this->relabel_id_(obj);
+  if (!App.get_area().empty()) {
+    labels += "\",area=\"";
+    labels += App.get_area();
+  }
+  if (!App.get_name().empty()) {
+    labels += "\",node=\"";
+    labels += App.get_name();
+  }
+  if (!App.get_friendly_name().empty()) {
+    labels += "\",friendly_name=\"";
+    labels += App.get_friendly_name();
+  }
+  labels += "\",name=\"";
+  labels += this->relabel_name_(obj);
+  labels += '"';
+  return labels;
+}
+
+// Type-specific implementation
+#ifdef USE_SENSOR
+void PrometheusExposition::sensor_type_(std::string &out) {
+  append(out, F("#TYPE esphome_sensor_value gauge\n"));
+  append(out, F("#TYPE esphome_sensor_failed gauge\n"));
+}
+void PrometheusExposition::sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels) {
+  if (!std::isnan(obj->state)) {
+    // We have a valid value, output this value
+    add_metric(out, F("esphome_sensor_failed"), labels);
+    append(out, F("} 0\n"));
+    // Data itself
+    add_metric(out, F("esphome_sensor_value"), labels);
+    append(out, F(",unit=\""));
+    out.append(obj->get_unit_of_measurement());
+    append(out, F("\"} "));
+    out.append(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()));
+    out.push_back('\n');
+  } else {
+    // Invalid state
+    add_metric(out, F("esphome_sensor_failed"), labels);
+    append(out, F("} 1\n"));
+  }
+}
+#endif
+
+// Type-specific implementation
+#ifdef USE_BINARY_SENSOR
+void PrometheusExposition::binary_sensor_type_(std::string &out) {
+  append(out, F("#TYPE esphome_binary_sensor_value gauge\n"));
+  append(out, F("#TYPE esphome_binary_sensor_failed gauge\n"));
+}
+void PrometheusExposition::binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj,
+                                              const std::string &labels) {
+  if (obj->has_state()) {
+    // We have a valid value, output this value
+    add_metric(out, F("esphome_binary_sensor_failed"), labels);
+    append(out, F("} 0\n"));
+    // Data itself
+    add_metric(out, F("esphome_binary_sensor_value"), labels);
+    append(out, F("} "));
+    append_value(out, obj->state);
+    out.push_back('\n');
+  } else {
+    // Invalid state
+    add_metric(out, F("esphome_binary_sensor_failed"), labels);
+    append(out, F("} 1\n"));
+  }
+}
+#endif
+
+#ifdef USE_FAN
+void PrometheusExposition::fan_type_(std::string &out) {
+  append(out, F("#TYPE esphome_fan_value gauge\n"));
+  append(out, F("#TYPE esphome_fan_failed gauge\n"));
+  append(out, F("#TYPE esphome_fan_speed gauge\n"));
+  append(out, F("#TYPE esphome_fan_oscillation gauge\n"));
+}
+void PrometheusExposition::fan_row_(std::string &out, fan::Fan *obj, const std::string &labels) {
+  add_metric(out, F("esphome_fan_failed"), labels);
+  append(out, F("} 0\n"));
+  // Data itself
+  add_metric(out, F("esphome_fan_value"), labels);
+  append(out, F("} "));
+  append_value(out, obj->state);
+  out.push_back('\n');
+  // Speed if available
+  if (obj->get_traits().supports_speed()) {
+    add_metric(out, F("esphome_fan_speed"), labels);
+    append(out, F("} "));
+    append_value(out, obj->speed);
+    out.push_back('\n');
+  }
+  // Oscillation if available
+  if (obj->get_traits().supports_oscillation()) {
+    add_metric(out, F("esphome_fan_oscillation"), labels);
+    append(out, F("} "));
+    append_value(out, obj->oscillating);
+    out.push_back('\n');
+  }
+}
+#endif
+
+#ifdef USE_LIGHT
+void PrometheusExposition::light_type_(std::string &out) {
+  append(out, F("#TYPE esphome_light_state gauge\n"));
+  append(out, F("#TYPE esphome_light_color gauge\n"));
+  append(out, F("#TYPE esphome_light_effect_active gauge\n"));
+}
+void PrometheusExposition::light_row_(std::string &out, light::LightState *obj, const std::string &labels) {
+  // State
+  add_metric(out, F("esphome_light_state"), labels);
+  append(out, F("} "));
+  append_value(out, obj->remote_values.is_on());
+  out.push_back('\n');
+  // Brightness and RGBW
+  light::LightColorValues color = obj->current_values;
+  float brightness, r, g, b, w;
+  color.as_brightness(&brightness);
+  color.as_rgbw(&r, &g, &b, &w);
+  add_metric(out, F("esphome_light_color"), labels);
+  append(out, F(",channel=\"brightness\"} "));
+  append_value(out, brightness);
+  out.push_back('\n');
+  add_metric(out, F("esphome_light_color"), labels);
+  append(out, F(",channel=\"r\"} "));
+  append_value(out, r);
+  out.push_back('\n');
+  add_metric(out, F("esphome_light_color"), labels);
+  append(out, F(",channel=\"g\"} "));
+  append_value(out, g);
+  out.push_back('\n');
+  add_metric(out, F("esphome_light_color"), labels);
+  append(out, F(",channel=\"b\"} "));
+  append_value(out, b);
+  out.push_back('\n');
+  add_metric(out, F("esphome_light_color"), labels);
+  append(out, F(",channel=\"w\"} "));
+  append_value(out, w);
+  out.push_back('\n');
+  // Effect
+  std::string effect = obj->get_effect_name();
+  if (effect == "None") {
+    add_metric(out, F("esphome_light_effect_active"), labels);
+    append(out, F(",effect=\"None\"} 0\n"));
+  } else {
+    add_metric(out, F("esphome_light_effect_active"), labels);
+    append(out, F(",effect=\""));
+    out.append(effect);
+    append(out, F("\"} 1\n"));
+  }
+}
+#endif
+
+#ifdef USE_COVER
+void PrometheusExposition::cover_type_(std::string &out) {
+  append(out, F("#TYPE esphome_cover_value gauge\n"));
+  append(out, F("#TYPE esphome_cover_failed gauge\n"));
+}
+void PrometheusExposition::cover_row_(std::string &out, cover::Cover *obj, const std::string &labels) {
+  if (!std::isnan(obj->position)) {
+    // We have a valid value, output this value
+    add_metric(out, F("esphome_cover_failed"), labels);
+    append(out, F("} 0\n"));
+    // Data itself
+    add_metric(out, F("esphome_cover_value"), labels);
+    append(out, F("} "));
+    append_value(out, obj->position);
+    out.push_back('\n');
+    if (obj->get_traits().get_supports_tilt()) {
+      add_metric(out, F("esphome_cover_tilt"), labels);
+      append(out, F("} "));
+      append_value(out, obj->tilt);
+      out.push_back('\n');
+    }
+  } else {
+    // Invalid state
+    add_metric(out, F("esphome_cover_failed"), labels);
+    append(out, F("} 1\n"));
+  }
+}
+#endif
+
+#ifdef USE_SWITCH
+void PrometheusExposition::switch_type_(std::string &out) {
+  append(out, F("#TYPE esphome_switch_value gauge\n"));
+  append(out, F("#TYPE esphome_switch_failed gauge\n"));
+}
+void PrometheusExposition::switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels) {
+  add_metric(out, F("esphome_switch_failed"), labels);
+  append(out, F("} 0\n"));
+  // Data itself
+  add_metric(out, F("esphome_switch_value"), labels);
+  append(out, F("} "));
+  append_value(out, obj->state);
+  out.push_back('\n');
+}
+#endif
+
+#ifdef USE_LOCK
+void PrometheusExposition::lock_type_(std::string &out) {
+  append(out, F("#TYPE esphome_lock_value gauge\n"));
+  append(out, F("#TYPE esphome_lock_failed gauge\n"));
+}
+void PrometheusExposition::lock_row_(std::string &out, lock::Lock *obj, const std::string &labels) {
+  add_metric(out, F("esphome_lock_failed"), labels);
+  append(out, F("} 0\n"));
+  // Data itself
+  add_metric(out, F("esphome_lock_value"), labels);
+  append(out, F("} "));
+  append_value(out, obj->state);
+  out.push_back('\n');
+}
+#endif
+
+// Type-specific implementation
+#ifdef USE_TEXT_SENSOR
+void PrometheusExposition::text_sensor_type_(std::string &out) {
+  append(out, F("#TYPE esphome_text_sensor_value gauge\n"));
+  append(out, F("#TYPE esphome_text_sensor_failed gauge\n"));
+}
+void PrometheusExposition::text_sensor_row_(std::string &out, text_sensor::TextSensor *obj, const std::string &labels) {
+  if (obj->has_state()) {
+    // We have a valid value, output this value
+    add_metric(out, F("esphome_text_sensor_failed"), labels);
+    append(out, F("} 0\n"));
+    // Data itself
+    add_metric(out, F("esphome_text_sensor_value"), labels);
+    append(out, F(",value=\""));
+    out.append(obj->state);
+    append(out, F("\"} "));
+    append(out, F("1.0"));
+    out.push_back('\n');
+  } else {
+    // Invalid state
+    add_metric(out, F("esphome_text_sensor_failed"), labels);
+    append(out, F("} 1\n"));
+  }
+}
+#endif
+
+// Type-specific implementation
+#ifdef USE_NUMBER
+void PrometheusExposition::number_type_(std::string &out) {
+  append(out, F("#TYPE esphome_number_value gauge\n"));
+  append(out, F("#TYPE esphome_number_failed gauge\n"));
+}
+void PrometheusExposition::number_row_(std::string &out, number::Number *obj, const std::string &labels) {
+  if (!std::isnan(obj->state)) {
+    // We have a valid value, output this value
+    add_metric(out, F("esphome_number_failed"), labels);
+    append(out, F("} 0\n"));
+    // Data itself
+    add_metric(out, F("esphome_number_value"), labels);
+    append(out, F("} "));
+    append_value(out, obj->state);
+    out.push_back('\n');
+  } else {
+    // Invalid state
+    add_metric(out, F("esphome_number_failed"), labels);
+    append(out, F("} 1\n"));
+  }
+}
+#endif
+
+#ifdef USE_SELECT
+void PrometheusExposition::select_type_(std::string &out) {
+  append(out, F("#TYPE esphome_select_value gauge\n"));
+  append(out, F("#TYPE esphome_select_failed gauge\n"));
+}
+void PrometheusExposition::select_row_(std::string &out, select::Select *obj, const std::string &labels) {
+  if (obj->has_state()) {
+    // We have a valid value, output this value
+    add_metric(out, F("esphome_select_failed"), labels);
+    append(out, F("} 0\n"));
+    // Data itself
+    add_metric(out, F("esphome_select_value"), labels);
+    append(out, F(",value=\""));
+    out.append(obj->state);
+    append(out, F("\"} "));
+    append(out, F("1.0"));
+    out.push_back('\n');
+  } else {
+    // Invalid state
+    add_metric(out, F("esphome_select_failed"), labels);
+    append(out, F("} 1\n"));
+  }
+}
+#endif
+
+#ifdef USE_MEDIA_PLAYER
+void PrometheusExposition::media_player_type_(std::string &out) {
+  append(out, F("#TYPE esphome_media_player_state_value gauge\n"));
+  append(out, F("#TYPE esphome_media_player_volume gauge\n"));
+  append(out, F("#TYPE esphome_media_player_is_muted gauge\n"));
+  append(out, F("#TYPE esphome_media_player_failed gauge\n"));
+}
+void PrometheusExposition::media_player_row_(std::string &out, media_player::MediaPlayer *obj,
+                                             const std::string &labels) {
+  add_metric(out, F("esphome_media_player_failed"), labels);
+  append(out, F("} 0\n"));
+  // Data itself
+  add_metric(out, F("esphome_media_player_state_value"), labels);
+  append(out, F(",value=\""));
+  out.append(media_player::media_player_state_to_string(obj->state));
+  append(out, F("\"} "));
+  append(out, F("1.0"));
+  out.push_back('\n');
+  add_metric(out, F("esphome_media_player_volume"), labels);
+  append(out, F("} "));
+  append_value(out, obj->volume);
+  out.push_back('\n');
+  add_metric(out, F("esphome_media_player_is_muted"), labels);
+  append(out, F("} "));
+  if (obj->is_muted()) {
+    append(out, F("1.0"));
+  } else {
+    append(out, F("0.0"));
+  }
+  out.push_back('\n');
+}
+#endif
+
+#ifdef USE_UPDATE
+void PrometheusExposition::update_entity_type_(std::string &out) {
+  append(out, F("#TYPE esphome_update_entity_state gauge\n"));
+  append(out, F("#TYPE esphome_update_entity_info gauge\n"));
+  append(out, F("#TYPE esphome_update_entity_failed gauge\n"));
+}
+
+void PrometheusExposition::handle_update_state_(std::string &out, update::UpdateState state) {
+  switch (state) {
+    case update::UpdateState::UPDATE_STATE_UNKNOWN:
+      out.append("unknown");
+      break;
+    case update::UpdateState::UPDATE_STATE_NO_UPDATE:
+      out.append("none");
+      break;
+    case update::UpdateState::UPDATE_STATE_AVAILABLE:
+      out.append("available");
+      break;
+    case update::UpdateState::UPDATE_STATE_INSTALLING:
+      out.append("installing");
+      break;
+    default:
+      out.append("invalid");
+      break;
+  }
+}
+
+void PrometheusExposition::update_entity_row_(std::string &out, update::UpdateEntity *obj, const std::string &labels) {
+  if (obj->has_state()) {
+    // We have a valid value, output this value
+    add_metric(out, F("esphome_update_entity_failed"), labels);
+    append(out, F("} 0\n"));
+    // First update state
+    add_metric(out, F("esphome_update_entity_state"), labels);
+    append(out, F(",value=\""));
+    handle_update_state_(out, obj->state);
+    append(out, F("\"} "));
+    append(out, F("1.0"));
+    out.push_back('\n');
+    // Next update info
+    add_metric(out, F("esphome_update_entity_info"), labels);
+    append(out, F(",current_version=\""));
+    out.append(obj->update_info.current_version);
+    append(out, F("\",latest_version=\""));
+    out.append(obj->update_info.latest_version);
+    append(out, F("\",title=\""));
+    out.append(obj->update_info.title);
+    append(out, F("\"} "));
+    append(out, F("1.0"));
+    out.push_back('\n');
+  } else {
+    // Invalid state
+    add_metric(out, F("esphome_update_entity_failed"), labels);
+    append(out, F("} 1\n"));
+  }
+}
+#endif
+
+#ifdef USE_VALVE
+void PrometheusExposition::valve_type_(std::string &out) {
+  append(out, F("#TYPE esphome_valve_operation gauge\n"));
+  append(out, F("#TYPE esphome_valve_failed gauge\n"));
+  append(out, F("#TYPE esphome_valve_position gauge\n"));
+}
+
+void PrometheusExposition::valve_row_(std::string &out, valve::Valve *obj, const std::string &labels) {
+  add_metric(out, F("esphome_valve_failed"), labels);
+  append(out, F("} 0\n"));
+  // Data itself
+  add_metric(out, F("esphome_valve_operation"), labels);
+  append(out, F(",operation=\""));
+  out.append(valve::valve_operation_to_str(obj->current_operation));
+  append(out, F("\"} "));
+  append(out, F("1.0"));
+  out.push_back('\n');
+  // Now see if position is supported
+  if (obj->get_traits().get_supports_position()) {
+    add_metric(out, F("esphome_valve_position"), labels);
+    append(out, F("} "));
+    append_value(out, obj->position);
+    out.push_back('\n');
+  }
+}
+#endif
+
+#ifdef USE_CLIMATE
+void PrometheusExposition::climate_type_(std::string &out) {
+  append(out, F("#TYPE esphome_climate_setting gauge\n"));
+  append(out, F("#TYPE esphome_climate_value gauge\n"));
+  append(out, F("#TYPE esphome_climate_failed gauge\n"));
+}
+
+void PrometheusExposition::climate_setting_row_(std::string &out, const std::string &labels, const char *category,
+                                                const LogString *setting_value) {
+  add_metric(out, F("esphome_climate_setting"), labels);
+  append(out, F(",category=\""));
+  out.append(category);
+  append(out, F("\",setting_value=\""));
+  append(out, setting_value);
+  append(out, F("\"} "));
+  append(out, F("1.0"));
+  out.push_back('\n');
+}
+
+void PrometheusExposition::climate_value_row_(std::string &out, const std::string &labels, const char *category,
+                                              const std::string &climate_value) {
+  add_metric(out, F("esphome_climate_value"), labels);
+  append(out, F(",category=\""));
+  out.append(category);
+  append(out, F("\"} "));
+  out.append(climate_value);
+  out.push_back('\n');
+}
+
+void PrometheusExposition::climate_failed_row_(std::string &out, const std::string &labels, const char *category,
+                                               bool is_failed_value) {
+  add_metric(out, F("esphome_climate_failed"), labels);
+  append(out, F(",category=\""));
+  out.append(category);
+  append(out, F("\"} "));
+  if (is_failed_value) {
+    append(out, F("1.0"));
+  } else {
+    append(out, F("0.0"));
+  }
+  out.push_back('\n');
+}
+
+void PrometheusExposition::climate_row_(std::string &out, climate::Climate *obj, const std::string &labels) {
+  // Data itself
+  bool any_failures = false;
+  const char *climate_mode_category = "mode";
+  const auto *climate_mode_value = climate::climate_mode_to_string(obj->mode);
+  climate_setting_row_(out, labels, climate_mode_category, climate_mode_value);
+  const auto traits = obj->get_traits();
+  // Now see if traits is supported
+  int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
+  int8_t current_accuracy = traits.get_current_temperature_accuracy_decimals();
+  // max temp
+  const char *max_temp = "maximum_temperature";
+  auto max_temp_value = value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy);
+  climate_value_row_(out, labels, max_temp, max_temp_value);
+  // max temp
+  const char *min_temp = "mininum_temperature";
+  auto min_temp_value = value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy);
+  climate_value_row_(out, labels, min_temp, min_temp_value);
+  // now check optional traits
+  if (traits.get_supports_current_temperature()) {
+    const char *current_temp = "current_temperature";
+    if (std::isnan(obj->current_temperature)) {
+      climate_failed_row_(out, labels, current_temp, true);
+      any_failures = true;
+    } else {
+      auto current_temp_value = value_accuracy_to_string(obj->current_temperature, current_accuracy);
+      climate_value_row_(out, labels, current_temp, current_temp_value);
+      climate_failed_row_(out, labels, current_temp, false);
+    }
+  }
+  if (traits.get_supports_current_humidity()) {
+    const char *current_humidity = "current_humidity";
+    if (std::isnan(obj->current_humidity)) {
+      climate_failed_row_(out, labels, current_humidity, true);
+      any_failures = true;
+    } else {
+      auto current_humidity_value = value_accuracy_to_string(obj->current_humidity, 0);
+      climate_value_row_(out, labels, current_humidity, current_humidity_value);
+      climate_failed_row_(out, labels, current_humidity, false);
+    }
+  }
+  if (traits.get_supports_target_humidity()) {
+    const char *target_humidity = "target_humidity";
+    if (std::isnan(obj->target_humidity)) {
+      climate_failed_row_(out, labels, target_humidity, true);
+      any_failures = true;
+    } else {
+      auto target_humidity_value = value_accuracy_to_string(obj->target_humidity, 0);
+      climate_value_row_(out, labels, target_humidity, target_humidity_value);
+      climate_failed_row_(out, labels, target_humidity, false);
+    }
+  }
+  if (traits.get_supports_two_point_target_temperature()) {
+    const char *target_temp_low = "target_temperature_low";
+    auto target_temp_low_value = value_accuracy_to_string(obj->target_temperature_low, target_accuracy);
+    climate_value_row_(out, labels, target_temp_low, target_temp_low_value);
+    const char *target_temp_high = "target_temperature_high";
+    auto target_temp_high_value = value_accuracy_to_string(obj->target_temperature_high, target_accuracy);
+    climate_value_row_(out, labels, target_temp_high, target_temp_high_value);
+  } else {
+    const char *target_temp = "target_temperature";
+    auto target_temp_value = value_accuracy_to_string(obj->target_temperature, target_accuracy);
+    climate_value_row_(out, labels, target_temp, target_temp_value);
+  }
+  if (traits.get_supports_action()) {
+    const char *climate_trait_category = "action";
+    const auto *climate_trait_value = climate::climate_action_to_string(obj->action);
+    climate_setting_row_(out, labels, climate_trait_category, climate_trait_value);
+  }
+  if (traits.get_supports_fan_modes()) {
+    const char *climate_trait_category = "fan_mode";
+    if (obj->fan_mode.has_value()) {
+      const auto *climate_trait_value = climate::climate_fan_mode_to_string(obj->fan_mode.value());
+      climate_setting_row_(out, labels, climate_trait_category, climate_trait_value);
+      climate_failed_row_(out, labels, climate_trait_category, false);
+    } else {
+      climate_failed_row_(out, labels, climate_trait_category, true);
+      any_failures = true;
+    }
+  }
+  if (traits.get_supports_presets()) {
+    const char *climate_trait_category = "preset";
+    if (obj->preset.has_value()) {
+      const auto *climate_trait_value = climate::climate_preset_to_string(obj->preset.value());
+      climate_setting_row_(out, labels, climate_trait_category, climate_trait_value);
+      climate_failed_row_(out, labels, climate_trait_category, false);
+    } else {
+      climate_failed_row_(out, labels, climate_trait_category, true);
+      any_failures = true;
+    }
+  }
+  if (traits.get_supports_swing_modes()) {
+    const char *climate_trait_category = "swing_mode";
+    const auto *climate_trait_value = climate::climate_swing_mode_to_string(obj->swing_mode);
+    climate_setting_row_(out, labels, climate_trait_category, climate_trait_value);
+  }
+  const char *all_climate_category = "all";
+  climate_failed_row_(out, labels, all_climate_category, any_failures);
+}
+#endif
+
+}  // namespace prometheus
+}  // namespace esphome
+#endif
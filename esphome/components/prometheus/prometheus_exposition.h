@@ -0,0 +1,261 @@
+#pragma once
+#include "esphome/core/defines.h"
+#ifdef USE_NETWORK
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "esphome/core/controller.h"
+#include "esphome/core/entity_base.h"
+#include "esphome/core/helpers.h"
+#ifdef USE_CLIMATE
+#include "esphome/core/log.h"
+#endif
+
+namespace esphome {
+namespace prometheus {
+
+/** The state of all entities in the Prometheus text format.
+ *
+ * The rows of each entity are rendered once and kept, labels included. An entity that publishes a new state is marked
+ * stale through the Controller dirty bits, and update() renders only the rows of stale entities again and copies the
+ * rest. Every version of the text has its own ETag.
+ */
+class PrometheusExposition : public Controller {
+ public:
+  /** Determine whether internal components should be exported as metrics.
+   * Defaults to false.
+   *
+   * @param include_internal Whether internal components should be exported.
+   */
+  void set_include_internal(bool include_internal) { include_internal_ = include_internal; }
+
+  /** Add the value for an entity's "id" label.
+   *
+   * @param obj The entity for which to set the "id" label
+   * @param value The value for the "id" label
+   */
+  void add_label_id(EntityBase *obj, const std::string &value) { relabel_map_id_.insert({obj, value}); }
+
+  /** Add the value for an entity's "name" label.
+   *
+   * @param obj The entity for which to set the "name" label
+   * @param value The value for the "name" label
+   */
+  void add_label_name(EntityBase *obj, const std::string &value) { relabel_map_name_.insert({obj, value}); }
+
+  /// Render the labels of the entities registered with App and start receiving their state changes.
+  void setup();
+  /// Mark the entities that published a new state since the last call stale, called from the main loop.
+  void loop() { this->process_entity_updates_(); }
+  /// Render the rows of stale entities into a new text, returns true if it changed. Called by one task at a time.
+  bool update();
+  /// The text as of the last update(), shared so it can be sent while the next update() replaces it.
+  const std::shared_ptr<std::string> &get_text() const { return this->text_; }
+  /// The quoted ETag of the text as of the last update().
+  const char *get_etag() const { return this->etag_; }
+
+#ifdef USE_SENSOR
+  void on_sensor_update(sensor::Sensor *obj, float state) override { this->mark_stale_(CONTROLLER_DOMAIN_SENSOR, obj); }
+#endif
+#ifdef USE_BINARY_SENSOR
+  void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override {
+    this->mark_stale_(CONTROLLER_DOMAIN_BINARY_SENSOR, obj);
+  }
+#endif
+#ifdef USE_FAN
+  void on_fan_update(fan::Fan *obj) override { this->mark_stale_(CONTROLLER_DOMAIN_FAN, obj); }
+#endif
+#ifdef USE_COVER
+  void on_cover_update(cover::Cover *obj) override { this->mark_stale_(CONTROLLER_DOMAIN_COVER, obj); }
+#endif
+#ifdef USE_SWITCH
+  void on_switch_update(switch_::Switch *obj, bool state) override { this->mark_stale_(CONTROLLER_DOMAIN_SWITCH, obj); }
+#endif
+#ifdef USE_LOCK
+  void on_lock_update(lock::Lock *obj) override { this->mark_stale_(CONTROLLER_DOMAIN_LOCK, obj); }
+#endif
+#ifdef USE_TEXT_SENSOR
+  void on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) override {
+    this->mark_stale_(CONTROLLER_DOMAIN_TEXT_SENSOR, obj);
+  }
+#endif
+#ifdef USE_NUMBER
+  void on_number_update(number::Number *obj, float state) override { this->mark_stale_(CONTROLLER_DOMAIN_NUMBER, obj); }
+#endif
+#ifdef USE_SELECT
+  void on_select_update(select::Select *obj, const std::string &state, size_t index) override {
+    this->mark_stale_(CONTROLLER_DOMAIN_SELECT, obj);
+  }
+#endif
+#ifdef USE_MEDIA_PLAYER
+  void on_media_player_update(media_player::MediaPlayer *obj) override {
+    this->mark_stale_(CONTROLLER_DOMAIN_MEDIA_PLAYER, obj);
+  }
+#endif
+#ifdef USE_UPDATE
+  void on_update(update::UpdateEntity *obj) override { this->mark_stale_(CONTROLLER_DOMAIN_UPDATE, obj); }
+#endif
+#ifdef USE_VALVE
+  void on_valve_update(valve::Valve *obj) override { this->mark_stale_(CONTROLLER_DOMAIN_VALVE, obj); }
+#endif
+#ifdef USE_CLIMATE
+  void on_climate_update(climate::Climate *obj) override { this->mark_stale_(CONTROLLER_DOMAIN_CLIMATE, obj); }
+#endif
+
+ protected:
+  /// The cached rows of one entity.
+  struct MetricsEntry {
+    /// The labels shared by all rows of the entity, empty if it is not exported.
+    std::string labels;
+    /// Where the rows are in the text.
+    uint32_t offset{0};
+    uint32_t length{0};
+    /// Set by the main loop when the entity published a new state since its rows were rendered. Guarded by lock_.
+    bool stale{true};
+    /// Whether the text that is being built renders the rows again, taken from stale under lock_.
+    bool render{false};
+  };
+
+  std::string relabel_id_(EntityBase *obj);
+  std::string relabel_name_(EntityBase *obj);
+  /// Render the labels that every row of \p obj starts with.
+  std::string render_labels_(EntityBase *obj);
+  template<typename T> void add_entries_(ControllerDomain domain, const std::vector<T *> &objs);
+  void mark_stale_(ControllerDomain domain, EntityBase *obj) {
+    LockGuard guard(this->lock_);
+    this->entries_[this->first_entry_[domain] + obj->get_domain_index()].stale = true;
+    this->any_stale_ = true;
+  }
+  template<typename T>
+  void add_rows_(std::string &out, ControllerDomain domain, const std::vector<T *> &objs,
+                 void (PrometheusExposition::*row)(std::string &, T *, const std::string &), bool &changed);
+
+#ifdef USE_SENSOR
+  /// Return the type for prometheus
+  void sensor_type_(std::string &out);
+  /// Return the sensor state as prometheus data point
+  void sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels);
+#endif
+
+#ifdef USE_BINARY_SENSOR
+  /// Return the type for prometheus
+  void binary_sensor_type_(std::string &out);
+  /// Return the binary sensor state as prometheus data point
+  void binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj, const std::string &labels);
+#endif
+
+#ifdef USE_FAN
+  /// Return the type for prometheus
+  void fan_type_(std::string &out);
+  /// Return the fan state as prometheus data point
+  void fan_row_(std::string &out, fan::Fan *obj, const std::string &labels);
+#endif
+
+#ifdef USE_LIGHT
+  /// Return the type for prometheus
+  void light_type_(std::string &out);
+  /// Return the light values state as prometheus data point
+  void light_row_(std::string &out, light::LightState *obj, const std::string &labels);
+#endif
+
+#ifdef USE_COVER
+  /// Return the type for prometheus
+  void cover_type_(std::string &out);
+  /// Return the cover values state as prometheus data point
+  void cover_row_(std::string &out, cover::Cover *obj, const std::string &labels);
+#endif
+
+#ifdef USE_SWITCH
+  /// Return the type for prometheus
+  void switch_type_(std::string &out);
+  /// Return the switch values state as prometheus data point
+  void switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels);
+#endif
+
+#ifdef USE_LOCK
+  /// Return the type for prometheus
+  void lock_type_(std::string &out);
+  /// Return the lock values state as prometheus data point
+  void lock_row_(std::string &out, lock::Lock *obj, const std::string &labels);
+#endif
+
+#ifdef USE_TEXT_SENSOR
+  /// Return the type for prometheus
+  void text_sensor_type_(std::string &out);
+  /// Return the text sensor values state as prometheus data point
+  void text_sensor_row_(std::string &out, text_sensor::TextSensor *obj, const std::string &labels);
+#endif
+
+#ifdef USE_NUMBER
+  /// Return the type for prometheus
+  void number_type_(std::string &out);
+  /// Return the number state as prometheus data point
+  void number_row_(std::string &out, number::Number *obj, const std::string &labels);
+#endif
+
+#ifdef USE_SELECT
+  /// Return the type for prometheus
+  void select_type_(std::string &out);
+  /// Return the select state as prometheus data point
+  void select_row_(std::string &out, select::Select *obj, const std::string &labels);
+#endif
+
+#ifdef USE_MEDIA_PLAYER
+  /// Return the type for prometheus
+  void media_player_type_(std::string &out);
+  /// Return the media player state as prometheus data point
+  void media_player_row_(std::string &out, media_player::MediaPlayer *obj, const std::string &labels);
+#endif
+
+#ifdef USE_UPDATE
+  /// Return the type for prometheus
+  void update_entity_type_(std::string &out);
+  /// Return the update state and info as prometheus data point
+  void update_entity_row_(std::string &out, update::UpdateEntity *obj, const std::string &labels);
+  void handle_update_state_(std::string &out, update::UpdateState state);
+#endif
+
+#ifdef USE_VALVE
+  /// Return the type for prometheus
+  void valve_type_(std::string &out);
+  /// Return the valve state as prometheus data point
+  void valve_row_(std::string &out, valve::Valve *obj, const std::string &labels);
+#endif
+
+#ifdef USE_CLIMATE
+  /// Return the type for prometheus
+  void climate_type_(std::string &out);
+  /// Return the climate state as prometheus data point
+  void climate_row_(std::string &out, climate::Climate *obj, const std::string &labels);
+  void climate_failed_row_(std::string &out, const std::string &labels, const char *category, bool is_failed_value);
+  void climate_setting_row_(std::string &out, const std::string &labels, const char *category,
+                            const LogString *setting_value);
+  void climate_value_row_(std::string &out, const std::string &labels, const char *category,
+                          const std::string &climate_value);
+#endif
+
+  bool include_internal_{false};
+  std::map<EntityBase *, std::string> relabel_map_id_;
+  std::map<EntityBase *, std::string> relabel_map_name_;
+  /// One entry per entity of every exported domain, in the order of the text.
+  std::vector<MetricsEntry> entries_;
+  /// Index of the first entry of each domain, entities follow in the order of their domain index.
+  uint16_t first_entry_[CONTROLLER_DOMAIN_COUNT]{};
+  /** Guards the stale flags and any_stale_. They are set from the main loop, but update() is called in the task of
+   * the web server on ESP-IDF and by the async TCP task on ESP32 Arduino.
+   */
+  Mutex lock_;
+  bool any_stale_{true};
+  /// Set if any light is exported, light rows are rendered again on every update().
+  bool render_lights_{false};
+  std::shared_ptr<std::string> text_;
+  uint32_t etag_prefix_{0};
+  uint32_t generation_{0};
+  char etag_[24]{};
+};
+
+}  // namespace prometheus
+}  // namespace esphome
+#endif
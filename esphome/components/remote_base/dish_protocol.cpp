@@ -65,7 +65,8 @@ optional<DishData> DishProtocol::decode(RemoteReceiveData src) {
     }
   }
 
-  for (uint8_t mask = 1UL; mask < 1UL << 5; mask <<= 1) {
+  // ADDRESS (unit code - 1, 4 bits like the encoder sends)
+  for (uint8_t mask = 1UL; mask < 1UL << 4; mask <<= 1) {
     if (src.expect_item(BIT_HIGH_US, BIT_ONE_LOW_US)) {
       data.address |= mask;
     } else if (src.expect_item(BIT_HIGH_US, BIT_ZERO_LOW_US)) {
@@ -10,6 +10,7 @@ struct DishData {
   uint8_t command;
 
   bool operator==(const DishData &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return remote_hash(address, command); }
 };
 
 class DishProtocol : public RemoteProtocol<DishData> {
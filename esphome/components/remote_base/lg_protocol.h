@@ -13,6 +13,7 @@ struct LGData {
   uint8_t nbits;
 
   bool operator==(const LGData &rhs) const { return data == rhs.data && nbits == rhs.nbits; }
+  uint32_t hash() const { return remote_hash(data, nbits); }
 };
 
 class LGProtocol : public RemoteProtocol<LGData> {
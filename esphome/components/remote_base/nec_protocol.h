@@ -11,6 +11,7 @@ struct NECData {
   uint16_t command_repeats;
 
   bool operator==(const NECData &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return remote_hash(address, command); }
 };
 
 class NECProtocol : public RemoteProtocol<NECData> {
@@ -13,6 +13,7 @@ struct PanasonicData {
   uint32_t command;
 
   bool operator==(const PanasonicData &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return remote_hash(address, command); }
 };
 
 class PanasonicProtocol : public RemoteProtocol<PanasonicData> {
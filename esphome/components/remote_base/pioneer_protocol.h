@@ -10,6 +10,7 @@ struct PioneerData {
   uint16_t rc_code_2;
 
   bool operator==(const PioneerData &rhs) const { return rc_code_1 == rhs.rc_code_1 && rc_code_2 == rhs.rc_code_2; }
+  uint32_t hash() const { return remote_hash(rc_code_1, rc_code_2); }
 };
 
 class PioneerProtocol : public RemoteProtocol<PioneerData> {
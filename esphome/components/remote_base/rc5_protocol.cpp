@@ -41,43 +41,49 @@ optional<RC5Data> RC5Protocol::decode(RemoteReceiveData src) {
       .address = 0,
       .command = 0,
   };
-  uint8_t field_bit;
 
-  if (src.expect_space(BIT_TIME_US) && src.expect_mark(BIT_TIME_US)) {
-    field_bit = 1;
-  } else if (src.expect_space(2 * BIT_TIME_US)) {
-    field_bit = 0;
-  } else {
-    return {};
-  }
-
-  if (!(((src.expect_space(BIT_TIME_US) || src.peek_space(2 * BIT_TIME_US)) ||
-         (src.expect_mark(BIT_TIME_US) || src.peek_mark(2 * BIT_TIME_US))) &&
-        (((src.expect_mark(BIT_TIME_US) || src.expect_mark(2 * BIT_TIME_US)) &&
-          (src.expect_space(BIT_TIME_US) || src.peek_space(2 * BIT_TIME_US))) ||
-         ((src.expect_space(BIT_TIME_US) || src.expect_space(2 * BIT_TIME_US)) &&
-          (src.expect_mark(BIT_TIME_US) || src.peek_mark(2 * BIT_TIME_US)))))) {
-    return {};
-  }
-
-  uint32_t out_data = 0;
-  for (int bit = NBITS - 4; bit >= 1; bit--) {
-    if ((src.expect_space(BIT_TIME_US) || src.expect_space(2 * BIT_TIME_US)) &&
-        (src.expect_mark(BIT_TIME_US) || src.peek_mark(2 * BIT_TIME_US))) {
-      out_data |= 0 << bit;
-    } else if ((src.expect_mark(BIT_TIME_US) || src.expect_mark(2 * BIT_TIME_US)) &&
-               (src.expect_space(BIT_TIME_US) || src.peek_space(2 * BIT_TIME_US))) {
-      out_data |= 1 << bit;
+  // Manchester coded, a one is a space then a mark and a zero a mark then a space. Receivers start recording at the
+  // first mark, so the space before it, the first half of the start bit, is implied. If the silence before the frame
+  // was recorded, it stands for that half.
+  bool halves[2 * NBITS];
+  uint8_t count = 1;
+  halves[0] = false;
+  if (src.peek_space_at_least(BIT_TIME_US))
+    src.advance();
+  while (count < 2 * NBITS) {
+    if (!src.is_valid()) {
+      // The last half of a zero is silence, which the receiver may not have recorded
+      if (count != 2 * NBITS - 1)
+        return {};
+      halves[count++] = false;
+      break;
+    }
+    bool mark = src.peek() > 0;
+    uint8_t units;
+    if (src.peek_mark(BIT_TIME_US) || src.peek_space(BIT_TIME_US)) {
+      units = 1;
+    } else if (src.peek_mark(2 * BIT_TIME_US) || src.peek_space(2 * BIT_TIME_US)) {
+      units = 2;
+    } else if (count == 2 * NBITS - 1 && src.peek_space_at_least(BIT_TIME_US)) {
+      // The last half of a zero runs into the silence after the frame
+      units = 1;
     } else {
       return {};
     }
+    src.advance();
+    for (; units != 0 && count < 2 * NBITS; units--)
+      halves[count++] = mark;
   }
-  if (src.expect_space(BIT_TIME_US) || src.expect_space(2 * BIT_TIME_US)) {
-    out_data |= 0;
-  } else if (src.expect_mark(BIT_TIME_US) || src.expect_mark(2 * BIT_TIME_US)) {
-    out_data |= 1;
+
+  uint32_t out_data = 0;
+  for (uint8_t bit = 0; bit < NBITS; bit++) {
+    if (halves[2 * bit] == halves[2 * bit + 1])
+      return {};
+    out_data = (out_data << 1) | halves[2 * bit + 1];
   }
 
+  // The second start bit is the inverted seventh command bit
+  uint8_t field_bit = (out_data >> 12) & 1;
   out.command = (uint8_t) (out_data & 0x3F) + (1 - field_bit) * 64u;
   out.address = (out_data >> 6) & 0x1F;
   return out;
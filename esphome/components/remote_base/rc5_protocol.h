@@ -11,6 +11,7 @@ struct RC5Data {
   uint8_t command;
 
   bool operator==(const RC5Data &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return remote_hash(address, command); }
 };
 
 class RC5Protocol : public RemoteProtocol<RC5Data> {
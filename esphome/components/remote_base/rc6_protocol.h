@@ -12,6 +12,7 @@ struct RC6Data {
   uint8_t command;
 
   bool operator==(const RC6Data &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return remote_hash(address, command); }
 };
 
 class RC6Protocol : public RemoteProtocol<RC6Data> {
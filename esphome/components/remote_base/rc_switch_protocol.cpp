@@ -26,6 +26,12 @@ RCSwitchBase::RCSwitchBase(uint32_t sync_high, uint32_t sync_low, uint32_t zero_
       one_low_(one_low),
       inverted_(inverted) {}
 
+bool RCSwitchBase::operator==(const RCSwitchBase &rhs) const {
+  return this->sync_high_ == rhs.sync_high_ && this->sync_low_ == rhs.sync_low_ && this->zero_high_ == rhs.zero_high_ &&
+         this->zero_low_ == rhs.zero_low_ && this->one_high_ == rhs.one_high_ && this->one_low_ == rhs.one_low_ &&
+         this->inverted_ == rhs.inverted_;
+}
+
 void RCSwitchBase::one(RemoteTransmitData *dst) const {
   if (!this->inverted_) {
     dst->mark(this->one_high_);
@@ -244,7 +250,47 @@ bool RCSwitchRawReceiver::matches(RemoteReceiveData src) {
   if (!this->protocol_.decode(src, &decoded_code, &decoded_nbits))
     return false;
 
-  return decoded_nbits == this->nbits_ && (decoded_code & this->mask_) == (this->code_ & this->mask_);
+  return this->matches_code(decoded_code, decoded_nbits);
+}
+
+const uint8_t RCSwitchRawGroup::TYPE = 0;
+
+void RCSwitchRawGroup::collect_protocols_() {
+  this->protocol_index_.clear();
+  for (auto *receiver : this->receivers_) {
+    const RCSwitchBase &protocol = receiver->get_protocol();
+    uint8_t i = 0;
+    while (i < this->protocols_.size() && !(this->protocols_[i] == protocol))
+      i++;
+    if (i == this->protocols_.size())
+      this->protocols_.push_back(protocol);
+    this->protocol_index_.push_back(i);
+  }
+}
+
+void RCSwitchRawGroup::on_receive(RemoteReceiveData src) {
+  if (this->protocols_.empty())
+    this->collect_protocols_();
+  for (uint8_t p = 0; p < this->protocols_.size(); p++) {
+    src.reset();
+    uint64_t decoded_code;
+    uint8_t decoded_nbits;
+    if (!this->protocols_[p].decode(src, &decoded_code, &decoded_nbits))
+      continue;
+    for (size_t i = 0; i < this->receivers_.size(); i++) {
+      if (this->protocol_index_[i] == p && this->receivers_[i]->matches_code(decoded_code, decoded_nbits))
+        this->receivers_[i]->publish_received();
+    }
+  }
+}
+
+void RemoteReceiverBase::register_listener(RCSwitchRawReceiver *listener) {
+  auto *group = this->find_group_(&RCSwitchRawGroup::TYPE);
+  if (group == nullptr) {
+    group = new RCSwitchRawGroup();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->groups_.push_back(group);
+  }
+  static_cast<RCSwitchRawGroup *>(group)->add_receiver(listener);
 }
 bool RCSwitchDumper::dump(RemoteReceiveData src) {
   for (uint8_t i = 1; i <= 8; i++) {
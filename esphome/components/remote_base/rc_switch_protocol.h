@@ -11,6 +11,7 @@ struct RCSwitchData {
   uint8_t protocol;
 
   bool operator==(const RCSwitchData &rhs) const { return code == rhs.code && protocol == rhs.protocol; }
+  uint32_t hash() const { return remote_hash(remote_hash(code, code >> 32), protocol); }
 };
 
 class RCSwitchBase {
@@ -21,6 +22,9 @@ class RCSwitchBase {
   RCSwitchBase(uint32_t sync_high, uint32_t sync_low, uint32_t zero_high, uint32_t zero_low, uint32_t one_high,
                uint32_t one_low, bool inverted);
 
+  /// Whether both protocols use the same timings.
+  bool operator==(const RCSwitchBase &rhs) const;
+
   void one(RemoteTransmitData *dst) const;
 
   void zero(RemoteTransmitData *dst) const;
@@ -201,6 +205,12 @@ class RCSwitchRawReceiver : public RemoteReceiverBinarySensorBase {
     RCSwitchBase::type_d_code(u_group, device, state, &this->code_, &this->nbits_);
   }
 
+  const RCSwitchBase &get_protocol() const { return this->protocol_; }
+  /// Whether a frame decoded to \p code with \p nbits bits matches this sensor.
+  bool matches_code(uint64_t code, uint8_t nbits) const {
+    return nbits == this->nbits_ && (code & this->mask_) == (this->code_ & this->mask_);
+  }
+
  protected:
   bool matches(RemoteReceiveData src) override;
 
@@ -210,6 +220,32 @@ class RCSwitchRawReceiver : public RemoteReceiverBinarySensorBase {
   uint8_t nbits_;
 };
 
+/** All RCSwitchRawReceivers of one receiver.
+ *
+ * Each frame is decoded once per distinct protocol timing and compared with the sensors using that timing. The
+ * protocols are collected on the first frame, as they are set after the sensors are registered.
+ */
+class RCSwitchRawGroup : public RemoteReceiverGroupBase {
+ public:
+  static const uint8_t TYPE;
+
+  RCSwitchRawGroup() : RemoteReceiverGroupBase(&TYPE) {}
+  void add_receiver(RCSwitchRawReceiver *receiver) {
+    this->receivers_.push_back(receiver);
+    this->protocols_.clear();
+  }
+  void on_receive(RemoteReceiveData src) override;
+
+ protected:
+  void collect_protocols_();
+
+  std::vector<RCSwitchRawReceiver *> receivers_;
+  /// Distinct protocol timings of the receivers.
+  std::vector<RCSwitchBase> protocols_;
+  /// Index into protocols_ for each receiver.
+  std::vector<uint8_t> protocol_index_;
+};
+
 class RCSwitchDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override;
@@ -90,10 +90,14 @@ bool RemoteReceiveData::expect_pulse_with_gap(uint32_t mark, uint32_t space) {
 bool RemoteReceiverBinarySensorBase::on_receive(RemoteReceiveData src) {
   if (!this->matches(src))
     return false;
+  this->publish_received();
+  return true;
+}
+
+void RemoteReceiverBinarySensorBase::publish_received() {
   this->publish_state(true);
   yield();
   this->publish_state(false);
-  return true;
 }
 
 /* RemoteReceiverBase */
@@ -106,7 +110,17 @@ void RemoteReceiverBase::register_dumper(RemoteReceiverDumperBase *dumper) {
   }
 }
 
+RemoteReceiverGroupBase *RemoteReceiverBase::find_group_(const void *type) {
+  for (auto *group : this->groups_) {
+    if (group->get_type() == type)
+      return group;
+  }
+  return nullptr;
+}
+
 void RemoteReceiverBase::call_listeners_() {
+  for (auto *group : this->groups_)
+    group->on_receive(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_));
   for (auto *listener : this->listeners_)
     listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_));
 }
@@ -1,3 +1,4 @@
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,13 @@ enum ToleranceMode : uint8_t {
 
 using RawTimings = std::vector<int32_t>;
 
+/// Mix \p value into \p hash. ProtocolData::hash() implementations must only hash the fields operator== compares.
+inline uint32_t remote_hash(uint32_t hash, uint32_t value) { return (hash ^ value) * 16777619UL; }
+
+/// True if ProtocolData \p T provides hash(), which lets receivers look up binary sensors instead of comparing each.
+template<typename T, typename = void> struct RemoteDataHashable : std::false_type {};
+template<typename T> struct RemoteDataHashable<T, decltype(void(std::declval<const T &>().hash()))> : std::true_type {};
+
 class RemoteTransmitData {
  public:
   void mark(uint32_t length) { this->data_.push_back(length); }
@@ -202,10 +210,35 @@ class RemoteReceiverDumperBase {
   virtual bool is_secondary() { return false; }
 };
 
+/// Listeners of one receiver that share the decoding of each received frame.
+class RemoteReceiverGroupBase {
+ public:
+  explicit RemoteReceiverGroupBase(const void *type) : type_(type) {}
+  /// Identifies the group class, a receiver holds at most one group per type.
+  const void *get_type() const { return this->type_; }
+  virtual void on_receive(RemoteReceiveData src) = 0;
+
+ protected:
+  const void *type_;
+};
+
+template<typename T> class RemoteReceiverBinarySensor;
+template<typename T> class RemoteReceiverTrigger;
+template<typename T> class RemoteReceiverProtocolGroup;
+class RCSwitchRawReceiver;
+
 class RemoteReceiverBase : public RemoteComponentBase {
  public:
   RemoteReceiverBase(InternalGPIOPin *pin) : RemoteComponentBase(pin) {}
   void register_listener(RemoteReceiverListener *listener) { this->listeners_.push_back(listener); }
+  /// Binary sensors and triggers of a protocol join its group, which decodes each frame only once for all of them.
+  template<typename T> void register_listener(RemoteReceiverBinarySensor<T> *listener) {
+    this->get_protocol_group_<T>()->add_binary_sensor(listener);
+  }
+  template<typename T> void register_listener(RemoteReceiverTrigger<T> *listener) {
+    this->get_protocol_group_<T>()->add_trigger(listener);
+  }
+  void register_listener(RCSwitchRawReceiver *listener);
   void register_dumper(RemoteReceiverDumperBase *dumper);
   void set_tolerance(uint32_t tolerance, ToleranceMode tolerance_mode) {
     this->tolerance_ = tolerance;
@@ -219,7 +252,11 @@ class RemoteReceiverBase : public RemoteComponentBase {
     this->call_listeners_();
     this->call_dumpers_();
   }
+  /// Return the group registered with \p type, or nullptr.
+  RemoteReceiverGroupBase *find_group_(const void *type);
+  template<typename T> RemoteReceiverProtocolGroup<T> *get_protocol_group_();
 
+  std::vector<RemoteReceiverGroupBase *> groups_;
   std::vector<RemoteReceiverListener *> listeners_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
@@ -236,6 +273,8 @@ class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitial
   void dump_config() override;
   virtual bool matches(RemoteReceiveData src) = 0;
   bool on_receive(RemoteReceiveData src) override;
+  /// Publish the short on/off pulse of a matching frame.
+  void publish_received();
 };
 
 /* TEMPLATES */
@@ -261,6 +300,7 @@ template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBin
 
  public:
   void set_data(typename T::ProtocolData data) { data_ = data; }
+  const typename T::ProtocolData &get_data() const { return this->data_; }
 
  protected:
   typename T::ProtocolData data_;
@@ -280,6 +320,102 @@ class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>, public R
   }
 };
 
+/** The binary sensors and triggers of protocol \p T on one receiver.
+ *
+ * A frame is decoded once and the result is handed to every trigger. Binary sensors are found through an open
+ * addressing index if T::ProtocolData provides hash(), otherwise each is compared. Protocols whose operator== has
+ * wildcards must not provide hash(). The index is built on the first frame, as sensor data is set after registration.
+ */
+template<typename T> class RemoteReceiverProtocolGroup : public RemoteReceiverGroupBase {
+ public:
+  using ProtocolData = typename T::ProtocolData;
+  static const uint8_t TYPE;
+
+  RemoteReceiverProtocolGroup() : RemoteReceiverGroupBase(&TYPE) {}
+  void add_binary_sensor(RemoteReceiverBinarySensor<T> *sensor) {
+    this->binary_sensors_.push_back(sensor);
+    this->index_.clear();
+  }
+  void add_trigger(RemoteReceiverTrigger<T> *trigger) { this->triggers_.push_back(trigger); }
+
+  void on_receive(RemoteReceiveData src) override {
+    auto proto = T();
+    auto res = proto.decode(src);
+    if (!res.has_value())
+      return;
+    for (auto *trigger : this->triggers_)
+      trigger->trigger(*res);
+    this->match_(*res, RemoteDataHashable<ProtocolData>{});
+  }
+
+ protected:
+  static uint32_t slot_hash_(const ProtocolData &data) {
+    // Spread the bits over the index (murmur3 finalizer)
+    uint32_t hash = data.hash();
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+  }
+
+  void match_(const ProtocolData &data, std::false_type) {
+    for (auto *sensor : this->binary_sensors_) {
+      if (data == sensor->get_data())
+        sensor->publish_received();
+    }
+  }
+
+  void match_(const ProtocolData &data, std::true_type) {
+    if (this->binary_sensors_.empty())
+      return;
+    if (this->index_.empty())
+      this->build_index_();
+    // Sensors configured with equal data all match, they sit in consecutive occupied slots
+    const uint32_t mask = this->index_.size() - 1;
+    for (uint32_t slot = slot_hash_(data) & mask;; slot = (slot + 1) & mask) {
+      uint16_t i = this->index_[slot];
+      if (i == 0)
+        return;
+      auto *sensor = this->binary_sensors_[i - 1];
+      if (data == sensor->get_data())
+        sensor->publish_received();
+    }
+  }
+
+  void build_index_() {
+    // Keep the index at most half full, so misses end quickly
+    size_t capacity = 8;
+    while (capacity < this->binary_sensors_.size() * 2)
+      capacity *= 2;
+    this->index_.assign(capacity, 0);
+    const uint32_t mask = capacity - 1;
+    for (uint16_t i = 0; i < this->binary_sensors_.size(); i++) {
+      uint32_t slot = slot_hash_(this->binary_sensors_[i]->get_data()) & mask;
+      while (this->index_[slot] != 0)
+        slot = (slot + 1) & mask;
+      this->index_[slot] = i + 1;
+    }
+  }
+
+  std::vector<RemoteReceiverBinarySensor<T> *> binary_sensors_;
+  std::vector<RemoteReceiverTrigger<T> *> triggers_;
+  /// Open addressing table of binary sensor index + 1, 0 marks a free slot. Its size is a power of two.
+  std::vector<uint16_t> index_;
+};
+
+template<typename T> const uint8_t RemoteReceiverProtocolGroup<T>::TYPE = 0;
+
+template<typename T> RemoteReceiverProtocolGroup<T> *RemoteReceiverBase::get_protocol_group_() {
+  auto *group = this->find_group_(&RemoteReceiverProtocolGroup<T>::TYPE);
+  if (group == nullptr) {
+    group = new RemoteReceiverProtocolGroup<T>();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->groups_.push_back(group);
+  }
+  return static_cast<RemoteReceiverProtocolGroup<T> *>(group);
+}
+
 class RemoteTransmittable {
  public:
   RemoteTransmittable() {}
@@ -13,6 +13,7 @@ struct Samsung36Data {
   uint32_t command;
 
   bool operator==(const Samsung36Data &rhs) const { return address == rhs.address && command == rhs.command; }
+  uint32_t hash() const { return remote_hash(address, command); }
 };
 
 class Samsung36Protocol : public RemoteProtocol<Samsung36Data> {
@@ -11,6 +11,7 @@ struct SamsungData {
   uint8_t nbits;
 
   bool operator==(const SamsungData &rhs) const { return data == rhs.data && nbits == rhs.nbits; }
+  uint32_t hash() const { return remote_hash(remote_hash(data, data >> 32), nbits); }
 };
 
 class SamsungProtocol : public RemoteProtocol<SamsungData> {
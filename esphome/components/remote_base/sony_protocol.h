@@ -13,6 +13,7 @@ struct SonyData {
   uint8_t nbits;
 
   bool operator==(const SonyData &rhs) const { return data == rhs.data && nbits == rhs.nbits; }
+  uint32_t hash() const { return remote_hash(data, nbits); }
 };
 
 class SonyProtocol : public RemoteProtocol<SonyData> {
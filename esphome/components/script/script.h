@@ -226,12 +226,17 @@ template<class C, typename... Ts> class ScriptWaitAction : public Action<Ts...>,
       return;
     }
     this->var_ = std::make_tuple(x...);
+    // Poll the script in loop() until it has finished
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      // Nothing is waiting, stop polling until the next play_complex()
+      this->disable_loop();
       return;
+    }
 
     if (this->script_->is_running())
       return;
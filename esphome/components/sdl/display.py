@@ -60,6 +60,7 @@ CONFIG_SCHEMA = cv.All(
                         }
                     ),
                 ),
+                cv.Optional(display.CONF_DOUBLE_BUFFER): cv.boolean,
                 cv.Optional(CONF_WINDOW_OPTIONS): cv.Schema(
                     {
                         cv.Optional(CONF_POSITION): cv.Schema(
@@ -1,6 +1,7 @@
 #ifdef USE_HOST
 #include "sdl_esphome.h"
 #include "esphome/components/display/display_color_utils.h"
+#include <algorithm>
 
 namespace esphome {
 namespace sdl {
@@ -15,18 +16,38 @@ void Sdl::setup() {
   this->texture_ =
       SDL_CreateTexture(this->renderer_, SDL_PIXELFORMAT_RGB565, SDL_TEXTUREACCESS_STATIC, this->width_, this->height_);
   SDL_SetTextureBlendMode(this->texture_, SDL_BLENDMODE_BLEND);
+  this->fill_row_.resize(std::max(this->width_, this->height_));
   ESP_LOGD(TAG, "Setup Complete");
 }
 void Sdl::update() {
+  // A real panel has to finish receiving the previous frame before its buffer can be drawn into again
+  this->present_pending_();
   this->do_update_();
-  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_))
+  uint32_t frame = this->submit_frame_();
+  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
+    this->frame_presented_(frame);
     return;
+  }
   SDL_Rect rect{this->x_low_, this->y_low_, this->x_high_ + 1 - this->x_low_, this->y_high_ + 1 - this->y_low_};
   this->x_low_ = this->width_;
   this->y_low_ = this->height_;
   this->x_high_ = 0;
   this->y_high_ = 0;
+  if (this->double_buffer_) {
+    this->pending_rect_ = rect;
+    this->pending_frame_ = frame;
+    return;
+  }
   this->redraw_(rect);
+  this->frame_presented_(frame);
+}
+
+void Sdl::present_pending_() {
+  if (this->pending_frame_ == 0)
+    return;
+  this->redraw_(this->pending_rect_);
+  this->frame_presented_(this->pending_frame_);
+  this->pending_frame_ = 0;
 }
 
 void Sdl::redraw_(SDL_Rect &rect) {
@@ -44,6 +65,17 @@ void Sdl::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *
     auto data = ptr + (stride * y_offset + x_offset) * 2;
     SDL_UpdateTexture(this->texture_, &rect, data, stride * 2);
   }
+  if (this->double_buffer_) {
+    // shown with the rest of the frame
+    int x1, x2, y1, y2;
+    if (this->clamp_x_(x_start, w, x1, x2) && this->clamp_y_(y_start, h, y1, y2)) {
+      this->x_low_ = std::min<int>(this->x_low_, x1);
+      this->y_low_ = std::min<int>(this->y_low_, y1);
+      this->x_high_ = std::max<int>(this->x_high_, x2 - 1);
+      this->y_high_ = std::max<int>(this->y_high_, y2 - 1);
+    }
+    return;
+  }
   this->redraw_(rect);
 }
 
@@ -61,6 +93,28 @@ void Sdl::draw_pixel_at(int x, int y, Color color) {
     this->y_high_ = y;
 }
 
+void Sdl::fill_span(int x, int y, int width, Color color) { this->fill_rect(x, y, width, 1, color); }
+
+void Sdl::fill_rect(int x, int y, int width, int height, Color color) {
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x, width, x1, x2) || !this->clamp_y_(y, height, y1, y2))
+    return;
+  // The texture is updated row by row from one row buffer, so filling doesn't allocate
+  std::fill_n(this->fill_row_.begin(), x2 - x1, display::ColorUtil::color_to_565(color, display::COLOR_ORDER_RGB));
+  for (int row = y1; row != y2; row++) {
+    SDL_Rect rect{x1, row, x2 - x1, 1};
+    SDL_UpdateTexture(this->texture_, &rect, this->fill_row_.data(), rect.w * 2);
+  }
+  if (x1 < this->x_low_)
+    this->x_low_ = x1;
+  if (y1 < this->y_low_)
+    this->y_low_ = y1;
+  if (x2 - 1 > this->x_high_)
+    this->x_high_ = x2 - 1;
+  if (y2 - 1 > this->y_high_)
+    this->y_high_ = y2 - 1;
+}
+
 void Sdl::process_key(uint32_t keycode, bool down) {
   auto callback = this->key_callbacks_.find(keycode);
   if (callback != this->key_callbacks_.end())
@@ -68,6 +122,7 @@ void Sdl::process_key(uint32_t keycode, bool down) {
 }
 
 void Sdl::loop() {
+  this->present_pending_();
   SDL_Event e;
   if (SDL_PollEvent(&e)) {
     switch (e.type) {
@@ -8,6 +8,7 @@
 #define SDL_MAIN_HANDLED
 #include "SDL.h"
 #include <map>
+#include <vector>
 
 namespace esphome {
 namespace sdl {
@@ -23,12 +24,16 @@ class Sdl : public display::Display {
   void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
                       display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
   void draw_pixel_at(int x, int y, Color color) override;
+  void fill_span(int x, int y, int width, Color color) override;
+  void fill_rect(int x, int y, int width, int height, Color color) override;
   void process_key(uint32_t keycode, bool down);
   void set_dimensions(uint16_t width, uint16_t height) {
     this->width_ = width;
     this->height_ = height;
   }
   void set_window_options(uint32_t window_options) { this->window_options_ = window_options; }
+  /// Emulate a double buffered panel: a frame drawn by update() only reaches the window on the next loop().
+  void set_double_buffer(bool double_buffer) { this->double_buffer_ = double_buffer; }
   void set_position(uint16_t pos_x, uint16_t pos_y) {
     this->pos_x_ = pos_x;
     this->pos_y_ = pos_y;
@@ -52,6 +57,7 @@ class Sdl : public display::Display {
   int get_width_internal() override { return this->width_; }
   int get_height_internal() override { return this->height_; }
   void redraw_(SDL_Rect &rect);
+  void present_pending_();
   int width_{};
   int height_{};
   uint32_t window_options_{0};
@@ -60,10 +66,16 @@ class Sdl : public display::Display {
   SDL_Renderer *renderer_{};
   SDL_Window *window_{};
   SDL_Texture *texture_{};
+  /// One row of pixels in the color of the last fill_rect(), long enough for either orientation.
+  std::vector<uint16_t> fill_row_{};
   uint16_t x_low_{0};
   uint16_t y_low_{0};
   uint16_t x_high_{0};
   uint16_t y_high_{0};
+  bool double_buffer_{false};
+  /// Frame waiting to be presented by loop() when double buffering, 0 if none.
+  uint32_t pending_frame_{0};
+  SDL_Rect pending_rect_{};
   std::map<int32_t, CallbackManager<void(bool)>> key_callbacks_{};
 };
 }  // namespace sdl
@@ -1,4 +1,5 @@
 #include "select.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -14,6 +15,7 @@ void Select::publish_state(const std::string &state) {
     this->state = state;
     ESP_LOGD(TAG, "'%s': Sending state %s (index %zu)", name, state.c_str(), index.value());
     this->state_callback_.call(state, index.value());
+    ControllerRegistry::notify_update(CONTROLLER_DOMAIN_SELECT, this);
   } else {
     ESP_LOGE(TAG, "'%s': invalid state for publish_state(): %s", name, state.c_str());
   }
@@ -31,49 +31,163 @@ void Filter::initialize(Sensor *parent, Filter *next) {
   this->next_ = next;
 }
 
-// MedianFilter
-MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
+// SlidingWindowFilter
+SlidingWindowFilter::SlidingWindowFilter(size_t window_size, size_t send_every, size_t send_first_at)
     : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MedianFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
+void SlidingWindowFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
+void SlidingWindowFilter::set_window_size(size_t window_size) {
+  // Oldest first, only the newest values that still fit
+  std::vector<float> values;
+  size_t keep = std::min(this->count_, window_size);
+  values.reserve(keep);
+  for (size_t i = this->count_ - keep; i < this->count_; i++)
+    values.push_back(this->window_[(this->head_ + this->window_size_ - this->count_ + i) % this->window_size_]);
+
+  this->window_size_ = window_size;
+  this->reset_window_();
+  for (float value : values) {
+    this->count_++;
+    this->window_[this->head_] = value;
+    this->add_value_(this->head_, value);
+    this->head_ = (this->head_ + 1) % this->window_size_;
+  }
+}
+void SlidingWindowFilter::reset_window_() {
+  if (this->window_size_ > this->max_window_size_()) {
+    ESP_LOGW(TAG, "%s(%p) window size %zu is too large, using %zu", this->log_name_(), this, this->window_size_,
+             this->max_window_size_());
+    this->window_size_ = this->max_window_size_();
   }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
+  this->window_.assign(this->window_size_, NAN);
+  this->window_.shrink_to_fit();
+  this->head_ = 0;
+  this->count_ = 0;
+  this->resize_(this->window_size_);
+}
+optional<float> SlidingWindowFilter::new_value(float value) {
+  // Allocated on the first value so subclasses are fully constructed
+  if (this->window_.size() != this->window_size_)
+    this->reset_window_();
+
+  if (this->count_ == this->window_size_) {
+    this->remove_value_(this->head_, this->window_[this->head_]);
+  } else {
+    this->count_++;
+  }
+  this->window_[this->head_] = value;
+  this->add_value_(this->head_, value);
+  if (++this->head_ == this->window_size_)
+    this->head_ = 0;
+  ESP_LOGVV(TAG, "%s(%p)::new_value(%f)", this->log_name_(), this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
-
-    float median = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> median_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          median_queue.push_back(v);
-        }
-      }
-
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size) {
-        if (queue_size % 2) {
-          median = median_queue[queue_size / 2];
-        } else {
-          median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-        }
-      }
-    }
-
-    ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f) SENDING %f", this, value, median);
-    return median;
+    float result = this->compute_result_();
+    ESP_LOGVV(TAG, "%s(%p)::new_value(%f) SENDING %f", this->log_name_(), this, value, result);
+    return result;
   }
   return {};
 }
 
+// OrderStatisticFilter
+void OrderStatisticFilter::resize_(size_t window_size) {
+  this->heap_.assign(window_size, 0);
+  this->heap_.shrink_to_fit();
+  this->heap_size_[LOWER] = 0;
+  this->heap_size_[UPPER] = 0;
+  this->positions_.assign(window_size, NOT_IN_HEAP);
+  this->positions_.shrink_to_fit();
+}
+void OrderStatisticFilter::add_value_(size_t slot, float value) {
+  if (std::isnan(value)) {
+    this->positions_[slot] = NOT_IN_HEAP;
+    return;
+  }
+  this->heap_push_(this->heap_size_[LOWER] == 0 || value <= this->top_(LOWER) ? LOWER : UPPER, slot);
+  this->rebalance_();
+}
+void OrderStatisticFilter::remove_value_(size_t slot, float value) {
+  size_t position = this->positions_[slot];
+  if (position == NOT_IN_HEAP)
+    return;
+  if (position < this->heap_size_[LOWER]) {
+    this->heap_erase_(LOWER, position);
+  } else {
+    this->heap_erase_(UPPER, this->heap_.size() - 1 - position);
+  }
+  this->positions_[slot] = NOT_IN_HEAP;
+  this->rebalance_();
+}
+void OrderStatisticFilter::rebalance_() {
+  size_t target = this->lower_count_(this->valid_count_());
+  while (this->heap_size_[LOWER] > target)
+    this->heap_push_(UPPER, this->heap_erase_(LOWER, 0));
+  while (this->heap_size_[LOWER] < target && this->heap_size_[UPPER] > 0)
+    this->heap_push_(LOWER, this->heap_erase_(UPPER, 0));
+}
+void OrderStatisticFilter::heap_push_(uint8_t heap, size_t slot) {
+  size_t index = this->heap_size_[heap]++;
+  this->heap_set_(heap, index, slot);
+  this->sift_up_(heap, index);
+}
+size_t OrderStatisticFilter::heap_erase_(uint8_t heap, size_t index) {
+  size_t slot = this->entry_(heap, index);
+  size_t last = this->entry_(heap, --this->heap_size_[heap]);
+  if (index < this->heap_size_[heap]) {
+    this->heap_set_(heap, index, last);
+    this->sift_up_(heap, index);
+    size_t position = this->positions_[last];
+    this->sift_down_(heap, heap == LOWER ? position : this->heap_.size() - 1 - position);
+  }
+  return slot;
+}
+void OrderStatisticFilter::heap_set_(uint8_t heap, size_t index, size_t slot) {
+  size_t position = this->array_index_(heap, index);
+  this->heap_[position] = slot;
+  this->positions_[slot] = position;
+}
+void OrderStatisticFilter::sift_up_(uint8_t heap, size_t index) {
+  size_t slot = this->entry_(heap, index);
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    size_t parent_slot = this->entry_(heap, parent);
+    if (!this->above_(heap, slot, parent_slot))
+      break;
+    this->heap_set_(heap, index, parent_slot);
+    index = parent;
+  }
+  this->heap_set_(heap, index, slot);
+}
+void OrderStatisticFilter::sift_down_(uint8_t heap, size_t index) {
+  size_t slot = this->entry_(heap, index);
+  size_t size = this->heap_size_[heap];
+  while (true) {
+    size_t child = index * 2 + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && this->above_(heap, this->entry_(heap, child + 1), this->entry_(heap, child)))
+      child++;
+    size_t child_slot = this->entry_(heap, child);
+    if (!this->above_(heap, child_slot, slot))
+      break;
+    this->heap_set_(heap, index, child_slot);
+    index = child;
+  }
+  this->heap_set_(heap, index, slot);
+}
+
+// MedianFilter
+MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
+    : OrderStatisticFilter(window_size, send_every, send_first_at) {}
+float MedianFilter::compute_result_() {
+  size_t count = this->valid_count_();
+  if (count == 0)
+    return NAN;
+  if (count % 2)
+    return this->top_(LOWER);
+  return (this->top_(UPPER) + this->top_(LOWER)) / 2.0f;
+}
+
 // SkipInitialFilter
 SkipInitialFilter::SkipInitialFilter(size_t num_to_ignore) : num_to_ignore_(num_to_ignore) {}
 optional<float> SkipInitialFilter::new_value(float value) {
@@ -89,136 +203,121 @@ optional<float> SkipInitialFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
-void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+    : OrderStatisticFilter(window_size, send_every, send_first_at), quantile_(quantile) {}
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
-optional<float> QuantileFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float result = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> quantile_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          quantile_queue.push_back(v);
-        }
-      }
-
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      if (queue_size) {
-        size_t position = ceilf(queue_size * this->quantile_) - 1;
-        ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
-        result = quantile_queue[position];
-      }
-    }
+size_t QuantileFilter::lower_count_(size_t count) const {
+  if (count == 0)
+    return 0;
+  // The quantile is the value at position ceil(count * quantile) of the sorted window
+  size_t position = ceilf(count * this->quantile_);
+  return clamp<size_t>(position, 1, count);
+}
+float QuantileFilter::compute_result_() {
+  if (this->valid_count_() == 0)
+    return NAN;
+  // The quantile may have changed since the last value
+  this->rebalance_();
+  ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %zu/%zu", this, this->heap_size_[LOWER], this->valid_count_());
+  return this->top_(LOWER);
+}
 
-    ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING %f", this, value, result);
-    return result;
+// MinMaxFilter
+MinMaxFilter::MinMaxFilter(size_t window_size, size_t send_every, size_t send_first_at, bool max)
+    : SlidingWindowFilter(window_size, send_every, send_first_at), max_(max) {}
+void MinMaxFilter::resize_(size_t window_size) {
+  this->queue_.assign(window_size, 0);
+  this->queue_.shrink_to_fit();
+  this->queue_head_ = 0;
+  this->queue_count_ = 0;
+}
+void MinMaxFilter::add_value_(size_t slot, float value) {
+  if (std::isnan(value))
+    return;
+  size_t size = this->queue_.size();
+  // Queued values the new one beats can never be the result again
+  while (this->queue_count_ > 0) {
+    size_t back = this->queue_head_ + this->queue_count_ - 1;
+    if (back >= size)
+      back -= size;
+    float queued = this->window_[this->queue_[back]];
+    if (this->max_ ? queued > value : queued < value)
+      break;
+    this->queue_count_--;
   }
-  return {};
+  size_t tail = this->queue_head_ + this->queue_count_;
+  if (tail >= size)
+    tail -= size;
+  this->queue_[tail] = slot;
+  this->queue_count_++;
+}
+void MinMaxFilter::remove_value_(size_t slot, float value) {
+  // The oldest value is either at the front of the queue or was already dropped
+  if (this->queue_count_ > 0 && this->queue_[this->queue_head_] == slot) {
+    if (++this->queue_head_ == this->queue_.size())
+      this->queue_head_ = 0;
+    this->queue_count_--;
+  }
+}
+float MinMaxFilter::compute_result_() {
+  if (this->queue_count_ == 0)
+    return NAN;
+  return this->window_[this->queue_[this->queue_head_]];
 }
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MinFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float min = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        min = std::isnan(min) ? v : std::min(min, v);
-      }
-    }
-
-    ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING %f", this, value, min);
-    return min;
-  }
-  return {};
-}
+    : MinMaxFilter(window_size, send_every, send_first_at, false) {}
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> MaxFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float max = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        max = std::isnan(max) ? v : std::max(max, v);
-      }
-    }
-
-    ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING %f", this, value, max);
-    return max;
-  }
-  return {};
-}
+    : MinMaxFilter(window_size, send_every, send_first_at, true) {}
 
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
-void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
-optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
-  ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f)", this, value);
-
-  if (++this->send_at_ >= this->send_every_) {
-    this->send_at_ = 0;
-
-    float sum = 0;
-    size_t valid_count = 0;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        sum += v;
-        valid_count++;
-      }
+    : SlidingWindowFilter(window_size, send_every, send_first_at) {}
+void SlidingWindowMovingAverageFilter::resize_(size_t window_size) {
+  this->sum_ = 0;
+  this->nan_count_ = 0;
+  this->positive_inf_count_ = 0;
+  this->negative_inf_count_ = 0;
+}
+void SlidingWindowMovingAverageFilter::count_value_(float value, int direction) {
+  if (std::isnan(value)) {
+    this->nan_count_ += direction;
+  } else if (std::isinf(value)) {
+    if (value > 0) {
+      this->positive_inf_count_ += direction;
+    } else {
+      this->negative_inf_count_ += direction;
     }
-
-    float average = NAN;
-    if (valid_count) {
-      average = sum / valid_count;
+  } else {
+    this->sum_ += direction * double(value);
+  }
+}
+void SlidingWindowMovingAverageFilter::add_value_(size_t slot, float value) {
+  this->count_value_(value, 1);
+  if (slot == this->window_size_ - 1 && this->count_ == this->window_size_) {
+    this->sum_ = 0;
+    for (float v : this->window_) {
+      if (std::isfinite(v))
+        this->sum_ += v;
     }
-
-    ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) SENDING %f", this, value, average);
-    return average;
   }
-  return {};
+}
+void SlidingWindowMovingAverageFilter::remove_value_(size_t slot, float value) { this->count_value_(value, -1); }
+float SlidingWindowMovingAverageFilter::compute_result_() {
+  size_t valid_count = this->count_ - this->nan_count_;
+  if (valid_count == 0)
+    return NAN;
+  // Infinities dominate the sum, and opposite ones cancel to NaN
+  if (this->positive_inf_count_ > 0 && this->negative_inf_count_ > 0)
+    return NAN;
+  if (this->positive_inf_count_ > 0)
+    return INFINITY;
+  if (this->negative_inf_count_ > 0)
+    return -INFINITY;
+  return this->sum_ / valid_count;
 }
 
 // ExponentialMovingAverageFilter
@@ -44,34 +44,134 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
-/** Simple quantile filter.
+/** Base class for filters that compute a statistic over the last window_size values and push it out every
+ * send_every values.
  *
- * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
+ * The window is a ring buffer that is allocated once per window size. Subclasses update their statistic as values
+ * enter and leave the window instead of rescanning it for every result.
  */
-class QuantileFilter : public Filter {
+class SlidingWindowFilter : public Filter {
  public:
-  /** Construct a QuantileFilter.
+  /** Construct a SlidingWindowFilter.
    *
-   * @param window_size The number of values that should be used in quantile calculation.
+   * @param window_size The number of values that the statistic is computed over.
    * @param send_every After how many sensor values should a new one be pushed out.
    * @param send_first_at After how many values to forward the very first value. Defaults to the first value
    *   on startup being published on the first *raw* value, so with no filter applied. Must be less than or equal to
    *   send_every.
-   * @param quantile float 0..1 to pick the requested quantile. Defaults to 0.9.
    */
-  explicit QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile);
+  SlidingWindowFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
   optional<float> new_value(float value) override;
 
   void set_send_every(size_t send_every);
+  /// Resize the window, keeping the newest values that still fit.
   void set_window_size(size_t window_size);
-  void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  /// Allocate the window and the subclass state for window_size_ values, dropping all values.
+  void reset_window_();
+  /// Name of the filter in verbose logs.
+  virtual const char *log_name_() const = 0;
+  /// Largest window the subclass can index, larger window sizes are clamped to it.
+  virtual size_t max_window_size_() const { return SIZE_MAX; }
+  /// Called with an empty window whenever it is (re)allocated.
+  virtual void resize_(size_t window_size) {}
+  /// Value \p value was written to \p slot of the window.
+  virtual void add_value_(size_t slot, float value) = 0;
+  /// Value \p value is about to be overwritten in \p slot, it is always the oldest value in the window.
+  virtual void remove_value_(size_t slot, float value) = 0;
+  virtual float compute_result_() = 0;
+
+  std::vector<float> window_;
+  /// Slot the next value is written to.
+  size_t head_{0};
+  size_t count_{0};
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
+};
+
+/** Shared implementation of the median and quantile filters.
+ *
+ * The non-NaN values of the window are split between a max-heap with the lowest values and a min-heap with the
+ * rest. The heaps hold window slots, and the position of each slot is tracked so an evicted value can be removed in
+ * O(log n). Subclasses choose how many values the lower heap holds, the result is then at the top of the heaps.
+ *
+ * Both heaps share one array of window_size entries: the lower heap grows from the front and the upper heap from the
+ * back. Slots are 16 bit, so the filter needs 8 bytes per window value, as much as the window and the sorted copy
+ * the filter used to make for every result.
+ */
+class OrderStatisticFilter : public SlidingWindowFilter {
+ public:
+  using SlidingWindowFilter::SlidingWindowFilter;
+
+ protected:
+  using slot_t = uint16_t;
+  static constexpr uint8_t LOWER = 0;
+  static constexpr uint8_t UPPER = 1;
+  /// Position of slots that hold NaN. Also the largest window size, so it is never a valid array index.
+  static constexpr slot_t NOT_IN_HEAP = UINT16_MAX;
+
+  /// Number of values the lower heap should hold with \p count non-NaN values in the window.
+  virtual size_t lower_count_(size_t count) const = 0;
+
+  size_t max_window_size_() const override { return NOT_IN_HEAP; }
+  void resize_(size_t window_size) override;
+  void add_value_(size_t slot, float value) override;
+  void remove_value_(size_t slot, float value) override;
+  /// Move values between the heaps until the lower heap holds lower_count_() values.
+  void rebalance_();
+
+  size_t valid_count_() const { return this->heap_size_[LOWER] + this->heap_size_[UPPER]; }
+  /// Array index of entry \p index of \p heap.
+  size_t array_index_(uint8_t heap, size_t index) const {
+    return heap == LOWER ? index : this->heap_.size() - 1 - index;
+  }
+  float top_(uint8_t heap) const { return this->window_[this->heap_[this->array_index_(heap, 0)]]; }
+  slot_t entry_(uint8_t heap, size_t index) const { return this->heap_[this->array_index_(heap, index)]; }
+
+  void heap_push_(uint8_t heap, size_t slot);
+  size_t heap_erase_(uint8_t heap, size_t index);
+  void heap_set_(uint8_t heap, size_t index, size_t slot);
+  void sift_up_(uint8_t heap, size_t index);
+  void sift_down_(uint8_t heap, size_t index);
+  /// Whether \p a belongs above \p b in \p heap.
+  bool above_(uint8_t heap, size_t a, size_t b) const {
+    return heap == LOWER ? this->window_[a] > this->window_[b] : this->window_[a] < this->window_[b];
+  }
+
+  /// Window slots of both heaps, the lower heap from the front and the upper heap from the back.
+  std::vector<slot_t> heap_;
+  size_t heap_size_[2]{0, 0};
+  /// Array index in heap_ of each window slot, or NOT_IN_HEAP for NaN values.
+  std::vector<slot_t> positions_;
+};
+
+/** Simple quantile filter.
+ *
+ * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
+ */
+class QuantileFilter : public OrderStatisticFilter {
+ public:
+  /** Construct a QuantileFilter.
+   *
+   * @param window_size The number of values that should be used in quantile calculation.
+   * @param send_every After how many sensor values should a new one be pushed out.
+   * @param send_first_at After how many values to forward the very first value. Defaults to the first value
+   *   on startup being published on the first *raw* value, so with no filter applied. Must be less than or equal to
+   *   send_every.
+   * @param quantile float 0..1 to pick the requested quantile. Defaults to 0.9.
+   */
+  explicit QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile);
+
+  void set_quantile(float quantile);
+
+ protected:
+  const char *log_name_() const override { return "QuantileFilter"; }
+  size_t lower_count_(size_t count) const override;
+  float compute_result_() override;
+
   float quantile_;
 };
 
@@ -79,7 +179,7 @@ class QuantileFilter : public Filter {
  *
  * Takes the median of the last <send_every> values and pushes it out every <send_every>.
  */
-class MedianFilter : public Filter {
+class MedianFilter : public OrderStatisticFilter {
  public:
   /** Construct a MedianFilter.
    *
@@ -91,16 +191,10 @@ class MedianFilter : public Filter {
    */
   explicit MedianFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
  protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
+  const char *log_name_() const override { return "MedianFilter"; }
+  size_t lower_count_(size_t count) const override { return (count + 1) / 2; }
+  float compute_result_() override;
 };
 
 /** Simple skip filter.
@@ -121,11 +215,33 @@ class SkipInitialFilter : public Filter {
   size_t num_to_ignore_;
 };
 
+/** Shared implementation of the min and max filters.
+ *
+ * Keeps a monotonic queue of the window slots that can still become the extreme value: a new value drops every
+ * queued value it beats, so the front of the queue is always the result and each value is queued and dropped once.
+ */
+class MinMaxFilter : public SlidingWindowFilter {
+ protected:
+  MinMaxFilter(size_t window_size, size_t send_every, size_t send_first_at, bool max);
+
+  const char *log_name_() const override { return this->max_ ? "MaxFilter" : "MinFilter"; }
+  void resize_(size_t window_size) override;
+  void add_value_(size_t slot, float value) override;
+  void remove_value_(size_t slot, float value) override;
+  float compute_result_() override;
+
+  /// Ring buffer of window slots, with the values in them ordered from most to least extreme.
+  std::vector<size_t> queue_;
+  size_t queue_head_{0};
+  size_t queue_count_{0};
+  bool max_;
+};
+
 /** Simple min filter.
  *
  * Takes the min of the last <send_every> values and pushes it out every <send_every>.
  */
-class MinFilter : public Filter {
+class MinFilter : public MinMaxFilter {
  public:
   /** Construct a MinFilter.
    *
@@ -136,24 +252,13 @@ class MinFilter : public Filter {
    *   send_every.
    */
   explicit MinFilter(size_t window_size, size_t send_every, size_t send_first_at);
-
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
- protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple max filter.
  *
  * Takes the max of the last <send_every> values and pushes it out every <send_every>.
  */
-class MaxFilter : public Filter {
+class MaxFilter : public MinMaxFilter {
  public:
   /** Construct a MaxFilter.
    *
@@ -164,17 +269,6 @@ class MaxFilter : public Filter {
    *   send_every.
    */
   explicit MaxFilter(size_t window_size, size_t send_every, size_t send_first_at);
-
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
- protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -182,7 +276,7 @@ class MaxFilter : public Filter {
  * Essentially just takes takes the average of the last window_size values and pushes them out
  * every send_every.
  */
-class SlidingWindowMovingAverageFilter : public Filter {
+class SlidingWindowMovingAverageFilter : public SlidingWindowFilter {
  public:
   /** Construct a SlidingWindowMovingAverageFilter.
    *
@@ -194,16 +288,21 @@ class SlidingWindowMovingAverageFilter : public Filter {
    */
   explicit SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every, size_t send_first_at);
 
-  optional<float> new_value(float value) override;
-
-  void set_send_every(size_t send_every);
-  void set_window_size(size_t window_size);
-
  protected:
-  std::deque<float> queue_;
-  size_t send_every_;
-  size_t send_at_;
-  size_t window_size_;
+  const char *log_name_() const override { return "SlidingWindowMovingAverageFilter"; }
+  void resize_(size_t window_size) override;
+  void add_value_(size_t slot, float value) override;
+  void remove_value_(size_t slot, float value) override;
+  float compute_result_() override;
+  /// Count \p value in or out of the window, \p direction is 1 or -1.
+  void count_value_(float value, int direction);
+
+  /// Running sum of the finite values, recomputed every time the window wraps so rounding errors cannot build up.
+  double sum_{0};
+  size_t nan_count_{0};
+  /// Infinities are counted instead of summed, so the sum is usable again once they leave the window.
+  size_t positive_inf_count_{0};
+  size_t negative_inf_count_{0};
 };
 
 /** Simple exponential moving average filter.
@@ -1,4 +1,5 @@
 #include "sensor.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -98,6 +99,7 @@ void Sensor::internal_send_state_to_frontend(float state) {
   ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy", this->get_name().c_str(), state,
            this->get_unit_of_measurement().c_str(), this->get_accuracy_decimals());
   this->callback_.call(state);
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_SENSOR, this);
 }
 
 }  // namespace sensor
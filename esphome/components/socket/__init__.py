@@ -1,9 +1,11 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+from esphome.core import CORE
 
 CODEOWNERS = ["@esphome/core"]
 
 CONF_IMPLEMENTATION = "implementation"
+CONF_SOCKET = "socket"
 IMPLEMENTATION_LWIP_TCP = "lwip_tcp"
 IMPLEMENTATION_LWIP_SOCKETS = "lwip_sockets"
 IMPLEMENTATION_BSD_SOCKETS = "bsd_sockets"
@@ -39,3 +41,20 @@ async def to_code(config):
     elif impl == IMPLEMENTATION_BSD_SOCKETS:
         cg.add_define("USE_SOCKET_IMPL_BSD_SOCKETS")
         cg.add_define("USE_SOCKET_SELECT_SUPPORT")
+
+
+def require_wake_loop_threadsafe() -> None:
+    """Enable App.wake_loop_threadsafe() for a component that hands work to the
+    main loop from another task or thread.
+
+    The main loop sleeps in select() between iterations, so waking it needs a
+    loopback socket in the monitored set. This is only available with BSD sockets
+    (ESP32 and host); elsewhere callers must guard with USE_WAKE_LOOP_THREADSAFE.
+    Call from to_code().
+    """
+    socket_config = CORE.config.get(CONF_SOCKET) if CORE.config else None
+    if (
+        socket_config is not None
+        and socket_config[CONF_IMPLEMENTATION] == IMPLEMENTATION_BSD_SOCKETS
+    ):
+        cg.add_define("USE_WAKE_LOOP_THREADSAFE")
@@ -1,4 +1,5 @@
 #include "switch.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -54,6 +55,7 @@ void Switch::publish_state(bool state) {
 
   ESP_LOGD(TAG, "'%s': Sending state %s", this->name_.c_str(), ONOFF(this->state));
   this->state_callback_.call(this->state);
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_SWITCH, this);
 }
 bool Switch::assumed_state() { return false; }
 
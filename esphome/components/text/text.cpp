@@ -1,4 +1,5 @@
 #include "text.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -16,6 +17,7 @@ void Text::publish_state(const std::string &state) {
     ESP_LOGD(TAG, "'%s': Sending state %s", this->get_name().c_str(), state.c_str());
   }
   this->state_callback_.call(state);
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_TEXT, this);
 }
 
 void Text::add_on_state_callback(std::function<void(std::string)> &&callback) {
@@ -1,5 +1,6 @@
 #include "update_entity.h"
 
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -32,6 +33,7 @@ void UpdateEntity::publish_state() {
 
   this->set_has_state(true);
   this->state_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_UPDATE, this);
 }
 
 }  // namespace update
@@ -1,4 +1,5 @@
 #include "valve.h"
+#include "esphome/core/controller.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -146,6 +147,7 @@ void Valve::publish_state(bool save) {
   ESP_LOGD(TAG, "  Current Operation: %s", valve_operation_to_str(this->current_operation));
 
   this->state_callback_.call();
+  ControllerRegistry::notify_update(CONTROLLER_DOMAIN_VALVE, this);
 
   if (save) {
     ValveRestoreState restore{};
@@ -1,6 +1,7 @@
 #include "web_server.h"
 #ifdef USE_WEBSERVER
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
 #include "esphome/core/entity_base.h"
@@ -185,10 +186,11 @@ void DeferredUpdateEventSourceList::on_client_connect_(WebServer *ws, DeferredUp
   source->try_send_nodefer(message.c_str(), "ping", millis(), 30000);
 
   for (auto &group : ws->sorting_groups_) {
-    message = json::build_json([group](JsonObject root) {
-      root["name"] = group.second.name;
-      root["sorting_weight"] = group.second.weight;
-    });
+    json::JsonWriter writer;
+    auto root = writer.root();
+    root["name"] = group.second.name;
+    root["sorting_weight"] = group.second.weight;
+    message = writer.str();
 
     // up to 31 groups should be able to be queued initially without defer
     source->try_send_nodefer(message.c_str(), "sorting_group");
@@ -225,18 +227,19 @@ void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_
 #endif
 
 std::string WebServer::get_config_json() {
-  return json::build_json([this](JsonObject root) {
-    root["title"] = App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name();
-    root["comment"] = App.get_comment();
-    root["ota"] = this->allow_ota_;
-    root["log"] = this->expose_log_;
-    root["lang"] = "en";
-  });
+  json::JsonWriter writer;
+  auto root = writer.root();
+  root["title"] = App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name();
+  root["comment"] = App.get_comment();
+  root["ota"] = this->allow_ota_;
+  root["log"] = this->expose_log_;
+  root["lang"] = "en";
+  return writer.str();
 }
 
 void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Running setup");
-  this->setup_controller(this->include_internal_);
+  this->setup_controller(this->include_internal_, /* coalesce_updates= */ true);
   this->base_->init();
 
 #ifdef USE_LOGGER
@@ -279,6 +282,7 @@ void WebServer::loop() {
   }
 #endif
 
+  this->process_entity_updates_();
   this->events_.loop();
 }
 void WebServer::dump_config() {
@@ -381,27 +385,28 @@ std::string WebServer::sensor_all_json_generator(WebServer *web_server, void *so
   return web_server->sensor_json((sensor::Sensor *) (source), ((sensor::Sensor *) (source))->state, DETAIL_ALL);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    std::string state;
-    if (std::isnan(value)) {
-      state = "NA";
-    } else {
-      state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-      if (!obj->get_unit_of_measurement().empty())
-        state += " " + obj->get_unit_of_measurement();
-    }
-    set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id(), state, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  std::string state;
+  if (std::isnan(value)) {
+    state = "NA";
+  } else {
+    state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
+    if (!obj->get_unit_of_measurement().empty())
+      state += " " + obj->get_unit_of_measurement();
+  }
+  set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id(), state, value, start_config);
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
-      if (!obj->get_unit_of_measurement().empty())
-        root["uom"] = obj->get_unit_of_measurement();
     }
-  });
+    if (!obj->get_unit_of_measurement().empty())
+      root["uom"] = obj->get_unit_of_measurement();
+  }
+  return writer.str();
 }
 #endif
 
@@ -438,17 +443,18 @@ std::string WebServer::text_sensor_all_json_generator(WebServer *web_server, voi
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -494,18 +500,19 @@ std::string WebServer::switch_all_json_generator(WebServer *web_server, void *so
   return web_server->switch_json((switch_::Switch *) (source), ((switch_::Switch *) (source))->state, DETAIL_ALL);
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
-    if (start_config == DETAIL_ALL) {
-      root["assumed_state"] = obj->assumed_state();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
+  if (start_config == DETAIL_ALL) {
+    root["assumed_state"] = obj->assumed_state();
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -540,17 +547,18 @@ std::string WebServer::button_all_json_generator(WebServer *web_server, void *so
   return web_server->button_json((button::Button *) (source), DETAIL_ALL);
 }
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -586,18 +594,19 @@ std::string WebServer::binary_sensor_all_json_generator(WebServer *web_server, v
                                         ((binary_sensor::BinarySensor *) (source))->state, DETAIL_ALL);
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value,
-                              start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_icon_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value,
+                            start_config);
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -669,25 +678,26 @@ std::string WebServer::fan_all_json_generator(WebServer *web_server, void *sourc
   return web_server->fan_json((fan::Fan *) (source), DETAIL_ALL);
 }
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state,
-                              start_config);
-    const auto traits = obj->get_traits();
-    if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
-      root["speed_count"] = traits.supported_speed_count();
-    }
-    if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_icon_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state,
+                            start_config);
+  const auto traits = obj->get_traits();
+  if (traits.supports_speed()) {
+    root["speed_level"] = obj->speed;
+    root["speed_count"] = traits.supported_speed_count();
+  }
+  if (obj->get_traits().supports_oscillation())
+    root["oscillation"] = obj->oscillating;
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -794,25 +804,28 @@ std::string WebServer::light_all_json_generator(WebServer *web_server, void *sou
   return web_server->light_json((light::LightState *) (source), DETAIL_ALL);
 }
 std::string WebServer::light_json(light::LightState *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
+  // dump_json() writes the state itself unless the color mode is unknown
+  if (!(obj->remote_values.get_color_mode() & light::ColorCapability::ON_OFF))
     root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
 
-    light::LightJSONSchema::dump_json(*obj, root);
-    if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("effects");
-      opt.add("None");
-      for (auto const &option : obj->get_effects()) {
-        opt.add(option->get_name());
-      }
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  light::LightJSONSchema::dump_json(*obj, root);
+  if (start_config == DETAIL_ALL) {
+    auto opt = root.create_nested_array("effects");
+    opt.add("None");
+    for (auto const &option : obj->get_effects()) {
+      opt.add(option->get_name());
+    }
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -885,24 +898,25 @@ std::string WebServer::cover_all_json_generator(WebServer *web_server, void *sou
   return web_server->cover_json((cover::Cover *) (source), DETAIL_STATE);
 }
 std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
-                              obj->position, start_config);
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
-
-    if (obj->get_traits().get_supports_position())
-      root["position"] = obj->position;
-    if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_icon_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
+                            obj->position, start_config);
+  root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
+
+  if (obj->get_traits().get_supports_position())
+    root["position"] = obj->position;
+  if (obj->get_traits().get_supports_tilt())
+    root["tilt"] = obj->tilt;
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -953,36 +967,37 @@ std::string WebServer::number_all_json_generator(WebServer *web_server, void *so
   return web_server->number_json((number::Number *) (source), ((number::Number *) (source))->state, DETAIL_ALL);
 }
 std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
-    if (start_config == DETAIL_ALL) {
-      root["min_value"] =
-          value_accuracy_to_string(obj->traits.get_min_value(), step_to_accuracy_decimals(obj->traits.get_step()));
-      root["max_value"] =
-          value_accuracy_to_string(obj->traits.get_max_value(), step_to_accuracy_decimals(obj->traits.get_step()));
-      root["step"] =
-          value_accuracy_to_string(obj->traits.get_step(), step_to_accuracy_decimals(obj->traits.get_step()));
-      root["mode"] = (int) obj->traits.get_mode();
-      if (!obj->traits.get_unit_of_measurement().empty())
-        root["uom"] = obj->traits.get_unit_of_measurement();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
+  if (start_config == DETAIL_ALL) {
+    root["min_value"] =
+        value_accuracy_to_string(obj->traits.get_min_value(), step_to_accuracy_decimals(obj->traits.get_step()));
+    root["max_value"] =
+        value_accuracy_to_string(obj->traits.get_max_value(), step_to_accuracy_decimals(obj->traits.get_step()));
+    root["step"] =
+        value_accuracy_to_string(obj->traits.get_step(), step_to_accuracy_decimals(obj->traits.get_step()));
+    root["mode"] = (int) obj->traits.get_mode();
+    if (!obj->traits.get_unit_of_measurement().empty())
+      root["uom"] = obj->traits.get_unit_of_measurement();
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-    if (std::isnan(value)) {
-      root["value"] = "\"NaN\"";
-      root["state"] = "NA";
-    } else {
-      root["value"] = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
-      std::string state = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
-      if (!obj->traits.get_unit_of_measurement().empty())
-        state += " " + obj->traits.get_unit_of_measurement();
-      root["state"] = state;
-    }
-  });
+  }
+  if (std::isnan(value)) {
+    root["value"] = "\"NaN\"";
+    root["state"] = "NA";
+  } else {
+    root["value"] = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
+    std::string state = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
+    if (!obj->traits.get_unit_of_measurement().empty())
+      state += " " + obj->traits.get_unit_of_measurement();
+    root["state"] = state;
+  }
+  return writer.str();
 }
 #endif
 
@@ -1037,20 +1052,21 @@ std::string WebServer::date_all_json_generator(WebServer *web_server, void *sour
   return web_server->date_json((datetime::DateEntity *) (source), DETAIL_ALL);
 }
 std::string WebServer::date_json(datetime::DateEntity *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "date-" + obj->get_object_id(), start_config);
-    std::string value = str_sprintf("%d-%02d-%02d", obj->year, obj->month, obj->day);
-    root["value"] = value;
-    root["state"] = value;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "date-" + obj->get_object_id(), start_config);
+  std::string value = str_sprintf("%d-%02d-%02d", obj->year, obj->month, obj->day);
+  root["value"] = value;
+  root["state"] = value;
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif  // USE_DATETIME_DATE
 
@@ -1104,20 +1120,21 @@ std::string WebServer::time_all_json_generator(WebServer *web_server, void *sour
   return web_server->time_json((datetime::TimeEntity *) (source), DETAIL_ALL);
 }
 std::string WebServer::time_json(datetime::TimeEntity *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "time-" + obj->get_object_id(), start_config);
-    std::string value = str_sprintf("%02d:%02d:%02d", obj->hour, obj->minute, obj->second);
-    root["value"] = value;
-    root["state"] = value;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "time-" + obj->get_object_id(), start_config);
+  std::string value = str_sprintf("%02d:%02d:%02d", obj->hour, obj->minute, obj->second);
+  root["value"] = value;
+  root["state"] = value;
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif  // USE_DATETIME_TIME
 
@@ -1171,21 +1188,22 @@ std::string WebServer::datetime_all_json_generator(WebServer *web_server, void *
   return web_server->datetime_json((datetime::DateTimeEntity *) (source), DETAIL_ALL);
 }
 std::string WebServer::datetime_json(datetime::DateTimeEntity *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "datetime-" + obj->get_object_id(), start_config);
-    std::string value = str_sprintf("%d-%02d-%02d %02d:%02d:%02d", obj->year, obj->month, obj->day, obj->hour,
-                                    obj->minute, obj->second);
-    root["value"] = value;
-    root["state"] = value;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "datetime-" + obj->get_object_id(), start_config);
+  std::string value = str_sprintf("%d-%02d-%02d %02d:%02d:%02d", obj->year, obj->month, obj->day, obj->hour,
+                                  obj->minute, obj->second);
+  root["value"] = value;
+  root["state"] = value;
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif  // USE_DATETIME_DATETIME
 
@@ -1235,27 +1253,28 @@ std::string WebServer::text_all_json_generator(WebServer *web_server, void *sour
   return web_server->text_json((text::Text *) (source), ((text::Text *) (source))->state, DETAIL_ALL);
 }
 std::string WebServer::text_json(text::Text *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "text-" + obj->get_object_id(), start_config);
-    root["min_length"] = obj->traits.get_min_length();
-    root["max_length"] = obj->traits.get_max_length();
-    root["pattern"] = obj->traits.get_pattern();
-    if (obj->traits.get_mode() == text::TextMode::TEXT_MODE_PASSWORD) {
-      root["state"] = "********";
-    } else {
-      root["state"] = value;
-    }
-    root["value"] = value;
-    if (start_config == DETAIL_ALL) {
-      root["mode"] = (int) obj->traits.get_mode();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "text-" + obj->get_object_id(), start_config);
+  root["min_length"] = obj->traits.get_min_length();
+  root["max_length"] = obj->traits.get_max_length();
+  root["pattern"] = obj->traits.get_pattern();
+  if (obj->traits.get_mode() == text::TextMode::TEXT_MODE_PASSWORD) {
+    root["state"] = "********";
+  } else {
+    root["state"] = value;
+  }
+  root["value"] = value;
+  if (start_config == DETAIL_ALL) {
+    root["mode"] = (int) obj->traits.get_mode();
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -1306,21 +1325,22 @@ std::string WebServer::select_all_json_generator(WebServer *web_server, void *so
   return web_server->select_json((select::Select *) (source), ((select::Select *) (source))->state, DETAIL_ALL);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("option");
-      for (auto &option : obj->traits.get_options()) {
-        opt.add(option);
-      }
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_icon_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
+  if (start_config == DETAIL_ALL) {
+    auto opt = root.create_nested_array("option");
+    for (auto &option : obj->traits.get_options()) {
+      opt.add(option);
+    }
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -1402,96 +1422,99 @@ std::string WebServer::climate_all_json_generator(WebServer *web_server, void *s
   return web_server->climate_json((climate::Climate *) (source), DETAIL_ALL);
 }
 std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "climate-" + obj->get_object_id(), start_config);
-    const auto traits = obj->get_traits();
-    int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
-    int8_t current_accuracy = traits.get_current_temperature_accuracy_decimals();
-    char buf[16];
-
-    if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("modes");
-      for (climate::ClimateMode m : traits.get_supported_modes())
-        opt.add(PSTR_LOCAL(climate::climate_mode_to_string(m)));
-      if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("fan_modes");
-        for (climate::ClimateFanMode m : traits.get_supported_fan_modes())
-          opt.add(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
-      }
-
-      if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("custom_fan_modes");
-        for (auto const &custom_fan_mode : traits.get_supported_custom_fan_modes())
-          opt.add(custom_fan_mode);
-      }
-      if (traits.get_supports_swing_modes()) {
-        JsonArray opt = root.createNestedArray("swing_modes");
-        for (auto swing_mode : traits.get_supported_swing_modes())
-          opt.add(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
-      }
-      if (traits.get_supports_presets() && obj->preset.has_value()) {
-        JsonArray opt = root.createNestedArray("presets");
-        for (climate::ClimatePreset m : traits.get_supported_presets())
-          opt.add(PSTR_LOCAL(climate::climate_preset_to_string(m)));
-      }
-      if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-        JsonArray opt = root.createNestedArray("custom_presets");
-        for (auto const &custom_preset : traits.get_supported_custom_presets())
-          opt.add(custom_preset);
-      }
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-
-    bool has_state = false;
-    root["mode"] = PSTR_LOCAL(climate_mode_to_string(obj->mode));
-    root["max_temp"] = value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy);
-    root["min_temp"] = value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy);
-    root["step"] = traits.get_visual_target_temperature_step();
-    if (traits.get_supports_action()) {
-      root["action"] = PSTR_LOCAL(climate_action_to_string(obj->action));
-      root["state"] = root["action"];
-      has_state = true;
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "climate-" + obj->get_object_id(), start_config);
+  const auto traits = obj->get_traits();
+  int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
+  int8_t current_accuracy = traits.get_current_temperature_accuracy_decimals();
+  char buf[16];
+
+  if (start_config == DETAIL_ALL) {
+    auto opt = root.create_nested_array("modes");
+    for (climate::ClimateMode m : traits.get_supported_modes())
+      opt.add(PSTR_LOCAL(climate::climate_mode_to_string(m)));
+    if (!traits.get_supported_custom_fan_modes().empty()) {
+      auto opt = root.create_nested_array("fan_modes");
+      for (climate::ClimateFanMode m : traits.get_supported_fan_modes())
+        opt.add(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
+    }
+
+    if (!traits.get_supported_custom_fan_modes().empty()) {
+      auto opt = root.create_nested_array("custom_fan_modes");
+      for (auto const &custom_fan_mode : traits.get_supported_custom_fan_modes())
+        opt.add(custom_fan_mode);
     }
-    if (traits.get_supports_fan_modes() && obj->fan_mode.has_value()) {
-      root["fan_mode"] = PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value()));
-    }
-    if (!traits.get_supported_custom_fan_modes().empty() && obj->custom_fan_mode.has_value()) {
-      root["custom_fan_mode"] = obj->custom_fan_mode.value().c_str();
+    if (traits.get_supports_swing_modes()) {
+      auto opt = root.create_nested_array("swing_modes");
+      for (auto swing_mode : traits.get_supported_swing_modes())
+        opt.add(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
     }
     if (traits.get_supports_presets() && obj->preset.has_value()) {
-      root["preset"] = PSTR_LOCAL(climate_preset_to_string(obj->preset.value()));
+      auto opt = root.create_nested_array("presets");
+      for (climate::ClimatePreset m : traits.get_supported_presets())
+        opt.add(PSTR_LOCAL(climate::climate_preset_to_string(m)));
     }
     if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-      root["custom_preset"] = obj->custom_preset.value().c_str();
-    }
-    if (traits.get_supports_swing_modes()) {
-      root["swing_mode"] = PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode));
+      auto opt = root.create_nested_array("custom_presets");
+      for (auto const &custom_preset : traits.get_supported_custom_presets())
+        opt.add(custom_preset);
     }
-    if (traits.get_supports_current_temperature()) {
-      if (!std::isnan(obj->current_temperature)) {
-        root["current_temperature"] = value_accuracy_to_string(obj->current_temperature, current_accuracy);
-      } else {
-        root["current_temperature"] = "NA";
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-    if (traits.get_supports_two_point_target_temperature()) {
-      root["target_temperature_low"] = value_accuracy_to_string(obj->target_temperature_low, target_accuracy);
-      root["target_temperature_high"] = value_accuracy_to_string(obj->target_temperature_high, target_accuracy);
-      if (!has_state) {
-        root["state"] = value_accuracy_to_string((obj->target_temperature_high + obj->target_temperature_low) / 2.0f,
-                                                 target_accuracy);
-      }
+  }
+
+  bool has_state = false;
+  root["mode"] = PSTR_LOCAL(climate_mode_to_string(obj->mode));
+  root["max_temp"] = value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy);
+  root["min_temp"] = value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy);
+  root["step"] = traits.get_visual_target_temperature_step();
+  if (traits.get_supports_action()) {
+    const char *action = PSTR_LOCAL(climate_action_to_string(obj->action));
+    root["action"] = action;
+    root["state"] = action;
+    has_state = true;
+  }
+  if (traits.get_supports_fan_modes() && obj->fan_mode.has_value()) {
+    root["fan_mode"] = PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value()));
+  }
+  if (!traits.get_supported_custom_fan_modes().empty() && obj->custom_fan_mode.has_value()) {
+    root["custom_fan_mode"] = obj->custom_fan_mode.value().c_str();
+  }
+  if (traits.get_supports_presets() && obj->preset.has_value()) {
+    root["preset"] = PSTR_LOCAL(climate_preset_to_string(obj->preset.value()));
+  }
+  if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
+    root["custom_preset"] = obj->custom_preset.value().c_str();
+  }
+  if (traits.get_supports_swing_modes()) {
+    root["swing_mode"] = PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode));
+  }
+  if (traits.get_supports_current_temperature()) {
+    if (!std::isnan(obj->current_temperature)) {
+      root["current_temperature"] = value_accuracy_to_string(obj->current_temperature, current_accuracy);
     } else {
-      root["target_temperature"] = value_accuracy_to_string(obj->target_temperature, target_accuracy);
-      if (!has_state)
-        root["state"] = root["target_temperature"];
+      root["current_temperature"] = "NA";
     }
-  });
+  }
+  if (traits.get_supports_two_point_target_temperature()) {
+    root["target_temperature_low"] = value_accuracy_to_string(obj->target_temperature_low, target_accuracy);
+    root["target_temperature_high"] = value_accuracy_to_string(obj->target_temperature_high, target_accuracy);
+    if (!has_state) {
+      root["state"] = value_accuracy_to_string((obj->target_temperature_high + obj->target_temperature_low) / 2.0f,
+                                               target_accuracy);
+    }
+  } else {
+    std::string target_temperature = value_accuracy_to_string(obj->target_temperature, target_accuracy);
+    root["target_temperature"] = target_temperature;
+    if (!has_state)
+      root["state"] = target_temperature;
+  }
+  return writer.str();
 }
 #endif
 
@@ -1537,18 +1560,19 @@ std::string WebServer::lock_all_json_generator(WebServer *web_server, void *sour
   return web_server->lock_json((lock::Lock *) (source), ((lock::Lock *) (source))->state, DETAIL_ALL);
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
-                              start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
+                            start_config);
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -1614,22 +1638,23 @@ std::string WebServer::valve_all_json_generator(WebServer *web_server, void *sou
   return web_server->valve_json((valve::Valve *) (source), DETAIL_ALL);
 }
 std::string WebServer::valve_json(valve::Valve *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "valve-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
-                              obj->position, start_config);
-    root["current_operation"] = valve::valve_operation_to_str(obj->current_operation);
-
-    if (obj->get_traits().get_supports_position())
-      root["position"] = obj->position;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_icon_state_value(root, obj, "valve-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
+                            obj->position, start_config);
+  root["current_operation"] = valve::valve_operation_to_str(obj->current_operation);
+
+  if (obj->get_traits().get_supports_position())
+    root["position"] = obj->position;
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -1694,19 +1719,20 @@ std::string WebServer::alarm_control_panel_all_json_generator(WebServer *web_ser
 std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
                                                 alarm_control_panel::AlarmControlPanelState value,
                                                 JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    char buf[16];
-    set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id(),
-                              PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  char buf[16];
+  set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id(),
+                            PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
+  if (start_config == DETAIL_ALL) {
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -1745,25 +1771,26 @@ std::string WebServer::event_all_json_generator(WebServer *web_server, void *sou
   return web_server->event_json(event, get_event_type(event), DETAIL_ALL);
 }
 std::string WebServer::event_json(event::Event *obj, const std::string &event_type, JsonDetail start_config) {
-  return json::build_json([this, obj, event_type, start_config](JsonObject root) {
-    set_json_id(root, obj, "event-" + obj->get_object_id(), start_config);
-    if (!event_type.empty()) {
-      root["event_type"] = event_type;
-    }
-    if (start_config == DETAIL_ALL) {
-      JsonArray event_types = root.createNestedArray("event_types");
-      for (auto const &event_type : obj->get_event_types()) {
-        event_types.add(event_type);
-      }
-      root["device_class"] = obj->get_device_class();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "event-" + obj->get_object_id(), start_config);
+  if (!event_type.empty()) {
+    root["event_type"] = event_type;
+  }
+  if (start_config == DETAIL_ALL) {
+    auto event_types = root.create_nested_array("event_types");
+    for (auto const &event_type : obj->get_event_types()) {
+      event_types.add(event_type);
+    }
+    root["device_class"] = obj->get_device_class();
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
@@ -1807,36 +1834,37 @@ std::string WebServer::update_all_json_generator(WebServer *web_server, void *so
   return web_server->update_json((update::UpdateEntity *) (source), DETAIL_STATE);
 }
 std::string WebServer::update_json(update::UpdateEntity *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "update-" + obj->get_object_id(), start_config);
-    root["value"] = obj->update_info.latest_version;
-    switch (obj->state) {
-      case update::UPDATE_STATE_NO_UPDATE:
-        root["state"] = "NO UPDATE";
-        break;
-      case update::UPDATE_STATE_AVAILABLE:
-        root["state"] = "UPDATE AVAILABLE";
-        break;
-      case update::UPDATE_STATE_INSTALLING:
-        root["state"] = "INSTALLING";
-        break;
-      default:
-        root["state"] = "UNKNOWN";
-        break;
-    }
-    if (start_config == DETAIL_ALL) {
-      root["current_version"] = obj->update_info.current_version;
-      root["title"] = obj->update_info.title;
-      root["summary"] = obj->update_info.summary;
-      root["release_url"] = obj->update_info.release_url;
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
+  json::JsonWriter writer;
+  auto root = writer.root();
+  set_json_id(root, obj, "update-" + obj->get_object_id(), start_config);
+  root["value"] = obj->update_info.latest_version;
+  switch (obj->state) {
+    case update::UPDATE_STATE_NO_UPDATE:
+      root["state"] = "NO UPDATE";
+      break;
+    case update::UPDATE_STATE_AVAILABLE:
+      root["state"] = "UPDATE AVAILABLE";
+      break;
+    case update::UPDATE_STATE_INSTALLING:
+      root["state"] = "INSTALLING";
+      break;
+    default:
+      root["state"] = "UNKNOWN";
+      break;
+  }
+  if (start_config == DETAIL_ALL) {
+    root["current_version"] = obj->update_info.current_version;
+    root["title"] = obj->update_info.title;
+    root["summary"] = obj->update_info.summary;
+    root["release_url"] = obj->update_info.release_url;
+    if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
+      root["sorting_weight"] = this->sorting_entitys_[obj].weight;
+      if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
+        root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
       }
     }
-  });
+  }
+  return writer.str();
 }
 #endif
 
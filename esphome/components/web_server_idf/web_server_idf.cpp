@@ -2,6 +2,7 @@
 
 #include <cstdarg>
 
+#include "esphome/components/json/json_writer.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
@@ -174,6 +175,7 @@ void AsyncWebServerRequest::redirect(const std::string &url) {
 
 void AsyncWebServerRequest::init_response_(AsyncWebServerResponse *rsp, int code, const char *content_type) {
   httpd_resp_set_status(*this, code == 200   ? HTTPD_200
+                               : code == 304 ? "304 Not Modified"
                                : code == 404 ? HTTPD_404
                                : code == 409 ? HTTPD_409
                                              : to_string(code).c_str());
@@ -339,10 +341,11 @@ AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *
   this->try_send_nodefer(message.c_str(), "ping", millis(), 30000);
 
   for (auto &group : ws->sorting_groups_) {
-    message = json::build_json([group](JsonObject root) {
-      root["name"] = group.second.name;
-      root["sorting_weight"] = group.second.weight;
-    });
+    json::JsonWriter writer;
+    auto root = writer.root();
+    root["name"] = group.second.name;
+    root["sorting_weight"] = group.second.weight;
+    message = writer.str();
 
     // a (very) large number of these should be able to be queued initially without defer
     // since the only thing in the send buffer at this point is the initial ping/config
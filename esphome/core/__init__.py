@@ -520,6 +520,13 @@ class EsphomeCore:
         # Dict to track platform entity counts for pre-allocation
         # Key: platform name (e.g. "sensor", "binary_sensor"), Value: count
         self.platform_counts: defaultdict[str, int] = defaultdict(int)
+        # Dict to track the entities of each platform in registration order,
+        # used to generate the key lookup tables
+        # Key: platform name, Value: list of entity IDs
+        self.platform_entities: defaultdict[str, list[str]] = defaultdict(list)
+        # Dict of entity object_ids set at compile time
+        # Key: entity ID, Value: (object_id, whether the entity has its own name)
+        self.entity_object_ids: dict[str, tuple[str, bool]] = {}
         # Whether ESPHome was started in verbose mode
         self.verbose = False
         # Whether ESPHome was started in quiet mode
@@ -550,6 +557,8 @@ class EsphomeCore:
         self.loaded_integrations = set()
         self.component_ids = set()
         self.platform_counts = defaultdict(int)
+        self.platform_entities = defaultdict(list)
+        self.entity_object_ids = {}
         PIN_SCHEMA_REGISTRY.reset()
 
     @property
@@ -835,9 +844,22 @@ class EsphomeCore:
         """Register a component for a platform and track its count.
 
         :param platform_name: The name of the platform (e.g., 'sensor', 'binary_sensor')
-        :param var: The variable (component) being registered (currently unused but kept for future use)
+        :param var: The variable (component) being registered
         """
         self.platform_counts[platform_name] += 1
+        self.platform_entities[platform_name].append(str(var.base))
+
+    def register_entity_object_id(
+        self, var, object_id: str, has_own_name: bool
+    ) -> None:
+        """Record the object_id an entity was given, used to generate the key lookup tables.
+
+        :param var: The entity variable
+        :param object_id: The sanitized object_id passed to set_object_id()
+        :param has_own_name: False if the entity is named after the device, in which case
+            its object_id changes at runtime when name_add_mac_suffix is enabled
+        """
+        self.entity_object_ids[str(var.base)] = (object_id, has_own_name)
 
     @property
     def cpp_main_section(self):
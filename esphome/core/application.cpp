@@ -26,6 +26,10 @@
 #endif
 #endif
 
+#ifdef USE_WAKE_LOOP_THREADSAFE
+#include "esphome/components/socket/headers.h"
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
@@ -91,18 +95,29 @@ void Application::loop() {
 
   this->scheduler.call();
 
+  if (this->has_pending_enable_loop_requests_)
+    this->enable_pending_loops_();
+
   // Get the initial loop time at the start
   uint32_t last_op_end_time = millis();
 
   // Feed WDT with time
   this->feed_wdt(last_op_end_time);
 
-  for (Component *component : this->looping_components_) {
+  // Components may disable or enable loops (their own or others') while we iterate, which reorders
+  // the active partition. Keep the index in a member so disable_component_loop_() can adjust it.
+  this->in_loop_ = true;
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;
+       this->current_loop_index_++) {
+    Component *component = this->looping_components_[this->current_loop_index_];
     // Update the cached time before each component runs
     this->loop_component_start_time_ = last_op_end_time;
 
     {
       this->set_current_component(component);
+      // This call serves any enable_loop_soon_any_context() request made so far. A request made during the call stays
+      // pending, so a component that disables its loop right after it is enabled again on the next iteration.
+      component->pending_enable_loop_ = false;
       WarnIfComponentBlockingGuard guard{component, last_op_end_time};
       component->call();
       // Use the finish method to get the current time as the end time
@@ -112,6 +127,10 @@ void Application::loop() {
     this->app_state_ |= new_app_state;
     this->feed_wdt(last_op_end_time);
   }
+  this->in_loop_ = false;
+  // Components with a disabled loop still report their status flags (e.g. for the status LED)
+  for (uint16_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++)
+    new_app_state |= this->looping_components_[i]->get_component_state();
   this->app_state_ = new_app_state;
 
   // Use the last component's end time instead of calling millis() again
@@ -235,12 +254,68 @@ void Application::teardown_components(uint32_t timeout_ms) {
 }
 
 void Application::calculate_looping_components_() {
+  // Active components first, then those that already disabled their loop (e.g. during setup) or failed
+  for (auto *obj : this->components_) {
+    if (obj->has_overridden_loop() && obj->is_loop_enabled_())
+      this->looping_components_.push_back(obj);
+  }
+  this->looping_components_active_end_ = this->looping_components_.size();
   for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
+    if (obj->has_overridden_loop() && !obj->is_loop_enabled_())
       this->looping_components_.push_back(obj);
   }
 }
 
+void Application::disable_component_loop_(Component *component) {
+  for (uint16_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Entries up to current_loop_index_ already ran in this iteration, the others are still to run. If a component
+    // that already ran is disabled, first swap it with the running one, which has run too, so the component moved
+    // into the freed slot below lands where the loop will still visit it.
+    if (this->in_loop_ && i < this->current_loop_index_) {
+      std::swap(this->looping_components_[i], this->looping_components_[this->current_loop_index_]);
+      i = this->current_loop_index_;
+    }
+    // Swap with the last active component and shrink the active partition - O(1) removal, order doesn't matter
+    this->looping_components_active_end_--;
+    if (i != this->looping_components_active_end_) {
+      std::swap(this->looping_components_[i], this->looping_components_[this->looping_components_active_end_]);
+      // The component swapped into the slot of the running one hasn't run yet in this iteration. Step back so
+      // the loop visits this slot again.
+      if (this->in_loop_ && i == this->current_loop_index_)
+        this->current_loop_index_--;  // may wrap to UINT16_MAX, the loop increment brings it back to 0
+    }
+    return;
+  }
+}
+
+void Application::enable_component_loop_(Component *component) {
+  const uint16_t size = this->looping_components_.size();
+  for (uint16_t i = this->looping_components_active_end_; i < size; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Move to the end of the active partition; if we're inside loop() it will still run this iteration
+    std::swap(this->looping_components_[i], this->looping_components_[this->looping_components_active_end_]);
+    this->looping_components_active_end_++;
+    return;
+  }
+}
+
+void Application::enable_pending_loops_() {
+  // Clear first so a request arriving while we scan is picked up on the next iteration
+  this->has_pending_enable_loop_requests_ = false;
+  // enable_loop() swaps the component to index looping_components_active_end_ (<= i) and grows the
+  // active partition, so the element now at i has already been visited and we can simply continue.
+  for (uint16_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    Component *component = this->looping_components_[i];
+    if (!component->pending_enable_loop_)
+      continue;
+    component->pending_enable_loop_ = false;
+    component->enable_loop();
+  }
+}
+
 #ifdef USE_SOCKET_SELECT_SUPPORT
 bool Application::register_socket_fd(int fd) {
   // WARNING: This function is NOT thread-safe and must only be called from the main loop
@@ -305,6 +380,14 @@ bool Application::is_socket_ready(int fd) const {
 void Application::yield_with_select_(uint32_t delay_ms) {
   // Delay while monitoring sockets. When delay_ms is 0, always yield() to ensure other tasks run
   // since select() with 0 timeout only polls without yielding.
+#ifdef USE_WAKE_LOOP_THREADSAFE
+  // Created on the first loop rather than in setup(): on ESP32 the TCP/IP task only runs once the network
+  // components are set up, and socket() asserts before that
+  if (!this->wake_socket_created_) {
+    this->wake_socket_created_ = true;
+    this->setup_wake_loop_threadsafe_();
+  }
+#endif
 #ifdef USE_SOCKET_SELECT_SUPPORT
   if (!this->socket_fds_.empty()) {
     // Update fd_set if socket list has changed
@@ -342,6 +425,11 @@ void Application::yield_with_select_(uint32_t delay_ms) {
       ESP_LOGW(TAG, "select() failed with errno %d", errno);
       delay(delay_ms);
     }
+#ifdef USE_WAKE_LOOP_THREADSAFE
+    if (ret > 0 && this->wake_socket_fd_ >= 0 && FD_ISSET(this->wake_socket_fd_, &this->read_fds_)) {
+      this->drain_wake_socket_();
+    }
+#endif
     // When delay_ms is 0, we need to yield since select(0) doesn't yield
     if (delay_ms == 0) {
       yield();
@@ -356,6 +444,65 @@ void Application::yield_with_select_(uint32_t delay_ms) {
 #endif
 }
 
+#ifdef USE_WAKE_LOOP_THREADSAFE
+void Application::setup_wake_loop_threadsafe_() {
+  // A UDP socket bound to loopback and connected to itself: sending a datagram from any thread makes it
+  // readable, which ends the select() in yield_with_select_() early. Works on both lwIP and host sockets.
+  int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    ESP_LOGW(TAG, "Failed to create wake socket: errno %d", errno);
+    return;
+  }
+
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;  // Let the stack pick a free port
+  socklen_t addr_len = sizeof(addr);
+  if (::bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      ::getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &addr_len) < 0 ||
+      ::connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+    ESP_LOGW(TAG, "Failed to set up wake socket: errno %d", errno);
+    ::close(fd);
+    return;
+  }
+
+  // Neither side may ever block: the sender when the receive queue is full, the main loop when draining
+  int flags = ::fcntl(fd, F_GETFL, 0);
+  ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+  if (!this->register_socket_fd(fd)) {
+    ::close(fd);
+    return;
+  }
+  this->wake_socket_fd_ = fd;
+}
+
+void Application::wake_loop_threadsafe() {
+  // Only the first wake after a drain sends a datagram. On lwIP every send() is a round trip through
+  // the TCP/IP task, so this keeps bursts (e.g. many BLE events) cheap.
+  if (this->wake_socket_fd_ < 0 || this->wake_pending_.exchange(true, std::memory_order_acq_rel))
+    return;
+  const uint8_t dummy = 0;
+  // Errors are ignored: a full queue means a wake is already pending, and logging here could recurse
+  // when called from the logger.
+  ::send(this->wake_socket_fd_, &dummy, 1, 0);
+}
+
+void Application::drain_wake_socket_() {
+  uint8_t buf[8];
+  do {
+    while (::recv(this->wake_socket_fd_, buf, sizeof(buf), 0) > 0) {
+    }
+    // Clear the flag only once the socket is empty. A wake that sets it from here on sends a datagram that stays
+    // queued, so the flag is never left set without a datagram that makes select() clear it again.
+    this->wake_pending_.store(false, std::memory_order_release);
+    // A datagram that arrived between the drain and the clear may come from a wake that already saw the cleared
+    // flag and set it again, so after reading it the flag must be cleared once more
+  } while (::recv(this->wake_socket_fd_, buf, sizeof(buf), 0) > 0);
+}
+#endif
+
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 }  // namespace esphome
@@ -12,6 +12,9 @@
 #ifdef USE_SOCKET_SELECT_SUPPORT
 #include <sys/select.h>
 #endif
+#ifdef USE_WAKE_LOOP_THREADSAFE
+#include <atomic>
+#endif
 
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
@@ -85,6 +88,20 @@ namespace esphome {
 // cleanly is a warning in the log.
 static const uint32_t TEARDOWN_TIMEOUT_REBOOT_MS = 1000;  // 1 second for quick reboot
 
+/// Entry of a table mapping object_id hashes to the position of an entity in its domain's vector.
+struct EntityKeyIndex {
+  uint32_t key;
+  uint32_t index;
+};
+
+/** Lookup table for the get_*_by_key() methods, generated at compile time for the entities whose object_id is
+ * fixed. Entries are sorted by key and stored in flash.
+ */
+struct EntityKeyTable {
+  const EntityKeyIndex *entries;
+  uint16_t size;
+};
+
 class Application {
  public:
   void pre_setup(const std::string &name, const std::string &friendly_name, const char *area, const char *comment,
@@ -112,90 +129,149 @@ class Application {
 
 #ifdef USE_BINARY_SENSOR
   void register_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
+    binary_sensor->set_domain_index(this->binary_sensors_.size());
     this->binary_sensors_.push_back(binary_sensor);
   }
 #endif
 
 #ifdef USE_SENSOR
-  void register_sensor(sensor::Sensor *sensor) { this->sensors_.push_back(sensor); }
+  void register_sensor(sensor::Sensor *sensor) {
+    sensor->set_domain_index(this->sensors_.size());
+    this->sensors_.push_back(sensor);
+  }
 #endif
 
 #ifdef USE_SWITCH
-  void register_switch(switch_::Switch *a_switch) { this->switches_.push_back(a_switch); }
+  void register_switch(switch_::Switch *a_switch) {
+    a_switch->set_domain_index(this->switches_.size());
+    this->switches_.push_back(a_switch);
+  }
 #endif
 
 #ifdef USE_BUTTON
-  void register_button(button::Button *button) { this->buttons_.push_back(button); }
+  void register_button(button::Button *button) {
+    button->set_domain_index(this->buttons_.size());
+    this->buttons_.push_back(button);
+  }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  void register_text_sensor(text_sensor::TextSensor *sensor) { this->text_sensors_.push_back(sensor); }
+  void register_text_sensor(text_sensor::TextSensor *sensor) {
+    sensor->set_domain_index(this->text_sensors_.size());
+    this->text_sensors_.push_back(sensor);
+  }
 #endif
 
 #ifdef USE_FAN
-  void register_fan(fan::Fan *state) { this->fans_.push_back(state); }
+  void register_fan(fan::Fan *state) {
+    state->set_domain_index(this->fans_.size());
+    this->fans_.push_back(state);
+  }
 #endif
 
 #ifdef USE_COVER
-  void register_cover(cover::Cover *cover) { this->covers_.push_back(cover); }
+  void register_cover(cover::Cover *cover) {
+    cover->set_domain_index(this->covers_.size());
+    this->covers_.push_back(cover);
+  }
 #endif
 
 #ifdef USE_CLIMATE
-  void register_climate(climate::Climate *climate) { this->climates_.push_back(climate); }
+  void register_climate(climate::Climate *climate) {
+    climate->set_domain_index(this->climates_.size());
+    this->climates_.push_back(climate);
+  }
 #endif
 
 #ifdef USE_LIGHT
-  void register_light(light::LightState *light) { this->lights_.push_back(light); }
+  void register_light(light::LightState *light) {
+    light->set_domain_index(this->lights_.size());
+    this->lights_.push_back(light);
+  }
 #endif
 
 #ifdef USE_NUMBER
-  void register_number(number::Number *number) { this->numbers_.push_back(number); }
+  void register_number(number::Number *number) {
+    number->set_domain_index(this->numbers_.size());
+    this->numbers_.push_back(number);
+  }
 #endif
 
 #ifdef USE_DATETIME_DATE
-  void register_date(datetime::DateEntity *date) { this->dates_.push_back(date); }
+  void register_date(datetime::DateEntity *date) {
+    date->set_domain_index(this->dates_.size());
+    this->dates_.push_back(date);
+  }
 #endif
 
 #ifdef USE_DATETIME_TIME
-  void register_time(datetime::TimeEntity *time) { this->times_.push_back(time); }
+  void register_time(datetime::TimeEntity *time) {
+    time->set_domain_index(this->times_.size());
+    this->times_.push_back(time);
+  }
 #endif
 
 #ifdef USE_DATETIME_DATETIME
-  void register_datetime(datetime::DateTimeEntity *datetime) { this->datetimes_.push_back(datetime); }
+  void register_datetime(datetime::DateTimeEntity *datetime) {
+    datetime->set_domain_index(this->datetimes_.size());
+    this->datetimes_.push_back(datetime);
+  }
 #endif
 
 #ifdef USE_TEXT
-  void register_text(text::Text *text) { this->texts_.push_back(text); }
+  void register_text(text::Text *text) {
+    text->set_domain_index(this->texts_.size());
+    this->texts_.push_back(text);
+  }
 #endif
 
 #ifdef USE_SELECT
-  void register_select(select::Select *select) { this->selects_.push_back(select); }
+  void register_select(select::Select *select) {
+    select->set_domain_index(this->selects_.size());
+    this->selects_.push_back(select);
+  }
 #endif
 
 #ifdef USE_LOCK
-  void register_lock(lock::Lock *a_lock) { this->locks_.push_back(a_lock); }
+  void register_lock(lock::Lock *a_lock) {
+    a_lock->set_domain_index(this->locks_.size());
+    this->locks_.push_back(a_lock);
+  }
 #endif
 
 #ifdef USE_VALVE
-  void register_valve(valve::Valve *valve) { this->valves_.push_back(valve); }
+  void register_valve(valve::Valve *valve) {
+    valve->set_domain_index(this->valves_.size());
+    this->valves_.push_back(valve);
+  }
 #endif
 
 #ifdef USE_MEDIA_PLAYER
-  void register_media_player(media_player::MediaPlayer *media_player) { this->media_players_.push_back(media_player); }
+  void register_media_player(media_player::MediaPlayer *media_player) {
+    media_player->set_domain_index(this->media_players_.size());
+    this->media_players_.push_back(media_player);
+  }
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
   void register_alarm_control_panel(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
+    a_alarm_control_panel->set_domain_index(this->alarm_control_panels_.size());
     this->alarm_control_panels_.push_back(a_alarm_control_panel);
   }
 #endif
 
 #ifdef USE_EVENT
-  void register_event(event::Event *event) { this->events_.push_back(event); }
+  void register_event(event::Event *event) {
+    event->set_domain_index(this->events_.size());
+    this->events_.push_back(event);
+  }
 #endif
 
 #ifdef USE_UPDATE
-  void register_update(update::UpdateEntity *update) { this->updates_.push_back(update); }
+  void register_update(update::UpdateEntity *update) {
+    update->set_domain_index(this->updates_.size());
+    this->updates_.push_back(update);
+  }
 #endif
 
   /// Reserve space for components to avoid memory fragmentation
@@ -203,66 +279,99 @@ class Application {
 
 #ifdef USE_BINARY_SENSOR
   void reserve_binary_sensor(size_t count) { this->binary_sensors_.reserve(count); }
+  void set_binary_sensor_key_table(const EntityKeyIndex *entries, uint16_t size) {
+    this->binary_sensor_key_table_ = {entries, size};
+  }
 #endif
 #ifdef USE_SWITCH
   void reserve_switch(size_t count) { this->switches_.reserve(count); }
+  void set_switch_key_table(const EntityKeyIndex *entries, uint16_t size) { this->switch_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_BUTTON
   void reserve_button(size_t count) { this->buttons_.reserve(count); }
+  void set_button_key_table(const EntityKeyIndex *entries, uint16_t size) { this->button_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_SENSOR
   void reserve_sensor(size_t count) { this->sensors_.reserve(count); }
+  void set_sensor_key_table(const EntityKeyIndex *entries, uint16_t size) { this->sensor_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_TEXT_SENSOR
   void reserve_text_sensor(size_t count) { this->text_sensors_.reserve(count); }
+  void set_text_sensor_key_table(const EntityKeyIndex *entries, uint16_t size) {
+    this->text_sensor_key_table_ = {entries, size};
+  }
 #endif
 #ifdef USE_FAN
   void reserve_fan(size_t count) { this->fans_.reserve(count); }
+  void set_fan_key_table(const EntityKeyIndex *entries, uint16_t size) { this->fan_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_COVER
   void reserve_cover(size_t count) { this->covers_.reserve(count); }
+  void set_cover_key_table(const EntityKeyIndex *entries, uint16_t size) { this->cover_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_CLIMATE
   void reserve_climate(size_t count) { this->climates_.reserve(count); }
+  void set_climate_key_table(const EntityKeyIndex *entries, uint16_t size) {
+    this->climate_key_table_ = {entries, size};
+  }
 #endif
 #ifdef USE_LIGHT
   void reserve_light(size_t count) { this->lights_.reserve(count); }
+  void set_light_key_table(const EntityKeyIndex *entries, uint16_t size) { this->light_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_NUMBER
   void reserve_number(size_t count) { this->numbers_.reserve(count); }
+  void set_number_key_table(const EntityKeyIndex *entries, uint16_t size) { this->number_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_DATETIME_DATE
   void reserve_date(size_t count) { this->dates_.reserve(count); }
+  void set_date_key_table(const EntityKeyIndex *entries, uint16_t size) { this->date_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_DATETIME_TIME
   void reserve_time(size_t count) { this->times_.reserve(count); }
+  void set_time_key_table(const EntityKeyIndex *entries, uint16_t size) { this->time_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_DATETIME_DATETIME
   void reserve_datetime(size_t count) { this->datetimes_.reserve(count); }
+  void set_datetime_key_table(const EntityKeyIndex *entries, uint16_t size) {
+    this->datetime_key_table_ = {entries, size};
+  }
 #endif
 #ifdef USE_SELECT
   void reserve_select(size_t count) { this->selects_.reserve(count); }
+  void set_select_key_table(const EntityKeyIndex *entries, uint16_t size) { this->select_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_TEXT
   void reserve_text(size_t count) { this->texts_.reserve(count); }
+  void set_text_key_table(const EntityKeyIndex *entries, uint16_t size) { this->text_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_LOCK
   void reserve_lock(size_t count) { this->locks_.reserve(count); }
+  void set_lock_key_table(const EntityKeyIndex *entries, uint16_t size) { this->lock_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_VALVE
   void reserve_valve(size_t count) { this->valves_.reserve(count); }
+  void set_valve_key_table(const EntityKeyIndex *entries, uint16_t size) { this->valve_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_MEDIA_PLAYER
   void reserve_media_player(size_t count) { this->media_players_.reserve(count); }
+  void set_media_player_key_table(const EntityKeyIndex *entries, uint16_t size) {
+    this->media_player_key_table_ = {entries, size};
+  }
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   void reserve_alarm_control_panel(size_t count) { this->alarm_control_panels_.reserve(count); }
+  void set_alarm_control_panel_key_table(const EntityKeyIndex *entries, uint16_t size) {
+    this->alarm_control_panel_key_table_ = {entries, size};
+  }
 #endif
 #ifdef USE_EVENT
   void reserve_event(size_t count) { this->events_.reserve(count); }
+  void set_event_key_table(const EntityKeyIndex *entries, uint16_t size) { this->event_key_table_ = {entries, size}; }
 #endif
 #ifdef USE_UPDATE
   void reserve_update(size_t count) { this->updates_.reserve(count); }
+  void set_update_key_table(const EntityKeyIndex *entries, uint16_t size) { this->update_key_table_ = {entries, size}; }
 #endif
 
   /// Register the component in this Application instance.
@@ -337,181 +446,109 @@ class Application {
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->binary_sensors_, this->binary_sensor_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->switches_, this->switch_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->buttons_, this->button_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->sensors_, this->sensor_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->text_sensors_, this->text_sensor_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::Fan *> &get_fans() { return this->fans_; }
   fan::Fan *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->fans_, this->fan_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->covers_, this->cover_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->lights_, this->light_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->climates_, this->climate_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->numbers_, this->number_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_DATE
   const std::vector<datetime::DateEntity *> &get_dates() { return this->dates_; }
   datetime::DateEntity *get_date_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->dates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->dates_, this->date_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_TIME
   const std::vector<datetime::TimeEntity *> &get_times() { return this->times_; }
   datetime::TimeEntity *get_time_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->times_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->times_, this->time_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_DATETIME
   const std::vector<datetime::DateTimeEntity *> &get_datetimes() { return this->datetimes_; }
   datetime::DateTimeEntity *get_datetime_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->datetimes_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->datetimes_, this->datetime_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT
   const std::vector<text::Text *> &get_texts() { return this->texts_; }
   text::Text *get_text_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->texts_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->texts_, this->text_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->selects_, this->select_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_LOCK
   const std::vector<lock::Lock *> &get_locks() { return this->locks_; }
   lock::Lock *get_lock_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->locks_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->locks_, this->lock_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_VALVE
   const std::vector<valve::Valve *> &get_valves() { return this->valves_; }
   valve::Valve *get_valve_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->valves_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->valves_, this->valve_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_MEDIA_PLAYER
   const std::vector<media_player::MediaPlayer *> &get_media_players() { return this->media_players_; }
   media_player::MediaPlayer *get_media_player_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->media_players_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->media_players_, this->media_player_key_table_, key, include_internal);
   }
 #endif
 
@@ -520,33 +557,22 @@ class Application {
     return this->alarm_control_panels_;
   }
   alarm_control_panel::AlarmControlPanel *get_alarm_control_panel_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->alarm_control_panels_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->alarm_control_panels_, this->alarm_control_panel_key_table_, key,
+                               include_internal);
   }
 #endif
 
 #ifdef USE_EVENT
   const std::vector<event::Event *> &get_events() { return this->events_; }
   event::Event *get_event_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->events_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->events_, this->event_key_table_, key, include_internal);
   }
 #endif
 
 #ifdef USE_UPDATE
   const std::vector<update::UpdateEntity *> &get_updates() { return this->updates_; }
   update::UpdateEntity *get_update_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->updates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return find_entity_by_key_(this->updates_, this->update_key_table_, key, include_internal);
   }
 #endif
 
@@ -565,6 +591,14 @@ class Application {
   bool is_socket_ready(int fd) const;
 #endif
 
+#ifdef USE_WAKE_LOOP_THREADSAFE
+  /// Wake the main loop if it is sleeping between iterations, so work handed over from another
+  /// task or thread is processed right away instead of after the rest of the loop interval.
+  /// Thread-safe, but NOT safe to call from an ISR. Repeated calls before the loop wakes are coalesced.
+  /// Does nothing until the first loop() after setup, which creates the wake socket.
+  void wake_loop_threadsafe();
+#endif
+
  protected:
   friend Component;
 
@@ -572,76 +606,140 @@ class Application {
 
   void calculate_looping_components_();
 
+  /// Move a component out of the active part of looping_components_, see Component::disable_loop()
+  void disable_component_loop_(Component *component);
+  /// Move a component back into the active part of looping_components_, see Component::enable_loop()
+  void enable_component_loop_(Component *component);
+  /// Handle Component::enable_loop_soon_any_context() requests, must be called from the main loop
+  void enable_pending_loops_();
+
   void feed_wdt_arch_();
 
+  /// Find an entity by object_id hash, using a binary search of the generated table and falling back to a linear scan
+  /// for keys not in it (entities named at runtime, keys shared by several entities, unknown keys).
+  template<typename T>
+  static T *find_entity_by_key_(const std::vector<T *> &entities, const EntityKeyTable &table, uint32_t key,
+                                bool include_internal) {
+    size_t low = 0;
+    size_t high = table.size;
+    while (low < high) {
+      size_t mid = (low + high) / 2;
+      if (table.entries[mid].key < key) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    if (low < table.size && table.entries[low].key == key && table.entries[low].index < entities.size()) {
+      T *obj = entities[table.entries[low].index];
+      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
+        return obj;
+    }
+    for (auto *obj : entities) {
+      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
+        return obj;
+    }
+    return nullptr;
+  }
+
   /// Perform a delay while also monitoring socket file descriptors for readiness
   void yield_with_select_(uint32_t delay_ms);
 
+#ifdef USE_WAKE_LOOP_THREADSAFE
+  /// Create the loopback socket used by wake_loop_threadsafe() and add it to the select() set, on the first loop
+  void setup_wake_loop_threadsafe_();
+  /// Discard pending wake datagrams, called after select() reported the wake socket readable
+  void drain_wake_socket_();
+#endif
+
   std::vector<Component *> components_{};
+  /// Components with an overridden loop(). The first `looping_components_active_end_` entries are
+  /// called every iteration, the rest have disabled their loop and are skipped until re-enabled.
   std::vector<Component *> looping_components_{};
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
+  EntityKeyTable binary_sensor_key_table_{};
 #endif
 #ifdef USE_SWITCH
   std::vector<switch_::Switch *> switches_{};
+  EntityKeyTable switch_key_table_{};
 #endif
 #ifdef USE_BUTTON
   std::vector<button::Button *> buttons_{};
+  EntityKeyTable button_key_table_{};
 #endif
 #ifdef USE_EVENT
   std::vector<event::Event *> events_{};
+  EntityKeyTable event_key_table_{};
 #endif
 #ifdef USE_SENSOR
   std::vector<sensor::Sensor *> sensors_{};
+  EntityKeyTable sensor_key_table_{};
 #endif
 #ifdef USE_TEXT_SENSOR
   std::vector<text_sensor::TextSensor *> text_sensors_{};
+  EntityKeyTable text_sensor_key_table_{};
 #endif
 #ifdef USE_FAN
   std::vector<fan::Fan *> fans_{};
+  EntityKeyTable fan_key_table_{};
 #endif
 #ifdef USE_COVER
   std::vector<cover::Cover *> covers_{};
+  EntityKeyTable cover_key_table_{};
 #endif
 #ifdef USE_CLIMATE
   std::vector<climate::Climate *> climates_{};
+  EntityKeyTable climate_key_table_{};
 #endif
 #ifdef USE_LIGHT
   std::vector<light::LightState *> lights_{};
+  EntityKeyTable light_key_table_{};
 #endif
 #ifdef USE_NUMBER
   std::vector<number::Number *> numbers_{};
+  EntityKeyTable number_key_table_{};
 #endif
 #ifdef USE_DATETIME_DATE
   std::vector<datetime::DateEntity *> dates_{};
+  EntityKeyTable date_key_table_{};
 #endif
 #ifdef USE_DATETIME_TIME
   std::vector<datetime::TimeEntity *> times_{};
+  EntityKeyTable time_key_table_{};
 #endif
 #ifdef USE_DATETIME_DATETIME
   std::vector<datetime::DateTimeEntity *> datetimes_{};
+  EntityKeyTable datetime_key_table_{};
 #endif
 #ifdef USE_SELECT
   std::vector<select::Select *> selects_{};
+  EntityKeyTable select_key_table_{};
 #endif
 #ifdef USE_TEXT
   std::vector<text::Text *> texts_{};
+  EntityKeyTable text_key_table_{};
 #endif
 #ifdef USE_LOCK
   std::vector<lock::Lock *> locks_{};
+  EntityKeyTable lock_key_table_{};
 #endif
 #ifdef USE_VALVE
   std::vector<valve::Valve *> valves_{};
+  EntityKeyTable valve_key_table_{};
 #endif
 #ifdef USE_MEDIA_PLAYER
   std::vector<media_player::MediaPlayer *> media_players_{};
+  EntityKeyTable media_player_key_table_{};
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   std::vector<alarm_control_panel::AlarmControlPanel *> alarm_control_panels_{};
+  EntityKeyTable alarm_control_panel_key_table_{};
 #endif
 #ifdef USE_UPDATE
   std::vector<update::UpdateEntity *> updates_{};
+  EntityKeyTable update_key_table_{};
 #endif
 
   std::string name_;
@@ -656,6 +754,11 @@ class Application {
   uint8_t app_state_{0};
   Component *current_component_{nullptr};
   uint32_t loop_component_start_time_{0};
+  uint16_t looping_components_active_end_{0};
+  uint16_t current_loop_index_{0};  ///< Index into looping_components_ of the component currently looping
+  bool in_loop_{false};             ///< True while loop() iterates over looping_components_
+  /// Set from any context by Component::enable_loop_soon_any_context(), consumed by the main loop
+  volatile bool has_pending_enable_loop_requests_{false};
 
 #ifdef USE_SOCKET_SELECT_SUPPORT
   // Socket select management
@@ -665,6 +768,11 @@ class Application {
   fd_set base_read_fds_{};          // Cached fd_set rebuilt only when socket_fds_ changes
   fd_set read_fds_{};               // Working fd_set for select(), copied from base_read_fds_
 #endif
+#ifdef USE_WAKE_LOOP_THREADSAFE
+  int wake_socket_fd_{-1};                  // UDP socket connected to itself, readable when a wake is pending
+  std::atomic<bool> wake_pending_{false};   // Set by wake_loop_threadsafe(), cleared when the socket is drained
+  bool wake_socket_created_{false};         // Set once setup_wake_loop_threadsafe_() was called, even if it failed
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
@@ -326,21 +326,26 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
 
     if (this->timeout_value_.has_value()) {
       auto f = std::bind(&WaitUntilAction<Ts...>::play_next_, this, x...);
-      this->set_timeout("timeout", this->timeout_value_.value(x...), f);
+      this->set_timeout(TIMEOUT_ID, this->timeout_value_.value(x...), f);
     }
 
+    // Poll the condition in loop() until it's met
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      // Nothing is waiting, stop polling until the next play_complex()
+      this->disable_loop();
       return;
+    }
 
     if (!this->condition_->check_tuple(this->var_)) {
       return;
     }
 
-    this->cancel_timeout("timeout");
+    this->cancel_timeout(TIMEOUT_ID);
 
     this->play_next_tuple_(this->var_);
   }
@@ -350,9 +355,11 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout("timeout"); }
+  void stop() override { this->cancel_timeout(TIMEOUT_ID); }
 
  protected:
+  static constexpr uint32_t TIMEOUT_ID = fnv1_hash("timeout");
+
   Condition<Ts...> *condition_;
   std::tuple<Ts...> var_{};
 };
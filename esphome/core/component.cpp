@@ -8,10 +8,18 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#ifdef USE_DEBUG_PROFILE
+#include "esphome/core/profiler.h"
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "component";
 
+#ifdef USE_DEBUG_PROFILE
+RuntimeProfiler *global_runtime_profiler = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
 namespace setup_priority {
 
 const float BUS = 1000.0f;
@@ -30,21 +38,25 @@ const float LATE = -100.0f;
 
 }  // namespace setup_priority
 
-// Component state uses bits 0-1 (4 states)
-const uint8_t COMPONENT_STATE_MASK = 0x03;
+// Component state uses bits 0-2 (5 states)
+const uint8_t COMPONENT_STATE_MASK = 0x07;
 const uint8_t COMPONENT_STATE_CONSTRUCTION = 0x00;
 const uint8_t COMPONENT_STATE_SETUP = 0x01;
 const uint8_t COMPONENT_STATE_LOOP = 0x02;
 const uint8_t COMPONENT_STATE_FAILED = 0x03;
-// Status LED uses bits 2-3
-const uint8_t STATUS_LED_MASK = 0x0C;
+const uint8_t COMPONENT_STATE_LOOP_DONE = 0x04;
+// Status LED uses bits 3-4
+const uint8_t STATUS_LED_MASK = 0x18;
 const uint8_t STATUS_LED_OK = 0x00;
-const uint8_t STATUS_LED_WARNING = 0x04;  // Bit 2
-const uint8_t STATUS_LED_ERROR = 0x08;    // Bit 3
+const uint8_t STATUS_LED_WARNING = 0x08;  // Bit 3
+const uint8_t STATUS_LED_ERROR = 0x10;    // Bit 4
 
 const uint16_t WARN_IF_BLOCKING_OVER_MS = 50U;       ///< Initial blocking time allowed without warning
 const uint16_t WARN_IF_BLOCKING_INCREMENT_MS = 10U;  ///< How long the blocking time must be larger to warn again
 
+/// Id of the "update" interval registered by PollingComponent, resolved at compile time.
+static constexpr uint32_t POLLING_UPDATE_ID = fnv1_hash("update");
+
 uint32_t global_state = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 float Component::get_loop_priority() const { return 0.0f; }
@@ -63,6 +75,14 @@ bool Component::cancel_interval(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_interval(this, name);
 }
 
+void Component::set_interval(uint32_t id, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_interval(this, id, interval, std::move(f));
+}
+
+bool Component::cancel_interval(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_interval(this, id);
+}
+
 void Component::set_retry(const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                           std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor) {  // NOLINT
   App.scheduler.set_retry(this, name, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
@@ -72,6 +92,15 @@ bool Component::cancel_retry(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_retry(this, name);
 }
 
+void Component::set_retry(uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                          std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor) {  // NOLINT
+  App.scheduler.set_retry(this, id, initial_wait_time, max_attempts, std::move(f), backoff_increase_factor);
+}
+
+bool Component::cancel_retry(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_retry(this, id);
+}
+
 void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, timeout, std::move(f));
 }
@@ -80,6 +109,14 @@ bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+void Component::set_timeout(uint32_t id, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, id, timeout, std::move(f));
+}
+
+bool Component::cancel_timeout(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, id);
+}
+
 void Component::call_loop() { this->loop(); }
 void Component::call_setup() { this->setup(); }
 void Component::call_dump_config() {
@@ -112,6 +149,9 @@ void Component::call() {
     case COMPONENT_STATE_FAILED:  // NOLINT(bugprone-branch-clone)
       // State failed: Do nothing
       break;
+    case COMPONENT_STATE_LOOP_DONE:  // NOLINT(bugprone-branch-clone)
+      // State loop done: Do nothing, loop() has been disabled
+      break;
     default:
       break;
   }
@@ -139,6 +179,36 @@ void Component::mark_failed() {
   this->component_state_ &= ~COMPONENT_STATE_MASK;
   this->component_state_ |= COMPONENT_STATE_FAILED;
   this->status_set_error();
+  // Failed components are never looped again, unless reset_to_construction_state() is called
+  App.disable_component_loop_(this);
+}
+void Component::disable_loop() {
+  uint8_t state = this->component_state_ & COMPONENT_STATE_MASK;
+  if (state != COMPONENT_STATE_SETUP && state != COMPONENT_STATE_LOOP)
+    return;
+  ESP_LOGVV(TAG, "%s loop disabled", this->get_component_source());
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP_DONE;
+  App.disable_component_loop_(this);
+}
+void Component::enable_loop() {
+  // Any enable_loop_soon_any_context() request is served now
+  this->pending_enable_loop_ = false;
+  if ((this->component_state_ & COMPONENT_STATE_MASK) != COMPONENT_STATE_LOOP_DONE)
+    return;
+  ESP_LOGVV(TAG, "%s loop enabled", this->get_component_source());
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP;
+  App.enable_component_loop_(this);
+}
+void IRAM_ATTR HOT Component::enable_loop_soon_any_context() {
+  // Only plain stores here: this may run in an ISR or on another task. The main loop does the rest.
+  this->pending_enable_loop_ = true;
+  App.has_pending_enable_loop_requests_ = true;
+}
+bool Component::is_loop_enabled_() const {
+  uint8_t state = this->component_state_ & COMPONENT_STATE_MASK;
+  return state != COMPONENT_STATE_FAILED && state != COMPONENT_STATE_LOOP_DONE;
 }
 void Component::reset_to_construction_state() {
   if ((this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED) {
@@ -147,10 +217,13 @@ void Component::reset_to_construction_state() {
     this->component_state_ |= COMPONENT_STATE_CONSTRUCTION;
     // Clear error status when resetting
     this->status_clear_error();
+    // Re-add to the active loop list so setup() runs again
+    App.enable_component_loop_(this);
   }
 }
 bool Component::is_in_loop_state() const {
-  return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP;
+  uint8_t state = this->component_state_ & COMPONENT_STATE_MASK;
+  return state == COMPONENT_STATE_LOOP || state == COMPONENT_STATE_LOOP_DONE;
 }
 void Component::defer(std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, "", 0, std::move(f));
@@ -161,6 +234,12 @@ bool Component::cancel_defer(const std::string &name) {  // NOLINT
 void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
+void Component::defer(uint32_t id, std::function<void()> &&f) {  // NOLINT
+  App.scheduler.set_timeout(this, id, 0, std::move(f));
+}
+bool Component::cancel_defer(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, id);
+}
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, "", timeout, std::move(f));
 }
@@ -174,6 +253,7 @@ void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std:
 bool Component::is_failed() const { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::is_ready() const {
   return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP ||
+         (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP_DONE ||
          (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_SETUP;
 }
 bool Component::can_proceed() { return true; }
@@ -250,22 +330,33 @@ void PollingComponent::call_setup() {
 
 void PollingComponent::start_poller() {
   // Register interval.
-  this->set_interval("update", this->get_update_interval(), [this]() { this->update(); });
+  this->set_interval(POLLING_UPDATE_ID, this->get_update_interval(), [this]() { this->update(); });
 }
 
 void PollingComponent::stop_poller() {
   // Clear the interval to suspend component
-  this->cancel_interval("update");
+  this->cancel_interval(POLLING_UPDATE_ID);
 }
 
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
 void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
 WarnIfComponentBlockingGuard::WarnIfComponentBlockingGuard(Component *component, uint32_t start_time)
-    : started_(start_time), component_(component) {}
+    : started_(start_time), component_(component) {
+#ifdef USE_DEBUG_PROFILE
+  this->started_us_ = micros();
+#endif
+}
 uint32_t WarnIfComponentBlockingGuard::finish() {
   uint32_t curr_time = millis();
 
+#ifdef USE_DEBUG_PROFILE
+  if (global_runtime_profiler != nullptr) {
+    global_runtime_profiler->record(this->component_, this->profile_kind_, this->profile_id_,
+                                    micros() - this->started_us_);
+  }
+#endif
+
   uint32_t blocking_time = curr_time - this->started_;
   bool should_warn;
   if (this->component_ != nullptr) {
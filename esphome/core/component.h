@@ -5,6 +5,7 @@
 #include <functional>
 #include <string>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -58,6 +59,7 @@ extern const uint8_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint8_t COMPONENT_STATE_SETUP;
 extern const uint8_t COMPONENT_STATE_LOOP;
 extern const uint8_t COMPONENT_STATE_FAILED;
+extern const uint8_t COMPONENT_STATE_LOOP_DONE;
 extern const uint8_t STATUS_LED_MASK;
 extern const uint8_t STATUS_LED_OK;
 extern const uint8_t STATUS_LED_WARNING;
@@ -132,11 +134,33 @@ class Component {
   void reset_to_construction_state();
 
   /** Check if this component has completed setup and is in the loop state.
+   *
+   * A component that disabled its loop with disable_loop() is still considered to be in the loop state.
    *
    * @return True if in loop state, false otherwise.
    */
   bool is_in_loop_state() const;
 
+  /** Stop calling loop() for this component until enable_loop() is called.
+   *
+   * Use this when loop() has nothing to do, e.g. while waiting for an event that will re-enable it.
+   * Idle components then cost nothing in the main loop. Timeouts and intervals keep running.
+   * May be called from setup(), loop() or any other main loop context, including other components.
+   */
+  void disable_loop();
+
+  /** Resume calling loop() for this component after disable_loop().
+   *
+   * Must be called from the main loop. Use enable_loop_soon_any_context() from ISRs or other tasks.
+   */
+  void enable_loop();
+
+  /** Request that loop() is re-enabled on the next main loop iteration.
+   *
+   * Safe to call from ISRs and other threads or tasks: it only sets flags which the main loop picks up.
+   */
+  void enable_loop_soon_any_context();
+
   /** Mark this component as failed. Any future timeouts/intervals/setup/loop will no longer be called.
    *
    * This might be useful if a component wants to indicate that a connection to its peripheral failed.
@@ -220,12 +244,20 @@ class Component {
 
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /** Set an interval function identified by a numeric id instead of a name.
+   *
+   * Behaves like set_interval(const std::string &, ...) with `name` replaced by its fnv1_hash(). Use
+   * `fnv1_hash("name")` as a compile time constant to avoid building and hashing a string on every call.
+   */
+  void set_interval(uint32_t id, uint32_t interval, std::function<void()> &&f);  // NOLINT
+
   /** Cancel an interval function.
    *
    * @param name The identifier for this interval function.
    * @return Whether an interval functions was deleted.
    */
   bool cancel_interval(const std::string &name);  // NOLINT
+  bool cancel_interval(uint32_t id);              // NOLINT
 
   /** Set an retry function with a unique name. Empty name means no cancelling possible.
    *
@@ -263,12 +295,16 @@ class Component {
   void set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult(uint8_t)> &&f,  // NOLINT
                  float backoff_increase_factor = 1.0f);                                                      // NOLINT
 
+  void set_retry(uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,                   // NOLINT
+                 std::function<RetryResult(uint8_t)> &&f, float backoff_increase_factor = 1.0f);  // NOLINT
+
   /** Cancel a retry function.
    *
    * @param name The identifier for this retry function.
    * @return Whether a retry function was deleted.
    */
   bool cancel_retry(const std::string &name);  // NOLINT
+  bool cancel_retry(uint32_t id);              // NOLINT
 
   /** Set a timeout function with a unique name.
    *
@@ -288,12 +324,16 @@ class Component {
 
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /// Set a timeout function identified by a numeric id, see set_interval(uint32_t, uint32_t, ...).
+  void set_timeout(uint32_t id, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
   /** Cancel a timeout function.
    *
    * @param name The identifier for this timeout function.
    * @return Whether a timeout functions was deleted.
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
+  bool cancel_timeout(uint32_t id);              // NOLINT
 
   /** Defer a callback to the next loop() call.
    *
@@ -307,15 +347,23 @@ class Component {
   /// Defer a callback to the next loop() call.
   void defer(std::function<void()> &&f);  // NOLINT
 
+  /// Defer a callback identified by a numeric id to the next loop() call.
+  void defer(uint32_t id, std::function<void()> &&f);  // NOLINT
+
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
+  bool cancel_defer(uint32_t id);              // NOLINT
+
+  /// Whether loop() should be called, i.e. the component has neither failed nor disabled its loop
+  bool is_loop_enabled_() const;
 
   /// State of this component - each bit has a purpose:
-  /// Bits 0-1: Component state (0x00=CONSTRUCTION, 0x01=SETUP, 0x02=LOOP, 0x03=FAILED)
-  /// Bit 2: STATUS_LED_WARNING
-  /// Bit 3: STATUS_LED_ERROR
-  /// Bits 4-7: Unused - reserved for future expansion (50% of the bits are free)
+  /// Bits 0-2: Component state (0x00=CONSTRUCTION, 0x01=SETUP, 0x02=LOOP, 0x03=FAILED, 0x04=LOOP_DONE)
+  /// Bit 3: STATUS_LED_WARNING
+  /// Bit 4: STATUS_LED_ERROR
+  /// Bits 5-7: Unused - reserved for future expansion
   uint8_t component_state_{0x00};
+  volatile bool pending_enable_loop_{false};  ///< Set by enable_loop_soon_any_context()
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
   uint16_t warn_if_blocking_over_{WARN_IF_BLOCKING_OVER_MS};  ///< Warn if blocked for this many ms (max 65.5s)
@@ -371,6 +419,14 @@ class WarnIfComponentBlockingGuard {
  public:
   WarnIfComponentBlockingGuard(Component *component, uint32_t start_time);
 
+#ifdef USE_DEBUG_PROFILE
+  /// Attribute the time measured by this guard to a scheduler callback instead of the component's loop()
+  void set_profile_source(const char *kind, uint32_t id) {
+    this->profile_kind_ = kind;
+    this->profile_id_ = id;
+  }
+#endif
+
   // Finish the timing operation and return the current time
   uint32_t finish();
 
@@ -379,6 +435,11 @@ class WarnIfComponentBlockingGuard {
  protected:
   uint32_t started_;
   Component *component_;
+#ifdef USE_DEBUG_PROFILE
+  uint32_t started_us_;
+  const char *profile_kind_{"loop"};
+  uint32_t profile_id_{0};
+#endif
 };
 
 }  // namespace esphome
@@ -32,7 +32,7 @@ from esphome.const import (
     __version__ as ESPHOME_VERSION,
 )
 from esphome.core import CORE, coroutine_with_priority
-from esphome.helpers import copy_file_if_changed, get_str_env, walk_files
+from esphome.helpers import copy_file_if_changed, fnv1_hash, get_str_env, walk_files
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -335,6 +335,38 @@ async def _add_platform_reserves() -> None:
         cg.add(cg.RawStatement(f"App.reserve_{platform_name}({count});"), prepend=True)
 
 
+@coroutine_with_priority(-100.0)
+async def _add_entity_key_tables(name_add_mac_suffix: bool) -> None:
+    # Sorted tables of object_id hashes to entity positions, used by App.get_*_by_key()
+    for platform_name, entity_ids in sorted(CORE.platform_entities.items()):
+        entries: dict[int, int] = {}
+        for index, entity_id in enumerate(entity_ids):
+            if entity_id not in CORE.entity_object_ids:
+                continue
+            object_id, has_own_name = CORE.entity_object_ids[entity_id]
+            if not has_own_name and name_add_mac_suffix:
+                # The object_id is only known at runtime
+                continue
+            # Keep the first entity for a key, like the linear search does
+            entries.setdefault(fnv1_hash(object_id), index)
+        if not entries:
+            continue
+        table = f"{platform_name.upper()}_KEY_TABLE"
+        values = ", ".join(
+            f"{{0x{key:08X}, {index}}}" for key, index in sorted(entries.items())
+        )
+        cg.add_global(
+            cg.RawStatement(
+                f"static const esphome::EntityKeyIndex {table}[] PROGMEM = {{{values}}};"
+            )
+        )
+        cg.add(
+            cg.RawStatement(
+                f"App.set_{platform_name}_key_table({table}, {len(entries)});"
+            )
+        )
+
+
 @coroutine_with_priority(100.0)
 async def to_code(config):
     cg.add_global(cg.global_ns.namespace("esphome").using)
@@ -359,6 +391,7 @@ async def to_code(config):
     )
 
     CORE.add_job(_add_platform_reserves)
+    CORE.add_job(_add_entity_key_tables, config[CONF_NAME_ADD_MAC_SUFFIX])
 
     CORE.add_job(_add_automations, config)
 
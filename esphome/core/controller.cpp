@@ -4,129 +4,268 @@
 
 namespace esphome {
 
-void Controller::setup_controller(bool include_internal) {
-#ifdef USE_BINARY_SENSOR
-  for (auto *obj : App.get_binary_sensors()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj](bool state) { this->on_binary_sensor_update(obj, state); });
+std::vector<Controller *> ControllerRegistry::controllers;            // NOLINT
+uint16_t ControllerRegistry::domain_offsets[CONTROLLER_DOMAIN_COUNT + 1];  // NOLINT
+
+void Controller::setup_controller(bool include_internal, bool coalesce_updates) {
+  this->notify_internal_ = include_internal;
+  this->coalesce_updates_ = coalesce_updates;
+  ControllerRegistry::register_controller(this);
+}
+
+template<typename F> void Controller::for_each_dirty_(ControllerDomain domain, F &&callback) {
+  uint32_t start = ControllerRegistry::domain_offsets[domain];
+  uint32_t end = ControllerRegistry::domain_offsets[domain + 1];
+  for (uint32_t word = start / 32; word * 32 < end; word++) {
+    uint32_t bits = this->dirty_[word];
+    if (bits == 0)
+      continue;
+    // Only the bits of this domain
+    if (word * 32 < start)
+      bits &= ~0u << (start % 32);
+    if ((word + 1) * 32 > end)
+      bits &= ~(~0u << (end % 32));
+    // Cleared first, so an entity that publishes again from the callback is passed on in the next loop
+    this->dirty_[word] &= ~bits;
+    while (bits != 0) {
+      uint32_t bit = __builtin_ctz(bits);
+      bits &= bits - 1;
+      callback(word * 32 + bit - start);
+    }
   }
+}
+
+void Controller::process_entity_updates_() {
+  if (!this->any_dirty_)
+    return;
+  this->any_dirty_ = false;
+  for (uint8_t domain = 0; domain < CONTROLLER_DOMAIN_COUNT; domain++) {
+    auto d = static_cast<ControllerDomain>(domain);
+    this->for_each_dirty_(d, [this, d](uint32_t index) { this->dispatch_update_(d, index); });
+  }
+}
+
+void Controller::dispatch_update_(ControllerDomain domain, uint32_t index) {
+  switch (domain) {
+#ifdef USE_BINARY_SENSOR
+    case CONTROLLER_DOMAIN_BINARY_SENSOR: {
+      auto *obj = App.get_binary_sensors()[index];
+      this->on_binary_sensor_update(obj, obj->state);
+      break;
+    }
 #endif
 #ifdef USE_FAN
-  for (auto *obj : App.get_fans()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_fan_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_FAN:
+      this->on_fan_update(App.get_fans()[index]);
+      break;
 #endif
 #ifdef USE_LIGHT
-  for (auto *obj : App.get_lights()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_new_remote_values_callback([this, obj]() { this->on_light_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_LIGHT:
+      this->on_light_update(App.get_lights()[index]);
+      break;
 #endif
 #ifdef USE_SENSOR
-  for (auto *obj : App.get_sensors()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj](float state) { this->on_sensor_update(obj, state); });
-  }
+    case CONTROLLER_DOMAIN_SENSOR: {
+      auto *obj = App.get_sensors()[index];
+      this->on_sensor_update(obj, obj->state);
+      break;
+    }
 #endif
 #ifdef USE_SWITCH
-  for (auto *obj : App.get_switches()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj](bool state) { this->on_switch_update(obj, state); });
-  }
+    case CONTROLLER_DOMAIN_SWITCH: {
+      auto *obj = App.get_switches()[index];
+      this->on_switch_update(obj, obj->state);
+      break;
+    }
 #endif
 #ifdef USE_COVER
-  for (auto *obj : App.get_covers()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_cover_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_COVER:
+      this->on_cover_update(App.get_covers()[index]);
+      break;
 #endif
 #ifdef USE_TEXT_SENSOR
-  for (auto *obj : App.get_text_sensors()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj](const std::string &state) { this->on_text_sensor_update(obj, state); });
-  }
+    case CONTROLLER_DOMAIN_TEXT_SENSOR: {
+      auto *obj = App.get_text_sensors()[index];
+      this->on_text_sensor_update(obj, obj->state);
+      break;
+    }
 #endif
 #ifdef USE_CLIMATE
-  for (auto *obj : App.get_climates()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj](climate::Climate & /*unused*/) { this->on_climate_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_CLIMATE:
+      this->on_climate_update(App.get_climates()[index]);
+      break;
 #endif
 #ifdef USE_NUMBER
-  for (auto *obj : App.get_numbers()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj](float state) { this->on_number_update(obj, state); });
-  }
+    case CONTROLLER_DOMAIN_NUMBER: {
+      auto *obj = App.get_numbers()[index];
+      this->on_number_update(obj, obj->state);
+      break;
+    }
 #endif
 #ifdef USE_DATETIME_DATE
-  for (auto *obj : App.get_dates()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_date_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_DATE:
+      this->on_date_update(App.get_dates()[index]);
+      break;
 #endif
 #ifdef USE_DATETIME_TIME
-  for (auto *obj : App.get_times()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_time_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_TIME:
+      this->on_time_update(App.get_times()[index]);
+      break;
 #endif
 #ifdef USE_DATETIME_DATETIME
-  for (auto *obj : App.get_datetimes()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_datetime_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_DATETIME:
+      this->on_datetime_update(App.get_datetimes()[index]);
+      break;
 #endif
 #ifdef USE_TEXT
-  for (auto *obj : App.get_texts()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj](const std::string &state) { this->on_text_update(obj, state); });
-  }
+    case CONTROLLER_DOMAIN_TEXT: {
+      auto *obj = App.get_texts()[index];
+      this->on_text_update(obj, obj->state);
+      break;
+    }
 #endif
 #ifdef USE_SELECT
-  for (auto *obj : App.get_selects()) {
-    if (include_internal || !obj->is_internal()) {
-      obj->add_on_state_callback(
-          [this, obj](const std::string &state, size_t index) { this->on_select_update(obj, state, index); });
+    case CONTROLLER_DOMAIN_SELECT: {
+      auto *obj = App.get_selects()[index];
+      // Selects are only marked after publishing one of their options. If the options changed since, the state has
+      // no index anymore and there is nothing valid to pass on.
+      auto active_index = obj->active_index();
+      if (active_index.has_value())
+        this->on_select_update(obj, obj->state, *active_index);
+      break;
     }
-  }
 #endif
 #ifdef USE_LOCK
-  for (auto *obj : App.get_locks()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_lock_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_LOCK:
+      this->on_lock_update(App.get_locks()[index]);
+      break;
 #endif
 #ifdef USE_VALVE
-  for (auto *obj : App.get_valves()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_valve_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_VALVE:
+      this->on_valve_update(App.get_valves()[index]);
+      break;
 #endif
 #ifdef USE_MEDIA_PLAYER
-  for (auto *obj : App.get_media_players()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_media_player_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_MEDIA_PLAYER:
+      this->on_media_player_update(App.get_media_players()[index]);
+      break;
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
-  for (auto *obj : App.get_alarm_control_panels()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_alarm_control_panel_update(obj); });
-  }
+    case CONTROLLER_DOMAIN_ALARM_CONTROL_PANEL:
+      this->on_alarm_control_panel_update(App.get_alarm_control_panels()[index]);
+      break;
 #endif
-#ifdef USE_EVENT
-  for (auto *obj : App.get_events()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_event_callback([this, obj](const std::string &event_type) { this->on_event(obj, event_type); });
+#ifdef USE_UPDATE
+    case CONTROLLER_DOMAIN_UPDATE:
+      this->on_update(App.get_updates()[index]);
+      break;
+#endif
+    default:
+      break;
   }
+}
+
+void ControllerRegistry::register_controller(Controller *controller) {
+  // All entities are registered with App before components are set up, and the domains follow the order of
+  // ControllerDomain
+  uint8_t domain = 0;
+  auto add_domain = [&domain](size_t size) {
+    domain_offsets[domain + 1] = domain_offsets[domain] + size;
+    domain++;
+  };
+  domain_offsets[0] = 0;
+#ifdef USE_BINARY_SENSOR
+  add_domain(App.get_binary_sensors().size());
+#endif
+#ifdef USE_FAN
+  add_domain(App.get_fans().size());
+#endif
+#ifdef USE_LIGHT
+  add_domain(App.get_lights().size());
+#endif
+#ifdef USE_SENSOR
+  add_domain(App.get_sensors().size());
+#endif
+#ifdef USE_SWITCH
+  add_domain(App.get_switches().size());
+#endif
+#ifdef USE_COVER
+  add_domain(App.get_covers().size());
+#endif
+#ifdef USE_TEXT_SENSOR
+  add_domain(App.get_text_sensors().size());
+#endif
+#ifdef USE_CLIMATE
+  add_domain(App.get_climates().size());
+#endif
+#ifdef USE_NUMBER
+  add_domain(App.get_numbers().size());
+#endif
+#ifdef USE_DATETIME_DATE
+  add_domain(App.get_dates().size());
+#endif
+#ifdef USE_DATETIME_TIME
+  add_domain(App.get_times().size());
+#endif
+#ifdef USE_DATETIME_DATETIME
+  add_domain(App.get_datetimes().size());
+#endif
+#ifdef USE_TEXT
+  add_domain(App.get_texts().size());
+#endif
+#ifdef USE_SELECT
+  add_domain(App.get_selects().size());
+#endif
+#ifdef USE_LOCK
+  add_domain(App.get_locks().size());
+#endif
+#ifdef USE_VALVE
+  add_domain(App.get_valves().size());
+#endif
+#ifdef USE_MEDIA_PLAYER
+  add_domain(App.get_media_players().size());
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  add_domain(App.get_alarm_control_panels().size());
 #endif
 #ifdef USE_UPDATE
-  for (auto *obj : App.get_updates()) {
-    if (include_internal || !obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_update(obj); });
-  }
+  add_domain(App.get_updates().size());
 #endif
+
+  controllers.push_back(controller);
+  for (auto *c : controllers) {
+    if (!c->coalesce_updates_)
+      continue;
+    c->dirty_.assign((domain_offsets[CONTROLLER_DOMAIN_COUNT] + 31) / 32, 0);
+    c->any_dirty_ = false;
+  }
+}
+
+void ControllerRegistry::notify_update(ControllerDomain domain, EntityBase *obj) {
+  uint32_t bit = domain_offsets[domain] + obj->get_domain_index();
+  // Entities registered after the controllers were set up are not tracked
+  if (bit >= domain_offsets[domain + 1])
+    return;
+  for (auto *controller : controllers) {
+    if (obj->is_internal() && !controller->notify_internal_)
+      continue;
+    if (!controller->coalesce_updates_) {
+      controller->dispatch_update_(domain, obj->get_domain_index());
+      continue;
+    }
+    controller->dirty_[bit / 32] |= 1u << (bit % 32);
+    controller->any_dirty_ = true;
+  }
 }
 
+#ifdef USE_EVENT
+void ControllerRegistry::notify_event(event::Event *obj, const std::string &event_type) {
+  for (auto *controller : controllers) {
+    if (obj->is_internal() && !controller->notify_internal_)
+      continue;
+    controller->on_event(obj, event_type);
+  }
+}
+#endif
+
 }  // namespace esphome
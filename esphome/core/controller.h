@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "esphome/core/defines.h"
+#include "esphome/core/entity_base.h"
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -67,9 +71,85 @@
 
 namespace esphome {
 
+/// Entity domains whose state changes are passed to controllers. Each domain has a range of bits in the dirty bitset
+/// of a controller, events are not included since they are passed on right away.
+enum ControllerDomain : uint8_t {
+#ifdef USE_BINARY_SENSOR
+  CONTROLLER_DOMAIN_BINARY_SENSOR,
+#endif
+#ifdef USE_FAN
+  CONTROLLER_DOMAIN_FAN,
+#endif
+#ifdef USE_LIGHT
+  CONTROLLER_DOMAIN_LIGHT,
+#endif
+#ifdef USE_SENSOR
+  CONTROLLER_DOMAIN_SENSOR,
+#endif
+#ifdef USE_SWITCH
+  CONTROLLER_DOMAIN_SWITCH,
+#endif
+#ifdef USE_COVER
+  CONTROLLER_DOMAIN_COVER,
+#endif
+#ifdef USE_TEXT_SENSOR
+  CONTROLLER_DOMAIN_TEXT_SENSOR,
+#endif
+#ifdef USE_CLIMATE
+  CONTROLLER_DOMAIN_CLIMATE,
+#endif
+#ifdef USE_NUMBER
+  CONTROLLER_DOMAIN_NUMBER,
+#endif
+#ifdef USE_DATETIME_DATE
+  CONTROLLER_DOMAIN_DATE,
+#endif
+#ifdef USE_DATETIME_TIME
+  CONTROLLER_DOMAIN_TIME,
+#endif
+#ifdef USE_DATETIME_DATETIME
+  CONTROLLER_DOMAIN_DATETIME,
+#endif
+#ifdef USE_TEXT
+  CONTROLLER_DOMAIN_TEXT,
+#endif
+#ifdef USE_SELECT
+  CONTROLLER_DOMAIN_SELECT,
+#endif
+#ifdef USE_LOCK
+  CONTROLLER_DOMAIN_LOCK,
+#endif
+#ifdef USE_VALVE
+  CONTROLLER_DOMAIN_VALVE,
+#endif
+#ifdef USE_MEDIA_PLAYER
+  CONTROLLER_DOMAIN_MEDIA_PLAYER,
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  CONTROLLER_DOMAIN_ALARM_CONTROL_PANEL,
+#endif
+#ifdef USE_UPDATE
+  CONTROLLER_DOMAIN_UPDATE,
+#endif
+  CONTROLLER_DOMAIN_COUNT,
+};
+
+/** Base class for components that pass entity state changes on to a client, like the native API and the web server.
+ *
+ * By default every state change is passed to the on_*_update() methods right away, from within publish_state().
+ *
+ * Controllers that set up with coalesce_updates instead have the entity marked dirty in a bitset with one bit per
+ * entity. They must call process_entity_updates_() from their loop(), which passes every dirty entity to the
+ * on_*_update() methods with its current state, so a burst of updates to one entity is passed on once.
+ */
 class Controller {
  public:
-  void setup_controller(bool include_internal = false);
+  /** Start receiving the state changes of the entities registered with App.
+   *
+   * @param include_internal Also pass on the state changes of internal entities.
+   * @param coalesce_updates Only mark changed entities, they are passed on by process_entity_updates_().
+   */
+  void setup_controller(bool include_internal = false, bool coalesce_updates = false);
 #ifdef USE_BINARY_SENSOR
   virtual void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state){};
 #endif
@@ -130,6 +210,41 @@ class Controller {
 #ifdef USE_UPDATE
   virtual void on_update(update::UpdateEntity *obj){};
 #endif
+
+ protected:
+  friend class ControllerRegistry;
+
+  /// Pass the entities that changed since the last call on to the on_*_update() methods.
+  void process_entity_updates_();
+  template<typename F> void for_each_dirty_(ControllerDomain domain, F &&callback);
+  /// Pass entity \p index of \p domain on to its on_*_update() method.
+  void dispatch_update_(ControllerDomain domain, uint32_t index);
+
+  /// One bit per entity, laid out by ControllerRegistry::domain_offsets. Empty unless coalesce_updates_ is set.
+  std::vector<uint32_t> dirty_;
+  bool any_dirty_{false};
+  bool notify_internal_{false};
+  bool coalesce_updates_{false};
+};
+
+/// Passes entity state changes to every controller that was set up.
+class ControllerRegistry {
+ public:
+  /// Add \p controller and size the dirty bitsets of all controllers for the entities registered with App.
+  static void register_controller(Controller *controller);
+  /// Called by an entity of \p domain when it publishes a new state.
+  static void notify_update(ControllerDomain domain, EntityBase *obj);
+#ifdef USE_EVENT
+  /// Events are not coalesced, every event is passed to the controllers right away.
+  static void notify_event(event::Event *obj, const std::string &event_type);
+#endif
+
+ protected:
+  friend class Controller;
+
+  static std::vector<Controller *> controllers;
+  /// First bit of each domain in the dirty bitsets, the last entry is the total number of bits.
+  static uint16_t domain_offsets[CONTROLLER_DOMAIN_COUNT + 1];
 };
 
 }  // namespace esphome
@@ -28,6 +28,7 @@
 #define USE_DATETIME_DATE
 #define USE_DATETIME_DATETIME
 #define USE_DATETIME_TIME
+#define USE_DEBUG_PROFILE
 #define USE_DEEP_SLEEP
 #define USE_DISPLAY
 #define USE_ESP32_IMPROV_STATE_CALLBACK
@@ -132,6 +133,7 @@
 #ifdef USE_ESP32
 #define USE_BLUETOOTH_PROXY
 #define USE_CAPTIVE_PORTAL
+#define USE_DISPLAY_DOUBLE_BUFFER
 #define USE_ESP32_BLE
 #define USE_ESP32_BLE_CLIENT
 #define USE_ESP32_BLE_SERVER
@@ -144,6 +146,7 @@
 #define USE_SPEAKER
 #define USE_SPI
 #define USE_VOICE_ASSISTANT
+#define USE_WAKE_LOOP_THREADSAFE
 #define USE_WEBSERVER
 #define USE_WEBSERVER_PORT 80  // NOLINT
 #define USE_WIFI_11KV_SUPPORT
@@ -211,6 +214,7 @@
 #ifdef USE_HOST
 #define USE_SOCKET_IMPL_BSD_SOCKETS
 #define USE_SOCKET_SELECT_SUPPORT
+#define USE_WAKE_LOOP_THREADSAFE
 #endif
 
 // Disabled feature flags
@@ -55,6 +55,10 @@ class EntityBase {
   // Set has_state - for components that need to manually set this
   void set_has_state(bool state) { this->flags_.has_state = state; }
 
+  // Get/set the position of this entity in the list of its domain in App, set when the entity is registered
+  uint16_t get_domain_index() const { return this->domain_index_; }
+  void set_domain_index(uint16_t domain_index) { this->domain_index_ = domain_index; }
+
  protected:
   /// The hash_base() function has been deprecated. It is kept in this
   /// class for now, to prevent external components from not compiling.
@@ -75,6 +79,7 @@ class EntityBase {
     uint8_t entity_category : 2;  // Supports up to 4 categories
     uint8_t reserved : 2;         // Reserved for future use
   } flags_{};
+  uint16_t domain_index_{0};
 };
 
 class EntityBase_DeviceClass {  // NOLINT(readability-identifier-naming)
@@ -184,9 +184,9 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc, uint16_t poly,
 }
 
 uint32_t fnv1_hash(const std::string &str) {
-  uint32_t hash = 2166136261UL;
+  uint32_t hash = FNV1_OFFSET_BASIS;
   for (char c : str) {
-    hash *= 16777619UL;
+    hash *= FNV1_PRIME;
     hash ^= c;
   }
   return hash;
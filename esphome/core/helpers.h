@@ -173,6 +173,19 @@ uint16_t crc16(const uint8_t *data, uint16_t len, uint16_t crc = 0xffff, uint16_
 uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc = 0, uint16_t poly = 0x1021, bool refin = false,
                  bool refout = false);
 
+static constexpr uint32_t FNV1_OFFSET_BASIS = 2166136261UL;
+static constexpr uint32_t FNV1_PRIME = 16777619UL;
+
+/// Extend a FNV-1 hash \p hash with the characters of the null-terminated string \p str.
+constexpr14 uint32_t fnv1_hash_extend(uint32_t hash, const char *str) {
+  while (*str != '\0') {
+    hash *= FNV1_PRIME;
+    hash ^= *str++;
+  }
+  return hash;
+}
+/// Calculate a FNV-1 hash of \p str. Usable in constant expressions, e.g. to derive ids from string literals.
+constexpr14 uint32_t fnv1_hash(const char *str) { return fnv1_hash_extend(FNV1_OFFSET_BASIS, str); }
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_DEBUG_PROFILE
+
+#include <cstdint>
+
+namespace esphome {
+
+class Component;
+
+/** Receives the run time of every component loop() and scheduler callback.
+ *
+ * WarnIfComponentBlockingGuard reports each call it wraps to global_runtime_profiler, if one is set.
+ * The debug component provides the implementation.
+ */
+class RuntimeProfiler {
+ public:
+  /// Record one call of \p duration_us. Only called from the main loop.
+  virtual void record(Component *component, const char *kind, uint32_t id, uint32_t duration_us) = 0;
+};
+
+extern RuntimeProfiler *global_runtime_profiler;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace esphome
+
+#endif  // USE_DEBUG_PROFILE
@@ -17,67 +17,82 @@ static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
-// A note on locking: the `lock_` lock protects the `items_` and `to_add_` containers. It must be taken when writing to
-// them (i.e. when adding/removing items, but not when changing items). As items are only deleted from the loop task,
-// iterating over them from the loop task is fine; but iterating from any other context requires the lock to be held to
-// avoid the main thread modifying the list while it is being accessed.
+// A note on locking: the `lock_` lock protects the heap, `to_add_`, the index and the pool. It must be taken when
+// writing to them (i.e. when adding/removing items, but not when changing items). As items are only deleted from the
+// loop task, iterating over them from the loop task is fine; but iterating from any other context requires the lock to
+// be held to avoid the main thread modifying the heap while it is being accessed.
 
 void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
                                 std::function<void()> func) {
-  const auto now = this->millis_();
-
-  if (!name.empty())
-    this->cancel_timeout(component, name);
-
-  if (timeout == SCHEDULER_DONT_RUN)
-    return;
-
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
-  item->next_execution_ = now + timeout;
-  item->callback = std::move(func);
-  item->remove = false;
-#ifdef ESPHOME_DEBUG_SCHEDULER
-  ESP_LOGD(TAG, "set_timeout(name='%s/%s', timeout=%" PRIu32 ")", item->get_source(), name.c_str(), timeout);
-#endif
-  this->push_(std::move(item));
+  this->set_timer_(component, SchedulerItem::TIMEOUT, !name.empty(), fnv1_hash(name), &name, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout(Component *component, uint32_t id, uint32_t timeout, std::function<void()> func) {
+  this->set_timer_(component, SchedulerItem::TIMEOUT, true, id, nullptr, timeout, std::move(func));
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+  return this->cancel_item_(component, !name.empty(), fnv1_hash(name), &name, SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, uint32_t id) {
+  return this->cancel_item_(component, true, id, nullptr, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> func) {
+  this->set_timer_(component, SchedulerItem::INTERVAL, !name.empty(), fnv1_hash(name), &name, interval,
+                   std::move(func));
+}
+void HOT Scheduler::set_interval(Component *component, uint32_t id, uint32_t interval, std::function<void()> func) {
+  this->set_timer_(component, SchedulerItem::INTERVAL, true, id, nullptr, interval, std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, !name.empty(), fnv1_hash(name), &name, SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel_interval(Component *component, uint32_t id) {
+  return this->cancel_item_(component, true, id, nullptr, SchedulerItem::INTERVAL);
+}
+void HOT Scheduler::set_timer_(Component *component, SchedulerItem::Type type, bool named, uint32_t id,
+                               const std::string *name, uint32_t delay, std::function<void()> func) {
   const auto now = this->millis_();
+  // Replacing the old item and queueing the new one happens under one lock, so another task can't slip in between
+  LockGuard guard{this->lock_};
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
+  if (named)
+    this->cancel_item_locked_(component, true, id, name, type);
 
-  if (interval == SCHEDULER_DONT_RUN)
+  if (delay == SCHEDULER_DONT_RUN)
     return;
 
-  // only put offset in lower half
-  uint32_t offset = 0;
-  if (interval != 0)
-    offset = (random_uint32() % interval) / 2;
-
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
-  item->interval = interval;
-  item->next_execution_ = now + offset;
+  // Unnamed items have no id, the debug output and the profiler show them as 0
+  item->id = named ? id : 0;
+  if (named && name != nullptr) {
+    // Assigning reuses the buffer of a recycled item
+    item->name = *name;
+  } else {
+    item->name.clear();
+  }
+  item->named = named;
+  item->type = type;
   item->callback = std::move(func);
   item->remove = false;
+  if (type == SchedulerItem::INTERVAL) {
+    // only put offset in lower half
+    uint32_t offset = 0;
+    if (delay != 0)
+      offset = (random_uint32() % delay) / 2;
+    item->interval = delay;
+    item->next_execution_ = now + offset;
+  } else {
+    item->interval = 0;
+    item->next_execution_ = now + delay;
+  }
 #ifdef ESPHOME_DEBUG_SCHEDULER
-  ESP_LOGD(TAG, "set_interval(name='%s/%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", item->get_source(),
-           name.c_str(), interval, offset);
+  ESP_LOGD(TAG, "set_%s(id='%s/%08" PRIX32 "', delay=%" PRIu32 ", next_execution in %" PRIu64 "ms)",
+           item->get_type_str(), item->get_source(), id, delay, item->next_execution_ - now);
 #endif
-  this->push_(std::move(item));
-}
-bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+  if (named)
+    this->index_add_(item.get());
+  this->to_add_.push_back(std::move(item));
 }
 
 struct RetryArgs {
@@ -85,17 +100,32 @@ struct RetryArgs {
   uint8_t retry_countdown;
   uint32_t current_interval;
   Component *component;
-  std::string name;
+  uint32_t id;
+  std::string name;  ///< Empty if the retry was set by id
   float backoff_increase_factor;
   Scheduler *scheduler;
 };
 
-static void retry_handler(const std::shared_ptr<RetryArgs> &args) {
+// Retries run as timeouts, so derive their id from the user's id to keep a retry from replacing
+// (or being cancelled as) a plain timeout that uses the same name. Unnamed retries all map to
+// retry_id(fnv1_hash("")) and therefore replace each other, as they always have.
+static uint32_t retry_id(uint32_t id) {
+  uint32_t hash = fnv1_hash("retry$");
+  for (uint8_t i = 0; i < 4; i++) {
+    hash *= FNV1_PRIME;
+    hash ^= (id >> (i * 8)) & 0xFF;
+  }
+  return hash;
+}
+
+void retry_handler(const std::shared_ptr<RetryArgs> &args) {
   RetryResult const retry_result = args->func(--args->retry_countdown);
   if (retry_result == RetryResult::DONE || args->retry_countdown <= 0)
     return;
   // second execution of `func` happens after `initial_wait_time`
-  args->scheduler->set_timeout(args->component, args->name, args->current_interval, [args]() { retry_handler(args); });
+  args->scheduler->set_timer_(args->component, Scheduler::SchedulerItem::TIMEOUT, true, args->id,
+                              args->name.empty() ? nullptr : &args->name, args->current_interval,
+                              [args]() { retry_handler(args); });
   // backoff_increase_factor applied to third & later executions
   args->current_interval *= args->backoff_increase_factor;
 }
@@ -103,19 +133,29 @@ static void retry_handler(const std::shared_ptr<RetryArgs> &args) {
 void HOT Scheduler::set_retry(Component *component, const std::string &name, uint32_t initial_wait_time,
                               uint8_t max_attempts, std::function<RetryResult(uint8_t)> func,
                               float backoff_increase_factor) {
-  if (!name.empty())
-    this->cancel_retry(component, name);
+  this->set_retry_(component, !name.empty(), fnv1_hash(name), &name, initial_wait_time, max_attempts, std::move(func),
+                   backoff_increase_factor);
+}
+void HOT Scheduler::set_retry(Component *component, uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                              std::function<RetryResult(uint8_t)> func, float backoff_increase_factor) {
+  this->set_retry_(component, true, id, nullptr, initial_wait_time, max_attempts, std::move(func),
+                   backoff_increase_factor);
+}
+void HOT Scheduler::set_retry_(Component *component, bool named, uint32_t id, const std::string *name,
+                               uint32_t initial_wait_time, uint8_t max_attempts,
+                               std::function<RetryResult(uint8_t)> func, float backoff_increase_factor) {
+  if (named)
+    this->cancel_item_(component, true, retry_id(id), name, SchedulerItem::TIMEOUT);
 
   if (initial_wait_time == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_retry(name='%s', initial_wait_time=%" PRIu32 ", max_attempts=%u, backoff_factor=%0.1f)",
-            name.c_str(), initial_wait_time, max_attempts, backoff_increase_factor);
+  ESP_LOGVV(TAG, "set_retry(id=%08" PRIX32 ", initial_wait_time=%" PRIu32 ", max_attempts=%u, backoff_factor=%0.1f)",
+            id, initial_wait_time, max_attempts, backoff_increase_factor);
 
   if (backoff_increase_factor < 0.0001) {
-    ESP_LOGE(TAG,
-             "set_retry(name='%s'): backoff_factor cannot be close to zero nor negative (%0.1f). Using 1.0 instead",
-             name.c_str(), backoff_increase_factor);
+    ESP_LOGE(TAG, "set_retry(id=%08" PRIX32 "): backoff_factor cannot be close to zero nor negative (%0.1f). Using 1.0",
+             id, backoff_increase_factor);
     backoff_increase_factor = 1;
   }
 
@@ -124,21 +164,28 @@ void HOT Scheduler::set_retry(Component *component, const std::string &name, uin
   args->retry_countdown = max_attempts;
   args->current_interval = initial_wait_time;
   args->component = component;
-  args->name = "retry$" + name;
+  args->id = retry_id(id);
+  if (named && name != nullptr)
+    args->name = *name;
   args->backoff_increase_factor = backoff_increase_factor;
   args->scheduler = this;
 
   // First execution of `func` immediately
-  this->set_timeout(component, args->name, 0, [args]() { retry_handler(args); });
+  this->set_timer_(component, SchedulerItem::TIMEOUT, true, args->id, args->name.empty() ? nullptr : &args->name, 0,
+                   [args]() { retry_handler(args); });
 }
 bool HOT Scheduler::cancel_retry(Component *component, const std::string &name) {
-  return this->cancel_timeout(component, "retry$" + name);
+  return this->cancel_item_(component, true, retry_id(fnv1_hash(name)), name.empty() ? nullptr : &name,
+                            SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_retry(Component *component, uint32_t id) {
+  return this->cancel_timeout(component, retry_id(id));
 }
 
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
   if (this->empty_())
     return {};
-  auto &item = this->items_[0];
+  auto *item = this->heap_;
   const auto now = this->millis_();
   if (item->next_execution_ < now)
     return 0;
@@ -154,16 +201,15 @@ void HOT Scheduler::call() {
   if (now - last_print > 2000) {
     last_print = now;
     std::vector<std::unique_ptr<SchedulerItem>> old_items;
-    ESP_LOGD(TAG, "Items: count=%u, now=%" PRIu64 " (%u, %" PRIu32 ")", this->items_.size(), now, this->millis_major_,
+    ESP_LOGD(TAG, "Items: count=%zu, now=%" PRIu64 " (%u, %" PRIu32 ")", this->heap_size_, now, this->millis_major_,
              this->last_millis_);
     while (!this->empty_()) {
       this->lock_.lock();
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
+      auto item = this->pop_raw_();
       this->lock_.unlock();
 
-      ESP_LOGD(TAG, "  %s '%s/%s' interval=%" PRIu32 " next_execution in %" PRIu64 "ms at %" PRIu64,
-               item->get_type_str(), item->get_source(), item->name.c_str(), item->interval,
+      ESP_LOGD(TAG, "  %s '%s/%08" PRIX32 "' interval=%" PRIu32 " next_execution in %" PRIu64 "ms at %" PRIu64,
+               item->get_type_str(), item->get_source(), item->id, item->interval,
                item->next_execution_ - now, item->next_execution_);
 
       old_items.push_back(std::move(item));
@@ -172,41 +218,24 @@ void HOT Scheduler::call() {
 
     {
       LockGuard guard{this->lock_};
-      this->items_ = std::move(old_items);
+      for (auto &item : old_items)
+        this->push_heap_(std::move(item));
     }
   }
 #endif  // ESPHOME_DEBUG_SCHEDULER
 
-  auto to_remove_was = to_remove_;
-  auto items_was = this->items_.size();
-  // If we have too many items to remove
-  if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
-    std::vector<std::unique_ptr<SchedulerItem>> valid_items;
-    while (!this->empty_()) {
-      LockGuard guard{this->lock_};
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
-    }
-
-    {
-      LockGuard guard{this->lock_};
-      this->items_ = std::move(valid_items);
-    }
-
-    // The following should not happen unless I'm missing something
-    if (to_remove_ != 0) {
-      ESP_LOGW(TAG, "to_remove_ was %" PRIu32 " now: %" PRIu32 " items where %zu now %zu. Please report this",
-               to_remove_was, to_remove_, items_was, items_.size());
-      to_remove_ = 0;
-    }
+  // If we have too many items to remove. Rebuilding is O(n), so with many timers wait until a good part of the heap
+  // was cancelled to keep replacing a timer O(1) amortized.
+  if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS && to_remove_ * 4 > this->heap_size_) {
+    LockGuard guard{this->lock_};
+    this->purge_removed_();
   }
 
   while (!this->empty_()) {
     // use scoping to indicate visibility of `item` variable
     {
-      // Don't copy-by value yet
-      auto &item = this->items_[0];
+      // Don't pop yet
+      auto *item = this->heap_;
       if (item->next_execution_ > now) {
         // Not reached timeout yet, done for this call
         break;
@@ -214,15 +243,15 @@ void HOT Scheduler::call() {
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
         LockGuard guard{this->lock_};
-        this->pop_raw_();
+        this->recycle_item_(this->pop_raw_());
         continue;
       }
       App.set_current_component(item->component);
 
 #ifdef ESPHOME_DEBUG_SCHEDULER
-      ESP_LOGV(TAG, "Running %s '%s/%s' with interval=%" PRIu32 " next_execution=%" PRIu64 " (now=%" PRIu64 ")",
-               item->get_type_str(), item->get_source(), item->name.c_str(), item->interval, item->next_execution_,
-               now);
+      ESP_LOGV(TAG, "Running %s '%s/%08" PRIX32 "' with interval=%" PRIu32 " next_execution=%" PRIu64
+                    " (now=%" PRIu64 ")",
+               item->get_type_str(), item->get_source(), item->id, item->interval, item->next_execution_, now);
 #endif
 
       // Warning: During callback(), a lot of stuff can happen, including:
@@ -231,6 +260,9 @@ void HOT Scheduler::call() {
       {
         uint32_t now_ms = millis();
         WarnIfComponentBlockingGuard guard{item->component, now_ms};
+#ifdef USE_DEBUG_PROFILE
+        guard.set_profile_source(item->get_type_str(), item->id);
+#endif
         item->callback();
         // Call finish to ensure blocking time is properly calculated and reported
         guard.finish();
@@ -238,26 +270,25 @@ void HOT Scheduler::call() {
     }
 
     {
-      this->lock_.lock();
-
-      // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
+      LockGuard guard{this->lock_};
 
+      // The callback only queued new items in to_add_, so the root is still the item that ran.
       // Only pop after function call, this ensures we were reachable
       // during the function call and know if we were cancelled.
-      this->pop_raw_();
-
-      this->lock_.unlock();
+      auto item = this->pop_raw_();
 
       if (item->remove) {
         // We were removed/cancelled in the function call, stop
-        to_remove_--;
+        this->recycle_item_(std::move(item));
         continue;
       }
 
       if (item->type == SchedulerItem::INTERVAL) {
         item->next_execution_ = now + item->interval;
-        this->push_(std::move(item));
+        // Queue it like a new item, an interval of 0 would otherwise run again in this call
+        this->to_add_.push_back(std::move(item));
+      } else {
+        this->recycle_item_(std::move(item));
       }
     }
   }
@@ -268,56 +299,220 @@ void HOT Scheduler::process_to_add() {
   LockGuard guard{this->lock_};
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      this->recycle_item_(std::move(it));
       continue;
     }
 
-    this->items_.push_back(std::move(it));
-    std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+    this->push_heap_(std::move(it));
   }
   this->to_add_.clear();
 }
 void HOT Scheduler::cleanup_() {
-  while (!this->items_.empty()) {
-    auto &item = this->items_[0];
-    if (!item->remove)
+  while (this->heap_ != nullptr) {
+    if (!this->heap_->remove)
       return;
 
-    to_remove_--;
-
     {
       LockGuard guard{this->lock_};
-      this->pop_raw_();
+      this->recycle_item_(this->pop_raw_());
     }
   }
 }
-void HOT Scheduler::pop_raw_() {
-  std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
-  this->items_.pop_back();
+Scheduler::SchedulerItem *HOT Scheduler::meld_(SchedulerItem *a, SchedulerItem *b) {
+  if (a == nullptr)
+    return b;
+  if (b == nullptr)
+    return a;
+  if (b->next_execution_ < a->next_execution_)
+    std::swap(a, b);
+  b->sibling = a->child;
+  a->child = b;
+  return a;
 }
-void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
-  LockGuard guard{this->lock_};
-  this->to_add_.push_back(std::move(item));
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::pop_raw_() {
+  SchedulerItem *item = this->heap_;
+  // Meld the children of the root in pairs from left to right, then the pairs from right to left
+  SchedulerItem *pairs = nullptr;
+  SchedulerItem *next = item->child;
+  while (next != nullptr) {
+    SchedulerItem *a = next;
+    SchedulerItem *b = a->sibling;
+    next = b != nullptr ? b->sibling : nullptr;
+    a->sibling = nullptr;
+    if (b != nullptr)
+      b->sibling = nullptr;
+    SchedulerItem *pair = meld_(a, b);
+    pair->sibling = pairs;
+    pairs = pair;
+  }
+  SchedulerItem *root = nullptr;
+  while (pairs != nullptr) {
+    next = pairs->sibling;
+    pairs->sibling = nullptr;
+    root = meld_(pairs, root);
+    pairs = next;
+  }
+  this->heap_ = root;
+  this->heap_size_--;
+  item->child = nullptr;
+  return std::unique_ptr<SchedulerItem>(item);
+}
+void HOT Scheduler::push_heap_(std::unique_ptr<SchedulerItem> item) {
+  item->child = nullptr;
+  item->sibling = nullptr;
+  this->heap_ = meld_(this->heap_, item.release());
+  this->heap_size_++;
 }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+void HOT Scheduler::purge_removed_() {
+  // Unlink all items into one list through `sibling`, and meld the ones still pending into a new heap
+  SchedulerItem *list = this->heap_;
+  this->heap_ = nullptr;
+  this->heap_size_ = 0;
+  while (list != nullptr) {
+    SchedulerItem *item = list;
+    list = item->sibling;
+    if (item->child != nullptr) {
+      SchedulerItem *last = item->child;
+      while (last->sibling != nullptr)
+        last = last->sibling;
+      last->sibling = list;
+      list = item->child;
+    }
+    item->child = nullptr;
+    item->sibling = nullptr;
+    if (item->remove) {
+      this->recycle_item_(std::unique_ptr<SchedulerItem>(item));
+    } else {
+      this->push_heap_(std::unique_ptr<SchedulerItem>(item));
+    }
+  }
+}
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_() {
+  if (this->item_pool_.empty())
+    return make_unique<SchedulerItem>();
+  auto item = std::move(this->item_pool_.back());
+  this->item_pool_.pop_back();
+  return item;
+}
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+  if (item->remove) {
+    this->to_remove_--;
+  } else if (item->named) {
+    this->index_remove_(item.get());
+  }
+  // Release anything captured by the callback now rather than when the item is reused.
+  item->callback = nullptr;
+  this->item_pool_.push_back(std::move(item));
+}
+bool HOT Scheduler::cancel_item_(Component *component, bool named, uint32_t id, const std::string *name,
+                                 Scheduler::SchedulerItem::Type type) {
   // obtain lock because this function iterates and can be called from non-loop task context
   LockGuard guard{this->lock_};
+  return this->cancel_item_locked_(component, named, id, name, type);
+}
+bool HOT Scheduler::cancel_item_locked_(Component *component, bool named, uint32_t id, const std::string *name,
+                                        Scheduler::SchedulerItem::Type type) {
   bool ret = false;
-  for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
-      to_remove_++;
-      it->remove = true;
+  if (named) {
+    if (this->index_.empty())
+      return false;
+    const uint32_t mask = this->index_.size() - 1;
+    uint32_t slot = this->index_slot_(component, type, id);
+    while (this->index_[slot] != nullptr) {
+      SchedulerItem *item = this->index_[slot];
+      if (item->component != component || item->type != type || item->id != id || !item->has_name(name)) {
+        slot = (slot + 1) & mask;
+        continue;
+      }
+      item->remove = true;
+      this->to_remove_++;
       ret = true;
+      // A later entry may have moved into this slot, so look at it again
+      this->index_erase_(slot);
     }
+    return ret;
   }
+
   for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->component == component && !it->named && it->type == type && !it->remove) {
       it->remove = true;
+      this->to_remove_++;
+      ret = true;
+    }
+  }
+  // Unnamed items are not indexed, walk the heap
+  std::vector<SchedulerItem *> stack;
+  if (this->heap_ != nullptr)
+    stack.push_back(this->heap_);
+  while (!stack.empty()) {
+    SchedulerItem *item = stack.back();
+    stack.pop_back();
+    if (item->sibling != nullptr)
+      stack.push_back(item->sibling);
+    if (item->child != nullptr)
+      stack.push_back(item->child);
+    if (item->component == component && !item->named && item->type == type && !item->remove) {
+      item->remove = true;
+      this->to_remove_++;
       ret = true;
     }
   }
-
   return ret;
 }
+uint32_t Scheduler::index_slot_(Component *component, SchedulerItem::Type type, uint32_t id) const {
+  // Components are heap objects, drop the alignment bits; then spread the bits with the murmur3 finalizer
+  uint32_t hash = id ^ (static_cast<uint32_t>(reinterpret_cast<uintptr_t>(component) >> 2) * 0x9E3779B1u) ^ type;
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35;
+  hash ^= hash >> 16;
+  return hash & (this->index_.size() - 1);
+}
+void Scheduler::index_add_(SchedulerItem *item) {
+  // Keep the index at most 3/4 full
+  if ((this->index_count_ + 1) * 4 > this->index_.size() * 3) {
+    std::vector<SchedulerItem *> old(this->index_.empty() ? 16 : this->index_.size() * 2, nullptr);
+    old.swap(this->index_);
+    this->index_count_ = 0;
+    for (SchedulerItem *it : old) {
+      if (it != nullptr)
+        this->index_add_(it);
+    }
+  }
+  const uint32_t mask = this->index_.size() - 1;
+  uint32_t slot = this->index_slot_(item->component, item->type, item->id);
+  while (this->index_[slot] != nullptr)
+    slot = (slot + 1) & mask;
+  this->index_[slot] = item;
+  this->index_count_++;
+}
+void Scheduler::index_remove_(SchedulerItem *item) {
+  if (this->index_.empty())
+    return;
+  const uint32_t mask = this->index_.size() - 1;
+  for (uint32_t slot = this->index_slot_(item->component, item->type, item->id); this->index_[slot] != nullptr;
+       slot = (slot + 1) & mask) {
+    if (this->index_[slot] == item) {
+      this->index_erase_(slot);
+      return;
+    }
+  }
+}
+void Scheduler::index_erase_(uint32_t slot) {
+  const uint32_t mask = this->index_.size() - 1;
+  for (uint32_t next = (slot + 1) & mask; this->index_[next] != nullptr; next = (next + 1) & mask) {
+    const SchedulerItem *item = this->index_[next];
+    uint32_t home = this->index_slot_(item->component, item->type, item->id);
+    // Entries whose home slot lies after the hole stay where they are
+    if (((next - home) & mask) >= ((next - slot) & mask)) {
+      this->index_[slot] = this->index_[next];
+      slot = next;
+    }
+  }
+  this->index_[slot] = nullptr;
+  this->index_count_--;
+}
 uint64_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
@@ -329,9 +524,4 @@ uint64_t Scheduler::millis_() {
   return now + (static_cast<uint64_t>(this->millis_major_) << 32);
 }
 
-bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
-                                       const std::unique_ptr<SchedulerItem> &b) {
-  return a->next_execution_ > b->next_execution_;
-}
-
 }  // namespace esphome
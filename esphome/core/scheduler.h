@@ -9,17 +9,39 @@
 namespace esphome {
 
 class Component;
+struct RetryArgs;
+void retry_handler(const std::shared_ptr<RetryArgs> &args);
 
 class Scheduler {
+  // Re-arms the timeout of a retry with its name
+  friend void ::esphome::retry_handler(const std::shared_ptr<RetryArgs> &args);
+
  public:
+  /** Named timers can be addressed either by a string name or by a numeric id.
+   *
+   * A string name is hashed with fnv1_hash() and then behaves like the id overloads, so
+   * `set_timeout(c, "foo", ...)` and `cancel_timeout(c, fnv1_hash("foo"))` refer to the same timer.
+   * Because fnv1_hash() is constexpr for string literals, callers on hot paths can precompute the id
+   * and skip hashing entirely. Timers set by name keep the name, and when two of them have the same hash
+   * the names are compared, so different names never replace or cancel each other. An id can't be told
+   * apart from a name with that hash. An empty name means the timer can't be replaced, only cancelled
+   * together with all other unnamed timers of the component by passing an empty name again.
+   */
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
+  void set_timeout(Component *component, uint32_t id, uint32_t timeout, std::function<void()> func);
   bool cancel_timeout(Component *component, const std::string &name);
+  bool cancel_timeout(Component *component, uint32_t id);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> func);
+  void set_interval(Component *component, uint32_t id, uint32_t interval, std::function<void()> func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, uint32_t id);
 
   void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                  std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
+  void set_retry(Component *component, uint32_t id, uint32_t initial_wait_time, uint8_t max_attempts,
+                 std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
   bool cancel_retry(Component *component, const std::string &name);
+  bool cancel_retry(Component *component, uint32_t id);
 
   optional<uint32_t> next_schedule_in();
 
@@ -30,14 +52,22 @@ class Scheduler {
  protected:
   struct SchedulerItem {
     Component *component;
-    std::string name;
+    uint32_t id;  ///< fnv1_hash() of the name, or the id passed by the caller. Only valid if `named` is set
+    std::string name;  ///< The name if the timer was set by name, empty if it was set by id
     enum Type { TIMEOUT, INTERVAL } type;
     uint32_t interval;
     uint64_t next_execution_;
     std::function<void()> callback;
+    bool named;
     bool remove;
+    /// Pairing heap links, only used while the item is in the heap.
+    SchedulerItem *child;
+    SchedulerItem *sibling;
 
-    static bool cmp(const std::unique_ptr<SchedulerItem> &a, const std::unique_ptr<SchedulerItem> &b);
+    /// Whether a timer set or cancelled with \p name (nullptr if by id) may refer to this item, given equal ids.
+    bool has_name(const std::string *name) const {
+      return name == nullptr || this->name.empty() || this->name == *name;
+    }
     const char *get_type_str() {
       switch (this->type) {
         case SchedulerItem::INTERVAL:
@@ -55,19 +85,57 @@ class Scheduler {
 
   uint64_t millis_();
   void cleanup_();
-  void pop_raw_();
-  void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  std::unique_ptr<SchedulerItem> pop_raw_();
+  /// Insert an item into the heap. Must be called from the loop task with `lock_` held.
+  void push_heap_(std::unique_ptr<SchedulerItem> item);
+  static SchedulerItem *meld_(SchedulerItem *a, SchedulerItem *b);
+  /// Rebuild the heap without the cancelled items.
+  void purge_removed_();
+  void set_timer_(Component *component, SchedulerItem::Type type, bool named, uint32_t id, const std::string *name,
+                  uint32_t delay, std::function<void()> func);
+  void set_retry_(Component *component, bool named, uint32_t id, const std::string *name, uint32_t initial_wait_time,
+                  uint8_t max_attempts, std::function<RetryResult(uint8_t)> func, float backoff_increase_factor);
+  /// Take a cleared item from the pool, or allocate a new one if the pool is empty. Must be called with `lock_` held.
+  std::unique_ptr<SchedulerItem> acquire_item_();
+  /// Return an item to the pool and drop it from the index. Must be called with `lock_` held.
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
+  bool cancel_item_(Component *component, bool named, uint32_t id, const std::string *name, SchedulerItem::Type type);
+  /// Same as cancel_item_(), must be called with `lock_` held.
+  bool cancel_item_locked_(Component *component, bool named, uint32_t id, const std::string *name,
+                           SchedulerItem::Type type);
+  uint32_t index_slot_(Component *component, SchedulerItem::Type type, uint32_t id) const;
+  void index_add_(SchedulerItem *item);
+  void index_remove_(SchedulerItem *item);
+  /// Empty a slot of the index, moving later entries of its probe sequence back.
+  void index_erase_(uint32_t slot);
   bool empty_() {
     this->cleanup_();
-    return this->items_.empty();
+    return this->heap_ == nullptr;
   }
 
   Mutex lock_;
-  std::vector<std::unique_ptr<SchedulerItem>> items_;
+  /** Pending items, ordered by next execution in a pairing heap.
+   *
+   * Inserting is O(1): the item becomes a child of the root, or the new root. Popping the root pairs up its children
+   * in O(log n) amortized time. Cancelled items stay in the heap with `remove` set until they reach the root, or until
+   * too many of them piled up and purge_removed_() rebuilds the heap.
+   */
+  SchedulerItem *heap_{nullptr};
+  size_t heap_size_{0};
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  /** Open addressing table of the named items that are pending and not cancelled, keyed by component, type and id.
+   *
+   * nullptr marks a free slot and its size is a power of two. Lets set_*() and cancel_*() find the item to replace
+   * or cancel without walking the heap. Unnamed items are not indexed, cancelling them walks all items.
+   */
+  std::vector<SchedulerItem *> index_;
+  size_t index_count_{0};
+  /// Finished and cancelled items kept for reuse, so steady-state timeouts don't hit the heap allocator. It grows to
+  /// the largest number of items that were pending at once and is never shrunk.
+  std::vector<std::unique_ptr<SchedulerItem>> item_pool_;
   uint32_t last_millis_{0};
   uint16_t millis_major_{0};
+  /// Cancelled items still in the heap or `to_add_`.
   uint32_t to_remove_{0};
 };
 
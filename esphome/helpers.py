@@ -458,3 +458,12 @@ _DISALLOWED_CHARS = re.compile(r"[^a-zA-Z0-9-_]")
 def sanitize(value):
     """Same behaviour as `helpers.cpp` method `str_sanitize`."""
     return _DISALLOWED_CHARS.sub("_", value)
+
+
+def fnv1_hash(value: str) -> int:
+    """Same behaviour as `helpers.cpp` method `fnv1_hash`."""
+    hash_ = 2166136261
+    for char in value.encode():
+        hash_ = (hash_ * 16777619) & 0xFFFFFFFF
+        hash_ ^= char
+    return hash_
@@ -479,6 +479,23 @@ class StringType(TypeInfo):
         return self.calculate_field_id_size() + 8  # field ID + 8 bytes typical string
 
 
+class StringRefType(StringType):
+    """String field of a message that is only ever received, see is_zero_copy_message().
+
+    Decodes to a StringRef pointing into the receive buffer instead of copying into a
+    std::string, so it is only valid while the message handler runs.
+    """
+
+    cpp_type = "StringRef"
+    reference_type = "StringRef &"
+    const_reference_type = "const StringRef &"
+    decode_length = "value.as_string_ref()"
+
+    def dump(self, name: str) -> str:
+        o = f'out.append("\'").append({name}.c_str(), {name}.size()).append("\'");'
+        return o
+
+
 @register_type(11)
 class MessageType(TypeInfo):
     @property
@@ -542,6 +559,26 @@ class BytesType(TypeInfo):
         return self.calculate_field_id_size() + 8  # field ID + 8 bytes typical bytes
 
 
+class BytesRefType(BytesType):
+    """Bytes field of a message that is only ever received, see StringRefType."""
+
+    cpp_type = "StringRef"
+    reference_type = "StringRef &"
+    const_reference_type = "const StringRef &"
+    decode_length = "value.as_string_ref()"
+
+    def dump(self, name: str) -> str:
+        o = f'out.append("\'").append({name}.c_str(), {name}.size()).append("\'");'
+        return o
+
+
+# Types used instead of TYPE_INFO for fields of zero-copy messages
+ZERO_COPY_TYPE_INFO: dict[int, TypeInfo] = {
+    9: StringRefType,
+    12: BytesRefType,
+}
+
+
 @register_type(13)
 class UInt32Type(TypeInfo):
     cpp_type = "uint32_t"
@@ -683,9 +720,14 @@ class SInt64Type(TypeInfo):
 
 
 class RepeatedTypeInfo(TypeInfo):
-    def __init__(self, field: descriptor.FieldDescriptorProto) -> None:
+    def __init__(
+        self, field: descriptor.FieldDescriptorProto, zero_copy: bool = False
+    ) -> None:
         super().__init__(field)
-        self._ti: TypeInfo = TYPE_INFO[field.type](field)
+        if zero_copy and field.type in ZERO_COPY_TYPE_INFO:
+            self._ti: TypeInfo = ZERO_COPY_TYPE_INFO[field.type](field)
+        else:
+            self._ti: TypeInfo = TYPE_INFO[field.type](field)
 
     @property
     def cpp_type(self) -> str:
@@ -848,6 +890,29 @@ def calculate_message_estimated_size(desc: descriptor.DescriptorProto) -> int:
     return total_size
 
 
+def is_zero_copy_message(desc: descriptor.DescriptorProto) -> bool:
+    """Check if string/bytes fields of a message are decoded as views.
+
+    Messages with source SOURCE_CLIENT are only ever decoded on the device, and the
+    decoded message only lives for the duration of its handler. Their string and bytes
+    fields can therefore reference the receive buffer directly instead of being copied,
+    which removes all heap allocations from decoding commands. Handlers must copy a
+    field if they keep it.
+    """
+    return get_opt(desc, pb.source, SOURCE_BOTH) == SOURCE_CLIENT
+
+
+def create_field_type_info(
+    field: descriptor.FieldDescriptorProto, zero_copy: bool = False
+) -> TypeInfo:
+    """Create the TypeInfo for a message field."""
+    if field.label == 3:
+        return RepeatedTypeInfo(field, zero_copy)
+    if zero_copy and field.type in ZERO_COPY_TYPE_INFO:
+        return ZERO_COPY_TYPE_INFO[field.type](field)
+    return TYPE_INFO[field.type](field)
+
+
 def build_message_type(
     desc: descriptor.DescriptorProto,
     base_class_fields: dict[str, list[descriptor.FieldDescriptorProto]] = None,
@@ -890,11 +955,9 @@ def build_message_type(
         )
         public_content.append("#endif")
 
+    zero_copy = is_zero_copy_message(desc)
     for field in desc.field:
-        if field.label == 3:
-            ti = RepeatedTypeInfo(field)
-        else:
-            ti = TYPE_INFO[field.type](field)
+        ti = create_field_type_info(field, zero_copy)
 
         # Skip field declarations for fields that are in the base class
         # but include their encode/decode logic
@@ -959,7 +1022,7 @@ def build_message_type(
         prot = "bool decode_64bit(uint32_t field_id, Proto64Bit value) override;"
         protected_content.insert(0, prot)
 
-    o = f"void {desc.name}::encode(ProtoWriteBuffer buffer) const {{"
+    o = f"void {desc.name}::encode(ProtoWriteBuffer &buffer) const {{"
     if encode:
         if len(encode) == 1 and len(encode[0]) + len(o) + 3 < 120:
             o += f" {encode[0]} "
@@ -968,7 +1031,7 @@ def build_message_type(
             o += indent("\n".join(encode)) + "\n"
     o += "}\n"
     cpp += o
-    prot = "void encode(ProtoWriteBuffer buffer) const override;"
+    prot = "void encode(ProtoWriteBuffer &buffer) const override;"
     public_content.append(prot)
 
     # Add calculate_size method
@@ -9,13 +9,22 @@ import logging
 import os
 from pathlib import Path
 import platform
+import re
 import signal
 import socket
 import sys
 import tempfile
 from typing import TextIO
 
-from aioesphomeapi import APIClient, APIConnectionError, LogParser, ReconnectLogic
+from aioesphomeapi import (
+    APIClient,
+    APIConnectionError,
+    ButtonInfo,
+    LogLevel,
+    LogParser,
+    ReconnectLogic,
+)
+from aioesphomeapi.api_pb2 import SubscribeLogsResponse
 import pytest
 import pytest_asyncio
 
@@ -35,8 +44,10 @@ from .const import (
 from .types import (
     APIClientConnectedFactory,
     APIClientFactory,
+    BenchLog,
     CompileFunction,
     ConfigWriter,
+    RunBenchFunction,
     RunCompiledFunction,
 )
 
@@ -114,6 +125,12 @@ async def yaml_config(request: pytest.FixtureRequest, unused_tcp_port: int) -> s
     loop = asyncio.get_running_loop()
     content = await loop.run_in_executor(None, fixture_path.read_text)
 
+    # Point local external components at the fixtures directory
+    content = content.replace(
+        "EXTERNAL_COMPONENT_PATH",
+        str(Path(__file__).parent / "fixtures" / "external_components"),
+    )
+
     # Replace the port in the config if it contains api section
     if "api:" in content:
         # Add port configuration after api:
@@ -554,3 +571,45 @@ async def run_compiled(
         )
 
     yield _run_compiled
+
+
+@pytest_asyncio.fixture
+async def run_bench(
+    yaml_config: str,
+    run_compiled: RunCompiledFunction,
+    api_client_connected: APIClientConnectedFactory,
+) -> AsyncGenerator[RunBenchFunction]:
+    """Run the configuration, press its button and collect the INFO log lines.
+
+    Bench components start when the only button of their configuration is
+    pressed, log their results at INFO level and end with a done line.
+    """
+
+    async def _run_bench(
+        done_pattern: re.Pattern[str], timeout: float = 60.0
+    ) -> BenchLog:
+        loop = asyncio.get_running_loop()
+        lines: list[str] = []
+        done: asyncio.Future[re.Match[str]] = loop.create_future()
+
+        def on_log(msg: SubscribeLogsResponse) -> None:
+            if done.done():
+                return
+            text = msg.message.decode("utf8", "backslashreplace")
+            lines.append(text)
+            if match := done_pattern.search(text):
+                done.set_result(match)
+
+        async with run_compiled(yaml_config), api_client_connected() as client:
+            client.subscribe_logs(on_log, log_level=LogLevel.LOG_LEVEL_INFO)
+            entities, _ = await client.list_entities_services()
+            button = next(e for e in entities if isinstance(e, ButtonInfo))
+            client.button_command(button.key)
+            try:
+                match = await asyncio.wait_for(done, timeout=timeout)
+            except asyncio.TimeoutError:
+                last = "\n".join(lines[-5:])
+                pytest.fail(f"Bench did not finish, last log lines:\n{last}")
+        return BenchLog(lines, match)
+
+    yield _run_bench
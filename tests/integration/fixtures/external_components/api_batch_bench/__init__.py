@@ -0,0 +1,29 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+DEPENDENCIES = ["api"]
+
+CONF_ENTITY_COUNTS = "entity_counts"
+CONF_RANDOM_STEPS = "random_steps"
+
+api_batch_bench_ns = cg.esphome_ns.namespace("api_batch_bench")
+ApiBatchBench = api_batch_bench_ns.class_("ApiBatchBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ApiBatchBench),
+        cv.Optional(
+            CONF_ENTITY_COUNTS, default=[10, 30, 100, 300, 1000]
+        ): cv.ensure_list(cv.int_range(min=1, max=5000)),
+        cv.Optional(CONF_RANDOM_STEPS, default=200000): cv.positive_not_null_int,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    for count in config[CONF_ENTITY_COUNTS]:
+        cg.add(var.add_entity_count(count))
+    cg.add(var.set_random_steps(config[CONF_RANDOM_STEPS]))
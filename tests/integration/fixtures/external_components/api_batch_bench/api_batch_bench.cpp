@@ -0,0 +1,153 @@
+#include "api_batch_bench.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace esphome {
+namespace api_batch_bench {
+
+static const char *const TAG = "api_batch_bench";
+
+using DeferredBatch = BenchConnection::DeferredBatch;
+using MessageCreator = BenchConnection::MessageCreator;
+
+/// Updates queued per entity while a batch waits to be sent.
+static const uint32_t UPDATES_PER_ENTITY = 3;
+static const uint32_t RANDOM_ENTITIES = 400;
+
+/// DeferredBatch before large batches were indexed: every update searches all pending items.
+class ReferenceBatch {
+ public:
+  bool add_item(EntityBase *entity, MessageCreator creator, uint16_t message_type) {
+    for (auto &item : this->items) {
+      if (item.entity == entity && item.message_type == message_type) {
+        item.creator = std::move(creator);
+        return true;
+      }
+    }
+    this->items.emplace_back(entity, std::move(creator), message_type);
+    return false;
+  }
+
+  std::vector<DeferredBatch::BatchItem> items;
+};
+
+// The creators return which one they are, so the comparison sees whether an update replaced the creator
+static uint16_t creator_1(EntityBase *, api::APIConnection *, uint32_t, bool) { return 1; }
+static uint16_t creator_2(EntityBase *, api::APIConnection *, uint32_t, bool) { return 2; }
+static uint16_t creator_3(EntityBase *, api::APIConnection *, uint32_t, bool) { return 3; }
+static const BenchConnection::MessageCreatorPtr CREATORS[] = {creator_1, creator_2, creator_3};
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint32_t ns_per_op(uint32_t elapsed_us, uint32_t ops) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / ops);
+}
+
+static bool same_items(const std::vector<DeferredBatch::BatchItem> &items,
+                       const std::vector<DeferredBatch::BatchItem> &reference) {
+  if (items.size() != reference.size())
+    return false;
+  for (size_t i = 0; i < items.size(); i++) {
+    const auto &item = items[i];
+    const auto &expected = reference[i];
+    if (item.entity != expected.entity || item.message_type != expected.message_type ||
+        item.creator(item.entity, nullptr, 0, false) != expected.creator(expected.entity, nullptr, 0, false))
+      return false;
+  }
+  return true;
+}
+
+void ApiBatchBench::setup() {
+  uint32_t count = RANDOM_ENTITIES;
+  for (uint32_t entity_count : this->entity_counts_)
+    count = std::max(count, entity_count);
+  this->entities_.resize(count);
+}
+
+void ApiBatchBench::bench_(uint32_t entity_count) {
+  // About the same number of updates for every entity count
+  const uint32_t rounds = 20000 / entity_count + 10;
+  const uint16_t message_type = 25;
+
+  uint32_t start = micros();
+  for (uint32_t round = 0; round < rounds; round++) {
+    DeferredBatch batch;
+    for (uint32_t update = 0; update < UPDATES_PER_ENTITY; update++) {
+      for (uint32_t i = 0; i < entity_count; i++)
+        batch.add_item(&this->entities_[i], MessageCreator(CREATORS[update]), message_type);
+    }
+  }
+  uint32_t indexed_ns = ns_per_op(micros() - start, rounds);
+
+  start = micros();
+  for (uint32_t round = 0; round < rounds; round++) {
+    ReferenceBatch batch;
+    for (uint32_t update = 0; update < UPDATES_PER_ENTITY; update++) {
+      for (uint32_t i = 0; i < entity_count; i++)
+        batch.add_item(&this->entities_[i], MessageCreator(CREATORS[update]), message_type);
+    }
+  }
+  uint32_t reference_ns = ns_per_op(micros() - start, rounds);
+
+  ESP_LOGI(TAG, "Batch %" PRIu32 " entities: %" PRIu32 " ns per batch, linear search %" PRIu32 " ns", entity_count,
+           indexed_ns, reference_ns);
+}
+
+uint32_t ApiBatchBench::check_random_() {
+  DeferredBatch batch;
+  ReferenceBatch reference;
+  uint32_t mismatches = 0;
+  uint32_t seed = 0x12345678;
+  // Entities updated since the last clear, so batches grow past the index threshold and shrink below it again
+  uint32_t active = 1 + xorshift(&seed) % RANDOM_ENTITIES;
+
+  for (uint32_t step = 0; step < this->random_steps_; step++) {
+    uint32_t action = xorshift(&seed) % 1000;
+    if (action < 990) {
+      EntityBase *entity = &this->entities_[xorshift(&seed) % active];
+      uint16_t message_type = 20 + xorshift(&seed) % 3;
+      auto creator = CREATORS[xorshift(&seed) % 3];
+      if (batch.add_item(entity, MessageCreator(creator), message_type) !=
+          reference.add_item(entity, MessageCreator(creator), message_type))
+        mismatches++;
+    } else if (action < 998) {
+      // A batch was sent in part
+      size_t count = batch.items.empty() ? 0 : xorshift(&seed) % (batch.items.size() + 1);
+      batch.remove_front(count);
+      reference.items.erase(reference.items.begin(), reference.items.begin() + std::min(count, reference.items.size()));
+    } else {
+      batch.clear();
+      reference.items.clear();
+      active = 1 + xorshift(&seed) % RANDOM_ENTITIES;
+    }
+    if ((action >= 990 || step % 64 == 0) && !same_items(batch.items, reference.items))
+      mismatches++;
+  }
+  if (!same_items(batch.items, reference.items))
+    mismatches++;
+  return mismatches;
+}
+
+void ApiBatchBench::run() {
+  for (uint32_t count : this->entity_counts_)
+    this->bench_(count);
+  ESP_LOGI(TAG, "Batch bench done: %" PRIu32 " mismatches", this->check_random_());
+}
+
+void ApiBatchBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "API Batch Bench:");
+  ESP_LOGCONFIG(TAG, "  Entity counts: %zu", this->entity_counts_.size());
+  ESP_LOGCONFIG(TAG, "  Random steps: %" PRIu32, this->random_steps_);
+}
+
+}  // namespace api_batch_bench
+}  // namespace esphome
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "esphome/components/api/api_connection.h"
+#include "esphome/core/component.h"
+#include "esphome/core/entity_base.h"
+
+#include <vector>
+
+namespace esphome {
+namespace api_batch_bench {
+
+/// Makes the batch of a connection reachable from the benchmark, it is never instantiated.
+class BenchConnection : public api::APIConnection {
+ public:
+  using APIConnection::DeferredBatch;
+  using APIConnection::MessageCreator;
+  using APIConnection::MessageCreatorPtr;
+};
+
+/** Times queueing state updates into the deferred batch of an API connection.
+ *
+ * For each configured entity count, run() queues three updates of every entity into a batch, once through
+ * DeferredBatch::add_item() and once through a copy of it before large batches were indexed, which searched all
+ * pending items for every update. check_random_() then adds, replaces, sends and clears items at random and
+ * compares the batch with that linear search after every step.
+ */
+class ApiBatchBench : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+
+  void add_entity_count(uint32_t count) { this->entity_counts_.push_back(count); }
+  void set_random_steps(uint32_t random_steps) { this->random_steps_ = random_steps; }
+  void run();
+
+ protected:
+  void bench_(uint32_t entity_count);
+  uint32_t check_random_();
+
+  std::vector<uint32_t> entity_counts_;
+  uint32_t random_steps_{200000};
+  /// The batches are keyed by entity address, so the entities are created once and never move.
+  std::vector<EntityBase> entities_;
+};
+
+}  // namespace api_batch_bench
+}  // namespace esphome
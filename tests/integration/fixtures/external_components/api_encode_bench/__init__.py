@@ -0,0 +1,26 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+DEPENDENCIES = ["api"]
+
+CONF_ENTITY_COUNT = "entity_count"
+CONF_ITERATIONS = "iterations"
+
+api_encode_bench_ns = cg.esphome_ns.namespace("api_encode_bench")
+ApiEncodeBench = api_encode_bench_ns.class_("ApiEncodeBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ApiEncodeBench),
+        cv.Optional(CONF_ENTITY_COUNT, default=500): cv.int_range(min=1, max=5000),
+        cv.Optional(CONF_ITERATIONS, default=20): cv.positive_not_null_int,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_entity_count(config[CONF_ENTITY_COUNT]))
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
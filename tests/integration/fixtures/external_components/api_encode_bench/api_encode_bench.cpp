@@ -0,0 +1,199 @@
+#include "api_encode_bench.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace esphome {
+namespace api_encode_bench {
+
+static const char *const TAG = "api_encode_bench";
+
+/// The encoder before messages were sized first: every byte is a push_back(), and a nested message is encoded at
+/// the end of the buffer and then shifted to make room for its length. Only the field types the benchmark sends are
+/// kept.
+class ReferenceWriter {
+ public:
+  explicit ReferenceWriter(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
+
+  void varint(uint64_t value) {
+    while (value > 0x7F) {
+      this->buffer_->push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    this->buffer_->push_back(static_cast<uint8_t>(value));
+  }
+  void key(uint32_t field_id, uint32_t type) { this->varint((field_id << 3) | type); }
+  void string(uint32_t field_id, const std::string &value) {
+    if (value.empty())
+      return;
+    this->key(field_id, 2);
+    this->varint(value.size());
+    for (char c : value)
+      this->buffer_->push_back(static_cast<uint8_t>(c));
+  }
+  void fixed32(uint32_t field_id, uint32_t value) {
+    if (value == 0)
+      return;
+    this->key(field_id, 5);
+    for (uint8_t shift = 0; shift < 32; shift += 8)
+      this->buffer_->push_back(static_cast<uint8_t>(value >> shift));
+  }
+  void uint64(uint32_t field_id, uint64_t value) {
+    if (value == 0)
+      return;
+    this->key(field_id, 0);
+    this->varint(value);
+  }
+  void int32(uint32_t field_id, int32_t value) { this->uint64(field_id, static_cast<uint64_t>(int64_t(value))); }
+  void boolean(uint32_t field_id, bool value) { this->uint64(field_id, value ? 1 : 0); }
+  template<typename F> void message(uint32_t field_id, F &&encode_nested) {
+    this->key(field_id, 2);
+    size_t begin = this->buffer_->size();
+    encode_nested(*this);
+    uint32_t length = this->buffer_->size() - begin;
+    std::vector<uint8_t> prefix;
+    ReferenceWriter(&prefix).varint(length);
+    this->buffer_->insert(this->buffer_->begin() + begin, prefix.begin(), prefix.end());
+  }
+
+ protected:
+  std::vector<uint8_t> *buffer_;
+};
+
+static void reference_encode(const api::ListEntitiesSensorResponse &msg, std::vector<uint8_t> *out) {
+  ReferenceWriter writer(out);
+  writer.string(1, msg.object_id);
+  writer.fixed32(2, msg.key);
+  writer.string(3, msg.name);
+  writer.string(4, msg.unique_id);
+  writer.string(5, msg.icon);
+  writer.string(6, msg.unit_of_measurement);
+  writer.int32(7, msg.accuracy_decimals);
+  writer.boolean(8, msg.force_update);
+  writer.string(9, msg.device_class);
+  writer.uint64(10, msg.state_class);
+  writer.uint64(11, msg.legacy_last_reset_type);
+  writer.boolean(12, msg.disabled_by_default);
+  writer.uint64(13, msg.entity_category);
+}
+
+static void reference_encode(const api::ListEntitiesServicesResponse &msg, std::vector<uint8_t> *out) {
+  ReferenceWriter writer(out);
+  writer.string(1, msg.name);
+  writer.fixed32(2, msg.key);
+  for (const auto &arg : msg.args) {
+    writer.message(3, [&arg](ReferenceWriter &nested) {
+      nested.string(1, arg.name);
+      nested.uint64(2, arg.type);
+    });
+  }
+}
+
+/// Append \p msg to \p out the way the API builds a batch: size it, grow the buffer, encode in place.
+template<typename T> static bool encode(const T &msg, std::vector<uint8_t> *out) {
+  uint32_t size = 0;
+  msg.calculate_size(size);
+  size_t offset = out->size();
+  out->resize(offset + size);
+  api::ProtoWriteBuffer buffer(out, offset);
+  msg.encode(buffer);
+  return buffer.verify(T::MESSAGE_TYPE);
+}
+
+static uint32_t ns_per_message(uint32_t elapsed_us, uint32_t messages) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / messages);
+}
+
+void ApiEncodeBench::setup() {
+  this->sensors_.resize(this->entity_count_);
+  for (uint32_t i = 0; i < this->entity_count_; i++) {
+    auto &msg = this->sensors_[i];
+    msg.object_id = "bench_sensor_" + to_string(i);
+    msg.key = fnv1_hash(msg.object_id);
+    msg.name = "Bench Sensor " + to_string(i);
+    msg.unique_id = "host-api-encode-bench-sensor-" + msg.object_id;
+    msg.icon = i % 2 ? "mdi:thermometer" : "";
+    msg.unit_of_measurement = "°C";
+    // Include a negative value, which is encoded as ten bytes
+    msg.accuracy_decimals = static_cast<int32_t>(i % 4) - 1;
+    msg.force_update = i % 3 == 0;
+    msg.device_class = "temperature";
+    msg.state_class = api::enums::STATE_CLASS_MEASUREMENT;
+    msg.disabled_by_default = i % 5 == 0;
+    msg.entity_category = static_cast<api::enums::EntityCategory>(i % 3);
+  }
+  this->services_.resize(std::max<uint32_t>(this->entity_count_ / 10, 1));
+  for (size_t i = 0; i < this->services_.size(); i++) {
+    auto &msg = this->services_[i];
+    msg.name = "bench_service_" + to_string(i);
+    msg.key = fnv1_hash(msg.name);
+    for (uint32_t j = 0; j < 4; j++) {
+      api::ListEntitiesServicesArgument arg;
+      // The first argument is empty and has to be written anyway, repeated messages are always sent
+      if (j != 0)
+        arg.name = "argument_" + to_string(j);
+      arg.type = static_cast<api::enums::ServiceArgType>(j);
+      msg.args.push_back(arg);
+    }
+  }
+}
+
+void ApiEncodeBench::run() {
+  const uint32_t messages = this->sensors_.size() + this->services_.size();
+  std::vector<uint8_t> encoded;
+  std::vector<uint8_t> reference;
+  uint32_t failures = 0;
+
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    encoded.clear();
+    for (const auto &msg : this->sensors_)
+      failures += !encode(msg, &encoded);
+    for (const auto &msg : this->services_)
+      failures += !encode(msg, &encoded);
+  }
+  uint32_t encode_ns = ns_per_message(micros() - start, messages * this->iterations_);
+
+  start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    reference.clear();
+    for (const auto &msg : this->sensors_)
+      reference_encode(msg, &reference);
+    for (const auto &msg : this->services_)
+      reference_encode(msg, &reference);
+  }
+  uint32_t reference_ns = ns_per_message(micros() - start, messages * this->iterations_);
+
+  bool identical = encoded == reference;
+  ESP_LOGI(TAG, "API encode %" PRIu32 " entities: %zu bytes, %" PRIu32 " ns per message, reference %" PRIu32 " ns",
+           this->entity_count_, encoded.size(), encode_ns, reference_ns);
+  ESP_LOGI(TAG, "API encode bench done: %" PRIu32 " failures, output %s, overflow check %s", failures,
+           identical ? "identical" : "DIFFERENT", this->check_overflow_() ? "ok" : "FAILED");
+}
+
+bool ApiEncodeBench::check_overflow_() {
+  const auto &msg = this->services_[0];
+  uint32_t size = 0;
+  msg.calculate_size(size);
+  // One byte short of the payload, followed by guard bytes the writer must not touch
+  std::vector<uint8_t> buffer;
+  buffer.reserve(size + 1);
+  buffer.resize(size - 1);
+  api::ProtoWriteBuffer writer(&buffer, 0);
+  buffer.resize(size + 1, 0xA5);
+  msg.encode(writer);
+  return !writer.verify(msg.MESSAGE_TYPE) && buffer[size - 1] == 0xA5 && buffer[size] == 0xA5;
+}
+
+void ApiEncodeBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "API Encode Bench:");
+  ESP_LOGCONFIG(TAG, "  Entities: %" PRIu32, this->entity_count_);
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+}
+
+}  // namespace api_encode_bench
+}  // namespace esphome
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "esphome/components/api/api_pb2.h"
+#include "esphome/core/component.h"
+
+#include <vector>
+
+namespace esphome {
+namespace api_encode_bench {
+
+/** Times encoding the entity list the API sends to a new client.
+ *
+ * run() builds one ListEntitiesSensorResponse per entity and one ListEntitiesServicesResponse with nested arguments
+ * per ten entities, then encodes them all back to back into one buffer, the way a batch is built. The same messages
+ * go through a copy of the encoder as it was before messages were sized first: a push_back() per byte, and nested
+ * messages shifted to make room for their length. Both outputs must be byte for byte identical. Encoding into a
+ * buffer one byte too small must be caught by verify() without writing past it.
+ */
+class ApiEncodeBench : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+
+  void set_entity_count(uint32_t entity_count) { this->entity_count_ = entity_count; }
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void run();
+
+ protected:
+  bool check_overflow_();
+
+  uint32_t entity_count_{500};
+  uint32_t iterations_{20};
+  std::vector<api::ListEntitiesSensorResponse> sensors_;
+  std::vector<api::ListEntitiesServicesResponse> services_;
+};
+
+}  // namespace api_encode_bench
+}  // namespace esphome
@@ -0,0 +1,36 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+DEPENDENCIES = ["api"]
+# Defines USE_LIGHT, USE_CLIMATE and USE_TEXT_SENSOR for the state messages
+AUTO_LOAD = ["climate", "light", "text_sensor"]
+
+CONF_CLIENT_COUNTS = "client_counts"
+CONF_ENTITY_COUNT = "entity_count"
+CONF_ITERATIONS = "iterations"
+
+api_state_cache_bench_ns = cg.esphome_ns.namespace("api_state_cache_bench")
+ApiStateCacheBench = api_state_cache_bench_ns.class_(
+    "ApiStateCacheBench", cg.Component
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ApiStateCacheBench),
+        cv.Optional(CONF_CLIENT_COUNTS, default=[2, 4, 8]): cv.ensure_list(
+            cv.int_range(min=1, max=16)
+        ),
+        cv.Optional(CONF_ENTITY_COUNT, default=50): cv.int_range(min=1, max=1000),
+        cv.Optional(CONF_ITERATIONS, default=200): cv.positive_not_null_int,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    for count in config[CONF_CLIENT_COUNTS]:
+        cg.add(var.add_client_count(count))
+    cg.add(var.set_entity_count(config[CONF_ENTITY_COUNT]))
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
@@ -0,0 +1,196 @@
+#include "api_state_cache_bench.h"
+#include "esphome/components/api/api_pb2.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace api_state_cache_bench {
+
+static const char *const TAG = "api_state_cache_bench";
+
+static const char *const EFFECTS[] = {"None", "Rainbow", "Strobe", "Fireworks"};
+static const char *const PRESETS[] = {"Comfort", "Eco", "Away", "Night boost"};
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint32_t ns_per_op(uint32_t elapsed_us, uint32_t ops) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / ops);
+}
+
+static const char *kind_name(BenchKind kind) {
+  switch (kind) {
+    case BenchKind::LIGHT:
+      return "light";
+    case BenchKind::CLIMATE:
+      return "climate";
+    default:
+      return "text sensor";
+  }
+}
+
+static uint16_t message_type(BenchKind kind) {
+  switch (kind) {
+    case BenchKind::LIGHT:
+      return api::LightStateResponse::MESSAGE_TYPE;
+    case BenchKind::CLIMATE:
+      return api::ClimateStateResponse::MESSAGE_TYPE;
+    default:
+      return api::TextSensorStateResponse::MESSAGE_TYPE;
+  }
+}
+
+template<typename T> static void encode(const T &msg, std::vector<uint8_t> *out) {
+  uint32_t size = 0;
+  msg.calculate_size(size);
+  size_t offset = out->size();
+  out->resize(offset + size);
+  api::ProtoWriteBuffer buffer(out, offset);
+  msg.encode(buffer);
+}
+
+/// What a try_send_*_state() creator does: build the message from the entity state and encode it at the end of
+/// \p out.
+static void encode_state(const BenchEntity &entity, std::vector<uint8_t> *out) {
+  switch (entity.kind) {
+    case BenchKind::LIGHT: {
+      api::LightStateResponse msg;
+      msg.state = entity.values[0] > 0.1f;
+      msg.brightness = entity.values[0];
+      msg.color_mode = api::enums::COLOR_MODE_RGB;
+      msg.color_brightness = 1.0f;
+      msg.red = entity.values[1];
+      msg.green = entity.values[2];
+      msg.blue = entity.values[3];
+      msg.effect = entity.text;
+      msg.key = entity.key;
+      encode(msg, out);
+      break;
+    }
+    case BenchKind::CLIMATE: {
+      api::ClimateStateResponse msg;
+      msg.mode = api::enums::CLIMATE_MODE_HEAT;
+      msg.current_temperature = entity.values[0];
+      msg.target_temperature = entity.values[1];
+      msg.action =
+          entity.values[0] < entity.values[1] ? api::enums::CLIMATE_ACTION_HEATING : api::enums::CLIMATE_ACTION_IDLE;
+      msg.custom_preset = entity.text;
+      msg.current_humidity = entity.values[2];
+      msg.target_humidity = entity.values[3];
+      msg.key = entity.key;
+      encode(msg, out);
+      break;
+    }
+    default: {
+      api::TextSensorStateResponse msg;
+      msg.state = entity.text;
+      msg.key = entity.key;
+      encode(msg, out);
+      break;
+    }
+  }
+}
+
+void ApiStateCacheBench::setup() {
+  // The cache is keyed by entity address, so the entities are created once and never move
+  this->entities_.resize(this->entity_count_);
+  for (uint32_t i = 0; i < this->entity_count_; i++)
+    this->entities_[i].key = (i + 1) * 0x9E3779B1u;
+}
+
+void ApiStateCacheBench::change_states_(BenchKind kind, uint32_t *seed) {
+  for (auto &entity : this->entities_) {
+    entity.kind = kind;
+    for (float &value : entity.values)
+      value = (xorshift(seed) % 1000) / 10.0f;
+    uint32_t choice = xorshift(seed) % 4;
+    entity.text = kind == BenchKind::LIGHT     ? EFFECTS[choice]
+                  : kind == BenchKind::CLIMATE ? PRESETS[choice]
+                                               : "Reading " + to_string(xorshift(seed) % 100000) + " ppm";
+  }
+}
+
+void ApiStateCacheBench::send_pass_(BenchKind kind, uint32_t clients, bool cached,
+                                    std::vector<std::vector<uint8_t>> *batches) {
+  const uint16_t type = message_type(kind);
+  std::vector<uint8_t> &buffer = this->shared_buffer_;
+  for (uint32_t client = 0; client < clients; client++) {
+    buffer.clear();
+    for (const auto &entity : this->entities_) {
+      if (!cached) {
+        encode_state(entity, &buffer);
+        continue;
+      }
+      api::EncodedStateCache::Payload payload = this->cache_.find(&entity, type);
+      if (payload.data != nullptr) {
+        size_t offset = buffer.size();
+        buffer.resize(offset + payload.size);
+        std::memcpy(buffer.data() + offset, payload.data, payload.size);
+        continue;
+      }
+      size_t offset = buffer.size();
+      encode_state(entity, &buffer);
+      this->cache_.store(&entity, type, buffer.data() + offset, buffer.size() - offset);
+    }
+    // A connection sends its batch before the next one builds its own
+    if (batches != nullptr)
+      batches->push_back(buffer);
+  }
+  this->cache_.clear();
+}
+
+void ApiStateCacheBench::bench_(BenchKind kind, uint32_t clients) {
+  uint32_t seed = 0x9E3779B9 ^ (clients << 8) ^ static_cast<uint32_t>(kind);
+  uint32_t cached_us = 0;
+  uint32_t uncached_us = 0;
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    this->change_states_(kind, &seed);
+    uint32_t start = micros();
+    this->send_pass_(kind, clients, true, nullptr);
+    cached_us += micros() - start;
+
+    start = micros();
+    this->send_pass_(kind, clients, false, nullptr);
+    uncached_us += micros() - start;
+  }
+
+  // One more pass of each, keeping what every client would have sent
+  this->change_states_(kind, &seed);
+  std::vector<std::vector<uint8_t>> cached;
+  std::vector<std::vector<uint8_t>> uncached;
+  this->send_pass_(kind, clients, true, &cached);
+  this->send_pass_(kind, clients, false, &uncached);
+  if (cached != uncached)
+    this->mismatches_++;
+
+  const uint32_t updates = this->iterations_ * this->entity_count_;
+  ESP_LOGI(TAG, "State cache %s %" PRIu32 " clients: %" PRIu32 " ns per update, every client encoding %" PRIu32 " ns",
+           kind_name(kind), clients, ns_per_op(cached_us, updates), ns_per_op(uncached_us, updates));
+}
+
+void ApiStateCacheBench::run() {
+  this->mismatches_ = 0;
+  for (BenchKind kind : {BenchKind::LIGHT, BenchKind::CLIMATE, BenchKind::TEXT_SENSOR}) {
+    for (uint32_t clients : this->client_counts_)
+      this->bench_(kind, clients);
+  }
+  ESP_LOGI(TAG, "State cache bench done: %" PRIu32 " mismatches", this->mismatches_);
+}
+
+void ApiStateCacheBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "API State Cache Bench:");
+  ESP_LOGCONFIG(TAG, "  Entities: %" PRIu32, this->entity_count_);
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+}
+
+}  // namespace api_state_cache_bench
+}  // namespace esphome
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "esphome/components/api/encoded_state_cache.h"
+#include "esphome/core/component.h"
+#include "esphome/core/entity_base.h"
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace api_state_cache_bench {
+
+enum class BenchKind : uint8_t { LIGHT, CLIMATE, TEXT_SENSOR };
+
+/// An entity whose state is turned into a light, climate or text sensor state message.
+class BenchEntity : public EntityBase {
+ public:
+  BenchKind kind{BenchKind::LIGHT};
+  uint32_t key{0};
+  float values[4]{};
+  std::string text;
+};
+
+/** Times sending the same state updates to several API clients.
+ *
+ * For each kind of state message and each configured number of clients, run() changes the state of every entity
+ * and then builds the batch of every client in turn. Without the cache each client builds the message from the
+ * entity state and encodes it. With it only the first client encodes, the others copy the payload out of an
+ * api::EncodedStateCache, the way APIConnection::encode_batch_item_() does. Every client must end up with the same
+ * bytes both ways.
+ */
+class ApiStateCacheBench : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+
+  void add_client_count(uint32_t count) { this->client_counts_.push_back(count); }
+  void set_entity_count(uint32_t entity_count) { this->entity_count_ = entity_count; }
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void run();
+
+ protected:
+  /// Give every entity of \p kind a new state.
+  void change_states_(BenchKind kind, uint32_t *seed);
+  /// Build the batch of every client, encoding each message for every one of them unless \p cached.
+  void send_pass_(BenchKind kind, uint32_t clients, bool cached, std::vector<std::vector<uint8_t>> *batches);
+  void bench_(BenchKind kind, uint32_t clients);
+
+  std::vector<uint32_t> client_counts_;
+  uint32_t entity_count_{50};
+  uint32_t iterations_{200};
+  std::vector<BenchEntity> entities_;
+  api::EncodedStateCache cache_;
+  /// The buffer a connection builds its batch in, shared like APIServer's.
+  std::vector<uint8_t> shared_buffer_;
+  uint32_t mismatches_{0};
+};
+
+}  // namespace api_state_cache_bench
+}  // namespace esphome
@@ -0,0 +1,25 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_HEIGHT, CONF_ID, CONF_WIDTH
+
+AUTO_LOAD = ["display", "image"]
+
+CONF_ITERATIONS = "iterations"
+
+display_bench_ns = cg.esphome_ns.namespace("display_bench")
+DisplayBench = display_bench_ns.class_("DisplayBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(DisplayBench),
+        cv.Optional(CONF_WIDTH, default=480): cv.int_range(min=64, max=1024),
+        cv.Optional(CONF_HEIGHT, default=320): cv.int_range(min=64, max=1024),
+        cv.Optional(CONF_ITERATIONS, default=50): cv.positive_not_null_int,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID], config[CONF_WIDTH], config[CONF_HEIGHT])
+    await cg.register_component(var, config)
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
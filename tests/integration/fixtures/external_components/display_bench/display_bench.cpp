@@ -0,0 +1,357 @@
+#include "display_bench.h"
+#include "esphome/components/image/image.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace display_bench {
+
+static const char *const TAG = "display_bench";
+
+static const display::DisplayRotation ROTATIONS[] = {
+    display::DISPLAY_ROTATION_0_DEGREES, display::DISPLAY_ROTATION_90_DEGREES,
+    display::DISPLAY_ROTATION_180_DEGREES, display::DISPLAY_ROTATION_270_DEGREES};
+
+/// Odd sizes, so that rows of binary images don't end on a byte boundary.
+static const int IMAGE_WIDTH = 101;
+static const int IMAGE_HEIGHT = 77;
+static const Color IMAGE_ON = Color(255, 200, 0);
+static const Color IMAGE_OFF = Color(0, 0, 80);
+
+struct ImageCase {
+  const char *name;
+  image::ImageType type;
+  image::Transparency transparency;
+};
+
+/// The first five are timed, all of them are checked.
+static const ImageCase IMAGE_CASES[] = {
+    {"rgb565", image::IMAGE_TYPE_RGB565, image::TRANSPARENCY_OPAQUE},
+    {"rgb565 chroma key", image::IMAGE_TYPE_RGB565, image::TRANSPARENCY_CHROMA_KEY},
+    {"rgb", image::IMAGE_TYPE_RGB, image::TRANSPARENCY_OPAQUE},
+    {"grayscale", image::IMAGE_TYPE_GRAYSCALE, image::TRANSPARENCY_OPAQUE},
+    {"binary", image::IMAGE_TYPE_BINARY, image::TRANSPARENCY_OPAQUE},
+    {"binary chroma key", image::IMAGE_TYPE_BINARY, image::TRANSPARENCY_CHROMA_KEY},
+    {"grayscale chroma key", image::IMAGE_TYPE_GRAYSCALE, image::TRANSPARENCY_CHROMA_KEY},
+    {"grayscale alpha", image::IMAGE_TYPE_GRAYSCALE, image::TRANSPARENCY_ALPHA_CHANNEL},
+    {"rgb565 alpha", image::IMAGE_TYPE_RGB565, image::TRANSPARENCY_ALPHA_CHANNEL},
+    {"rgb chroma key", image::IMAGE_TYPE_RGB, image::TRANSPARENCY_CHROMA_KEY},
+    {"rgb alpha", image::IMAGE_TYPE_RGB, image::TRANSPARENCY_ALPHA_CHANNEL},
+};
+static const size_t TIMED_IMAGE_CASES = 5;
+
+/// Image::draw() before images were drawn row by row: one draw_pixel_at() per visible pixel, column by column.
+class ReferenceImage : public image::Image {
+ public:
+  using image::Image::Image;
+
+  void draw(int x, int y, display::Display *display, Color color_on, Color color_off) override {
+    int img_x0 = 0;
+    int img_y0 = 0;
+    int w = this->width_;
+    int h = this->height_;
+
+    auto clipping = display->get_clipping();
+    if (clipping.is_set()) {
+      if (clipping.x > x)
+        img_x0 += clipping.x - x;
+      if (clipping.y > y)
+        img_y0 += clipping.y - y;
+      if (w > clipping.x2() - x)
+        w = clipping.x2() - x;
+      if (h > clipping.y2() - y)
+        h = clipping.y2() - y;
+    }
+
+    switch (this->type_) {
+      case image::IMAGE_TYPE_BINARY: {
+        for (int img_x = img_x0; img_x < w; img_x++) {
+          for (int img_y = img_y0; img_y < h; img_y++) {
+            if (this->get_binary_pixel_(img_x, img_y)) {
+              display->draw_pixel_at(x + img_x, y + img_y, color_on);
+            } else if (!this->transparency_) {
+              display->draw_pixel_at(x + img_x, y + img_y, color_off);
+            }
+          }
+        }
+        break;
+      }
+      case image::IMAGE_TYPE_GRAYSCALE:
+        for (int img_x = img_x0; img_x < w; img_x++) {
+          for (int img_y = img_y0; img_y < h; img_y++) {
+            const uint32_t pos = (img_x + img_y * this->width_);
+            const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
+            Color color = Color(gray, gray, gray, 0xFF);
+            switch (this->transparency_) {
+              case image::TRANSPARENCY_CHROMA_KEY:
+                if (gray == 1) {
+                  continue;  // skip drawing
+                }
+                break;
+              case image::TRANSPARENCY_ALPHA_CHANNEL: {
+                auto on = (float) gray / 255.0f;
+                auto off = 1.0f - on;
+                // blend color_on and color_off
+                color = Color(color_on.r * on + color_off.r * off, color_on.g * on + color_off.g * off,
+                              color_on.b * on + color_off.b * off, 0xFF);
+                break;
+              }
+              default:
+                break;
+            }
+            display->draw_pixel_at(x + img_x, y + img_y, color);
+          }
+        }
+        break;
+      case image::IMAGE_TYPE_RGB565:
+        for (int img_x = img_x0; img_x < w; img_x++) {
+          for (int img_y = img_y0; img_y < h; img_y++) {
+            auto color = this->get_rgb565_pixel_(img_x, img_y);
+            if (color.w >= 0x80) {
+              display->draw_pixel_at(x + img_x, y + img_y, color);
+            }
+          }
+        }
+        break;
+      case image::IMAGE_TYPE_RGB:
+        for (int img_x = img_x0; img_x < w; img_x++) {
+          for (int img_y = img_y0; img_y < h; img_y++) {
+            auto color = this->get_rgb_pixel_(img_x, img_y);
+            if (color.w >= 0x80) {
+              display->draw_pixel_at(x + img_x, y + img_y, color);
+            }
+          }
+        }
+        break;
+    }
+  }
+};
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+/// Random pixels, with every seventh pixel set to the transparent color of chroma keyed images. Binary images get
+/// runs of 1 to 16 equal pixels, like icons and text have.
+static std::vector<uint8_t> make_image_data(const ImageCase &image_case) {
+  image::Image layout(nullptr, IMAGE_WIDTH, IMAGE_HEIGHT, image_case.type, image_case.transparency);
+  const size_t stride = layout.get_width_stride();
+  std::vector<uint8_t> data(stride * IMAGE_HEIGHT);
+  uint32_t seed = 0x2545F491;
+  if (image_case.type == image::IMAGE_TYPE_BINARY) {
+    for (int y = 0; y < IMAGE_HEIGHT; y++) {
+      bool on = xorshift(&seed) & 1;
+      for (int x = 0; x < IMAGE_WIDTH; on = !on) {
+        int end = std::min<int>(x + 1 + xorshift(&seed) % 16, IMAGE_WIDTH);
+        for (; x != end; x++) {
+          if (on)
+            data[y * stride + x / 8] |= 0x80 >> (x % 8);
+        }
+      }
+    }
+    return data;
+  }
+  for (auto &byte : data)
+    byte = xorshift(&seed);
+  if (image_case.transparency != image::TRANSPARENCY_CHROMA_KEY)
+    return data;
+  const size_t bytes_per_pixel = layout.get_bpp() / 8;
+  for (size_t pos = 0; pos < data.size(); pos += bytes_per_pixel * 7) {
+    switch (image_case.type) {
+      case image::IMAGE_TYPE_GRAYSCALE:
+        data[pos] = 1;
+        break;
+      case image::IMAGE_TYPE_RGB565:
+        data[pos] = 0x00;
+        data[pos + 1] = 0x20;
+        break;
+      default:
+        data[pos] = 0;
+        data[pos + 1] = 1;
+        data[pos + 2] = 0;
+        break;
+    }
+  }
+  return data;
+}
+
+bool BenchDisplay::same_pixels(const BenchDisplay &other) const {
+  return this->buffer_length_ == other.buffer_length_ &&
+         std::memcmp(this->buffer_, other.buffer_, this->buffer_length_) == 0;
+}
+
+void BenchDisplay::draw_absolute_pixel_internal(int x, int y, Color color) {
+  if (x < 0 || y < 0 || x >= this->width_ || y >= this->height_)
+    return;
+  uint16_t value = display::ColorUtil::color_to_565(color);
+  uint8_t *ptr = this->buffer_ + (y * this->width_ + x) * 2;
+  if (ptr[0] == (value >> 8) && ptr[1] == (value & 0xFF))
+    return;
+  ptr[0] = value >> 8;
+  ptr[1] = value;
+  this->mark_dirty_(x, y, 1, 1);
+}
+
+void BenchDisplay::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  if (!this->rect_hook_) {
+    DisplayBuffer::fill_rect_internal(x, y, width, height, color);
+    return;
+  }
+  uint16_t value = display::ColorUtil::color_to_565(color);
+  for (int row = y; row != y + height; row++) {
+    uint8_t *ptr = this->buffer_ + (row * this->width_ + x) * 2;
+    for (int i = 0; i != width; i++, ptr += 2) {
+      ptr[0] = value >> 8;
+      ptr[1] = value;
+    }
+  }
+  this->mark_dirty_(x, y, width, height);
+}
+
+void BenchDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr,
+                                  display::ColorOrder order, display::ColorBitness bitness, bool big_endian,
+                                  int x_offset, int y_offset, int x_pad) {
+  if (!this->rect_hook_ || this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES ||
+      bitness != display::COLOR_BITNESS_565 || !big_endian || order != display::COLOR_ORDER_RGB) {
+    DisplayBuffer::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset, x_pad);
+    return;
+  }
+  int x1, x2, y1, y2;
+  if (!this->clamp_x_(x_start, w, x1, x2) || !this->clamp_y_(y_start, h, y1, y2))
+    return;
+  size_t stride = x_offset + w + x_pad;
+  for (int y = y1; y != y2; y++) {
+    std::memcpy(this->buffer_ + (y * this->width_ + x1) * 2,
+                ptr + ((y - y_start + y_offset) * stride + x_offset + x1 - x_start) * 2, (x2 - x1) * 2);
+  }
+  this->mark_dirty_(x1, y1, x2 - x1, y2 - y1);
+}
+
+DisplayBench::DisplayBench(int width, int height)
+    : reference_(width, height, false), pixel_hook_(width, height, false), rect_hook_(width, height, true) {}
+
+void DisplayBench::setup() {
+  this->reference_.allocate();
+  this->pixel_hook_.allocate();
+  this->rect_hook_.allocate();
+}
+
+static uint32_t ns_per_op(uint32_t elapsed_us, uint32_t ops) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / ops);
+}
+
+uint32_t DisplayBench::test_card_fps_(BenchDisplay *display) {
+  display->set_rotation(display::DISPLAY_ROTATION_0_DEGREES);
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++)
+    display->test_card();
+  uint32_t elapsed = std::max<uint32_t>(micros() - start, 1);
+  return static_cast<uint32_t>(uint64_t(this->iterations_) * 1000000 / elapsed);
+}
+
+uint32_t DisplayBench::check_test_card_() {
+  uint32_t mismatches = 0;
+  for (auto rotation : ROTATIONS) {
+    for (BenchDisplay *display : {(BenchDisplay *) &this->reference_, &this->pixel_hook_, &this->rect_hook_}) {
+      display->set_rotation(rotation);
+      display->test_card();
+    }
+    if (!this->pixel_hook_.same_pixels(this->reference_) || !this->rect_hook_.same_pixels(this->reference_))
+      mismatches++;
+  }
+  return mismatches;
+}
+
+void DisplayBench::bench_image_(size_t index) {
+  const ImageCase &image_case = IMAGE_CASES[index];
+  auto data = make_image_data(image_case);
+  image::Image current(data.data(), IMAGE_WIDTH, IMAGE_HEIGHT, image_case.type, image_case.transparency);
+  ReferenceImage reference(data.data(), IMAGE_WIDTH, IMAGE_HEIGHT, image_case.type, image_case.transparency);
+  // Both draw on the same display, so only the image code differs
+  BenchDisplay *display = &this->rect_hook_;
+  display->set_rotation(display::DISPLAY_ROTATION_0_DEGREES);
+  const uint32_t draws = this->iterations_ * 20;
+
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < draws; i++)
+    current.draw(13, 17, display, IMAGE_ON, IMAGE_OFF);
+  uint32_t current_ns = ns_per_op(micros() - start, draws);
+
+  start = micros();
+  for (uint32_t i = 0; i < draws; i++)
+    reference.draw(13, 17, display, IMAGE_ON, IMAGE_OFF);
+  uint32_t reference_ns = ns_per_op(micros() - start, draws);
+
+  ESP_LOGI(TAG, "Image %s: %" PRIu32 " ns per draw, reference %" PRIu32 " ns", image_case.name, current_ns,
+           reference_ns);
+}
+
+uint32_t DisplayBench::check_images_() {
+  const int width = this->rect_hook_.get_width();
+  const int height = this->rect_hook_.get_height();
+  // Inside, off every edge, and clipped
+  const int positions[][2] = {{13, 17}, {-30, -20}, {width - 50, height - 40}, {40, 30}};
+  const display::Rect clip(60, 40, 50, 35);
+  uint32_t mismatches = 0;
+  for (const auto &image_case : IMAGE_CASES) {
+    auto data = make_image_data(image_case);
+    image::Image current(data.data(), IMAGE_WIDTH, IMAGE_HEIGHT, image_case.type, image_case.transparency);
+    ReferenceImage reference(data.data(), IMAGE_WIDTH, IMAGE_HEIGHT, image_case.type, image_case.transparency);
+    bool same = true;
+    for (auto rotation : ROTATIONS) {
+      this->reference_.set_rotation(rotation);
+      this->rect_hook_.set_rotation(rotation);
+      this->reference_.fill(Color(0x20, 0x40, 0x60));
+      this->rect_hook_.fill(Color(0x20, 0x40, 0x60));
+      for (const auto &position : positions) {
+        bool clipped = position == positions[3];
+        if (clipped) {
+          this->reference_.start_clipping(clip);
+          this->rect_hook_.start_clipping(clip);
+        }
+        reference.draw(position[0], position[1], &this->reference_, IMAGE_ON, IMAGE_OFF);
+        current.draw(position[0], position[1], &this->rect_hook_, IMAGE_ON, IMAGE_OFF);
+        if (clipped) {
+          this->reference_.end_clipping();
+          this->rect_hook_.end_clipping();
+        }
+      }
+      same = same && this->rect_hook_.same_pixels(this->reference_);
+    }
+    if (!same) {
+      ESP_LOGW(TAG, "Image %s differs from the reference", image_case.name);
+      mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+void DisplayBench::run() {
+  uint32_t reference_fps = this->test_card_fps_(&this->reference_);
+  uint32_t pixel_hook_fps = this->test_card_fps_(&this->pixel_hook_);
+  uint32_t rect_hook_fps = this->test_card_fps_(&this->rect_hook_);
+  ESP_LOGI(TAG, "Test card: %" PRIu32 " frames/s per pixel, %" PRIu32 " frames/s pixel hook, %" PRIu32
+           " frames/s rect hook", reference_fps, pixel_hook_fps, rect_hook_fps);
+  for (size_t i = 0; i < TIMED_IMAGE_CASES; i++)
+    this->bench_image_(i);
+  uint32_t test_card_mismatches = this->check_test_card_();
+  ESP_LOGI(TAG, "Display bench done: %" PRIu32 " test card mismatches, %" PRIu32 " image mismatches",
+           test_card_mismatches, this->check_images_());
+}
+
+void DisplayBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "Display Bench:");
+  ESP_LOGCONFIG(TAG, "  Size: %dx%d", this->rect_hook_.get_width(), this->rect_hook_.get_height());
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+}
+
+}  // namespace display_bench
+}  // namespace esphome
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/core/component.h"
+
+#include <vector>
+
+namespace esphome {
+namespace display_bench {
+
+/// A DisplayBuffer driver with a big endian RGB565 framebuffer in RAM, like ili9xxx and mipi_spi keep.
+class BenchDisplay : public display::DisplayBuffer {
+ public:
+  /// With \p rect_hook unset, filled rectangles and pixel blocks reach the buffer through
+  /// draw_absolute_pixel_internal() only.
+  BenchDisplay(int width, int height, bool rect_hook) : width_(width), height_(height), rect_hook_(rect_hook) {}
+
+  void allocate() { this->init_internal_(this->width_ * this->height_ * 2); }
+  void update() override {}
+  display::DisplayType get_display_type() override { return display::DISPLAY_TYPE_COLOR; }
+
+  bool same_pixels(const BenchDisplay &other) const;
+  /// Copies big endian RGB565 rows into the buffer without rotation, as the drivers do.
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                      display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset,
+                      int x_pad) override;
+
+ protected:
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+  void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_rect_internal(int x, int y, int width, int height, Color color) override;
+
+  int width_;
+  int height_;
+  bool rect_hook_;
+};
+
+/// Draws every pixel with draw_pixel_at(), which clips and rotates each one, as Display did before it had span,
+/// rectangle and block primitives.
+class PixelDisplay : public BenchDisplay {
+ public:
+  using BenchDisplay::BenchDisplay;
+
+  void fill_span(int x, int y, int width, Color color) override { Display::fill_span(x, y, width, color); }
+  void fill_rect(int x, int y, int width, int height, Color color) override {
+    Display::fill_rect(x, y, width, height, color);
+  }
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                      display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset,
+                      int x_pad) override {
+    Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset, x_pad);
+  }
+};
+
+/** Times drawing into a framebuffer through the Display primitives.
+ *
+ * run() draws the test card on three displays: one that goes pixel by pixel like Display used to, one whose driver
+ * only has the pixel hook, and one that also fills rectangles row by row. It logs frames per second for each and
+ * checks, in all four rotations, that the three framebuffers end up identical.
+ *
+ * It then times Image::draw() against the previous column by column implementation for the common image formats,
+ * and checks that both draw the same pixels for every type and transparency, rotation, and clipping.
+ */
+class DisplayBench : public Component {
+ public:
+  DisplayBench(int width, int height);
+
+  void setup() override;
+  void dump_config() override;
+
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void run();
+
+ protected:
+  /// Frames per second of drawing the test card \p iterations_ times.
+  uint32_t test_card_fps_(BenchDisplay *display);
+  /// Draw the test card on all displays in every rotation and count the rotations where their pixels differ.
+  uint32_t check_test_card_();
+  /// Nanoseconds per draw of a random image of type \p index in IMAGE_CASES, with and without the reference drawer.
+  void bench_image_(size_t index);
+  /// Count the image types and transparencies whose reference and current drawings differ anywhere.
+  uint32_t check_images_();
+
+  uint32_t iterations_{50};
+  PixelDisplay reference_;
+  BenchDisplay pixel_hook_;
+  BenchDisplay rect_hook_;
+};
+
+}  // namespace display_bench
+}  // namespace esphome
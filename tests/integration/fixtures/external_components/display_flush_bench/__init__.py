@@ -0,0 +1,26 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+AUTO_LOAD = ["display"]
+
+CONF_UPDATES = "updates"
+CONF_RANDOM_FRAMES = "random_frames"
+
+display_flush_bench_ns = cg.esphome_ns.namespace("display_flush_bench")
+DisplayFlushBench = display_flush_bench_ns.class_("DisplayFlushBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(DisplayFlushBench),
+        cv.Optional(CONF_UPDATES, default=100): cv.int_range(min=2, max=10000),
+        cv.Optional(CONF_RANDOM_FRAMES, default=2000): cv.positive_not_null_int,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_updates(config[CONF_UPDATES]))
+    cg.add(var.set_random_frames(config[CONF_RANDOM_FRAMES]))
@@ -0,0 +1,281 @@
+#include "display_flush_bench.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace display_flush_bench {
+
+static const char *const TAG = "display_flush_bench";
+
+static const int WIDTH = 320;
+static const int HEIGHT = 240;
+
+static const display::DisplayRotation ROTATIONS[] = {
+    display::DISPLAY_ROTATION_0_DEGREES, display::DISPLAY_ROTATION_90_DEGREES,
+    display::DISPLAY_ROTATION_180_DEGREES, display::DISPLAY_ROTATION_270_DEGREES};
+
+void FlushDisplay::allocate() {
+  this->init_internal_(this->width_ * this->height_ * 2);
+  this->panel_.assign(this->buffer_, this->buffer_ + this->buffer_length_);
+  this->dirty_region_.clear();
+}
+
+uint32_t FlushDisplay::window_bytes() const {
+  if (this->dirty_region_.empty())
+    return 0;
+  int x1 = this->width_, y1 = this->height_, x2 = 0, y2 = 0;
+  for (const auto &rect : this->dirty_region_) {
+    x1 = std::min<int>(x1, rect.x);
+    y1 = std::min<int>(y1, rect.y);
+    x2 = std::max<int>(x2, rect.x2());
+    y2 = std::max<int>(y2, rect.y2());
+  }
+  return (x2 - x1) * (y2 - y1) * 2;
+}
+
+bool FlushDisplay::panel_matches() const {
+  return std::memcmp(this->panel_.data(), this->buffer_, this->buffer_length_) == 0;
+}
+
+void FlushDisplay::draw_absolute_pixel_internal(int x, int y, Color color) {
+  if (x < 0 || y < 0 || x >= this->width_ || y >= this->height_)
+    return;
+  uint16_t value = display::ColorUtil::color_to_565(color);
+  uint8_t *ptr = this->buffer_ + (y * this->width_ + x) * 2;
+  if (ptr[0] == (value >> 8) && ptr[1] == (value & 0xFF))
+    return;
+  ptr[0] = value >> 8;
+  ptr[1] = value;
+  this->mark_dirty_(x, y, 1, 1);
+}
+
+void FlushDisplay::flush_rect_internal(const uint8_t *buffer, int x, int y, int width, int height) {
+  for (int row = y; row != y + height; row++) {
+    size_t offset = (row * this->width_ + x) * 2;
+    std::memcpy(this->panel_.data() + offset, buffer + offset, width * 2);
+  }
+  this->bytes_sent += width * height * 2;
+  this->writes++;
+}
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+/// Segments a to g of a seven segment digit, as bits 0 to 6.
+static const uint8_t DIGIT_SEGMENTS[10] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F};
+
+/// Draw \p digit as a 12x22 seven segment digit with its top left corner at [x,y].
+static void draw_digit(display::Display *display, int x, int y, uint8_t digit, Color color) {
+  static const int SEGMENTS[7][4] = {{2, 0, 8, 2}, {10, 2, 2, 8},  {10, 12, 2, 8}, {2, 20, 8, 2},
+                                     {0, 12, 2, 8}, {0, 2, 2, 8}, {2, 10, 8, 2}};
+  for (int segment = 0; segment != 7; segment++) {
+    if (DIGIT_SEGMENTS[digit] & (1 << segment)) {
+      const int *rect = SEGMENTS[segment];
+      display->filled_rectangle(x + rect[0], y + rect[1], rect[2], rect[3], color);
+    }
+  }
+}
+
+/// A four digit clock showing \p minutes in a box at [x,y].
+static void draw_clock(display::Display *display, int x, int y, uint32_t minutes) {
+  const uint8_t digits[4] = {uint8_t(minutes / 600 % 3), uint8_t(minutes / 60 % 10), uint8_t(minutes % 60 / 10),
+                             uint8_t(minutes % 10)};
+  display->filled_rectangle(x, y, 80, 30, Color(0, 0, 40));
+  for (int i = 0; i != 4; i++)
+    draw_digit(display, x + 4 + i * 18 + (i >= 2 ? 4 : 0), y + 4, digits[i], Color(255, 255, 255));
+}
+
+uint32_t DisplayFlushBench::check_dirty_region_() {
+  using display::DirtyRegion;
+  using display::Rect;
+  uint32_t failures = 0;
+  auto expect = [&failures](bool ok, const char *what) {
+    if (!ok) {
+      ESP_LOGW(TAG, "Dirty region check failed: %s", what);
+      failures++;
+    }
+  };
+  auto only = [](const DirtyRegion &region, Rect rect) {
+    return region.size() == 1 && region.begin()->equal(rect);
+  };
+
+  DirtyRegion region;
+  expect(region.empty(), "a new region is empty");
+  region.add(0, 0, 10, 10);
+  region.add(10, 0, 10, 10);
+  expect(only(region, Rect(0, 0, 20, 10)), "touching rectangles merge");
+  region.add(15, 5, 5, 5);
+  expect(only(region, Rect(0, 0, 20, 10)), "a contained rectangle leaves the region unchanged");
+  region.add(5, 5, 20, 10);
+  expect(only(region, Rect(0, 0, 25, 15)), "overlapping rectangles merge");
+  region.add(200, 200, 10, 10);
+  expect(region.size() == 2, "distant rectangles stay separate");
+  region.clear();
+  expect(region.empty(), "clear() empties the region");
+
+  // A long row and a long column only share one pixel
+  region.add(0, 100, 300, 1);
+  region.add(150, 0, 1, 200);
+  expect(region.size() == 2, "crossing lines stay separate");
+  region.clear();
+
+  // Two separate rectangles that a third one bridges end up as one
+  region.add(0, 0, 10, 10);
+  region.add(30, 0, 10, 10);
+  expect(region.size() == 2, "rectangles 20 pixels apart stay separate");
+  region.add(10, 0, 20, 10);
+  expect(only(region, Rect(0, 0, 40, 10)), "a bridging rectangle merges all three");
+
+  // Random rectangles never exceed MAX_RECTS and are always covered
+  uint32_t seed = 0x9E3779B9;
+  for (int round = 0; round != 200; round++) {
+    region.clear();
+    std::vector<Rect> added;
+    int count = 1 + xorshift(&seed) % 40;
+    for (int i = 0; i != count; i++) {
+      Rect rect(xorshift(&seed) % WIDTH, xorshift(&seed) % HEIGHT, 1 + xorshift(&seed) % 20, 1 + xorshift(&seed) % 20);
+      region.add(rect.x, rect.y, rect.w, rect.h);
+      added.push_back(rect);
+    }
+    bool covered = true;
+    for (const auto &rect : added) {
+      covered = covered && std::any_of(region.begin(), region.end(), [&rect](const Rect &entry) {
+                  return entry.x <= rect.x && entry.y <= rect.y && entry.x2() >= rect.x2() && entry.y2() >= rect.y2();
+                });
+    }
+    expect(region.size() <= DirtyRegion::MAX_RECTS, "the region holds at most MAX_RECTS rectangles");
+    expect(covered, "the region covers every added rectangle");
+  }
+  return failures;
+}
+
+void DisplayFlushBench::bench_widgets_() {
+  FlushDisplay display(WIDTH, HEIGHT);
+  display.allocate();
+  display.fill(Color(0, 0, 40));
+  display.flush();
+  uint32_t window_bytes = 0;
+  display.bytes_sent = 0;
+  display.writes = 0;
+  for (uint32_t i = 0; i < this->updates_; i++) {
+    draw_clock(&display, 10, 10, i);
+    // A bar graph of a reading in the opposite corner
+    int level = (i * 37) % 100;
+    display.filled_rectangle(210, 200, level, 20, Color(0, 200, 0));
+    display.filled_rectangle(210 + level, 200, 100 - level, 20, Color(0, 0, 40));
+    window_bytes += display.window_bytes();
+    display.flush();
+  }
+  uint32_t writes_tenths = display.writes * 10 / this->updates_;
+  ESP_LOGI(TAG,
+           "Widgets: %" PRIu32 " bytes per update in %" PRIu32 ".%" PRIu32 " writes, single window %" PRIu32
+           " bytes",
+           display.bytes_sent / this->updates_, writes_tenths / 10, writes_tenths % 10, window_bytes / this->updates_);
+}
+
+void DisplayFlushBench::bench_dashboard_() {
+  FlushDisplay plain(WIDTH, HEIGHT);
+  FlushDisplay skipping(WIDTH, HEIGHT);
+  skipping.set_skip_unchanged(true);
+  uint32_t empty_updates = 0;
+  for (FlushDisplay *display : {&plain, &skipping}) {
+    display->allocate();
+    display->flush();
+    display->bytes_sent = 0;
+    for (uint32_t i = 0; i < this->updates_; i++) {
+      // What do_update_() does with auto clear, followed by a page that only changes in its clock
+      display->clear();
+      display->filled_rectangle(0, 0, WIDTH, 24, Color(0, 60, 120));
+      for (int panel = 0; panel != 4; panel++) {
+        int x = 10 + (panel % 2) * 155;
+        int y = 60 + (panel / 2) * 90;
+        display->rectangle(x, y, 145, 80, Color(128, 128, 128));
+        display->filled_rectangle(x + 10, y + 50, 25 * (panel + 1), 16, Color(200, 120, 0));
+      }
+      draw_clock(display, 120, 28, i / 2);
+      if (!display->flush() && display == &skipping)
+        empty_updates++;
+    }
+  }
+  ESP_LOGI(TAG,
+           "Dashboard: %" PRIu32 " bytes per update, %" PRIu32 " with skip_unchanged, %" PRIu32 " of %" PRIu32
+           " updates sent nothing",
+           plain.bytes_sent / this->updates_, skipping.bytes_sent / this->updates_, empty_updates, this->updates_);
+}
+
+uint32_t DisplayFlushBench::check_random_frames_() {
+  FlushDisplay plain(WIDTH, HEIGHT);
+  FlushDisplay skipping(WIDTH, HEIGHT);
+  skipping.set_skip_unchanged(true);
+  plain.allocate();
+  skipping.allocate();
+  uint32_t mismatches = 0;
+  uint32_t seed = 0x2545F491;
+  for (uint32_t frame = 0; frame < this->random_frames_; frame++) {
+    auto rotation = ROTATIONS[xorshift(&seed) % 4];
+    bool clear = xorshift(&seed) % 4 == 0;
+    uint32_t shapes = xorshift(&seed) % 8;
+    uint32_t shape_seed = xorshift(&seed);
+    // Both displays draw the same frame
+    for (FlushDisplay *display : {&plain, &skipping}) {
+      uint32_t state = shape_seed;
+      display->set_rotation(rotation);
+      if (clear)
+        display->clear();
+      for (uint32_t i = 0; i < shapes; i++) {
+        // Rotated by 90 degrees the display is WIDTH pixels high, some shapes reach past the edges either way
+        int x = int(xorshift(&state) % (WIDTH + 40)) - 20;
+        int y = int(xorshift(&state) % (WIDTH + 40)) - 20;
+        int w = xorshift(&state) % 60;
+        int h = xorshift(&state) % 60;
+        // A few colors only, so that shapes are often redrawn with the color they already have
+        uint8_t red = xorshift(&state) % 2 * 255;
+        uint8_t green = xorshift(&state) % 2 * 255;
+        Color color = Color(red, green, 0);
+        switch (xorshift(&state) % 4) {
+          case 0:
+            display->filled_rectangle(x, y, w, h, color);
+            break;
+          case 1:
+            display->line(x, y, x + w, y + h, color);
+            break;
+          case 2:
+            display->filled_circle(x, y, w / 2, color);
+            break;
+          default:
+            display->draw_pixel_at(x, y, color);
+            break;
+        }
+      }
+      display->flush();
+      if (!display->panel_matches())
+        mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+void DisplayFlushBench::run() {
+  uint32_t failures = this->check_dirty_region_();
+  ESP_LOGI(TAG, "Dirty region: %" PRIu32 " failed checks", failures);
+  this->bench_widgets_();
+  this->bench_dashboard_();
+  ESP_LOGI(TAG, "Display flush bench done: %" PRIu32 " panel mismatches in %" PRIu32 " random frames",
+           this->check_random_frames_(), this->random_frames_);
+}
+
+void DisplayFlushBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "Display Flush Bench:");
+  ESP_LOGCONFIG(TAG, "  Updates: %" PRIu32, this->updates_);
+  ESP_LOGCONFIG(TAG, "  Random frames: %" PRIu32, this->random_frames_);
+}
+
+}  // namespace display_flush_bench
+}  // namespace esphome
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/core/component.h"
+
+#include <vector>
+
+namespace esphome {
+namespace display_flush_bench {
+
+/** A DisplayBuffer driver with a big endian RGB565 framebuffer and a simulated panel.
+ *
+ * Every rectangle the display flushes is copied to the panel and counted, so the bytes a real driver would send
+ * over the bus can be compared, and the panel checked against the framebuffer.
+ */
+class FlushDisplay : public display::DisplayBuffer {
+ public:
+  FlushDisplay(int width, int height) : width_(width), height_(height) {}
+
+  void allocate();
+  void update() override {}
+  display::DisplayType get_display_type() override { return display::DISPLAY_TYPE_COLOR; }
+
+  /// Send the dirty region to the panel.
+  bool flush() { return this->flush_dirty_(); }
+  /// Bytes of the smallest window around all changes, which is what the drivers sent before they kept rectangles.
+  uint32_t window_bytes() const;
+  bool panel_matches() const;
+
+  uint32_t bytes_sent{0};
+  uint32_t writes{0};
+
+ protected:
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+  void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void flush_rect_internal(const uint8_t *buffer, int x, int y, int width, int height) override;
+
+  int width_;
+  int height_;
+  std::vector<uint8_t> panel_;
+};
+
+/** Measures what dirty rectangles and skip_unchanged save on the bus of a 320x240 RGB565 panel.
+ *
+ * run() checks how DirtyRegion merges rectangles, then simulates two pages:
+ * - widgets: a clock and a reading redrawn in place without auto clear, sent as dirty rectangles and, for
+ *   comparison, as the single window around them;
+ * - dashboard: a page redrawn from scratch with auto clear whose clock changes every other update, sent with and
+ *   without skip_unchanged.
+ * Finally it draws random frames in every rotation and checks after each flush that the panel shows the
+ * framebuffer.
+ */
+class DisplayFlushBench : public Component {
+ public:
+  void dump_config() override;
+
+  void set_updates(uint32_t updates) { this->updates_ = updates; }
+  void set_random_frames(uint32_t random_frames) { this->random_frames_ = random_frames; }
+  void run();
+
+ protected:
+  /// Number of DirtyRegion checks that failed.
+  uint32_t check_dirty_region_();
+  void bench_widgets_();
+  void bench_dashboard_();
+  /// Number of flushes after which the panel differed from the framebuffer.
+  uint32_t check_random_frames_();
+
+  uint32_t updates_{100};
+  uint32_t random_frames_{2000};
+};
+
+}  // namespace display_flush_bench
+}  // namespace esphome
@@ -0,0 +1,29 @@
+import esphome.codegen as cg
+from esphome.components.font import Font
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+AUTO_LOAD = ["display"]
+DEPENDENCIES = ["font"]
+
+CONF_FONTS = "fonts"
+CONF_ITERATIONS = "iterations"
+
+font_bench_ns = cg.esphome_ns.namespace("font_bench")
+FontBench = font_bench_ns.class_("FontBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(FontBench),
+        cv.Required(CONF_FONTS): cv.ensure_list(cv.use_id(Font)),
+        cv.Optional(CONF_ITERATIONS, default=200): cv.positive_not_null_int,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    for font_id in config[CONF_FONTS]:
+        cg.add(var.add_font(await cg.get_variable(font_id)))
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
@@ -0,0 +1,257 @@
+#include "font_bench.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace esphome {
+namespace font_bench {
+
+static const char *const TAG = "font_bench";
+
+static const char *const LINE = "Temperature 21.5°C, humidity 48 %, wind 3 m/s";
+static const Color TEXT_COLOR = Color(255, 200, 0);
+static const Color BACKGROUND = Color(0, 0, 40);
+
+bool BenchDisplay::same_pixels(const BenchDisplay &other) const {
+  return this->buffer_length_ == other.buffer_length_ &&
+         std::memcmp(this->buffer_, other.buffer_, this->buffer_length_) == 0;
+}
+
+void BenchDisplay::draw_absolute_pixel_internal(int x, int y, Color color) {
+  if (x < 0 || y < 0 || x >= this->width_ || y >= this->height_)
+    return;
+  uint16_t value = display::ColorUtil::color_to_565(color);
+  uint8_t *ptr = this->buffer_ + (y * this->width_ + x) * 2;
+  ptr[0] = value >> 8;
+  ptr[1] = value;
+}
+
+void BenchDisplay::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  uint16_t value = display::ColorUtil::color_to_565(color);
+  for (int row = y; row != y + height; row++) {
+    uint8_t *ptr = this->buffer_ + (row * this->width_ + x) * 2;
+    for (int i = 0; i != width; i++, ptr += 2) {
+      ptr[0] = value >> 8;
+      ptr[1] = value;
+    }
+  }
+}
+
+/// Font::match_next_glyph() before the glyph cache: a binary search over the sorted glyphs.
+static int reference_match(const font::Font *font, const uint8_t *str, int *match_length) {
+  const auto &glyphs = font->get_glyphs();
+  int lo = 0;
+  int hi = glyphs.size() - 1;
+  while (lo != hi) {
+    int mid = (lo + hi + 1) / 2;
+    if (glyphs[mid].compare_to(str)) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  *match_length = glyphs[lo].match_length(str);
+  if (*match_length <= 0)
+    return -1;
+  return lo;
+}
+
+/// Font::print() before glyphs were drawn as spans: the pixels are decoded bit by bit, blended and drawn one by one.
+static void reference_print(font::Font *font, int x_start, int y_start, display::Display *display, Color color,
+                            const char *text, Color background) {
+  int i = 0;
+  int x_at = x_start;
+  int scan_x1, scan_y1, scan_width, scan_height;
+  const uint8_t bpp = font->get_bpp();
+  while (text[i] != '\0') {
+    int match_length;
+    int glyph_n = reference_match(font, (const uint8_t *) text + i, &match_length);
+    if (glyph_n < 0) {
+      // Unknown char, skip
+      if (!font->get_glyphs().empty()) {
+        uint8_t glyph_width = font->get_glyphs()[0].get_glyph_data()->advance;
+        display->filled_rectangle(x_at, y_start, glyph_width, font->get_height(), color);
+        x_at += glyph_width;
+      }
+
+      i++;
+      continue;
+    }
+
+    const font::Glyph &glyph = font->get_glyphs()[glyph_n];
+    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
+
+    const uint8_t *data = glyph.get_glyph_data()->data;
+    const int max_x = x_at + scan_x1 + scan_width;
+    const int max_y = y_start + scan_y1 + scan_height;
+
+    uint8_t bitmask = 0;
+    uint8_t pixel_data = 0;
+    uint8_t bpp_max = (1 << bpp) - 1;
+    auto diff_r = (float) color.r - (float) background.r;
+    auto diff_g = (float) color.g - (float) background.g;
+    auto diff_b = (float) color.b - (float) background.b;
+    auto diff_w = (float) color.w - (float) background.w;
+    auto b_r = (float) background.r;
+    auto b_g = (float) background.g;
+    auto b_b = (float) background.b;
+    auto b_w = (float) background.w;
+    for (int glyph_y = y_start + scan_y1; glyph_y != max_y; glyph_y++) {
+      for (int glyph_x = x_at + scan_x1; glyph_x != max_x; glyph_x++) {
+        uint8_t pixel = 0;
+        for (int bit_num = 0; bit_num != bpp; bit_num++) {
+          if (bitmask == 0) {
+            pixel_data = progmem_read_byte(data++);
+            bitmask = 0x80;
+          }
+          pixel <<= 1;
+          if ((pixel_data & bitmask) != 0)
+            pixel |= 1;
+          bitmask >>= 1;
+        }
+        if (pixel == bpp_max) {
+          display->draw_pixel_at(glyph_x, glyph_y, color);
+        } else if (pixel != 0) {
+          auto on = (float) pixel / (float) bpp_max;
+          auto blended = Color((uint8_t) (diff_r * on + b_r), (uint8_t) (diff_g * on + b_g),
+                               (uint8_t) (diff_b * on + b_b), (uint8_t) (diff_w * on + b_w));
+          display->draw_pixel_at(glyph_x, glyph_y, blended);
+        }
+      }
+    }
+    x_at += glyph.get_glyph_data()->advance;
+
+    i += match_length;
+  }
+}
+
+static uint32_t ns_per_op(uint32_t elapsed_us, uint32_t ops) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / ops);
+}
+
+void FontBench::setup() {
+  this->reference_.allocate();
+  this->current_.allocate();
+}
+
+void FontBench::bench_lookup_(font::Font *font) {
+  const auto *line = reinterpret_cast<const uint8_t *>(LINE);
+  const size_t length = strlen(LINE);
+  const uint32_t lines = this->iterations_ * 10;
+  uint32_t characters = 0;
+  uint32_t checksum = 0;
+
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < lines; i++) {
+    for (size_t pos = 0; pos < length; characters++) {
+      int match_length;
+      checksum += font->match_next_glyph(line + pos, &match_length);
+      pos += std::max(match_length, 1);
+    }
+  }
+  uint32_t cached_ns = ns_per_op(micros() - start, characters);
+
+  start = micros();
+  for (uint32_t i = 0; i < lines; i++) {
+    for (size_t pos = 0; pos < length;) {
+      int match_length;
+      checksum -= reference_match(font, line + pos, &match_length);
+      pos += std::max(match_length, 1);
+    }
+  }
+  uint32_t reference_ns = ns_per_op(micros() - start, characters);
+
+  ESP_LOGI(TAG, "Glyph lookup: %" PRIu32 " ns per character, binary search %" PRIu32 " ns%s", cached_ns,
+           reference_ns, checksum == 0 ? "" : " (results differ)");
+}
+
+uint32_t FontBench::check_lookup_(font::Font *font) {
+  std::vector<std::string> probes;
+  for (const auto &glyph : font->get_glyphs()) {
+    const char *a_char = reinterpret_cast<const char *>(glyph.get_char());
+    probes.emplace_back(a_char);
+    probes.push_back(std::string(a_char) + "x");
+  }
+  // Characters the font may lack: 3 and 4 byte sequences, and U+00C1 which shares the cache entry of 'A'
+  for (const char *missing : {"\xE2\x82\xAC", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80", "\xC3\x81"})
+    probes.emplace_back(missing);
+  // Malformed UTF-8: overlong 'A', overlong 'A' and 'ä' in three bytes, surrogates, bad or missing continuation
+  // bytes and a lone continuation byte
+  for (const char *malformed : {"\xC1\x81", "\xE0\x81\x81", "\xE0\x83\xA4", "\xED\xA0\x80", "\xED\xBF\xBF",
+                                "\xC3\x28", "\xE2\x82", "\xC3", "\x80"})
+    probes.emplace_back(malformed);
+
+  uint32_t mismatches = 0;
+  auto compare = [font, &mismatches](const std::string &probe) {
+    const auto *str = reinterpret_cast<const uint8_t *>(probe.c_str());
+    int length, reference_length;
+    int glyph = font->match_next_glyph(str, &length);
+    int reference_glyph = reference_match(font, str, &reference_length);
+    if (glyph != reference_glyph || (glyph >= 0 && length != reference_length))
+      mismatches++;
+  };
+  // Each probe is followed by the valid characters it could be confused with in the cache
+  for (const auto &probe : probes) {
+    compare(probe);
+    for (const char *valid : {"A", "\xC3\xA4", "x"})
+      compare(valid);
+  }
+  return mismatches;
+}
+
+void FontBench::bench_print_(font::Font *font) {
+  BenchDisplay *display = &this->current_;
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++)
+    font->print(0, 100, display, TEXT_COLOR, LINE, BACKGROUND);
+  uint32_t current_ns = ns_per_op(micros() - start, this->iterations_);
+
+  start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++)
+    reference_print(font, 0, 100, display, TEXT_COLOR, LINE, BACKGROUND);
+  uint32_t reference_ns = ns_per_op(micros() - start, this->iterations_);
+
+  ESP_LOGI(TAG, "Font %dpx %d bpp: %" PRIu32 " ns per line, reference %" PRIu32 " ns", font->get_height(),
+           font->get_bpp(), current_ns, reference_ns);
+}
+
+bool FontBench::check_print_(font::Font *font) {
+  this->reference_.fill(BACKGROUND);
+  this->current_.fill(BACKGROUND);
+  // Inside the display, and cut off at the left edge
+  const int positions[][2] = {{13, 40}, {-7, 160}};
+  for (const auto &position : positions) {
+    reference_print(font, position[0], position[1], &this->reference_, TEXT_COLOR, LINE, BACKGROUND);
+    font->print(position[0], position[1], &this->current_, TEXT_COLOR, LINE, BACKGROUND);
+  }
+  return this->current_.same_pixels(this->reference_);
+}
+
+void FontBench::run() {
+  uint32_t lookup_mismatches = 0;
+  uint32_t print_mismatches = 0;
+  if (!this->fonts_.empty())
+    this->bench_lookup_(this->fonts_[0]);
+  for (auto *font : this->fonts_) {
+    lookup_mismatches += this->check_lookup_(font);
+    this->bench_print_(font);
+    if (!this->check_print_(font)) {
+      ESP_LOGW(TAG, "Font %dpx %d bpp draws different pixels", font->get_height(), font->get_bpp());
+      print_mismatches++;
+    }
+  }
+  ESP_LOGI(TAG, "Font bench done: %" PRIu32 " lookup mismatches, %" PRIu32 " print mismatches", lookup_mismatches,
+           print_mismatches);
+}
+
+void FontBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "Font Bench:");
+  ESP_LOGCONFIG(TAG, "  Fonts: %zu", this->fonts_.size());
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+}
+
+}  // namespace font_bench
+}  // namespace esphome
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/components/font/font.h"
+#include "esphome/core/component.h"
+
+#include <vector>
+
+namespace esphome {
+namespace font_bench {
+
+/// A DisplayBuffer driver with a big endian RGB565 framebuffer in RAM that fills rectangles row by row.
+class BenchDisplay : public display::DisplayBuffer {
+ public:
+  BenchDisplay(int width, int height) : width_(width), height_(height) {}
+
+  void allocate() { this->init_internal_(this->width_ * this->height_ * 2); }
+  void update() override {}
+  display::DisplayType get_display_type() override { return display::DISPLAY_TYPE_COLOR; }
+
+  bool same_pixels(const BenchDisplay &other) const;
+
+ protected:
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+  void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_rect_internal(int x, int y, int width, int height, Color color) override;
+
+  int width_;
+  int height_;
+};
+
+/** Times glyph lookups and text drawing against the font code before glyphs were cached and drawn as spans.
+ *
+ * run() looks up every character of a line of text through the glyph cache and through a plain binary search,
+ * then checks that both agree for every glyph, for characters the font lacks, and for malformed UTF-8 followed by
+ * valid characters. For each font it then times drawing the line with Font::print() and with the previous pixel by
+ * pixel renderer, and checks that both leave the same pixels, also for text clipped at the left edge.
+ */
+class FontBench : public Component {
+ public:
+  FontBench() : reference_(480, 320), current_(480, 320) {}
+
+  void setup() override;
+  void dump_config() override;
+
+  void add_font(font::Font *font) { this->fonts_.push_back(font); }
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void run();
+
+ protected:
+  /// Nanoseconds per character of looking up the benchmark line, logged for the first font.
+  void bench_lookup_(font::Font *font);
+  /// Number of lookups whose glyph or length differs from the binary search.
+  uint32_t check_lookup_(font::Font *font);
+  void bench_print_(font::Font *font);
+  /// Whether the current and the previous renderer draw the same pixels.
+  bool check_print_(font::Font *font);
+
+  std::vector<font::Font *> fonts_;
+  uint32_t iterations_{200};
+  BenchDisplay reference_;
+  BenchDisplay current_;
+};
+
+}  // namespace font_bench
+}  // namespace esphome
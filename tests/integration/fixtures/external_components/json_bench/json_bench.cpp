@@ -0,0 +1,153 @@
+#include "json_bench.h"
+#include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace esphome {
+namespace json_bench {
+
+static const char *const TAG = "json_bench";
+
+/// The members WebServer::sensor_json() writes, for a json::JsonObjectWriter or an ArduinoJson JsonObject.
+template<typename T> static void write_sensor(T &root, const BenchSensor &sensor, bool detail_all) {
+  std::string state;
+  if (std::isnan(sensor.state)) {
+    state = "NA";
+  } else {
+    state = value_accuracy_to_string(sensor.state, sensor.accuracy_decimals);
+    if (!sensor.unit_of_measurement.empty())
+      state += " " + sensor.unit_of_measurement;
+  }
+  root["id"] = "sensor-" + sensor.object_id;
+  if (detail_all) {
+    root["name"] = sensor.name;
+    root["icon"] = sensor.icon;
+    root["entity_category"] = sensor.entity_category;
+    if (sensor.disabled_by_default)
+      root["is_disabled_by_default"] = sensor.disabled_by_default;
+  }
+  root["value"] = sensor.state;
+  root["state"] = state;
+  if (detail_all && !sensor.unit_of_measurement.empty())
+    root["uom"] = sensor.unit_of_measurement;
+}
+
+static std::string writer_json(const BenchSensor &sensor, bool detail_all) {
+  json::JsonWriter writer;
+  auto root = writer.root();
+  write_sensor(root, sensor, detail_all);
+  return writer.str();
+}
+
+static std::string arduinojson_json(const BenchSensor &sensor, bool detail_all) {
+  return json::build_json([&sensor, detail_all](JsonObject root) { write_sensor(root, sensor, detail_all); });
+}
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint32_t events_per_second(uint32_t elapsed_us, uint32_t events) {
+  return static_cast<uint32_t>(uint64_t(events) * 1000000 / std::max<uint32_t>(elapsed_us, 1));
+}
+
+void JsonBench::setup() {
+  uint32_t seed = 0x9E3779B9;
+  this->sensors_.resize(this->entity_count_);
+  for (uint32_t i = 0; i < this->entity_count_; i++) {
+    auto &sensor = this->sensors_[i];
+    sensor.object_id = "bench_sensor_" + to_string(i);
+    sensor.name = "Bench \"Sensor\" " + to_string(i);
+    sensor.icon = i % 2 ? "mdi:thermometer" : "";
+    sensor.unit_of_measurement = i % 3 ? "°C" : "";
+    sensor.accuracy_decimals = i % 4;
+    sensor.entity_category = static_cast<EntityCategory>(i % 3);
+    sensor.disabled_by_default = i % 5 == 0;
+    // Every tenth sensor has no state yet
+    sensor.state = i % 10 == 9 ? NAN : (int32_t(xorshift(&seed) % 200000) - 100000) / 1000.0f;
+  }
+}
+
+uint32_t JsonBench::bench_(bool detail_all) {
+  const uint32_t events = this->entity_count_ * this->iterations_;
+  size_t bytes = 0;
+
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    for (const auto &sensor : this->sensors_)
+      bytes += writer_json(sensor, detail_all).size();
+  }
+  uint32_t writer_rate = events_per_second(micros() - start, events);
+
+  start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    for (const auto &sensor : this->sensors_)
+      bytes -= arduinojson_json(sensor, detail_all).size();
+  }
+  uint32_t arduinojson_rate = events_per_second(micros() - start, events);
+
+  uint32_t mismatches = bytes != 0;
+  for (const auto &sensor : this->sensors_) {
+    if (writer_json(sensor, detail_all) != arduinojson_json(sensor, detail_all))
+      mismatches++;
+  }
+  ESP_LOGI(TAG, "JSON %" PRIu32 " sensors %s: %" PRIu32 " events/s, ArduinoJson %" PRIu32 " events/s",
+           this->entity_count_, detail_all ? "detail all" : "state", writer_rate, arduinojson_rate);
+  return mismatches;
+}
+
+uint32_t JsonBench::check_floats_() {
+  uint32_t mismatches = 0;
+  uint32_t seed = 0x2545F491;
+  for (uint32_t round = 0; round < 100; round++) {
+    json::JsonWriter writer;
+    auto root = writer.root();
+    auto values = root.create_nested_array("values");
+    std::vector<float> floats;
+    for (uint32_t i = 0; i < 50; i++) {
+      // Random bit patterns cover every exponent, the rest are sensor-like values with few decimals
+      uint32_t bits = xorshift(&seed);
+      float value;
+      if (i % 2) {
+        std::memcpy(&value, &bits, sizeof(value));
+      } else {
+        value = (int32_t(bits % 2000000) - 1000000) / powf(10.0f, bits % 7);
+      }
+      floats.push_back(value);
+      values.add(value);
+    }
+    std::string reference = json::build_json([&floats](JsonObject root) {
+      JsonArray values = root.createNestedArray("values");
+      for (float value : floats)
+        values.add(value);
+    });
+    if (writer.str() != reference)
+      mismatches++;
+  }
+  return mismatches;
+}
+
+void JsonBench::run() {
+  uint32_t mismatches = this->bench_(false) + this->bench_(true);
+  ESP_LOGI(TAG, "JSON bench done: %" PRIu32 " event mismatches, %" PRIu32 " float mismatches", mismatches,
+           this->check_floats_());
+}
+
+void JsonBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "JSON Bench:");
+  ESP_LOGCONFIG(TAG, "  Entities: %" PRIu32, this->entity_count_);
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+}
+
+}  // namespace json_bench
+}  // namespace esphome
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/entity_base.h"
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace json_bench {
+
+/// What web_server reads from a sensor to write its state event.
+struct BenchSensor {
+  std::string object_id;
+  std::string name;
+  std::string icon;
+  std::string unit_of_measurement;
+  int8_t accuracy_decimals;
+  EntityCategory entity_category;
+  bool disabled_by_default;
+  float state;
+};
+
+/** Times the sensor state events of web_server, written with json::JsonWriter and with ArduinoJson.
+ *
+ * run() writes the event of every sensor with both, for the plain state and for the full details, and logs the
+ * events per second of each. The outputs must be identical, and so must a few thousand random floats written by
+ * both.
+ */
+class JsonBench : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+
+  void set_entity_count(uint32_t entity_count) { this->entity_count_ = entity_count; }
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void run();
+
+ protected:
+  /// Time both paths for all sensors, returns the number of events that differ.
+  uint32_t bench_(bool detail_all);
+  uint32_t check_floats_();
+
+  uint32_t entity_count_{200};
+  uint32_t iterations_{50};
+  std::vector<BenchSensor> sensors_;
+};
+
+}  // namespace json_bench
+}  // namespace esphome
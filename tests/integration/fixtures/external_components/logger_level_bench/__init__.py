@@ -0,0 +1,29 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+DEPENDENCIES = ["logger"]
+
+CONF_ITERATIONS = "iterations"
+CONF_OVERRIDE_COUNTS = "override_counts"
+
+logger_level_bench_ns = cg.esphome_ns.namespace("logger_level_bench")
+LoggerLevelBench = logger_level_bench_ns.class_("LoggerLevelBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(LoggerLevelBench),
+        cv.Optional(CONF_ITERATIONS, default=1000000): cv.positive_not_null_int,
+        cv.Optional(CONF_OVERRIDE_COUNTS, default=[0, 10, 100]): cv.ensure_list(
+            cv.int_range(min=0, max=1000)
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
+    for count in sorted(config[CONF_OVERRIDE_COUNTS]):
+        cg.add(var.add_override_count(count))
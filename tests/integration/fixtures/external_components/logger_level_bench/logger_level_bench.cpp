@@ -0,0 +1,85 @@
+#include "logger_level_bench.h"
+#include "esphome/components/logger/logger.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace logger_level_bench {
+
+static const char *const TAG = "logger_level_bench";
+
+static const uint32_t TAG_COUNT = 20;
+
+void LoggerLevelBench::setup() {
+  this->tags_.reserve(TAG_COUNT);
+  for (uint32_t i = 0; i < TAG_COUNT; i++)
+    this->tags_.push_back("bench_tag_" + to_string(i));
+}
+
+void LoggerLevelBench::run() {
+  this->mismatches_ = 0;
+  for (uint32_t count : this->override_counts_)
+    this->bench_(count);
+  ESP_LOGI(TAG, "Logger level bench done: %" PRIu32 " mismatches", this->mismatches_);
+}
+
+void LoggerLevelBench::set_level_(const std::string &tag, int level) {
+  logger::global_logger->set_log_level(tag, level);
+  this->reference_levels_[tag] = level;
+}
+
+int LoggerLevelBench::reference_level_for_(const char *tag) {
+  // Builds a std::string from the tag for every lookup, like the logger used to
+  auto it = this->reference_levels_.find(tag);
+  if (it != this->reference_levels_.end())
+    return it->second;
+  return logger::global_logger->get_log_level();
+}
+
+void LoggerLevelBench::bench_(uint32_t override_count) {
+  // Levels are only ever added, so each count extends the previous one
+  while (this->overrides_ < override_count) {
+    if (this->overrides_ == 0) {
+      this->set_level_(this->tags_[0], ESPHOME_LOG_LEVEL_VERBOSE);
+    } else {
+      this->set_level_("bench_override_" + to_string(this->overrides_), ESPHOME_LOG_LEVEL_VERBOSE);
+    }
+    this->overrides_++;
+  }
+
+  for (const auto &tag : this->tags_) {
+    if (logger::global_logger->level_for(tag.c_str()) != this->reference_level_for_(tag.c_str()))
+      this->mismatches_++;
+  }
+
+  uint32_t sum = 0;
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++)
+    sum += logger::global_logger->level_for(this->tags_[i % TAG_COUNT].c_str());
+  uint32_t cached_us = std::max<uint32_t>(micros() - start, 1);
+
+  uint32_t reference_sum = 0;
+  start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++)
+    reference_sum += this->reference_level_for_(this->tags_[i % TAG_COUNT].c_str());
+  uint32_t reference_us = std::max<uint32_t>(micros() - start, 1);
+
+  if (sum != reference_sum)
+    this->mismatches_++;
+  // Nanoseconds per 1000 lookups, a single lookup takes only a few
+  ESP_LOGI(TAG, "Logger %" PRIu32 " tag levels: %" PRIu32 " ns per 1000 lookups, reference %" PRIu32 " ns",
+           override_count, static_cast<uint32_t>(uint64_t(cached_us) * 1000000 / this->iterations_),
+           static_cast<uint32_t>(uint64_t(reference_us) * 1000000 / this->iterations_));
+}
+
+void LoggerLevelBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "Logger Level Bench:");
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+  ESP_LOGCONFIG(TAG, "  Tag level counts: %zu", this->override_counts_.size());
+}
+
+}  // namespace logger_level_bench
+}  // namespace esphome
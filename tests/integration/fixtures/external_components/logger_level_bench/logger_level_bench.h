@@ -0,0 +1,43 @@
+#pragma once
+
+#include "esphome/core/component.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace logger_level_bench {
+
+/** Times resolving the log level of a tag, which every log call does before it is filtered.
+ *
+ * For each configured number of per-tag levels, in increasing order, run() adds that many levels to the logger and
+ * looks up a fixed set of tags through Logger::level_for(). The same lookups go through a std::map keyed by
+ * std::string, as Logger did before tag levels were cached, and every tag must resolve to the same level in both.
+ * One of the looked up tags has a level of its own once any are configured.
+ */
+class LoggerLevelBench : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void add_override_count(uint32_t count) { this->override_counts_.push_back(count); }
+  void run();
+
+ protected:
+  void bench_(uint32_t override_count);
+  void set_level_(const std::string &tag, int level);
+  int reference_level_for_(const char *tag);
+
+  uint32_t iterations_{1000000};
+  std::vector<uint32_t> override_counts_;
+  /// Tags that are looked up, their c_str() must stay valid because the logger caches them by pointer.
+  std::vector<std::string> tags_;
+  std::map<std::string, int> reference_levels_;
+  uint32_t overrides_{0};
+  uint32_t mismatches_{0};
+};
+
+}  // namespace logger_level_bench
+}  // namespace esphome
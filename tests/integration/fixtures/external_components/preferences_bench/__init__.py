@@ -0,0 +1,30 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+CONF_ITERATIONS = "iterations"
+CONF_KEY_COUNTS = "key_counts"
+CONF_RANDOM_STEPS = "random_steps"
+
+preferences_bench_ns = cg.esphome_ns.namespace("preferences_bench")
+PreferencesBench = preferences_bench_ns.class_("PreferencesBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(PreferencesBench),
+        cv.Optional(CONF_ITERATIONS, default=200): cv.positive_not_null_int,
+        cv.Optional(CONF_KEY_COUNTS, default=[10, 100, 1000]): cv.ensure_list(
+            cv.int_range(min=5, max=100000)
+        ),
+        cv.Optional(CONF_RANDOM_STEPS, default=20000): cv.positive_not_null_int,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
+    for count in config[CONF_KEY_COUNTS]:
+        cg.add(var.add_key_count(count))
+    cg.add(var.set_random_steps(config[CONF_RANDOM_STEPS]))
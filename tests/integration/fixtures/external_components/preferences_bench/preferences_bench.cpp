@@ -0,0 +1,223 @@
+#include "preferences_bench.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace esphome {
+namespace preferences_bench {
+
+static const char *const TAG = "preferences_bench";
+
+/// Values changed before every sync of the benchmark.
+static const uint32_t CHANGED_PER_SYNC = 5;
+static const uint32_t RANDOM_KEYS = 500;
+
+/** HostPreferences before the log: a std::map that sync() writes out in full, and load() copies the value out of.
+ * The old sync() did not fsync() the file, it does here so that both pay for making the values durable.
+ */
+class ReferencePreferences {
+ public:
+  explicit ReferencePreferences(std::string filename) : filename_(std::move(filename)) {}
+
+  bool save(uint32_t key, const uint8_t *data, size_t len) {
+    std::vector vec(data, data + len);
+    this->data_[key] = vec;
+    return true;
+  }
+  bool load(uint32_t key, uint8_t *data, size_t len) {
+    if (this->data_.count(key) == 0)
+      return false;
+    auto vec = this->data_[key];
+    if (vec.size() != len)
+      return false;
+    memcpy(data, vec.data(), len);
+    return true;
+  }
+  bool sync() {
+    FILE *fp = fopen(this->filename_.c_str(), "wb");
+    if (fp == nullptr)
+      return false;
+    for (auto &it : this->data_) {
+      fwrite(&it.first, sizeof(uint32_t), 1, fp);
+      uint8_t len = it.second.size();
+      fwrite(&len, sizeof(len), 1, fp);
+      fwrite(it.second.data(), sizeof(uint8_t), it.second.size(), fp);
+    }
+    fflush(fp);
+    fsync(fileno(fp));
+    fclose(fp);
+    return true;
+  }
+
+ protected:
+  std::string filename_;
+  std::map<uint32_t, std::vector<uint8_t>> data_;
+};
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint32_t ns_per_op(uint32_t elapsed_us, uint32_t ops) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / ops);
+}
+
+std::string PreferencesBench::make_filename_(const char *suffix) {
+  std::string filename = std::string(getenv("HOME")) + "/.esphome/prefs/" + App.get_name() + "-" + suffix + ".prefs";
+  remove(filename.c_str());
+  remove((filename + ".tmp").c_str());
+  return filename;
+}
+
+/// Save 8 bytes derived from \p key and \p round to \p prefs.
+template<typename T> static void save_value(T *prefs, uint32_t key, uint32_t round) {
+  uint32_t value[2] = {key, round};
+  prefs->save(key, reinterpret_cast<const uint8_t *>(value), sizeof(value));
+}
+
+template<typename T> static uint32_t time_sync(T *prefs, uint32_t key_count, uint32_t iterations) {
+  for (uint32_t key = 0; key < key_count; key++)
+    save_value(prefs, key, 0);
+  prefs->sync();
+  uint32_t seed = 0x9E3779B9;
+  uint32_t start = micros();
+  for (uint32_t i = 1; i <= iterations; i++) {
+    for (uint32_t j = 0; j < CHANGED_PER_SYNC; j++)
+      save_value(prefs, xorshift(&seed) % key_count, i);
+    prefs->sync();
+  }
+  return ns_per_op(micros() - start, iterations);
+}
+
+template<typename T> static uint32_t time_load(T *prefs, uint32_t key_count, uint32_t iterations, uint64_t *checksum) {
+  uint32_t value[2];
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (uint32_t key = 0; key < key_count; key++) {
+      if (prefs->load(key, reinterpret_cast<uint8_t *>(value), sizeof(value)))
+        *checksum += value[0] ^ (uint64_t(value[1]) << 32);
+    }
+  }
+  return ns_per_op(micros() - start, iterations * key_count);
+}
+
+void PreferencesBench::bench_(uint32_t key_count) {
+  BenchPreferences prefs(this->make_filename_("bench"));
+  ReferencePreferences reference(this->make_filename_("reference"));
+
+  uint32_t sync_ns = time_sync(&prefs, key_count, this->iterations_);
+  uint32_t reference_sync_ns = time_sync(&reference, key_count, this->iterations_);
+  // Both saw the same values, so the loads add up to the same checksum
+  uint64_t checksum = 0;
+  uint64_t reference_checksum = 0;
+  uint32_t load_iterations = std::max<uint32_t>(100000 / key_count, 1);
+  uint32_t load_ns = time_load(&prefs, key_count, load_iterations, &checksum);
+  uint32_t reference_load_ns = time_load(&reference, key_count, load_iterations, &reference_checksum);
+
+  ESP_LOGI(TAG,
+           "Preferences %" PRIu32 " keys: sync %" PRIu32 " ns, reference %" PRIu32 " ns, load %" PRIu32
+           " ns, reference %" PRIu32 " ns%s",
+           key_count, sync_ns, reference_sync_ns, load_ns, reference_load_ns,
+           checksum == reference_checksum ? "" : " (values differ)");
+}
+
+uint32_t PreferencesBench::check_random_() {
+  const std::string filename = this->make_filename_("random");
+  auto prefs = make_unique<BenchPreferences>(filename);
+  // What load() returns now, and what it returns after a reload
+  std::map<uint32_t, std::vector<uint8_t>> current;
+  std::map<uint32_t, std::vector<uint8_t>> synced;
+  uint32_t mismatches = 0;
+  uint32_t seed = 0x12345678;
+
+  auto reload = [&]() {
+    prefs = make_unique<BenchPreferences>(filename);
+    current = synced;
+    uint8_t buf[255];
+    for (uint32_t key = 0; key < RANDOM_KEYS; key++) {
+      auto it = synced.find(key);
+      if (it == synced.end()) {
+        // Any length, the key must not be found
+        mismatches += prefs->load(key, buf, 1 + key % 40);
+      } else if (!prefs->load(key, buf, it->second.size()) ||
+                 memcmp(buf, it->second.data(), it->second.size()) != 0) {
+        mismatches++;
+      }
+    }
+  };
+
+  for (uint32_t step = 0; step < this->random_steps_; step++) {
+    uint32_t action = xorshift(&seed) % 1000;
+    if (action < 900) {
+      uint32_t key = xorshift(&seed) % RANDOM_KEYS;
+      // Mostly the same length for a key, now and then a different one
+      size_t len = xorshift(&seed) % 8 == 0 ? 1 + xorshift(&seed) % 40 : 1 + key % 40;
+      std::vector<uint8_t> value(len);
+      for (auto &byte : value)
+        byte = xorshift(&seed);
+      // Now and then save a value that did not change
+      if (current.count(key) != 0 && xorshift(&seed) % 4 == 0)
+        value = current[key];
+      prefs->save(key, value.data(), value.size());
+      current[key] = value;
+    } else if (action < 960) {
+      if (prefs->sync())
+        synced = current;
+    } else if (action < 985) {
+      reload();
+    } else if (action < 990) {
+      prefs->reset();
+      current.clear();
+    } else {
+      // A crash in the middle of an append leaves part of a record behind
+      if (prefs->sync())
+        synced = current;
+      FILE *fp = fopen(filename.c_str(), "ab");
+      if (fp != nullptr) {
+        const uint8_t partial[] = {0x01, 0x00, 0x00, 0x00, 20, 0xAA, 0xBB, 0xCC};
+        fwrite(partial, 1, 1 + xorshift(&seed) % sizeof(partial), fp);
+        fclose(fp);
+      }
+      reload();
+    }
+  }
+  if (prefs->sync())
+    synced = current;
+  reload();
+  prefs.reset();
+  remove(filename.c_str());
+  return mismatches;
+}
+
+void PreferencesBench::run() {
+  for (uint32_t count : this->key_counts_)
+    this->bench_(count);
+  // Leave no files behind
+  this->make_filename_("bench");
+  this->make_filename_("reference");
+  ESP_LOGI(TAG, "Preferences bench done: %" PRIu32 " reload mismatches", this->check_random_());
+}
+
+void PreferencesBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "Preferences Bench:");
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+  ESP_LOGCONFIG(TAG, "  Key counts: %zu", this->key_counts_.size());
+  ESP_LOGCONFIG(TAG, "  Random steps: %" PRIu32, this->random_steps_);
+}
+
+}  // namespace preferences_bench
+}  // namespace esphome
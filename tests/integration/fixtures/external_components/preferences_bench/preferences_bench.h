@@ -0,0 +1,47 @@
+#pragma once
+
+#include "esphome/components/host/preferences.h"
+#include "esphome/core/component.h"
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace preferences_bench {
+
+/// HostPreferences stored in a file of its own, so the bench does not touch the preferences of the node.
+class BenchPreferences : public host::HostPreferences {
+ public:
+  explicit BenchPreferences(const std::string &filename) { this->filename_ = filename; }
+};
+
+/** Times syncing host preferences and checks that they survive reloads.
+ *
+ * For each configured number of keys, run() saves 5 changed 8-byte values before every sync and times saving and
+ * syncing, and loading every key, against the preferences before the log was introduced. Then it runs a random mix of
+ * saves with varying lengths, syncs, resets, reloads and records cut short by a crash, and checks after every reload
+ * that exactly the values of the last sync come back.
+ */
+class PreferencesBench : public Component {
+ public:
+  void dump_config() override;
+
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void add_key_count(uint32_t count) { this->key_counts_.push_back(count); }
+  void set_random_steps(uint32_t random_steps) { this->random_steps_ = random_steps; }
+  void run();
+
+ protected:
+  /// Path of a file next to the preferences of the node, removed together with its compaction file.
+  std::string make_filename_(const char *suffix);
+  void bench_(uint32_t key_count);
+  /// Returns the number of values that did not come back as expected.
+  uint32_t check_random_();
+
+  uint32_t iterations_{200};
+  std::vector<uint32_t> key_counts_;
+  uint32_t random_steps_{20000};
+};
+
+}  // namespace preferences_bench
+}  // namespace esphome
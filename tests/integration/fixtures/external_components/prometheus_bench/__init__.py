@@ -0,0 +1,47 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+# prometheus_exposition.h and .cpp link to the prometheus component, which needs a web
+# server that host builds do not have
+AUTO_LOAD = ["binary_sensor", "sensor", "switch", "text_sensor"]
+
+CONF_SENSORS = "sensors"
+CONF_BINARY_SENSORS = "binary_sensors"
+CONF_SWITCHES = "switches"
+CONF_TEXT_SENSORS = "text_sensors"
+CONF_ITERATIONS = "iterations"
+CONF_CHANGED_COUNTS = "changed_counts"
+
+prometheus_bench_ns = cg.esphome_ns.namespace("prometheus_bench")
+PrometheusBench = prometheus_bench_ns.class_("PrometheusBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(PrometheusBench),
+        cv.Optional(CONF_SENSORS, default=300): cv.int_range(min=1, max=2000),
+        cv.Optional(CONF_BINARY_SENSORS, default=100): cv.int_range(min=1, max=2000),
+        cv.Optional(CONF_SWITCHES, default=50): cv.int_range(min=1, max=2000),
+        cv.Optional(CONF_TEXT_SENSORS, default=50): cv.int_range(min=1, max=2000),
+        cv.Optional(CONF_ITERATIONS, default=200): cv.positive_not_null_int,
+        cv.Optional(CONF_CHANGED_COUNTS, default=[0, 5, 50, 500]): cv.ensure_list(
+            cv.positive_int
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(
+        var.create_entities(
+            config[CONF_SENSORS],
+            config[CONF_BINARY_SENSORS],
+            config[CONF_SWITCHES],
+            config[CONF_TEXT_SENSORS],
+        )
+    )
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
+    for count in config[CONF_CHANGED_COUNTS]:
+        cg.add(var.add_changed_count(count))
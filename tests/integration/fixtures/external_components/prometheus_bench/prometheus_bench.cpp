@@ -0,0 +1,243 @@
+#include "prometheus_bench.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace prometheus_bench {
+
+static const char *const TAG = "prometheus_bench";
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint32_t ns_per_op(uint32_t elapsed_us, uint32_t ops) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / ops);
+}
+
+void PrometheusBench::create_entities(uint32_t sensors, uint32_t binary_sensors, uint32_t switches,
+                                      uint32_t text_sensors) {
+  // Entities keep pointers to their names, so the vector must not grow past this
+  this->names_.reserve(2 * (sensors + binary_sensors + switches + text_sensors));
+  for (uint32_t i = 0; i < sensors; i++) {
+    auto *obj = new sensor::Sensor();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->configure_entity_(obj, "sensor", i);
+    obj->set_unit_of_measurement("°C");
+    obj->set_accuracy_decimals(1);
+    App.register_sensor(obj);
+    this->sensors_.push_back(obj);
+  }
+  for (uint32_t i = 0; i < binary_sensors; i++) {
+    auto *obj = new binary_sensor::BinarySensor();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->configure_entity_(obj, "binary_sensor", i);
+    App.register_binary_sensor(obj);
+    this->binary_sensors_.push_back(obj);
+  }
+  for (uint32_t i = 0; i < switches; i++) {
+    auto *obj = new BenchSwitch();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->configure_entity_(obj, "switch", i);
+    App.register_switch(obj);
+    this->switches_.push_back(obj);
+  }
+  for (uint32_t i = 0; i < text_sensors; i++) {
+    auto *obj = new text_sensor::TextSensor();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->configure_entity_(obj, "text_sensor", i);
+    App.register_text_sensor(obj);
+    this->text_sensors_.push_back(obj);
+  }
+}
+
+void PrometheusBench::configure_entity_(EntityBase *obj, const char *prefix, uint32_t index) {
+  this->names_.push_back(str_sprintf("Bench %s %" PRIu32, prefix, index));
+  obj->set_name(this->names_.back().c_str());
+  this->names_.push_back(str_sprintf("bench_%s_%" PRIu32, prefix, index));
+  obj->set_object_id(this->names_.back().c_str());
+  obj->set_internal(true);
+  if (index % 7 == 0) {
+    this->relabel_map_id_[obj] = "relabeled_" + this->names_.back();
+    this->relabel_map_name_[obj] = "Relabeled " + this->names_[this->names_.size() - 2];
+  }
+}
+
+void PrometheusBench::setup() {
+  this->exposition_.set_include_internal(true);
+  for (const auto &it : this->relabel_map_id_)
+    this->exposition_.add_label_id(it.first, it.second);
+  for (const auto &it : this->relabel_map_name_)
+    this->exposition_.add_label_name(it.first, it.second);
+  this->exposition_.setup();
+}
+
+void PrometheusBench::change_entity_(uint32_t *seed) {
+  uint32_t index = xorshift(seed) % (this->sensors_.size() + this->binary_sensors_.size() + this->switches_.size() +
+                                     this->text_sensors_.size());
+  if (index < this->sensors_.size()) {
+    uint32_t value = xorshift(seed);
+    // Now and then the sensor fails
+    this->sensors_[index]->publish_state(value % 16 == 0 ? NAN : static_cast<int32_t>(value % 20001) / 100.0f - 100.0f);
+    return;
+  }
+  index -= this->sensors_.size();
+  if (index < this->binary_sensors_.size()) {
+    auto *obj = this->binary_sensors_[index];
+    obj->publish_state(!obj->state);
+    return;
+  }
+  index -= this->binary_sensors_.size();
+  if (index < this->switches_.size()) {
+    auto *obj = this->switches_[index];
+    obj->publish_state(!obj->state);
+    return;
+  }
+  index -= this->switches_.size();
+  this->text_sensors_[index]->publish_state("value " + to_string(this->text_changes_++));
+}
+
+std::string PrometheusBench::render_reference_() {
+  std::string out;
+  std::string area = App.get_area();
+  std::string node = App.get_name();
+  std::string friendly_name = App.get_friendly_name();
+  auto relabel_id = [this](EntityBase *obj) -> std::string {
+    auto item = this->relabel_map_id_.find(obj);
+    return item == this->relabel_map_id_.end() ? obj->get_object_id() : item->second;
+  };
+  auto relabel_name = [this](EntityBase *obj) -> std::string {
+    auto item = this->relabel_map_name_.find(obj);
+    return item == this->relabel_map_name_.end() ? obj->get_name() : item->second;
+  };
+  // Every row prints its labels again, looking up the relabel maps each time
+  auto add_metric = [&](const char *metric, EntityBase *obj) {
+    out.append(metric);
+    out.append("{id=\"");
+    out.append(relabel_id(obj));
+    if (!area.empty()) {
+      out.append("\",area=\"");
+      out.append(area);
+    }
+    if (!node.empty()) {
+      out.append("\",node=\"");
+      out.append(node);
+    }
+    if (!friendly_name.empty()) {
+      out.append("\",friendly_name=\"");
+      out.append(friendly_name);
+    }
+    out.append("\",name=\"");
+    out.append(relabel_name(obj));
+  };
+
+  out.append("#TYPE esphome_sensor_value gauge\n");
+  out.append("#TYPE esphome_sensor_failed gauge\n");
+  for (auto *obj : this->sensors_) {
+    add_metric("esphome_sensor_failed", obj);
+    if (std::isnan(obj->state)) {
+      out.append("\"} 1\n");
+      continue;
+    }
+    out.append("\"} 0\n");
+    add_metric("esphome_sensor_value", obj);
+    out.append("\",unit=\"");
+    out.append(obj->get_unit_of_measurement());
+    out.append("\"} ");
+    out.append(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()));
+    out.append("\n");
+  }
+
+  out.append("#TYPE esphome_binary_sensor_value gauge\n");
+  out.append("#TYPE esphome_binary_sensor_failed gauge\n");
+  for (auto *obj : this->binary_sensors_) {
+    add_metric("esphome_binary_sensor_failed", obj);
+    if (!obj->has_state()) {
+      out.append("\"} 1\n");
+      continue;
+    }
+    out.append("\"} 0\n");
+    add_metric("esphome_binary_sensor_value", obj);
+    out.append("\"} ");
+    out.append(obj->state ? "1" : "0");
+    out.append("\n");
+  }
+
+  out.append("#TYPE esphome_switch_value gauge\n");
+  out.append("#TYPE esphome_switch_failed gauge\n");
+  for (auto *obj : this->switches_) {
+    add_metric("esphome_switch_failed", obj);
+    out.append("\"} 0\n");
+    add_metric("esphome_switch_value", obj);
+    out.append("\"} ");
+    out.append(obj->state ? "1" : "0");
+    out.append("\n");
+  }
+
+  out.append("#TYPE esphome_text_sensor_value gauge\n");
+  out.append("#TYPE esphome_text_sensor_failed gauge\n");
+  for (auto *obj : this->text_sensors_) {
+    add_metric("esphome_text_sensor_failed", obj);
+    if (!obj->has_state()) {
+      out.append("\"} 1\n");
+      continue;
+    }
+    out.append("\"} 0\n");
+    add_metric("esphome_text_sensor_value", obj);
+    out.append("\",value=\"");
+    out.append(obj->state);
+    out.append("\"} ");
+    out.append("1.0");
+    out.append("\n");
+  }
+  return out;
+}
+
+void PrometheusBench::bench_(uint32_t changed) {
+  uint32_t seed = 0x9E3779B9 ^ changed;
+  uint32_t current_us = 0;
+  uint32_t reference_us = 0;
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    for (uint32_t j = 0; j < changed; j++)
+      this->change_entity_(&seed);
+
+    uint32_t start = micros();
+    this->exposition_.loop();
+    this->exposition_.update();
+    current_us += micros() - start;
+
+    start = micros();
+    std::string reference = this->render_reference_();
+    reference_us += micros() - start;
+
+    if (*this->exposition_.get_text() != reference)
+      this->mismatches_++;
+  }
+  ESP_LOGI(TAG, "Prometheus %" PRIu32 " changed per scrape: %" PRIu32 " ns per scrape, reference %" PRIu32 " ns",
+           changed, ns_per_op(current_us, this->iterations_), ns_per_op(reference_us, this->iterations_));
+}
+
+void PrometheusBench::run() {
+  this->mismatches_ = 0;
+  // The first update renders every entity
+  this->exposition_.loop();
+  this->exposition_.update();
+  for (uint32_t changed : this->changed_counts_)
+    this->bench_(changed);
+  ESP_LOGI(TAG, "Prometheus bench done: %" PRIu32 " mismatches, %zu bytes", this->mismatches_,
+           this->exposition_.get_text()->size());
+}
+
+void PrometheusBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "Prometheus Bench:");
+  ESP_LOGCONFIG(TAG, "  Entities: %zu", this->names_.size() / 2);
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+}
+
+}  // namespace prometheus_bench
+}  // namespace esphome
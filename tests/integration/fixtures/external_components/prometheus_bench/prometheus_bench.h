@@ -0,0 +1,64 @@
+#pragma once
+
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/switch/switch.h"
+#include "esphome/components/text_sensor/text_sensor.h"
+#include "esphome/core/component.h"
+#include "prometheus_exposition.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace prometheus_bench {
+
+class BenchSwitch : public switch_::Switch {
+ protected:
+  void write_state(bool state) override { this->publish_state(state); }
+};
+
+/** Times a Prometheus scrape of many entities while some of them change between scrapes.
+ *
+ * create_entities() registers internal sensors, binary sensors, switches and text sensors with App, and every seventh
+ * one is relabeled. For each configured number of changed entities, run() publishes new states of that many random
+ * entities before every scrape, then times bringing a prometheus::PrometheusExposition up to date against rendering
+ * everything the way the handler did before the text was cached. Both texts must be identical after every scrape.
+ */
+class PrometheusBench : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+
+  void create_entities(uint32_t sensors, uint32_t binary_sensors, uint32_t switches, uint32_t text_sensors);
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void add_changed_count(uint32_t count) { this->changed_counts_.push_back(count); }
+  void run();
+
+ protected:
+  /// Configure \p obj as an internal entity named after \p prefix and \p index, and relabel every seventh one.
+  void configure_entity_(EntityBase *obj, const char *prefix, uint32_t index);
+  /// Publish a new state of a random entity.
+  void change_entity_(uint32_t *seed);
+  /// Render all entities like the handler before the text was cached, with the labels looked up for every row.
+  std::string render_reference_();
+  void bench_(uint32_t changed);
+
+  uint32_t iterations_{200};
+  std::vector<uint32_t> changed_counts_;
+  std::vector<sensor::Sensor *> sensors_;
+  std::vector<binary_sensor::BinarySensor *> binary_sensors_;
+  std::vector<BenchSwitch *> switches_;
+  std::vector<text_sensor::TextSensor *> text_sensors_;
+  /// Names and object ids of the entities, which keep pointers to them.
+  std::vector<std::string> names_;
+  std::map<EntityBase *, std::string> relabel_map_id_;
+  std::map<EntityBase *, std::string> relabel_map_name_;
+  prometheus::PrometheusExposition exposition_;
+  uint32_t text_changes_{0};
+  uint32_t mismatches_{0};
+};
+
+}  // namespace prometheus_bench
+}  // namespace esphome
@@ -0,0 +1 @@
+../../../../../esphome/components/prometheus/prometheus_exposition.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../../../../../esphome/components/prometheus/prometheus_exposition.h
\ No newline at end of file
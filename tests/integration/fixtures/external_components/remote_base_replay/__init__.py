@@ -0,0 +1,46 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ADDRESS, CONF_COMMAND, CONF_ID, CONF_NAME, CONF_PROTOCOL
+
+AUTO_LOAD = ["remote_base"]
+
+CONF_CAPTURES = "captures"
+CONF_ITERATIONS = "iterations"
+CONF_TIMINGS = "timings"
+
+remote_base_replay_ns = cg.esphome_ns.namespace("remote_base_replay")
+RemoteBaseReplay = remote_base_replay_ns.class_("RemoteBaseReplay", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(RemoteBaseReplay),
+        cv.Optional(CONF_ITERATIONS, default=1000): cv.positive_not_null_int,
+        cv.Optional(CONF_CAPTURES, default=[]): cv.ensure_list(
+            {
+                # Defaults to the protocol, needed for several captures of one
+                cv.Optional(CONF_NAME): cv.string,
+                cv.Required(CONF_PROTOCOL): cv.string,
+                cv.Required(CONF_TIMINGS): cv.All([cv.int_], cv.Length(min=2)),
+                # The values the capture must decode to
+                cv.Inclusive(CONF_ADDRESS, "decoded"): cv.uint16_t,
+                cv.Inclusive(CONF_COMMAND, "decoded"): cv.uint16_t,
+            }
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
+    for capture in config[CONF_CAPTURES]:
+        cg.add(
+            var.add_capture(
+                capture.get(CONF_NAME, capture[CONF_PROTOCOL]),
+                capture[CONF_PROTOCOL],
+                capture[CONF_TIMINGS],
+                capture.get(CONF_ADDRESS, -1),
+                capture.get(CONF_COMMAND, -1),
+            )
+        )
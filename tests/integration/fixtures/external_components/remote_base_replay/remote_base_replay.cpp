@@ -0,0 +1,407 @@
+#include "remote_base_replay.h"
+#include "esphome/components/remote_base/abbwelcome_protocol.h"
+#include "esphome/components/remote_base/aeha_protocol.h"
+#include "esphome/components/remote_base/beo4_protocol.h"
+#include "esphome/components/remote_base/byronsx_protocol.h"
+#include "esphome/components/remote_base/canalsat_protocol.h"
+#include "esphome/components/remote_base/coolix_protocol.h"
+#include "esphome/components/remote_base/dish_protocol.h"
+#include "esphome/components/remote_base/dooya_protocol.h"
+#include "esphome/components/remote_base/drayton_protocol.h"
+#include "esphome/components/remote_base/gobox_protocol.h"
+#include "esphome/components/remote_base/haier_protocol.h"
+#include "esphome/components/remote_base/jvc_protocol.h"
+#include "esphome/components/remote_base/keeloq_protocol.h"
+#include "esphome/components/remote_base/lg_protocol.h"
+#include "esphome/components/remote_base/magiquest_protocol.h"
+#include "esphome/components/remote_base/midea_protocol.h"
+#include "esphome/components/remote_base/mirage_protocol.h"
+#include "esphome/components/remote_base/nec_protocol.h"
+#include "esphome/components/remote_base/nexa_protocol.h"
+#include "esphome/components/remote_base/panasonic_protocol.h"
+#include "esphome/components/remote_base/pioneer_protocol.h"
+#include "esphome/components/remote_base/pronto_protocol.h"
+#include "esphome/components/remote_base/rc5_protocol.h"
+#include "esphome/components/remote_base/rc6_protocol.h"
+#include "esphome/components/remote_base/rc_switch_protocol.h"
+#include "esphome/components/remote_base/roomba_protocol.h"
+#include "esphome/components/remote_base/samsung36_protocol.h"
+#include "esphome/components/remote_base/samsung_protocol.h"
+#include "esphome/components/remote_base/sony_protocol.h"
+#include "esphome/components/remote_base/toshiba_ac_protocol.h"
+#include "esphome/components/remote_base/toto_protocol.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace esphome {
+namespace remote_base_replay {
+
+using namespace remote_base;
+
+static const char *const TAG = "remote_base_replay";
+
+/// The remote_receiver defaults.
+static const uint32_t TOLERANCE = 25;
+static const int32_t IDLE_US = 10000;
+
+static RemoteReceiveData receive_data(const RawTimings &timings) {
+  return RemoteReceiveData(timings, TOLERANCE, TOLERANCE_MODE_PERCENTAGE);
+}
+
+/// Return \p sent as remote_receiver records it. It only sees level changes, so it starts at the first mark,
+/// consecutive marks or spaces become one, and the silence after the last mark becomes one idle space.
+static RawTimings as_received(const RawTimings &sent) {
+  RawTimings timings;
+  for (int32_t value : sent) {
+    if (timings.empty() && value < 0)
+      continue;
+    if (!timings.empty() && (timings.back() < 0) == (value < 0)) {
+      timings.back() += value;
+    } else {
+      timings.push_back(value);
+    }
+  }
+  if (!timings.empty() && timings.back() < 0)
+    timings.pop_back();
+  timings.push_back(-IDLE_US);
+  return timings;
+}
+
+template<typename P> static bool decodes(const RawTimings &timings) {
+  auto src = receive_data(timings);
+  return P().decode(src).has_value();
+}
+
+/// Whether \p timings decode to \p address and \p command.
+template<typename P> static bool decodes_to(const RawTimings &timings, uint32_t address, uint32_t command) {
+  auto decoded = P().decode(receive_data(timings));
+  return decoded.has_value() && decoded->address == address && decoded->command == command;
+}
+
+/// Encode \p data into \p frame and check that decoding the frame returns \p data again.
+template<typename P> static bool round_trip(const typename P::ProtocolData &data, RawTimings *frame) {
+  RemoteTransmitData dst;
+  P().encode(&dst, data);
+  *frame = as_received(dst.get_data());
+  auto decoded = P().decode(receive_data(*frame));
+  return decoded.has_value() && *decoded == data;
+}
+
+static ABBWelcomeData abbwelcome_sample() {
+  ABBWelcomeData data;
+  data.set_source_address(0x1001);
+  data.set_destination_address(0x2002);
+  data.set_message_type(0x0d);
+  data.set_message_id(0x42);
+  data.set_data({0x01, 0x02});
+  data.finalize();
+  return data;
+}
+
+// Haier and Mirage decoders expect frames of a fixed length, the encoder appends the checksum
+static HaierData haier_sample() { return {{0xA6, 0x12, 0x10, 0x00, 0x0C, 0, 0, 0, 0, 0, 0, 0, 0}}; }
+
+static MirageData mirage_sample() { return {{0x56, 0x74, 0x00, 0x00, 0x12, 0, 0, 0, 0, 0, 0, 0, 0, 0}}; }
+
+static MideaData midea_sample() {
+  MideaData data({0xA1, 0x82, 0x48, 0xFF, 0xFF});
+  data.finalize();
+  return data;
+}
+
+static bool rc_switch_round_trip(RawTimings *frame) {
+  uint64_t code;
+  uint8_t nbits;
+  RCSwitchBase::type_a_code(0b10101, 0b00010, true, &code, &nbits);
+  RemoteTransmitData dst;
+  RC_SWITCH_PROTOCOLS[1].transmit(&dst, code, nbits);
+  // Transmitters repeat the frame, the sync of the next one ends the last bit
+  RC_SWITCH_PROTOCOLS[1].sync(&dst);
+  *frame = as_received(dst.get_data());
+  auto src = receive_data(*frame);
+  auto decoded = RCSwitchBase().decode(src);
+  return decoded.has_value() && decoded->protocol == 1 && decoded->code == code;
+}
+
+struct Protocol {
+  const char *name;
+  /// Encode a sample into the frame and return whether it decodes to the same value.
+  bool (*round_trip)(RawTimings *frame);
+  bool (*decodes)(const RawTimings &timings);
+};
+
+static const Protocol PROTOCOLS[] = {
+    {"abbwelcome", [](RawTimings *f) { return round_trip<ABBWelcomeProtocol>(abbwelcome_sample(), f); },
+     decodes<ABBWelcomeProtocol>},
+    {"aeha", [](RawTimings *f) { return round_trip<AEHAProtocol>({0x2002, {0x80, 0x00, 0x30, 0x40}}, f); },
+     decodes<AEHAProtocol>},
+    {"beo4", [](RawTimings *f) { return round_trip<Beo4Protocol>({0x00, 0x0c, 0}, f); }, decodes<Beo4Protocol>},
+    {"byronsx", [](RawTimings *f) { return round_trip<ByronSXProtocol>({0x5a, 0x03}, f); },
+     decodes<ByronSXProtocol>},
+    {"canalsat", [](RawTimings *f) { return round_trip<CanalSatProtocol>({0x7f, 0x01, 0, 0x21}, f); },
+     decodes<CanalSatProtocol>},
+    {"canalsatld", [](RawTimings *f) { return round_trip<CanalSatLDProtocol>({0x02, 0x01, 0, 0x21}, f); },
+     decodes<CanalSatLDProtocol>},
+    {"coolix", [](RawTimings *f) { return round_trip<CoolixProtocol>(CoolixData(0xB2BFD0), f); },
+     decodes<CoolixProtocol>},
+    {"dish", [](RawTimings *f) { return round_trip<DishProtocol>({0x01, 0x10}, f); }, decodes<DishProtocol>},
+    {"dooya", [](RawTimings *f) { return round_trip<DooyaProtocol>({0x141770, 0x01, 0x01, 0x01}, f); },
+     decodes<DooyaProtocol>},
+    {"drayton", [](RawTimings *f) { return round_trip<DraytonProtocol>({0x1234, 0x02, 0x0b}, f); },
+     decodes<DraytonProtocol>},
+    {"gobox", [](RawTimings *f) { return round_trip<GoboxProtocol>({GOBOX_MENU}, f); }, decodes<GoboxProtocol>},
+    {"haier", [](RawTimings *f) { return round_trip<HaierProtocol>(haier_sample(), f); }, decodes<HaierProtocol>},
+    {"jvc", [](RawTimings *f) { return round_trip<JVCProtocol>({0xC5E8}, f); }, decodes<JVCProtocol>},
+    {"keeloq", [](RawTimings *f) { return round_trip<KeeloqProtocol>({0x12345678, 0x0abcdef, 0x02, false, false}, f); },
+     decodes<KeeloqProtocol>},
+    {"lg", [](RawTimings *f) { return round_trip<LGProtocol>({0x20DF10EF, 32}, f); }, decodes<LGProtocol>},
+    {"magiquest", [](RawTimings *f) { return round_trip<MagiQuestProtocol>({0x1234, 0x01020304}, f); },
+     decodes<MagiQuestProtocol>},
+    {"midea", [](RawTimings *f) { return round_trip<MideaProtocol>(midea_sample(), f); }, decodes<MideaProtocol>},
+    {"mirage", [](RawTimings *f) { return round_trip<MirageProtocol>(mirage_sample(), f); }, decodes<MirageProtocol>},
+    {"nec", [](RawTimings *f) { return round_trip<NECProtocol>({0x1234, 0x5678, 1}, f); }, decodes<NECProtocol>},
+    {"nexa", [](RawTimings *f) { return round_trip<NexaProtocol>({0x1234567, 0, 1, 2, 0}, f); },
+     decodes<NexaProtocol>},
+    {"panasonic", [](RawTimings *f) { return round_trip<PanasonicProtocol>({0x4004, 0x0100BCBD}, f); },
+     decodes<PanasonicProtocol>},
+    {"pioneer", [](RawTimings *f) { return round_trip<PioneerProtocol>({0xA556, 0}, f); }, decodes<PioneerProtocol>},
+    {"pronto",
+     [](RawTimings *f) {
+       return round_trip<ProntoProtocol>({"0000 006D 0004 0000 0041 0016 0016 0041 0016 0016 0041 06C3", -1}, f);
+     },
+     decodes<ProntoProtocol>},
+    {"rc5", [](RawTimings *f) { return round_trip<RC5Protocol>({0x05, 0x0c}, f); }, decodes<RC5Protocol>},
+    {"rc6", [](RawTimings *f) { return round_trip<RC6Protocol>({0, 0, 0x04, 0x0c}, f); }, decodes<RC6Protocol>},
+    {"rc_switch", rc_switch_round_trip, decodes<RCSwitchBase>},
+    {"roomba", [](RawTimings *f) { return round_trip<RoombaProtocol>({0x88}, f); }, decodes<RoombaProtocol>},
+    {"samsung", [](RawTimings *f) { return round_trip<SamsungProtocol>({0xE0E040BF, 32}, f); },
+     decodes<SamsungProtocol>},
+    {"samsung36", [](RawTimings *f) { return round_trip<Samsung36Protocol>({0x0400, 0x000E00FF}, f); },
+     decodes<Samsung36Protocol>},
+    {"sony", [](RawTimings *f) { return round_trip<SonyProtocol>({0xA90, 12}, f); }, decodes<SonyProtocol>},
+    {"toshiba_ac",
+     [](RawTimings *f) { return round_trip<ToshibaAcProtocol>({0xB24DBF4040BF, 0xD5660001003B}, f); },
+     decodes<ToshibaAcProtocol>},
+    {"toto", [](RawTimings *f) { return round_trip<TotoProtocol>({0x02, 0x00, 0x17}, f); }, decodes<TotoProtocol>},
+};
+
+static const size_t PROTOCOL_COUNT = sizeof(PROTOCOLS) / sizeof(PROTOCOLS[0]);
+
+/// Whether \p timings decode to \p address and \p command with \p protocol, false for protocols without them.
+static bool decodes_to(const std::string &protocol, const RawTimings &timings, int32_t address, int32_t command) {
+  if (protocol == "dish")
+    return decodes_to<DishProtocol>(timings, address, command);
+  if (protocol == "nec")
+    return decodes_to<NECProtocol>(timings, address, command);
+  if (protocol == "rc5")
+    return decodes_to<RC5Protocol>(timings, address, command);
+  return false;
+}
+
+/// Encode \p code with the timings of RC switch \p protocol, the way remote_transmitter repeats it.
+static RawTimings rc_switch_frame(uint8_t protocol, uint64_t code, uint8_t nbits) {
+  RemoteTransmitData dst;
+  RC_SWITCH_PROTOCOLS[protocol].transmit(&dst, code, nbits);
+  RC_SWITCH_PROTOCOLS[protocol].sync(&dst);
+  return as_received(dst.get_data());
+}
+
+void RemoteBaseReplay::setup() {
+  this->setup_receiver_();
+  this->disable_loop();
+}
+
+template<typename P>
+void RemoteBaseReplay::add_binary_sensor_(const std::string &name, const typename P::ProtocolData &data) {
+  auto *sensor = new RemoteReceiverBinarySensor<P>();  // NOLINT(cppcoreguidelines-owning-memory)
+  // Like the generated code, the data is only set after the sensor registered
+  this->receiver_.register_listener(sensor);
+  sensor->set_data(data);
+  sensor->add_on_state_callback([this, name](bool state) {
+    if (state)
+      this->fired_.push_back(name);
+  });
+  this->listeners_.push_back(sensor);
+}
+
+template<typename P> void RemoteBaseReplay::add_trigger_(const std::string &name) {
+  using Data = typename P::ProtocolData;
+  auto *trigger = new RemoteReceiverTrigger<P>();  // NOLINT(cppcoreguidelines-owning-memory)
+  this->receiver_.register_listener(trigger);
+  auto *automation = new Automation<Data>(trigger);  // NOLINT(cppcoreguidelines-owning-memory)
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  automation->add_action(new LambdaAction<Data>([this, name](Data) { this->fired_.push_back(name); }));
+  this->listeners_.push_back(trigger);
+}
+
+RCSwitchRawReceiver *RemoteBaseReplay::add_rc_switch_(const std::string &name, uint8_t protocol) {
+  auto *sensor = new RCSwitchRawReceiver();  // NOLINT(cppcoreguidelines-owning-memory)
+  this->receiver_.register_listener(sensor);
+  sensor->set_protocol(RC_SWITCH_PROTOCOLS[protocol]);
+  sensor->add_on_state_callback([this, name](bool state) {
+    if (state)
+      this->fired_.push_back(name);
+  });
+  this->listeners_.push_back(sensor);
+  return sensor;
+}
+
+template<typename P> void RemoteBaseReplay::add_frame_(const std::string &name, const typename P::ProtocolData &data) {
+  RemoteTransmitData dst;
+  P().encode(&dst, data);
+  this->frames_.push_back({name, "", as_received(dst.get_data()), -1, -1});
+}
+
+void RemoteBaseReplay::setup_receiver_() {
+  this->receiver_.set_tolerance(TOLERANCE, TOLERANCE_MODE_PERCENTAGE);
+
+  // Enough NEC sensors that the index grows past its initial size, and two with the same data
+  this->add_binary_sensor_<NECProtocol>("nec_a", {0x1234, 0x5678, 1});
+  this->add_binary_sensor_<NECProtocol>("nec_a_copy", {0x1234, 0x5678, 1});
+  this->add_binary_sensor_<NECProtocol>("nec_b", {0x1234, 0x5679, 1});
+  for (uint16_t i = 0; i < 12; i++)
+    this->add_binary_sensor_<NECProtocol>("nec_" + to_string(i), {static_cast<uint16_t>(0x2000 + i), 0x00FF, 1});
+  this->add_binary_sensor_<SonyProtocol>("sony", {0xA90, 12});
+  this->add_binary_sensor_<SamsungProtocol>("samsung", {0xE0E040BF, 32});
+  // AEHA data has no hash(), its sensors are compared one by one
+  this->add_binary_sensor_<AEHAProtocol>("aeha", {0x2002, {0x80, 0x00, 0x30, 0x40}});
+  this->add_binary_sensor_<AEHAProtocol>("aeha_other", {0x2002, {0x80, 0x00, 0x30, 0x41}});
+  this->add_trigger_<NECProtocol>("nec_trigger");
+  this->add_trigger_<LGProtocol>("lg_trigger");
+  this->add_trigger_<SonyProtocol>("sony_trigger");
+
+  // RC switch sensors with the timings of protocol 1 and 2, some with the same code
+  this->add_rc_switch_("rc1_on", 1)->set_type_a("10101", "00010", true);
+  this->add_rc_switch_("rc1_on_copy", 1)->set_type_a("10101", "00010", true);
+  this->add_rc_switch_("rc1_off", 1)->set_type_a("10101", "00010", false);
+  this->add_rc_switch_("rc2_on", 2)->set_type_a("10101", "00010", true);
+  // The last four bits, on or off, are wildcards
+  uint64_t code;
+  uint8_t nbits;
+  RCSwitchBase::type_a_code(0b10101, 0b00010, true, &code, &nbits);
+  std::string pattern;
+  for (int bit = nbits - 1; bit >= 0; bit--)
+    pattern += bit < 4 ? 'x' : ((code >> bit) & 1 ? '1' : '0');
+  this->add_rc_switch_("rc1_any", 1)->set_code(pattern);
+
+  this->add_frame_<NECProtocol>("nec_a", {0x1234, 0x5678, 1});
+  this->add_frame_<NECProtocol>("nec_b", {0x1234, 0x5679, 1});
+  this->add_frame_<NECProtocol>("nec_7", {0x2007, 0x00FF, 1});
+  this->add_frame_<NECProtocol>("nec_unknown", {0x4321, 0x1111, 1});
+  this->add_frame_<SonyProtocol>("sony", {0xA90, 12});
+  this->add_frame_<SamsungProtocol>("samsung", {0xE0E040BF, 32});
+  this->add_frame_<AEHAProtocol>("aeha", {0x2002, {0x80, 0x00, 0x30, 0x40}});
+  this->add_frame_<LGProtocol>("lg", {0x20DF10EF, 32});
+  this->frames_.push_back({"rc1_on", "", rc_switch_frame(1, code, nbits), -1, -1});
+  RCSwitchBase::type_a_code(0b10101, 0b00010, false, &code, &nbits);
+  this->frames_.push_back({"rc1_off", "", rc_switch_frame(1, code, nbits), -1, -1});
+  this->frames_.push_back({"rc2_off", "", rc_switch_frame(2, code, nbits), -1, -1});
+  RCSwitchBase::type_a_code(0b10101, 0b00010, true, &code, &nbits);
+  this->frames_.push_back({"rc2_on", "", rc_switch_frame(2, code, nbits), -1, -1});
+  this->frames_.push_back({"rc3_on", "", rc_switch_frame(3, code, nbits), -1, -1});
+}
+
+void RemoteBaseReplay::run() {
+  this->step_ = 0;
+  this->round_trips_ok_ = 0;
+  this->captures_ok_ = 0;
+  this->frames_ok_ = 0;
+  this->enable_loop();
+}
+
+void RemoteBaseReplay::loop() {
+  if (this->step_ < PROTOCOL_COUNT) {
+    this->round_trip_(this->step_++);
+    return;
+  }
+  size_t capture = this->step_++ - PROTOCOL_COUNT;
+  if (capture < this->captures_.size()) {
+    this->replay_capture_(this->captures_[capture]);
+    return;
+  }
+  size_t frame = capture - this->captures_.size();
+  if (frame < this->frames_.size()) {
+    this->replay_frame_(this->frames_[frame]);
+    return;
+  }
+  ESP_LOGI(TAG,
+           "Replay done: %" PRIu32 "/%zu round trips ok, %" PRIu32 "/%zu captures decoded, %" PRIu32
+           "/%zu frames fired as per listener",
+           this->round_trips_ok_, PROTOCOL_COUNT, this->captures_ok_, this->captures_.size(), this->frames_ok_,
+           this->frames_.size());
+  this->disable_loop();
+}
+
+void RemoteBaseReplay::round_trip_(size_t index) {
+  const Protocol &protocol = PROTOCOLS[index];
+  RawTimings frame;
+  bool ok = protocol.round_trip(&frame);
+  if (ok)
+    this->round_trips_ok_++;
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++)
+    protocol.decodes(frame);
+  uint32_t elapsed = std::max<uint32_t>(micros() - start, 1);
+  ESP_LOGI(TAG, "Round trip %s: %s, %zu timings, %" PRIu32 " decodes/s", protocol.name, ok ? "ok" : "FAILED",
+           frame.size(), static_cast<uint32_t>(uint64_t(this->iterations_) * 1000000 / elapsed));
+}
+
+void RemoteBaseReplay::replay_capture_(const Capture &capture) {
+  // Like the dumpers of a receiver, hand the capture to every decoder
+  std::string decoded_by;
+  bool expected = false;
+  for (const auto &protocol : PROTOCOLS) {
+    if (!protocol.decodes(capture.timings))
+      continue;
+    if (!decoded_by.empty())
+      decoded_by += ",";
+    decoded_by += protocol.name;
+    if (capture.protocol == protocol.name)
+      expected = true;
+  }
+  if (expected && capture.address >= 0)
+    expected = decodes_to(capture.protocol, capture.timings, capture.address, capture.command);
+  if (expected)
+    this->captures_ok_++;
+  ESP_LOGI(TAG, "Capture %s: %s, decoded by [%s]", capture.name.c_str(), expected ? "ok" : "FAILED",
+           decoded_by.c_str());
+}
+
+std::string RemoteBaseReplay::take_fired_() {
+  std::sort(this->fired_.begin(), this->fired_.end());
+  std::string names;
+  for (const auto &name : this->fired_) {
+    if (!names.empty())
+      names += ",";
+    names += name;
+  }
+  this->fired_.clear();
+  return names;
+}
+
+void RemoteBaseReplay::replay_frame_(const Capture &frame) {
+  this->fired_.clear();
+  this->receiver_.replay(frame.timings);
+  std::string grouped = this->take_fired_();
+  for (auto *listener : this->listeners_)
+    listener->on_receive(receive_data(frame.timings));
+  std::string per_listener = this->take_fired_();
+  if (grouped == per_listener)
+    this->frames_ok_++;
+  ESP_LOGI(TAG, "Frame %s: fired [%s], per listener [%s]", frame.name.c_str(), grouped.c_str(),
+           per_listener.c_str());
+}
+
+void RemoteBaseReplay::dump_config() {
+  ESP_LOGCONFIG(TAG, "Remote Base Replay:");
+  ESP_LOGCONFIG(TAG, "  Protocols: %zu", PROTOCOL_COUNT);
+  ESP_LOGCONFIG(TAG, "  Captures: %zu", this->captures_.size());
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+}
+
+}  // namespace remote_base_replay
+}  // namespace esphome
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "esphome/components/remote_base/remote_base.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/base_automation.h"
+#include "esphome/core/component.h"
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace remote_base_replay {
+
+/// A receiver without hardware, frames are handed to it by replay().
+class ReplayReceiver : public remote_base::RemoteReceiverBase {
+ public:
+  ReplayReceiver() : RemoteReceiverBase(nullptr) {}
+  /// Hand \p timings to the listeners, like a frame that was just received.
+  void replay(const remote_base::RawTimings &timings) {
+    this->temp_ = timings;
+    this->call_listeners_dumpers_();
+  }
+};
+
+/** Exercises the remote_base decoders without a receiver.
+ *
+ * run() round-trips a sample of every protocol through its own encode() and decode() and times the decoder on that
+ * frame. Then it replays the configured captures through every decoder. Last, it replays encoded frames through a
+ * ReplayReceiver with binary sensors and triggers of several protocols, including duplicate sensors and RC switch
+ * sensors with different timings, and logs which of them fired. Each listener then gets the frame on its own, the
+ * way receivers called them before they were grouped by protocol, and must fire the same way. One protocol, capture
+ * or frame is handled per loop() and logged, so the main loop keeps running and no log line is dropped.
+ */
+class RemoteBaseReplay : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void add_capture(const std::string &name, const std::string &protocol, const remote_base::RawTimings &timings,
+                   int32_t address = -1, int32_t command = -1) {
+    this->captures_.push_back({name, protocol, timings, address, command});
+  }
+  void run();
+
+ protected:
+  struct Capture {
+    std::string name;
+    /// The protocol expected to decode the capture, empty for frames.
+    std::string protocol;
+    remote_base::RawTimings timings;
+    /// The address and command the protocol must decode, -1 when not checked.
+    int32_t address;
+    int32_t command;
+  };
+
+  void round_trip_(size_t index);
+  void replay_capture_(const Capture &capture);
+  /// Register the listeners of receiver_ and encode the frames replayed to it.
+  void setup_receiver_();
+  template<typename P> void add_binary_sensor_(const std::string &name, const typename P::ProtocolData &data);
+  template<typename P> void add_trigger_(const std::string &name);
+  remote_base::RCSwitchRawReceiver *add_rc_switch_(const std::string &name, uint8_t protocol);
+  template<typename P> void add_frame_(const std::string &name, const typename P::ProtocolData &data);
+  void replay_frame_(const Capture &frame);
+  /// Names of the listeners that fired since the last call, sorted and separated by commas.
+  std::string take_fired_();
+
+  uint32_t iterations_{1000};
+  std::vector<Capture> captures_;
+  ReplayReceiver receiver_;
+  /// The listeners of receiver_, to hand them a frame one by one.
+  std::vector<remote_base::RemoteReceiverListener *> listeners_;
+  std::vector<std::string> fired_;
+  /// Encoded frames replayed to receiver_.
+  std::vector<Capture> frames_;
+  /// Next protocol, then capture, to process.
+  size_t step_{0};
+  uint32_t round_trips_ok_{0};
+  uint32_t captures_ok_{0};
+  uint32_t frames_ok_{0};
+};
+
+}  // namespace remote_base_replay
+}  // namespace esphome
@@ -0,0 +1,27 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+CONF_ITERATIONS = "iterations"
+CONF_TIMER_COUNTS = "timer_counts"
+
+scheduler_bench_ns = cg.esphome_ns.namespace("scheduler_bench")
+SchedulerBench = scheduler_bench_ns.class_("SchedulerBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(SchedulerBench),
+        cv.Optional(CONF_ITERATIONS, default=10000): cv.positive_not_null_int,
+        cv.Optional(CONF_TIMER_COUNTS, default=[16, 128, 1024]): cv.ensure_list(
+            cv.int_range(min=1, max=10000)
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
+    for count in config[CONF_TIMER_COUNTS]:
+        cg.add(var.add_timer_count(count))
@@ -0,0 +1,207 @@
+#include "scheduler_bench.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+namespace esphome {
+namespace scheduler_bench {
+
+static const char *const TAG = "scheduler_bench";
+
+/// Far enough out that no benchmark timeout ever runs.
+static const uint32_t DELAY = 3600000;
+static const size_t COMPONENT_COUNT = 4;
+
+/// The scheduler before items were pooled and indexed: one allocation per timeout, a binary heap, and a linear scan
+/// with string compares to cancel. Only what the benchmark needs is kept.
+class ReferenceScheduler {
+ public:
+  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func) {
+    this->cancel_timeout(component, name);
+    auto item = make_unique<Item>();
+    item->component = component;
+    item->name = name;
+    item->next_execution = millis() + uint64_t(timeout);
+    item->callback = std::move(func);
+    item->remove = false;
+    this->to_add_.push_back(std::move(item));
+  }
+  bool cancel_timeout(Component *component, const std::string &name) {
+    bool ret = false;
+    for (auto &it : this->items_) {
+      if (it->component == component && it->name == name && !it->remove) {
+        this->to_remove_++;
+        it->remove = true;
+        ret = true;
+      }
+    }
+    for (auto &it : this->to_add_) {
+      if (it->component == component && it->name == name) {
+        it->remove = true;
+        ret = true;
+      }
+    }
+    return ret;
+  }
+  /// Queue the new items and drop the cancelled ones, like Scheduler::call() when nothing is due.
+  void call() {
+    for (auto &it : this->to_add_) {
+      if (it->remove)
+        continue;
+      this->items_.push_back(std::move(it));
+      std::push_heap(this->items_.begin(), this->items_.end(), Item::cmp);
+    }
+    this->to_add_.clear();
+    if (this->to_remove_ > 10) {
+      this->items_.erase(std::remove_if(this->items_.begin(), this->items_.end(),
+                                        [](const std::unique_ptr<Item> &it) { return it->remove; }),
+                         this->items_.end());
+      std::make_heap(this->items_.begin(), this->items_.end(), Item::cmp);
+      this->to_remove_ = 0;
+    }
+    while (!this->items_.empty() && this->items_[0]->remove) {
+      std::pop_heap(this->items_.begin(), this->items_.end(), Item::cmp);
+      this->items_.pop_back();
+      this->to_remove_--;
+    }
+  }
+
+ protected:
+  struct Item {
+    Component *component;
+    std::string name;
+    uint64_t next_execution;
+    std::function<void()> callback;
+    bool remove;
+
+    static bool cmp(const std::unique_ptr<Item> &a, const std::unique_ptr<Item> &b) {
+      return a->next_execution > b->next_execution;
+    }
+  };
+
+  std::vector<std::unique_ptr<Item>> items_;
+  std::vector<std::unique_ptr<Item>> to_add_;
+  uint32_t to_remove_{0};
+};
+
+/// Timers are spread over a few components, as they would be on a device.
+static Component components[COMPONENT_COUNT];
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint32_t ns_per_op(uint32_t elapsed_us, uint32_t ops) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / ops);
+}
+
+void SchedulerBench::setup() { this->disable_loop(); }
+
+void SchedulerBench::run() {
+  this->step_ = 0;
+  this->mismatches_ = 0;
+  this->enable_loop();
+}
+
+void SchedulerBench::loop() {
+  if (this->step_ == 0) {
+    this->step_++;
+    ESP_LOGI(TAG, "Scheduler name collision: %s", this->check_name_collision_() ? "ok" : "FAILED");
+    return;
+  }
+  if (this->step_ <= this->timer_counts_.size()) {
+    this->bench_(this->timer_counts_[this->step_++ - 1]);
+    return;
+  }
+  ESP_LOGI(TAG, "Scheduler bench done: %" PRIu32 " cancel mismatches", this->mismatches_);
+  this->disable_loop();
+}
+
+bool SchedulerBench::check_name_collision_() {
+  // Two names with the same fnv1_hash()
+  const std::string first = "timer_66358";
+  const std::string second = "timer_749130";
+  if (fnv1_hash(first) != fnv1_hash(second))
+    return false;
+  Component *component = &components[0];
+  auto noop = []() {};
+  auto retry = [](uint8_t) { return RetryResult::RETRY; };
+  this->scheduler_.set_timeout(component, first, DELAY, noop);
+  this->scheduler_.set_timeout(component, second, DELAY, noop);
+  this->scheduler_.set_retry(component, first, DELAY, 3, retry);
+  this->scheduler_.set_retry(component, second, DELAY, 3, retry);
+  this->scheduler_.call();
+  // Setting the second name must not have replaced the first, and each cancel only finds its own timer
+  bool ok = this->scheduler_.cancel_timeout(component, first) && this->scheduler_.cancel_timeout(component, second) &&
+            this->scheduler_.cancel_retry(component, first) && this->scheduler_.cancel_retry(component, second);
+  ok = ok && !this->scheduler_.cancel_timeout(component, first) && !this->scheduler_.cancel_retry(component, second);
+  this->scheduler_.call();
+  return ok;
+}
+
+void SchedulerBench::bench_(uint32_t timer_count) {
+  ReferenceScheduler reference;
+  std::vector<std::string> names;
+  names.reserve(timer_count);
+  for (uint32_t i = 0; i < timer_count; i++)
+    names.push_back("timer_" + to_string(i));
+  auto noop = []() {};
+
+  for (uint32_t i = 0; i < timer_count; i++) {
+    Component *component = &components[i % COMPONENT_COUNT];
+    this->scheduler_.set_timeout(component, names[i], DELAY, noop);
+    reference.set_timeout(component, names[i], DELAY, noop);
+  }
+  this->scheduler_.process_to_add();
+  reference.call();
+
+  // Replace random timers by name, each followed by a call() that queues the new item
+  uint32_t seed = 0x9E3779B9;
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    uint32_t index = xorshift(&seed) % timer_count;
+    this->scheduler_.set_timeout(&components[index % COMPONENT_COUNT], names[index], DELAY, noop);
+    this->scheduler_.call();
+  }
+  uint32_t replace_ns = ns_per_op(micros() - start, this->iterations_);
+
+  seed = 0x9E3779B9;
+  start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    uint32_t index = xorshift(&seed) % timer_count;
+    reference.set_timeout(&components[index % COMPONENT_COUNT], names[index], DELAY, noop);
+    reference.call();
+  }
+  uint32_t reference_ns = ns_per_op(micros() - start, this->iterations_);
+
+  // Cancel everything twice: first every cancel finds its timer, then none does
+  for (uint32_t round = 0; round < 2; round++) {
+    for (uint32_t i = 0; i < timer_count; i++) {
+      Component *component = &components[i % COMPONENT_COUNT];
+      bool cancelled = this->scheduler_.cancel_timeout(component, names[i]);
+      if (cancelled != reference.cancel_timeout(component, names[i]) || cancelled != (round == 0))
+        this->mismatches_++;
+    }
+  }
+  this->scheduler_.call();
+
+  ESP_LOGI(TAG, "Scheduler %" PRIu32 " timers: %" PRIu32 " ns per replace, reference %" PRIu32 " ns", timer_count,
+           replace_ns, reference_ns);
+}
+
+void SchedulerBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "Scheduler Bench:");
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+  ESP_LOGCONFIG(TAG, "  Timer counts: %zu", this->timer_counts_.size());
+}
+
+}  // namespace scheduler_bench
+}  // namespace esphome
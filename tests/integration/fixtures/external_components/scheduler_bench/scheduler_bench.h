@@ -0,0 +1,41 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/scheduler.h"
+
+#include <vector>
+
+namespace esphome {
+namespace scheduler_bench {
+
+/** Times replacing and cancelling named timeouts while many others are pending.
+ *
+ * run() fills a private Scheduler with each configured number of named timeouts, then replaces random ones by name
+ * and cancels them all. The same operations go to a copy of the scheduler as it was before items were pooled and
+ * indexed, and every cancel must return the same result in both. One timer count is handled per loop() and logged.
+ * Before that, it checks that two names with the same hash are kept apart.
+ */
+class SchedulerBench : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void add_timer_count(uint32_t count) { this->timer_counts_.push_back(count); }
+  void run();
+
+ protected:
+  bool check_name_collision_();
+  void bench_(uint32_t timer_count);
+
+  uint32_t iterations_{10000};
+  std::vector<uint32_t> timer_counts_;
+  Scheduler scheduler_;
+  /// 0 for the collision check, then the index of the next timer count plus one.
+  size_t step_{0};
+  uint32_t mismatches_{0};
+};
+
+}  // namespace scheduler_bench
+}  // namespace esphome
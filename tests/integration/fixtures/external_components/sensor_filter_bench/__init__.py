@@ -0,0 +1,26 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+AUTO_LOAD = ["sensor"]
+
+CONF_SAMPLES = "samples"
+CONF_RANDOM_RUNS = "random_runs"
+
+sensor_filter_bench_ns = cg.esphome_ns.namespace("sensor_filter_bench")
+SensorFilterBench = sensor_filter_bench_ns.class_("SensorFilterBench", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(SensorFilterBench),
+        cv.Optional(CONF_SAMPLES, default=20000): cv.positive_not_null_int,
+        cv.Optional(CONF_RANDOM_RUNS, default=1000): cv.positive_not_null_int,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_samples(config[CONF_SAMPLES]))
+    cg.add(var.set_random_runs(config[CONF_RANDOM_RUNS]))
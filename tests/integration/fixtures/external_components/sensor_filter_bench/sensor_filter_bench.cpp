@@ -0,0 +1,246 @@
+#include "sensor_filter_bench.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace sensor_filter_bench {
+
+static const char *const TAG = "sensor_filter_bench";
+
+static const char *kind_name(FilterKind kind) {
+  switch (kind) {
+    case FilterKind::MEDIAN:
+      return "median";
+    case FilterKind::QUANTILE:
+      return "quantile";
+    case FilterKind::MIN:
+      return "min";
+    case FilterKind::MAX:
+      return "max";
+    default:
+      return "average";
+  }
+}
+
+/// The sliding window filters before they were computed incrementally: a deque of the window, and every result
+/// rescans it. Median and quantile copy the non-NaN values and sort them.
+class ReferenceFilter {
+ public:
+  ReferenceFilter(FilterKind kind, size_t window_size, size_t send_every, size_t send_first_at, float quantile)
+      : kind_(kind), send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size),
+        quantile_(quantile) {}
+
+  void set_window_size(size_t window_size) { this->window_size_ = window_size; }
+  void set_quantile(float quantile) { this->quantile_ = quantile; }
+
+  optional<float> new_value(float value) {
+    while (this->queue_.size() >= this->window_size_) {
+      this->queue_.pop_front();
+    }
+    this->queue_.push_back(value);
+    if (++this->send_at_ < this->send_every_)
+      return {};
+    this->send_at_ = 0;
+    switch (this->kind_) {
+      case FilterKind::MEDIAN:
+      case FilterKind::QUANTILE:
+        return this->order_statistic_();
+      case FilterKind::MIN:
+      case FilterKind::MAX: {
+        float result = NAN;
+        for (auto v : this->queue_) {
+          if (!std::isnan(v)) {
+            if (this->kind_ == FilterKind::MIN) {
+              result = std::isnan(result) ? v : std::min(result, v);
+            } else {
+              result = std::isnan(result) ? v : std::max(result, v);
+            }
+          }
+        }
+        return result;
+      }
+      default: {
+        float sum = 0;
+        size_t valid_count = 0;
+        for (auto v : this->queue_) {
+          if (!std::isnan(v)) {
+            sum += v;
+            valid_count++;
+          }
+        }
+        return valid_count ? sum / valid_count : NAN;
+      }
+    }
+  }
+
+ protected:
+  float order_statistic_() {
+    // Copy queue without NaN values
+    std::vector<float> sorted;
+    for (auto v : this->queue_) {
+      if (!std::isnan(v)) {
+        sorted.push_back(v);
+      }
+    }
+    sort(sorted.begin(), sorted.end());
+    size_t size = sorted.size();
+    if (size == 0)
+      return NAN;
+    if (this->kind_ == FilterKind::QUANTILE)
+      return sorted[size_t(ceilf(size * this->quantile_)) - 1];
+    if (size % 2)
+      return sorted[size / 2];
+    return (sorted[size / 2] + sorted[(size / 2) - 1]) / 2.0f;
+  }
+
+  FilterKind kind_;
+  std::deque<float> queue_;
+  size_t send_every_;
+  size_t send_at_;
+  size_t window_size_;
+  float quantile_;
+};
+
+/// A shared_ptr deletes the filter through its own type, Filter has no virtual destructor.
+static std::shared_ptr<sensor::SlidingWindowFilter> make_filter(FilterKind kind, size_t window_size,
+                                                                size_t send_every, size_t send_first_at,
+                                                                float quantile) {
+  switch (kind) {
+    case FilterKind::MEDIAN:
+      return std::make_shared<sensor::MedianFilter>(window_size, send_every, send_first_at);
+    case FilterKind::QUANTILE:
+      return std::make_shared<sensor::QuantileFilter>(window_size, send_every, send_first_at, quantile);
+    case FilterKind::MIN:
+      return std::make_shared<sensor::MinFilter>(window_size, send_every, send_first_at);
+    case FilterKind::MAX:
+      return std::make_shared<sensor::MaxFilter>(window_size, send_every, send_first_at);
+    default:
+      return std::make_shared<sensor::SlidingWindowMovingAverageFilter>(window_size, send_every, send_first_at);
+  }
+}
+
+static uint32_t xorshift(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+static uint32_t ns_per_op(uint32_t elapsed_us, uint32_t ops) {
+  return static_cast<uint32_t>(uint64_t(std::max<uint32_t>(elapsed_us, 1)) * 1000 / ops);
+}
+
+/// Whether \p result matches \p reference. The average used to be summed in float, so it only has to be close.
+static bool same_result(FilterKind kind, const optional<float> &result, const optional<float> &reference) {
+  if (result.has_value() != reference.has_value())
+    return false;
+  if (!result.has_value())
+    return true;
+  float a = *result;
+  float b = *reference;
+  if (std::isnan(a) || std::isnan(b))
+    return std::isnan(a) && std::isnan(b);
+  if (a == b)
+    return true;
+  return kind == FilterKind::AVERAGE && std::isfinite(b) && std::fabs(a - b) <= 1e-3f * std::max(1.0f, std::fabs(b));
+}
+
+void SensorFilterBench::bench_(FilterKind kind, size_t window_size, size_t send_every) {
+  auto filter = make_filter(kind, window_size, send_every, 1, 0.9f);
+  ReferenceFilter reference(kind, window_size, send_every, 1, 0.9f);
+  std::vector<float> samples(this->samples_);
+  uint32_t seed = 0x9E3779B9;
+  for (uint32_t i = 0; i < this->samples_; i++)
+    samples[i] = 20.0f + 5.0f * sinf(i * 0.01f) + (xorshift(&seed) % 1000) / 1000.0f;
+
+  double sum = 0;
+  uint32_t start = micros();
+  for (float sample : samples)
+    sum += filter->new_value(sample).value_or(0.0f);
+  uint32_t filter_ns = ns_per_op(micros() - start, this->samples_);
+
+  double reference_sum = 0;
+  start = micros();
+  for (float sample : samples)
+    reference_sum += reference.new_value(sample).value_or(0.0f);
+  uint32_t reference_ns = ns_per_op(micros() - start, this->samples_);
+
+  ESP_LOGI(TAG, "Filter %s window %zu send_every %zu: %" PRIu32 " ns per value, reference %" PRIu32 " ns%s",
+           kind_name(kind), window_size, send_every, filter_ns, reference_ns,
+           std::fabs(sum - reference_sum) <= 1e-6 * std::fabs(reference_sum) ? "" : " (results differ)");
+}
+
+uint32_t SensorFilterBench::check_random_(FilterKind kind, uint32_t *seed) {
+  size_t window_size = 1 + xorshift(seed) % 100;
+  size_t send_every = 1 + xorshift(seed) % 5;
+  size_t send_first_at = 1 + xorshift(seed) % send_every;
+  float quantile = (1 + xorshift(seed) % 100) / 100.0f;
+  uint32_t nan_percent = xorshift(seed) % 4 * 10;
+  // Few distinct values give many duplicates
+  uint32_t levels = xorshift(seed) % 2 ? 1 + xorshift(seed) % 10 : 0;
+  uint32_t length = 100 + xorshift(seed) % 400;
+
+  auto filter = make_filter(kind, window_size, send_every, send_first_at, quantile);
+  ReferenceFilter reference(kind, window_size, send_every, send_first_at, quantile);
+  uint32_t mismatches = 0;
+  for (uint32_t i = 0; i < length; i++) {
+    uint32_t event = xorshift(seed) % 100;
+    if (event == 0) {
+      window_size = 1 + xorshift(seed) % 100;
+      filter->set_window_size(window_size);
+      reference.set_window_size(window_size);
+    } else if (event == 1 && kind == FilterKind::QUANTILE) {
+      quantile = (1 + xorshift(seed) % 100) / 100.0f;
+      static_cast<sensor::QuantileFilter *>(filter.get())->set_quantile(quantile);
+      reference.set_quantile(quantile);
+    }
+
+    float value;
+    uint32_t pick = xorshift(seed) % 100;
+    if (pick < nan_percent) {
+      value = NAN;
+    } else if (pick == 99) {
+      value = xorshift(seed) % 2 ? INFINITY : -INFINITY;
+    } else if (levels != 0) {
+      value = float(xorshift(seed) % levels);
+    } else {
+      value = (int32_t(xorshift(seed) % 20000) - 10000) / 100.0f;
+    }
+    if (!same_result(kind, filter->new_value(value), reference.new_value(value)))
+      mismatches++;
+  }
+  return mismatches;
+}
+
+void SensorFilterBench::run() {
+  const FilterKind kinds[] = {FilterKind::MEDIAN, FilterKind::QUANTILE, FilterKind::MIN, FilterKind::MAX,
+                              FilterKind::AVERAGE};
+  for (FilterKind kind : kinds) {
+    this->bench_(kind, 1000, 1);
+    this->bench_(kind, 100, 10);
+    this->bench_(kind, 5, 5);
+  }
+
+  uint32_t mismatches = 0;
+  uint32_t seed = 0x2545F491;
+  for (uint32_t run = 0; run < this->random_runs_; run++)
+    mismatches += this->check_random_(kinds[run % 5], &seed);
+  ESP_LOGI(TAG, "Filter bench done: %" PRIu32 " mismatches in %" PRIu32 " random runs", mismatches,
+           this->random_runs_);
+}
+
+void SensorFilterBench::dump_config() {
+  ESP_LOGCONFIG(TAG, "Sensor Filter Bench:");
+  ESP_LOGCONFIG(TAG, "  Samples: %" PRIu32, this->samples_);
+  ESP_LOGCONFIG(TAG, "  Random runs: %" PRIu32, this->random_runs_);
+}
+
+}  // namespace sensor_filter_bench
+}  // namespace esphome
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/filter.h"
+
+#include <cstdint>
+
+namespace esphome {
+namespace sensor_filter_bench {
+
+enum class FilterKind : uint8_t { MEDIAN, QUANTILE, MIN, MAX, AVERAGE };
+
+/** Compares the sliding window sensor filters with copies of them from before they were computed incrementally.
+ *
+ * run() first feeds a noisy sine through each filter and its reference and logs the time per value for a few window
+ * sizes. Then it runs random sequences with NaN, infinities, duplicate values, window resizes and quantile changes
+ * through both, and counts the results that differ.
+ */
+class SensorFilterBench : public Component {
+ public:
+  void dump_config() override;
+
+  void set_samples(uint32_t samples) { this->samples_ = samples; }
+  void set_random_runs(uint32_t random_runs) { this->random_runs_ = random_runs; }
+  void run();
+
+ protected:
+  void bench_(FilterKind kind, size_t window_size, size_t send_every);
+  /// Number of results that differ from the reference in one random run.
+  uint32_t check_random_(FilterKind kind, uint32_t *seed);
+
+  uint32_t samples_{20000};
+  uint32_t random_runs_{1000};
+};
+
+}  // namespace sensor_filter_bench
+}  // namespace esphome
@@ -0,0 +1,27 @@
+"""Integration test timing the deferred batch of an API connection."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"Batch (\d+) entities: (\d+) ns per batch, linear search (\d+) ns"
+)
+DONE_RE = re.compile(r"Batch bench done: (\d+) mismatches")
+
+
+@pytest.mark.asyncio
+async def test_host_mode_api_batch_bench(run_bench: RunBenchFunction) -> None:
+    """Test that the indexed batch matches the linear search.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=60.0)
+
+    assert int(log.done.group(1)) == 0, "The batch differs from the linear search"
+    entity_counts = {int(match.group(1)) for match in log.matches(RESULT_RE)}
+    assert entity_counts == {10, 30, 100, 300, 1000}
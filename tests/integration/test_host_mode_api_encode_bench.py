@@ -0,0 +1,34 @@
+"""Integration test timing the API encoder on a 500 entity list."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"API encode (\d+) entities: (\d+) bytes, (\d+) ns per message, reference (\d+) ns"
+)
+DONE_RE = re.compile(
+    r"API encode bench done: (\d+) failures, output (\w+), overflow check (\w+)"
+)
+
+
+@pytest.mark.asyncio
+async def test_host_mode_api_encode_bench(run_bench: RunBenchFunction) -> None:
+    """Test that sized encoding matches the old encoder and stays in bounds.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=30.0)
+
+    failures, output, overflow = log.done.groups()
+    assert int(failures) == 0, "Encoding did not end exactly at the calculated size"
+    assert output == "identical", "Output differs from the reference encoder"
+    assert overflow == "ok", "Encoding into a short buffer was not caught"
+    results = log.matches(RESULT_RE)
+    assert len(results) == 1
+    assert int(results[0].group(1)) == 500
+    assert int(results[0].group(2)) > 0
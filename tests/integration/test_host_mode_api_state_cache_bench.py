@@ -0,0 +1,27 @@
+"""Integration test timing shared state payloads for several API clients."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"State cache ([a-z ]+) (\d+) clients: (\d+) ns per update, "
+    r"every client encoding (\d+) ns"
+)
+DONE_RE = re.compile(r"State cache bench done: (\d+) mismatches")
+
+
+@pytest.mark.asyncio
+async def test_host_mode_api_state_cache_bench(run_bench: RunBenchFunction) -> None:
+    """Test that shared payloads match per client encoding.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=30.0)
+
+    assert int(log.done.group(1)) == 0, "Clients received other bytes from the cache"
+    assert len(log.matches(RESULT_RE)) == 9
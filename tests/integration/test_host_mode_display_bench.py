@@ -0,0 +1,39 @@
+"""Integration test timing the Display drawing primitives on a framebuffer."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+TEST_CARD_RE = re.compile(
+    r"Test card: (\d+) frames/s per pixel, (\d+) frames/s pixel hook, "
+    r"(\d+) frames/s rect hook"
+)
+IMAGE_RE = re.compile(r"Image ([a-z0-9 ]+): (\d+) ns per draw, reference (\d+) ns")
+DONE_RE = re.compile(
+    r"Display bench done: (\d+) test card mismatches, (\d+) image mismatches"
+)
+
+
+@pytest.mark.asyncio
+async def test_host_mode_display_bench(run_bench: RunBenchFunction) -> None:
+    """Test that spans, rectangles and images draw the same pixels.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=60.0)
+
+    test_card_mismatches, image_mismatches = map(int, log.done.groups())
+    assert test_card_mismatches == 0, "Test card differs from the per pixel path"
+    assert image_mismatches == 0, "Images differ from the column by column drawer"
+    assert len(log.matches(TEST_CARD_RE)) == 1
+    assert {match.group(1) for match in log.matches(IMAGE_RE)} == {
+        "rgb565",
+        "rgb565 chroma key",
+        "rgb",
+        "grayscale",
+        "binary",
+    }
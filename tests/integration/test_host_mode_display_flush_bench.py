@@ -0,0 +1,50 @@
+"""Integration test of dirty rectangle tracking and skip_unchanged in DisplayBuffer."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+DIRTY_REGION_RE = re.compile(r"Dirty region: (\d+) failed checks")
+WIDGETS_RE = re.compile(
+    r"Widgets: (\d+) bytes per update in (\d+)\.(\d) writes, single window (\d+) bytes"
+)
+DASHBOARD_RE = re.compile(
+    r"Dashboard: (\d+) bytes per update, (\d+) with skip_unchanged, "
+    r"(\d+) of (\d+) updates sent nothing"
+)
+DONE_RE = re.compile(
+    r"Display flush bench done: (\d+) panel mismatches in (\d+) random frames"
+)
+
+
+@pytest.mark.asyncio
+async def test_host_mode_display_flush_bench(run_bench: RunBenchFunction) -> None:
+    """Test that only changed parts of the framebuffer are sent, and all of them."""
+    log = await run_bench(DONE_RE, timeout=60.0)
+
+    mismatches, frames = map(int, log.done.groups())
+    (dirty_region,) = log.matches(DIRTY_REGION_RE)
+    assert dirty_region.group(1) == "0", "DirtyRegion checks failed"
+    assert mismatches == 0, f"Panel differed after {mismatches} of {frames} flushes"
+
+    # Byte counts don't depend on timing
+    (widgets,) = log.matches(WIDGETS_RE)
+    dirty_bytes, _, _, window_bytes = map(int, widgets.groups())
+    # Two widgets in opposite corners: their rectangles are far smaller than
+    # the window around both
+    assert dirty_bytes * 10 < window_bytes, (
+        f"Dirty rectangles sent {dirty_bytes} bytes, "
+        f"the single window {window_bytes} bytes"
+    )
+
+    (dashboard,) = log.matches(DASHBOARD_RE)
+    plain_bytes, skipping_bytes, empty_updates, updates = map(int, dashboard.groups())
+    assert skipping_bytes * 5 < plain_bytes, (
+        f"skip_unchanged sent {skipping_bytes} bytes, without {plain_bytes} bytes"
+    )
+    # The clock only changes on every other update
+    assert empty_updates >= updates // 2 - 1
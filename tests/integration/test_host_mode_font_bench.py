@@ -0,0 +1,34 @@
+"""Integration test timing glyph lookups and text drawing."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+LOOKUP_RE = re.compile(
+    r"Glyph lookup: (\d+) ns per character, binary search (\d+) ns(.*)$"
+)
+PRINT_RE = re.compile(r"Font (\d+)px (\d) bpp: (\d+) ns per line, reference (\d+) ns")
+DONE_RE = re.compile(
+    r"Font bench done: (\d+) lookup mismatches, (\d+) print mismatches"
+)
+
+
+@pytest.mark.asyncio
+async def test_host_mode_font_bench(run_bench: RunBenchFunction) -> None:
+    """Test that cached lookups and span drawing give the same text.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=60.0)
+
+    lookup_mismatches, print_mismatches = map(int, log.done.groups())
+    assert lookup_mismatches == 0, "Cached lookups differ from the binary search"
+    assert print_mismatches == 0, "Text differs from the pixel by pixel renderer"
+
+    (lookup,) = log.matches(LOOKUP_RE)
+    assert lookup.group(3).strip() == "", "Lookups of the benchmark line differ"
+    assert len(log.matches(PRINT_RE)) == 4
@@ -0,0 +1,29 @@
+"""Integration test comparing the JSON writer with ArduinoJson for sensor events."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"JSON 200 sensors (state|detail all): (\d+) events/s, ArduinoJson (\d+) events/s"
+)
+DONE_RE = re.compile(r"JSON bench done: (\d+) event mismatches, (\d+) float mismatches")
+
+
+@pytest.mark.asyncio
+async def test_host_mode_json_bench(run_bench: RunBenchFunction) -> None:
+    """Test that the writer matches ArduinoJson byte for byte.
+
+    The rates are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=30.0)
+
+    event_mismatches, float_mismatches = map(int, log.done.groups())
+    assert event_mismatches == 0, "Sensor events differ from ArduinoJson"
+    assert float_mismatches == 0, "Floats are written differently from ArduinoJson"
+    details = sorted(match.group(1) for match in log.matches(RESULT_RE))
+    assert details == ["detail all", "state"]
@@ -0,0 +1,27 @@
+"""Integration test timing per-tag log level lookups."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"Logger (\d+) tag levels: (\d+) ns per 1000 lookups, reference (\d+) ns"
+)
+DONE_RE = re.compile(r"Logger level bench done: (\d+) mismatches")
+
+
+@pytest.mark.asyncio
+async def test_host_mode_logger_level_bench(run_bench: RunBenchFunction) -> None:
+    """Test that cached tag levels match the map.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=30.0)
+
+    assert int(log.done.group(1)) == 0, "Cached tag levels differ from the map"
+    counts = sorted(int(match.group(1)) for match in log.matches(RESULT_RE))
+    assert counts == [0, 10, 100]
@@ -0,0 +1,44 @@
+"""Integration test for components disabling and re-enabling their loop."""
+
+from __future__ import annotations
+
+import asyncio
+
+from aioesphomeapi import ButtonInfo, EntityState, SensorState, SwitchInfo
+import pytest
+
+from .types import APIClientConnectedFactory, RunCompiledFunction
+
+
+@pytest.mark.asyncio
+async def test_host_mode_loop_disable(
+    yaml_config: str,
+    run_compiled: RunCompiledFunction,
+    api_client_connected: APIClientConnectedFactory,
+) -> None:
+    """Test that wait_until keeps working when its loop is disabled while idle."""
+    async with run_compiled(yaml_config), api_client_connected() as client:
+        entities, _ = await client.list_entities_services()
+        gate = next(e for e in entities if isinstance(e, SwitchInfo))
+        button = next(e for e in entities if isinstance(e, ButtonInfo))
+
+        counts: asyncio.Queue[float] = asyncio.Queue()
+
+        def on_state(state: EntityState) -> None:
+            if isinstance(state, SensorState) and not state.missing_state:
+                counts.put_nowait(state.state)
+
+        client.subscribe_states(on_state)
+
+        for expected in (1.0, 2.0):
+            # Start waiting with the gate closed; the action must not complete yet
+            client.switch_command(gate.key, False)
+            await asyncio.sleep(0.2)
+            client.button_command(button.key)
+            await asyncio.sleep(0.5)
+            assert counts.empty(), "wait_until completed before its condition was met"
+
+            # Opening the gate must be noticed by the (re-enabled) loop
+            client.switch_command(gate.key, True)
+            count = await asyncio.wait_for(counts.get(), timeout=2.0)
+            assert count == expected
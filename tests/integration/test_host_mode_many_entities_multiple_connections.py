@@ -3,69 +3,122 @@
 from __future__ import annotations
 
 import asyncio
+from collections.abc import Callable
+from contextlib import AsyncExitStack
 
-from aioesphomeapi import EntityState
+from aioesphomeapi import EntityState, SwitchInfo, TextSensorInfo, TextSensorState
 import pytest
 
 from .types import APIClientConnectedFactory, RunCompiledFunction
 
 
+def counter_value(state: TextSensorState) -> tuple[str, int]:
+    """Split a counter text like "Text 1: 42" into its prefix and count."""
+    prefix, _, count = state.state.rpartition(" ")
+    return prefix, int(count)
+
+
 @pytest.mark.asyncio
+@pytest.mark.parametrize("num_clients", [2, 4])
 async def test_host_mode_many_entities_multiple_connections(
     yaml_config: str,
     run_compiled: RunCompiledFunction,
     api_client_connected: APIClientConnectedFactory,
+    num_clients: int,
 ) -> None:
     """Test shared buffer optimization with multiple API connections."""
     # Write, compile and run the ESPHome device
     loop = asyncio.get_running_loop()
-    async with (
-        run_compiled(yaml_config),
-        api_client_connected() as client1,
-        api_client_connected() as client2,
-    ):
-        # Subscribe both clients to state changes
-        states1: dict[int, EntityState] = {}
-        states2: dict[int, EntityState] = {}
-
-        client1_ready = loop.create_future()
-        client2_ready = loop.create_future()
-
-        def on_state1(state: EntityState) -> None:
-            states1[state.key] = state
-            if len(states1) >= 20 and not client1_ready.done():
-                client1_ready.set_result(len(states1))
-
-        def on_state2(state: EntityState) -> None:
-            states2[state.key] = state
-            if len(states2) >= 20 and not client2_ready.done():
-                client2_ready.set_result(len(states2))
-
-        client1.subscribe_states(on_state1)
-        client2.subscribe_states(on_state2)
-
-        # Wait for both clients to receive states
+    async with run_compiled(yaml_config), AsyncExitStack() as stack:
+        clients = [
+            await stack.enter_async_context(api_client_connected())
+            for _ in range(num_clients)
+        ]
+        entities, _ = await clients[0].list_entities_services()
+        counting_key = next(
+            e.key
+            for e in entities
+            if isinstance(e, SwitchInfo) and e.object_id == "counting"
+        )
+        counter_keys = {
+            e.key
+            for e in entities
+            if isinstance(e, TextSensorInfo) and e.object_id.startswith("test_text")
+        }
+        assert len(counter_keys) == 2
+
+        # Subscribe all clients to state changes
+        states: list[dict[int, EntityState]] = [{} for _ in clients]
+        counters: list[dict[int, list[TextSensorState]]] = [
+            {key: [] for key in counter_keys} for _ in clients
+        ]
+        ready = [loop.create_future() for _ in clients]
+
+        def make_on_state(index: int) -> Callable[[EntityState], None]:
+            def on_state(state: EntityState) -> None:
+                states[index][state.key] = state
+                if state.key in counter_keys:
+                    counters[index][state.key].append(state)
+                if len(states[index]) >= 20 and not ready[index].done():
+                    ready[index].set_result(len(states[index]))
+
+            return on_state
+
+        for index, client in enumerate(clients):
+            client.subscribe_states(make_on_state(index))
+
+        # Wait for all clients to receive states
         try:
-            count1, count2 = await asyncio.gather(
-                asyncio.wait_for(client1_ready, timeout=10.0),
-                asyncio.wait_for(client2_ready, timeout=10.0),
+            counts = await asyncio.gather(
+                *(asyncio.wait_for(future, timeout=10.0) for future in ready)
             )
         except asyncio.TimeoutError:
             pytest.fail(
-                f"One or both clients did not receive enough states within 10 seconds. "
-                f"Client1: {len(states1)}, Client2: {len(states2)}"
+                f"Not all clients received enough states within 10 seconds: "
+                f"{[len(s) for s in states]}"
             )
 
-        # Verify both clients received states successfully
-        assert count1 >= 20, (
-            f"Client 1 should have received at least 20 states, got {count1}"
-        )
-        assert count2 >= 20, (
-            f"Client 2 should have received at least 20 states, got {count2}"
-        )
+        # Verify all clients received states successfully
+        for index, count in enumerate(counts):
+            assert count >= 20, (
+                f"Client {index + 1} should have received at least 20 states, got {count}"
+            )
 
-        # Verify both clients received the same entity keys (same device state)
-        common_keys = set(states1.keys()) & set(states2.keys())
+        # Verify all clients received the same entity keys (same device state)
+        common_keys = set.intersection(*(set(s) for s in states))
         assert len(common_keys) >= 20, (
             f"Expected at least 20 common entity keys, got {len(common_keys)}"
         )
+
+        # Let the counters run for a while, then stop them and let the last values
+        # reach every client
+        await asyncio.sleep(1.0)
+        clients[0].switch_command(counting_key, False)
+        await asyncio.sleep(0.5)
+
+        # State payloads are encoded once and shared. A payload sent to the wrong
+        # client, or kept past its state, shows up as a counter going backwards, a
+        # value of the other sensor or a client that ends on another value.
+        for key in counter_keys:
+            last_values = set()
+            for index in range(num_clients):
+                received = counters[index][key]
+                assert len(received) >= 5, (
+                    f"Client {index + 1} received {len(received)} counter updates"
+                )
+                assert all(isinstance(s, TextSensorState) for s in received)
+                values = [counter_value(s) for s in received]
+                assert len({prefix for prefix, _ in values}) == 1, (
+                    f"Client {index + 1} mixed up the text sensors: {values}"
+                )
+                # The initial state may repeat a value that was just published
+                numbers = [number for _, number in values]
+                assert numbers == sorted(numbers), (
+                    f"Client {index + 1} received counter values out of order: "
+                    f"{numbers}"
+                )
+                last_values.add(values[-1])
+            assert len(last_values) == 1, (
+                f"Clients ended on different values of text sensor {key}: "
+                f"{last_values}"
+            )
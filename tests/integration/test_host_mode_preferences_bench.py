@@ -0,0 +1,33 @@
+"""Integration test timing host preference syncs and checking them across reloads."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"Preferences (\d+) keys: sync (\d+) ns, reference (\d+) ns, "
+    r"load (\d+) ns, reference (\d+) ns(.*)"
+)
+DONE_RE = re.compile(r"Preferences bench done: (\d+) reload mismatches")
+
+
+@pytest.mark.asyncio
+async def test_host_mode_preferences_bench(run_bench: RunBenchFunction) -> None:
+    """Test that loads match the reference and that reloads keep every value.
+
+    The timings are only logged, they depend on the load of the machine and disk.
+    """
+    log = await run_bench(DONE_RE, timeout=120.0)
+
+    assert int(log.done.group(1)) == 0, (
+        "Values after a reload differ from the last sync"
+    )
+    results = log.matches(RESULT_RE)
+    assert sorted(int(match.group(1)) for match in results) == [10, 100, 1000]
+    assert all(match.group(6) == "" for match in results), (
+        "Loaded values differ from the reference"
+    )
@@ -0,0 +1,29 @@
+"""Integration test timing Prometheus scrapes of 500 entities."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"Prometheus (\d+) changed per scrape: (\d+) ns per scrape, reference (\d+) ns"
+)
+DONE_RE = re.compile(r"Prometheus bench done: (\d+) mismatches, (\d+) bytes")
+
+
+@pytest.mark.asyncio
+async def test_host_mode_prometheus_bench(run_bench: RunBenchFunction) -> None:
+    """Test that the cached text matches a full render after every scrape.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=60.0)
+
+    mismatches, size = map(int, log.done.groups())
+    assert mismatches == 0, "The cached text differs from a full render"
+    assert size > 0
+    changed = sorted(int(match.group(1)) for match in log.matches(RESULT_RE))
+    assert changed == [0, 5, 50, 500]
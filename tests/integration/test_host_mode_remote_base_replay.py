@@ -0,0 +1,123 @@
+"""Integration test replaying remote_base frames through the decoders and listeners."""
+
+from __future__ import annotations
+
+import asyncio
+import re
+
+from aioesphomeapi import ButtonInfo, LogLevel
+from aioesphomeapi.api_pb2 import SubscribeLogsResponse
+import pytest
+
+from .types import APIClientConnectedFactory, RunCompiledFunction
+
+ROUND_TRIP_RE = re.compile(
+    r"Round trip (\w+): (ok|FAILED), (\d+) timings, (\d+) decodes/s"
+)
+CAPTURE_RE = re.compile(r"Capture (\w+): (ok|FAILED), decoded by \[([\w,]*)\]")
+FRAME_RE = re.compile(r"Frame (\w+): fired \[([\w,]*)\], per listener \[([\w,]*)\]")
+DONE_RE = re.compile(
+    r"Replay done: (\d+)/(\d+) round trips ok, .* (\d+)/(\d+) frames fired"
+)
+
+# The captures in the fixture, rc5 and dish ones also check the decoded values
+EXPECTED_CAPTURES = {
+    "nec",
+    "samsung",
+    "sony",
+    "panasonic",
+    "rc_switch",
+    "dish",
+    "rc5_leading_space",
+    "rc5_no_idle",
+    "rc5_field_no_idle",
+}
+
+# The listeners each frame fires. LG and NEC frames only differ in their checksum
+# bits, so each trigger also fires on the other protocol.
+EXPECTED_FIRED = {
+    "nec_a": {"lg_trigger", "nec_a", "nec_a_copy", "nec_trigger"},
+    "nec_b": {"lg_trigger", "nec_b", "nec_trigger"},
+    "nec_7": {"lg_trigger", "nec_7", "nec_trigger"},
+    "nec_unknown": {"lg_trigger", "nec_trigger"},
+    "sony": {"sony", "sony_trigger"},
+    "samsung": {"samsung"},
+    "aeha": {"aeha"},
+    "lg": {"lg_trigger", "nec_trigger"},
+    "rc1_on": {"rc1_any", "rc1_on", "rc1_on_copy"},
+    "rc1_off": {"rc1_any", "rc1_off"},
+    "rc2_off": set(),
+    "rc2_on": {"rc2_on"},
+    "rc3_on": set(),
+}
+
+
+def name_set(names: str) -> set[str]:
+    """Split a comma separated list of listener names."""
+    return set(names.split(",")) - {""}
+
+
+@pytest.mark.asyncio
+async def test_host_mode_remote_base_replay(
+    yaml_config: str,
+    run_compiled: RunCompiledFunction,
+    api_client_connected: APIClientConnectedFactory,
+) -> None:
+    """Test the decoders on their own encoding and captures, and the listeners."""
+    loop = asyncio.get_running_loop()
+    round_trips: dict[str, tuple[bool, int, int]] = {}
+    captures: dict[str, tuple[bool, list[str]]] = {}
+    frames: dict[str, tuple[set[str], set[str]]] = {}
+    done: asyncio.Future[tuple[int, int, int]] = loop.create_future()
+
+    def on_log(msg: SubscribeLogsResponse) -> None:
+        text = msg.message.decode("utf8", "backslashreplace")
+        if match := ROUND_TRIP_RE.search(text):
+            name, result, timings, rate = match.groups()
+            round_trips[name] = (result == "ok", int(timings), int(rate))
+        elif match := CAPTURE_RE.search(text):
+            name, result, decoders = match.groups()
+            captures[name] = (result == "ok", decoders.split(","))
+        elif match := FRAME_RE.search(text):
+            name, fired, per_listener = match.groups()
+            frames[name] = (name_set(fired), name_set(per_listener))
+        elif (match := DONE_RE.search(text)) and not done.done():
+            _, protocols, frames_ok, frame_count = match.groups()
+            done.set_result((int(protocols), int(frames_ok), int(frame_count)))
+
+    async with run_compiled(yaml_config), api_client_connected() as client:
+        client.subscribe_logs(on_log, log_level=LogLevel.LOG_LEVEL_INFO)
+        entities, _ = await client.list_entities_services()
+        button = next(e for e in entities if isinstance(e, ButtonInfo))
+        client.button_command(button.key)
+
+        try:
+            protocol_count, frames_ok, frame_count = await asyncio.wait_for(
+                done, timeout=30.0
+            )
+        except asyncio.TimeoutError:
+            pytest.fail(
+                f"Replay did not finish, got round trips for {sorted(round_trips)}"
+            )
+
+        assert len(round_trips) == protocol_count, "Missing round trip results"
+        for name, (ok, timings, rate) in round_trips.items():
+            assert ok, f"{name} did not decode its own encoding"
+            assert timings > 0, f"{name} encoded an empty frame"
+            assert rate > 0, f"{name} was not timed"
+        assert set(captures) == EXPECTED_CAPTURES
+        for name, (ok, decoders) in captures.items():
+            assert ok, f"Capture {name} decoded wrongly, decoded by {decoders}"
+
+        # The receiver looks listeners up by protocol and data, which must fire the
+        # same listeners as handing the frame to each of them
+        assert set(frames) == set(EXPECTED_FIRED)
+        for name, (fired, per_listener) in frames.items():
+            assert fired == per_listener, (
+                f"Frame {name} fired {sorted(fired)}, listeners on their own "
+                f"{sorted(per_listener)}"
+            )
+            assert fired == EXPECTED_FIRED[name], (
+                f"Frame {name} fired {sorted(fired)}"
+            )
+        assert frames_ok == frame_count == len(EXPECTED_FIRED)
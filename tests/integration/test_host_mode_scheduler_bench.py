@@ -0,0 +1,32 @@
+"""Integration test timing named timer replacement in the scheduler."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"Scheduler (\d+) timers: (\d+) ns per replace, reference (\d+) ns"
+)
+COLLISION_RE = re.compile(r"Scheduler name collision: (ok|FAILED)")
+DONE_RE = re.compile(r"Scheduler bench done: (\d+) cancel mismatches")
+
+
+@pytest.mark.asyncio
+async def test_host_mode_scheduler_bench(run_bench: RunBenchFunction) -> None:
+    """Test that indexed timer replacement cancels the same timers as a scan.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=30.0)
+
+    collision = [match.group(1) for match in log.matches(COLLISION_RE)]
+    assert collision == ["ok"], "Names with the same hash replaced each other"
+    assert int(log.done.group(1)) == 0, (
+        "Cancel results differ from the reference scheduler"
+    )
+    counts = sorted(int(match.group(1)) for match in log.matches(RESULT_RE))
+    assert counts == [16, 128, 1024]
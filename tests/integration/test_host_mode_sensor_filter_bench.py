@@ -0,0 +1,39 @@
+"""Integration test comparing the sliding window sensor filters with the old ones."""
+
+from __future__ import annotations
+
+import re
+
+import pytest
+
+from .types import RunBenchFunction
+
+RESULT_RE = re.compile(
+    r"Filter (\w+) window (\d+) send_every (\d+): (\d+) ns per value, "
+    r"reference (\d+) ns(.*)"
+)
+DONE_RE = re.compile(r"Filter bench done: (\d+) mismatches in (\d+) random runs")
+
+KINDS = ["median", "quantile", "min", "max", "average"]
+
+
+@pytest.mark.asyncio
+async def test_host_mode_sensor_filter_bench(run_bench: RunBenchFunction) -> None:
+    """Test that the filters match their old results.
+
+    The timings are only logged, they depend on the load of the machine.
+    """
+    log = await run_bench(DONE_RE, timeout=60.0)
+
+    mismatches, runs = map(int, log.done.groups())
+    assert runs == 1000
+    assert mismatches == 0, "Filter results differ from the old implementation"
+    results = log.matches(RESULT_RE)
+    assert len(results) == 3 * len(KINDS)
+    assert {match.group(1) for match in results} == set(KINDS)
+    for match in results:
+        kind, window, send_every = match.group(1, 2, 3)
+        assert match.group(6) == "", (
+            f"{kind} window {window} send_every {send_every} produced different "
+            "results while timed"
+        )
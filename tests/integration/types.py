@@ -5,7 +5,9 @@ from __future__ import annotations
 import asyncio
 from collections.abc import Awaitable, Callable
 from contextlib import AbstractAsyncContextManager
+from dataclasses import dataclass
 from pathlib import Path
+import re
 from typing import Protocol
 
 from aioesphomeapi import APIClient
@@ -17,6 +19,18 @@ RunCompiledFunction = Callable[[str, str | None], AbstractAsyncContextManager[No
 WaitFunction = Callable[[APIClient, float], Awaitable[bool]]
 
 
+@dataclass
+class BenchLog:
+    """INFO log lines of a bench run, up to and including its done line."""
+
+    lines: list[str]
+    done: re.Match[str]
+
+    def matches(self, pattern: re.Pattern[str]) -> list[re.Match[str]]:
+        """Return the match of every line that matches pattern, in log order."""
+        return [match for line in self.lines if (match := pattern.search(line))]
+
+
 class APIClientFactory(Protocol):
     """Protocol for API client factory."""
 
@@ -42,3 +56,11 @@ class APIClientConnectedFactory(Protocol):
         client_info: str = "integration-test",
         timeout: float = 30,
     ) -> AbstractAsyncContextManager[APIClient]: ...
+
+
+class RunBenchFunction(Protocol):
+    """Protocol for running a bench component until it logs its done line."""
+
+    def __call__(  # noqa: E704
+        self, done_pattern: re.Pattern[str], timeout: float = 60.0
+    ) -> Awaitable[BenchLog]: ...
@@ -269,6 +269,20 @@ def test_sanitize(text, expected):
     assert actual == expected
 
 
+@pytest.mark.parametrize(
+    "text, expected",
+    (
+        ("", 0x811C9DC5),
+        ("a", 0x050C5D7E),
+        ("foobar", 0x31F0B262),
+    ),
+)
+def test_fnv1_hash(text, expected):
+    actual = helpers.fnv1_hash(text)
+
+    assert actual == expected
+
+
 @pytest.mark.parametrize(
     "text, expected",
     ((["127.0.0.1", "fe80::1", "2001::2"], ["2001::2", "127.0.0.1", "fe80::1"]),),